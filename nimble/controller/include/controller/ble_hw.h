@@ -57,6 +57,17 @@ int ble_hw_whitelist_match(void);
 struct ble_encryption_block;
 int ble_hw_encrypt_block(struct ble_encryption_block *ecb);
 
+/*
+ * Encrypt one plain text with each of num keys. Keys and texts are in the
+ * byte order used by struct ble_encryption_block. Only drivers that encrypt
+ * many blocks faster than one at a time provide it; it is used only if
+ * BLE_LL_RESOLV_BATCH_SIZE is larger than 1.
+ */
+int ble_hw_encrypt_block_batch(const uint8_t *plain_text,
+                               const uint8_t * const *keys,
+                               uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE],
+                               int num);
+
 /* Random number generation */
 typedef void (*ble_rng_isr_cb_t)(uint8_t rnum);
 int ble_hw_rng_init(ble_rng_isr_cb_t cb, int bias);
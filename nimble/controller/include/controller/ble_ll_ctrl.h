@@ -356,6 +356,11 @@ void ble_ll_hci_ev_send_vs_css_slot_changed(uint16_t conn_handle,
                                             uint16_t slot_idx);
 #endif
 
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+int ble_ll_hci_ev_send_vs_sched_trace(const struct ble_hci_vs_sched_trace_rec *recs,
+                                      uint8_t count, uint16_t lost);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
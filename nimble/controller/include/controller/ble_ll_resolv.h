@@ -115,6 +115,11 @@ int ble_ll_resolv_peer_rpa_any(const uint8_t *rpa);
 /* Initialize resolv*/
 void ble_ll_resolv_init(void);
 
+#if MYNEWT_VAL(SELFTEST)
+/* Does what expiry of the RPA timer does, without waiting for it */
+void ble_ll_resolv_rpa_timer_expire(void);
+#endif
+
 #if MYNEWT_VAL(BLE_LL_HCI_VS_LOCAL_IRK)
 int ble_ll_resolv_local_irk_set(uint8_t own_addr_type, const uint8_t *irk);
 int ble_ll_resolv_local_rpa_get(uint8_t own_addr_type, uint8_t *rpa);
@@ -109,6 +109,14 @@ struct ble_ll_sched_item
     void            *cb_arg;
     sched_cb_func   sched_cb;
     TAILQ_ENTRY(ble_ll_sched_item) link;
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    /* Scheduler queue tree node, see ble_ll_sched_q_priv.h */
+    struct ble_ll_sched_item *rb_parent;
+    struct ble_ll_sched_item *rb_left;
+    struct ble_ll_sched_item *rb_right;
+    uint32_t        rb_max_gap;
+    uint8_t         rb_red;
+#endif
 };
 
 /* Initialize the scheduler */
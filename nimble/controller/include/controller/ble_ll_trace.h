@@ -89,6 +89,40 @@ ble_ll_trace_u32x3(unsigned id, uint32_t p1, uint32_t p2, uint32_t p3)
 
 #endif
 
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+
+void ble_ll_trace_sched_init(void);
+void ble_ll_trace_sched_reset(void);
+void ble_ll_trace_sched_enable(uint8_t enable);
+
+/*
+ * Records scheduler event (one of BLE_HCI_VS_SCHED_TRACE_*) for item of given
+ * type. Current time is recorded along with planned start and end time.
+ * Context: any
+ */
+void ble_ll_trace_sched(uint8_t event, uint8_t sched_type, uint8_t reason,
+                        uint32_t start_time, uint32_t end_time);
+
+#else
+
+static inline void
+ble_ll_trace_sched_init(void)
+{
+}
+
+static inline void
+ble_ll_trace_sched_reset(void)
+{
+}
+
+static inline void
+ble_ll_trace_sched(uint8_t event, uint8_t sched_type, uint8_t reason,
+                   uint32_t start_time, uint32_t end_time)
+{
+}
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -1676,6 +1676,7 @@ ble_ll_reset(void)
 
     /* Reset scheduler */
     ble_ll_sched_init();
+    ble_ll_trace_sched_reset();
 
     /* Set state to standby */
     ble_ll_state_set(BLE_LL_STATE_STANDBY);
@@ -1802,6 +1803,7 @@ ble_ll_init(void)
     SYSINIT_ASSERT_ACTIVE();
 
     ble_ll_trace_init();
+    ble_ll_trace_sched_init();
     ble_phy_trace_init();
 
     /* Set public device address if not already set */
@@ -668,3 +668,32 @@ ble_ll_hci_ev_send_vs_llcp_trace(uint8_t type, uint16_t handle, uint16_t count,
     }
 }
 #endif
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+int
+ble_ll_hci_ev_send_vs_sched_trace(const struct ble_hci_vs_sched_trace_rec *recs,
+                                  uint8_t count, uint16_t lost)
+{
+    struct ble_hci_ev_vs_sched_trace *ev;
+    struct ble_hci_ev_vs *ev_vs;
+    struct ble_hci_ev *hci_ev;
+
+    hci_ev = ble_transport_alloc_evt(1);
+    if (!hci_ev) {
+        return -1;
+    }
+
+    hci_ev->opcode = BLE_HCI_EVCODE_VS;
+    hci_ev->length = sizeof(*ev_vs) + sizeof(*ev) + count * sizeof(*recs);
+    ev_vs = (void *)hci_ev->data;
+    ev_vs->id = BLE_HCI_VS_SUBEV_ID_SCHED_TRACE;
+    ev = (void *)ev_vs->data;
+    ev->lost = htole16(lost);
+    ev->count = count;
+    memcpy(ev->recs, recs, count * sizeof(*recs));
+
+    ble_ll_hci_event_send(hci_ev);
+
+    return 0;
+}
+#endif
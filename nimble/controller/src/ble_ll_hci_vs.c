@@ -31,6 +31,7 @@
 #include "ble_ll_conn_priv.h"
 #include "ble_ll_priv.h"
 #include "controller/ble_ll_resolv.h"
+#include "controller/ble_ll_trace.h"
 
 #if MYNEWT_VAL(BLE_LL_HCI_VS)
 
@@ -388,6 +389,29 @@ ble_ll_hci_vs_set_scan_cfg(uint16_t ocf, const uint8_t *cmdbuf, uint8_t cmdlen,
 }
 #endif
 
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+static int
+ble_ll_hci_vs_sched_trace(uint16_t ocf, const uint8_t *cmdbuf, uint8_t cmdlen,
+                          uint8_t *rspbuf, uint8_t *rsplen)
+{
+    const struct ble_hci_vs_sched_trace_cp *cmd = (const void *)cmdbuf;
+
+    if (cmdlen != sizeof(*cmd)) {
+        return BLE_ERR_INV_HCI_CMD_PARMS;
+    }
+
+    if (cmd->enable > 1) {
+        return BLE_ERR_INV_HCI_CMD_PARMS;
+    }
+
+    ble_ll_trace_sched_enable(cmd->enable);
+
+    *rsplen = 0;
+
+    return 0;
+}
+#endif
+
 static struct ble_ll_hci_vs_cmd g_ble_ll_hci_vs_cmds[] = {
     BLE_LL_HCI_VS_CMD(BLE_HCI_OCF_VS_RD_STATIC_ADDR,
                       ble_ll_hci_vs_rd_static_addr),
@@ -420,7 +444,11 @@ static struct ble_ll_hci_vs_cmd g_ble_ll_hci_vs_cmds[] = {
 #endif
 #if MYNEWT_VAL(BLE_LL_HCI_VS_SET_SCAN_CFG)
     BLE_LL_HCI_VS_CMD(BLE_HCI_OCF_VS_SET_SCAN_CFG,
-                      ble_ll_hci_vs_set_scan_cfg)
+                      ble_ll_hci_vs_set_scan_cfg),
+#endif
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+    BLE_LL_HCI_VS_CMD(BLE_HCI_OCF_VS_SCHED_TRACE,
+                      ble_ll_hci_vs_sched_trace),
 #endif
 };
 
@@ -48,6 +48,28 @@ struct ble_ll_resolv_data g_ble_ll_resolv_data;
 __attribute__((aligned(4)))
 struct ble_ll_resolv_entry g_ble_ll_resolv_list[MYNEWT_VAL(BLE_LL_RESOLV_LIST_SIZE)];
 
+#if MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE)
+/* Peer RPAs that resolved recently, with the RL entry they resolved to */
+struct ble_ll_resolv_cache_entry {
+    uint8_t rpa[BLE_DEV_ADDR_LEN];
+    int8_t rl_idx;
+};
+
+static struct ble_ll_resolv_cache_entry
+    g_ble_ll_resolv_cache[MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE)];
+static uint8_t g_ble_ll_resolv_cache_cnt;
+static uint8_t g_ble_ll_resolv_cache_next;
+#endif
+
+#if MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+/* Peer RPAs that recently did not resolve with any IRK on RL */
+static uint8_t
+    g_ble_ll_resolv_neg_cache[MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)]
+                             [BLE_DEV_ADDR_LEN];
+static uint8_t g_ble_ll_resolv_neg_cache_cnt;
+static uint8_t g_ble_ll_resolv_neg_cache_next;
+#endif
+
 #if MYNEWT_VAL(BLE_LL_HCI_VS_LOCAL_IRK)
 struct local_irk_data {
     uint8_t is_set;
@@ -80,6 +102,110 @@ ble_ll_resolv_list_chg_allowed(void)
     return rc;
 }
 
+/**
+ * Forgets all cached results of peer RPA resolution. Must be called whenever
+ * the peer IRKs on the resolving list or their order change.
+ */
+static void
+ble_ll_resolv_cache_flush(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+#if MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE)
+    g_ble_ll_resolv_cache_cnt = 0;
+    g_ble_ll_resolv_cache_next = 0;
+#endif
+#if MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+    g_ble_ll_resolv_neg_cache_cnt = 0;
+    g_ble_ll_resolv_neg_cache_next = 0;
+#endif
+    OS_EXIT_CRITICAL(sr);
+}
+
+/**
+ * Looks up a peer RPA among the cached results of resolution.
+ *
+ * @param rpa
+ * @param rl_idx On hit, index on RL the RPA resolved to or -1 if it did not
+ *               resolve.
+ *
+ * @return int 1: cache hit. 0: RPA is not cached.
+ */
+static int
+ble_ll_resolv_cache_find(const uint8_t *rpa, int *rl_idx)
+{
+#if MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE) || \
+    MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+    int i;
+#endif
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+#if MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE)
+    for (i = 0; i < g_ble_ll_resolv_cache_cnt; i++) {
+        if (!memcmp(g_ble_ll_resolv_cache[i].rpa, rpa, BLE_DEV_ADDR_LEN)) {
+            *rl_idx = g_ble_ll_resolv_cache[i].rl_idx;
+            OS_EXIT_CRITICAL(sr);
+            return 1;
+        }
+    }
+#endif
+#if MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+    for (i = 0; i < g_ble_ll_resolv_neg_cache_cnt; i++) {
+        if (!memcmp(g_ble_ll_resolv_neg_cache[i], rpa, BLE_DEV_ADDR_LEN)) {
+            *rl_idx = -1;
+            OS_EXIT_CRITICAL(sr);
+            return 1;
+        }
+    }
+#endif
+    OS_EXIT_CRITICAL(sr);
+
+    return 0;
+}
+
+/**
+ * Stores the result of peer RPA resolution, replacing the oldest result if
+ * the cache is full.
+ *
+ * @param rpa
+ * @param rl_idx Index on RL the RPA resolved to or -1 if it did not resolve.
+ */
+static void
+ble_ll_resolv_cache_add(const uint8_t *rpa, int rl_idx)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    if (rl_idx >= 0) {
+#if MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE)
+        memcpy(g_ble_ll_resolv_cache[g_ble_ll_resolv_cache_next].rpa, rpa,
+               BLE_DEV_ADDR_LEN);
+        g_ble_ll_resolv_cache[g_ble_ll_resolv_cache_next].rl_idx = rl_idx;
+
+        if (g_ble_ll_resolv_cache_cnt < ARRAY_SIZE(g_ble_ll_resolv_cache)) {
+            g_ble_ll_resolv_cache_cnt++;
+        }
+        g_ble_ll_resolv_cache_next = (g_ble_ll_resolv_cache_next + 1) %
+                                     ARRAY_SIZE(g_ble_ll_resolv_cache);
+#endif
+    } else {
+#if MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+        memcpy(g_ble_ll_resolv_neg_cache[g_ble_ll_resolv_neg_cache_next], rpa,
+               BLE_DEV_ADDR_LEN);
+
+        if (g_ble_ll_resolv_neg_cache_cnt <
+            ARRAY_SIZE(g_ble_ll_resolv_neg_cache)) {
+            g_ble_ll_resolv_neg_cache_cnt++;
+        }
+        g_ble_ll_resolv_neg_cache_next = (g_ble_ll_resolv_neg_cache_next + 1) %
+                                         ARRAY_SIZE(g_ble_ll_resolv_neg_cache);
+#endif
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+
 static void
 generate_rpa(const uint8_t *irk, uint8_t *rpa)
 {
@@ -145,6 +271,11 @@ ble_ll_resolv_rpa_timer_cb(struct ble_npl_event *ev)
     os_sr_t sr;
 #endif
 
+    /* Don't keep results for longer than our own RPAs are used; peers are
+     * likely to rotate theirs on a similar period.
+     */
+    ble_ll_resolv_cache_flush();
+
     rl = &g_ble_ll_resolv_list[0];
     for (i = 0; i < g_ble_ll_resolv_data.rl_cnt; ++i) {
         if (rl->rl_has_local) {
@@ -179,6 +310,14 @@ ble_ll_resolv_rpa_timer_cb(struct ble_npl_event *ev)
 #endif
 }
 
+#if MYNEWT_VAL(SELFTEST)
+void
+ble_ll_resolv_rpa_timer_expire(void)
+{
+    ble_ll_resolv_rpa_timer_cb(NULL);
+}
+#endif
+
 /**
  * Called to determine if the IRK is all zero.
  *
@@ -221,6 +360,7 @@ ble_ll_resolv_list_clr(void)
     g_ble_ll_resolv_data.rl_cnt_hw = 0;
     g_ble_ll_resolv_data.rl_cnt = 0;
     ble_hw_resolv_list_clear();
+    ble_ll_resolv_cache_flush();
 
     /* stop RPA timer when clearing RL */
     ble_npl_callout_stop(&g_ble_ll_resolv_data.rpa_timer);
@@ -379,6 +519,11 @@ ble_ll_resolv_list_add(const uint8_t *cmdbuf, uint8_t len)
         rc = ble_hw_resolv_list_add(rl->rl_peer_irk);
         BLE_LL_ASSERT(rc == BLE_ERR_SUCCESS);
         g_ble_ll_resolv_data.rl_cnt_hw++;
+
+        /* New IRK may resolve RPAs cached as unresolvable and it shifted
+         * indices of entries following it.
+         */
+        ble_ll_resolv_cache_flush();
     }
 
     g_ble_ll_resolv_data.rl_cnt++;
@@ -429,6 +574,7 @@ ble_ll_resolv_list_rmv(const uint8_t *cmdbuf, uint8_t len)
         if (position <= g_ble_ll_resolv_data.rl_cnt_hw) {
             ble_hw_resolv_list_rmv(position - 1);
             g_ble_ll_resolv_data.rl_cnt_hw--;
+            ble_ll_resolv_cache_flush();
         }
 
         /* stop RPA timer if list is empty */
@@ -719,6 +865,36 @@ ble_ll_resolv_local_rpa_get(uint8_t own_addr_type, uint8_t *rpa)
 }
 #endif
 
+/**
+ * Fills in the plain text for ah() from the prand part of an RPA.
+ *
+ * @param rpa
+ * @param plain_text
+ */
+static void
+ble_ll_resolv_rpa_prand(const uint8_t *rpa, uint8_t *plain_text)
+{
+    memset(plain_text, 0, BLE_ENC_BLOCK_SIZE);
+    plain_text[15] = rpa[3];
+    plain_text[14] = rpa[4];
+    plain_text[13] = rpa[5];
+}
+
+/**
+ * Checks the result of ah() against the hash part of an RPA.
+ *
+ * @param rpa
+ * @param cipher_text
+ *
+ * @return int 1: hash matches. 0: it does not.
+ */
+static int
+ble_ll_resolv_rpa_hash_match(const uint8_t *rpa, const uint8_t *cipher_text)
+{
+    return (cipher_text[15] == rpa[0]) && (cipher_text[14] == rpa[1]) &&
+           (cipher_text[13] == rpa[2]);
+}
+
 /**
  * Resolve a Resolvable Private Address
  *
@@ -730,43 +906,59 @@ ble_ll_resolv_local_rpa_get(uint8_t own_addr_type, uint8_t *rpa)
 int
 ble_ll_resolv_rpa(const uint8_t *rpa, const uint8_t *irk)
 {
-    int rc;
-    const uint32_t *irk32;
-    uint32_t *key32;
-    uint32_t *pt32;
     struct ble_encryption_block ecb;
 
-    irk32 = (const uint32_t *)irk;
-    key32 = (uint32_t *)&ecb.key[0];
+    memcpy(ecb.key, irk, BLE_ENC_BLOCK_SIZE);
+    ble_ll_resolv_rpa_prand(rpa, ecb.plain_text);
 
-    key32[0] = irk32[0];
-    key32[1] = irk32[1];
-    key32[2] = irk32[2];
-    key32[3] = irk32[3];
+    ble_hw_encrypt_block(&ecb);
 
-    pt32 = (uint32_t *)&ecb.plain_text[0];
-    pt32[0] = 0;
-    pt32[1] = 0;
-    pt32[2] = 0;
-    pt32[3] = 0;
+    return ble_ll_resolv_rpa_hash_match(rpa, ecb.cipher_text);
+}
 
-    ecb.plain_text[15] = rpa[3];
-    ecb.plain_text[14] = rpa[4];
-    ecb.plain_text[13] = rpa[5];
+#if MYNEWT_VAL(BLE_LL_RESOLV_BATCH_SIZE) > 1
+/**
+ * Checks peer IRKs in batches, so that implementations which can encrypt
+ * with many keys at once do so.
+ */
+static int
+ble_ll_resolv_peer_rpa_sweep(const uint8_t *rpa)
+{
+    /* Static, as this is called from LL task only and may not fit its stack */
+    static const uint8_t *irks[MYNEWT_VAL(BLE_LL_RESOLV_BATCH_SIZE)];
+    static uint8_t hash[MYNEWT_VAL(BLE_LL_RESOLV_BATCH_SIZE)]
+                       [BLE_ENC_BLOCK_SIZE];
+    uint8_t prand[BLE_ENC_BLOCK_SIZE];
+    int num;
+    int i;
+    int j;
 
-    ble_hw_encrypt_block(&ecb);
-    if ((ecb.cipher_text[15] == rpa[0]) && (ecb.cipher_text[14] == rpa[1]) &&
-        (ecb.cipher_text[13] == rpa[2])) {
-        rc = 1;
-    } else {
-        rc = 0;
+    ble_ll_resolv_rpa_prand(rpa, prand);
+
+    for (i = 0; i < g_ble_ll_resolv_data.rl_cnt_hw; i += num) {
+        num = g_ble_ll_resolv_data.rl_cnt_hw - i;
+        if (num > MYNEWT_VAL(BLE_LL_RESOLV_BATCH_SIZE)) {
+            num = MYNEWT_VAL(BLE_LL_RESOLV_BATCH_SIZE);
+        }
+
+        for (j = 0; j < num; j++) {
+            irks[j] = g_ble_ll_resolv_list[i + j].rl_peer_irk;
+        }
+
+        ble_hw_encrypt_block_batch(prand, irks, hash, num);
+
+        for (j = 0; j < num; j++) {
+            if (ble_ll_resolv_rpa_hash_match(rpa, hash[j])) {
+                return i + j;
+            }
+        }
     }
 
-    return rc;
+    return -1;
 }
-
-int
-ble_ll_resolv_peer_rpa_any(const uint8_t *rpa)
+#else
+static int
+ble_ll_resolv_peer_rpa_sweep(const uint8_t *rpa)
 {
     int i;
 
@@ -778,6 +970,23 @@ ble_ll_resolv_peer_rpa_any(const uint8_t *rpa)
 
     return -1;
 }
+#endif
+
+int
+ble_ll_resolv_peer_rpa_any(const uint8_t *rpa)
+{
+    int rl_idx;
+
+    if (ble_ll_resolv_cache_find(rpa, &rl_idx)) {
+        return rl_idx;
+    }
+
+    rl_idx = ble_ll_resolv_peer_rpa_sweep(rpa);
+
+    ble_ll_resolv_cache_add(rpa, rl_idx);
+
+    return rl_idx;
+}
 
 /**
  * Returns whether or not address resolution is enabled.
@@ -816,6 +1025,8 @@ ble_ll_resolv_init(void)
     }
     g_ble_ll_resolv_data.rl_size = hw_size;
 
+    ble_ll_resolv_cache_flush();
+
     ble_npl_callout_init(&g_ble_ll_resolv_data.rpa_timer,
                          &g_ble_ll_data.ll_evq,
                          ble_ll_resolv_rpa_timer_cb,
@@ -42,6 +42,7 @@
 #include "controller/ble_ll_sync.h"
 #include "ble_ll_conn_priv.h"
 #include "ble_ll_priv.h"
+#include "ble_ll_scan_dup_priv.h"
 
 #if MYNEWT_VAL(BLE_LL_ROLE_OBSERVER)
 
@@ -113,21 +114,25 @@ g_ble_ll_scan_rsp_advs[MYNEWT_VAL(BLE_LL_NUM_SCAN_RSP_ADVS)];
 #define BLE_LL_SCAN_DUP_F_DIR_ADV_REPORT_SENT   (0x02)
 #define BLE_LL_SCAN_DUP_F_SCAN_RSP_SENT         (0x04)
 
-struct ble_ll_scan_dup_entry {
-    uint8_t type;       /* entry type, see BLE_LL_SCAN_ENTRY_TYPE_* */
-    uint8_t addr[6];
-    uint8_t flags;      /* use BLE_LL_SCAN_DUP_F_xxx */
+static os_membuf_t g_scan_dup_mem[ BLE_LL_SCAN_DUP_TABLE_MEM_SIZE(
+                                   MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS)) ];
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+/* One hash bucket per entry; 0 entries still needs a bucket to compile */
+#define BLE_LL_SCAN_DUP_NUM_BUCKETS \
+    (MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS) > 0 ? \
+     MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS) : 1)
+
+static struct ble_ll_scan_dup_bucket
+    g_scan_dup_buckets[BLE_LL_SCAN_DUP_NUM_BUCKETS];
+#define BLE_LL_SCAN_DUP_BUCKETS     g_scan_dup_buckets
+#else
+#define BLE_LL_SCAN_DUP_NUM_BUCKETS 0
+#define BLE_LL_SCAN_DUP_BUCKETS     NULL
+#endif
+static struct ble_ll_scan_dup_table g_scan_dup;
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
-    uint16_t adi;
+static const uint8_t g_ble_ll_scan_dup_anon_addr[BLE_DEV_ADDR_LEN];
 #endif
-    TAILQ_ENTRY(ble_ll_scan_dup_entry) link;
-};
-
-static os_membuf_t g_scan_dup_mem[ OS_MEMPOOL_SIZE(
-                                   MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS),
-                                   sizeof(struct ble_ll_scan_dup_entry)) ];
-static struct os_mempool g_scan_dup_pool;
-static TAILQ_HEAD(ble_ll_scan_dup_list, ble_ll_scan_dup_entry) g_scan_dup_list;
 
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
 static int
@@ -631,7 +636,7 @@ ble_ll_scan_dup_update_legacy(uint8_t addr_type, const uint8_t *addr,
      * some entry or allocated new one and placed in on the top of queue.
      */
 
-    e = TAILQ_FIRST(&g_scan_dup_list);
+    e = ble_ll_scan_dup_table_head(&g_scan_dup);
     BLE_LL_ASSERT(e && e->type == type && !memcmp(e->addr, addr, 6));
 
     if (subev == BLE_HCI_LE_SUBEV_DIRECT_ADV_RPT) {
@@ -964,8 +969,7 @@ ble_ll_scan_sm_start(struct ble_ll_scan_sm *scansm)
     /* Forget filtered advertisers from previous scan. */
     g_ble_ll_scan_num_rsp_advs = 0;
 
-    os_mempool_clear(&g_scan_dup_pool);
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_table_clear(&g_scan_dup);
 
     /*
      * First scan window can start when RF is enabled. Add 1 tick since we are
@@ -1774,65 +1778,27 @@ ble_ll_scan_wfr_timer_exp(void)
     ble_phy_restart_rx();
 }
 
-static inline void
-ble_ll_scan_dup_move_to_head(struct ble_ll_scan_dup_entry *e)
-{
-    if (e != TAILQ_FIRST(&g_scan_dup_list)) {
-        TAILQ_REMOVE(&g_scan_dup_list, e, link);
-        TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
-    }
-}
-
-static inline struct ble_ll_scan_dup_entry *
-ble_ll_scan_dup_new(void)
-{
-    struct ble_ll_scan_dup_entry *e;
-
-    e = os_memblock_get(&g_scan_dup_pool);
-    if (!e) {
-        e = TAILQ_LAST(&g_scan_dup_list, ble_ll_scan_dup_list);
-        TAILQ_REMOVE(&g_scan_dup_list, e, link);
-    }
-
-    memset(e, 0, sizeof(*e));
-
-    return e;
-}
-
 static int
 ble_ll_scan_dup_check_legacy(uint8_t addr_type, uint8_t *addr, uint8_t pdu_type)
 {
     struct ble_ll_scan_dup_entry *e;
     uint8_t type;
+    int created;
     int rc;
 
     type = BLE_LL_SCAN_ENTRY_TYPE_LEGACY(addr_type);
 
-    TAILQ_FOREACH(e, &g_scan_dup_list, link) {
-        if ((e->type == type) && !memcmp(e->addr, addr, 6)) {
-            break;
-        }
+    e = ble_ll_scan_dup_table_get(&g_scan_dup, type, addr, &created);
+    if (created) {
+        return 0;
     }
 
-    if (e) {
-        if (pdu_type == BLE_ADV_PDU_TYPE_ADV_DIRECT_IND) {
-            rc = e->flags & BLE_LL_SCAN_DUP_F_DIR_ADV_REPORT_SENT;
-        } else if (pdu_type == BLE_ADV_PDU_TYPE_SCAN_RSP) {
-            rc = e->flags & BLE_LL_SCAN_DUP_F_SCAN_RSP_SENT;
-        } else {
-            rc = e->flags & BLE_LL_SCAN_DUP_F_ADV_REPORT_SENT;
-        }
-
-        ble_ll_scan_dup_move_to_head(e);
+    if (pdu_type == BLE_ADV_PDU_TYPE_ADV_DIRECT_IND) {
+        rc = e->flags & BLE_LL_SCAN_DUP_F_DIR_ADV_REPORT_SENT;
+    } else if (pdu_type == BLE_ADV_PDU_TYPE_SCAN_RSP) {
+        rc = e->flags & BLE_LL_SCAN_DUP_F_SCAN_RSP_SENT;
     } else {
-        rc = 0;
-
-        e = ble_ll_scan_dup_new();
-        e->flags = 0;
-        e->type = type;
-        memcpy(e->addr, addr, 6);
-
-        TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
+        rc = e->flags & BLE_LL_SCAN_DUP_F_ADV_REPORT_SENT;
     }
 
     return rc;
@@ -1846,6 +1812,7 @@ ble_ll_scan_dup_check_ext(uint8_t addr_type, uint8_t *addr, bool has_aux,
     struct ble_ll_scan_dup_entry *e;
     bool is_anon;
     uint8_t type;
+    int created;
     int rc;
 
     is_anon = addr == NULL;
@@ -1853,36 +1820,17 @@ ble_ll_scan_dup_check_ext(uint8_t addr_type, uint8_t *addr, bool has_aux,
 
     type = BLE_LL_SCAN_ENTRY_TYPE_EXT(addr_type, has_aux, is_anon, adi);
 
-    TAILQ_FOREACH(e, &g_scan_dup_list, link) {
-        if ((e->type == type) &&
-            (is_anon || !memcmp(e->addr, addr, BLE_DEV_ADDR_LEN))) {
-            break;
-        }
-    }
-
-    if (e) {
-        if (e->adi != adi) {
-            rc = 0;
-
-            e->flags = 0;
-            e->adi = adi;
-        } else {
-            rc = e->flags & BLE_LL_SCAN_DUP_F_ADV_REPORT_SENT;
-        }
-
-        ble_ll_scan_dup_move_to_head(e);
-    } else {
+    /* Anonymous entries differ by type only; key them on a null address */
+    e = ble_ll_scan_dup_table_get(&g_scan_dup, type,
+                                  is_anon ? g_ble_ll_scan_dup_anon_addr : addr,
+                                  &created);
+    if (created || (e->adi != adi)) {
         rc = 0;
 
-        e = ble_ll_scan_dup_new();
         e->flags = 0;
-        e->type = type;
         e->adi = adi;
-        if (!is_anon) {
-            memcpy(e->addr, addr, 6);
-        }
-
-        TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
+    } else {
+        rc = e->flags & BLE_LL_SCAN_DUP_F_ADV_REPORT_SENT;
     }
 
     return rc;
@@ -1906,7 +1854,7 @@ ble_ll_scan_dup_update_ext(uint8_t addr_type, uint8_t *addr, bool has_aux,
      * some entry or allocated new one and placed in on the top of queue.
      */
 
-    e = TAILQ_FIRST(&g_scan_dup_list);
+    e = ble_ll_scan_dup_table_head(&g_scan_dup);
     BLE_LL_ASSERT(e && e->type == type && (is_anon || !memcmp(e->addr, addr, 6)));
 
     e->flags |= BLE_LL_SCAN_DUP_F_ADV_REPORT_SENT;
@@ -2802,8 +2750,7 @@ ble_ll_scan_reset(void)
     g_ble_ll_scan_num_rsp_advs = 0;
     memset(&g_ble_ll_scan_rsp_advs[0], 0, sizeof(g_ble_ll_scan_rsp_advs));
 
-    os_mempool_clear(&g_scan_dup_pool);
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_table_clear(&g_scan_dup);
 
     /* Call the common init function again */
     ble_ll_scan_common_init();
@@ -2821,16 +2768,11 @@ ble_ll_scan_reset(void)
 void
 ble_ll_scan_init(void)
 {
-    os_error_t err;
-
-    err = os_mempool_init(&g_scan_dup_pool,
-                          MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS),
-                          sizeof(struct ble_ll_scan_dup_entry),
-                          g_scan_dup_mem,
-                          "ble_ll_scan_dup_pool");
-    BLE_LL_ASSERT(err == 0);
-
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_table_init(&g_scan_dup, g_scan_dup_mem,
+                               MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS),
+                               BLE_LL_SCAN_DUP_BUCKETS,
+                               BLE_LL_SCAN_DUP_NUM_BUCKETS,
+                               "ble_ll_scan_dup_pool");
 
     ble_ll_scan_common_init();
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
@@ -0,0 +1,171 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "syscfg/syscfg.h"
+#include "os/os.h"
+#include "os/endian.h"
+#include "nimble/ble.h"
+#include "controller/ble_ll.h"
+#include "ble_ll_scan_dup_priv.h"
+
+#if MYNEWT_VAL(BLE_LL_ROLE_OBSERVER)
+
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+static struct ble_ll_scan_dup_bucket *
+ble_ll_scan_dup_bucket(struct ble_ll_scan_dup_table *tbl, uint8_t type,
+                       const uint8_t *addr)
+{
+    uint32_t h;
+
+    /* Fold the key into 32 bits and mix it, so that addresses differing in
+     * only a few bits, as consecutive public addresses do, still spread over
+     * all buckets.
+     */
+    h = get_le32(addr) ^ ((uint32_t)get_le16(addr + 4) << 16) ^ type;
+    h = (h ^ (h >> 16)) * 0x45d9f3b;
+    h ^= h >> 16;
+
+    return &tbl->buckets[h % tbl->num_buckets];
+}
+
+static struct ble_ll_scan_dup_entry *
+ble_ll_scan_dup_find(struct ble_ll_scan_dup_bucket *bucket, uint8_t type,
+                     const uint8_t *addr)
+{
+    struct ble_ll_scan_dup_entry *e;
+
+    LIST_FOREACH(e, bucket, hash_link) {
+        if ((e->type == type) && !memcmp(e->addr, addr, BLE_DEV_ADDR_LEN)) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+#else
+static struct ble_ll_scan_dup_entry *
+ble_ll_scan_dup_find(struct ble_ll_scan_dup_table *tbl, uint8_t type,
+                     const uint8_t *addr)
+{
+    struct ble_ll_scan_dup_entry *e;
+
+    TAILQ_FOREACH(e, &tbl->lru, lru_link) {
+        if ((e->type == type) && !memcmp(e->addr, addr, BLE_DEV_ADDR_LEN)) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+void
+ble_ll_scan_dup_table_init(struct ble_ll_scan_dup_table *tbl,
+                           os_membuf_t *mem, uint16_t num_entries,
+                           struct ble_ll_scan_dup_bucket *buckets,
+                           uint16_t num_buckets, char *name)
+{
+    os_error_t err;
+
+    err = os_mempool_init(&tbl->pool, num_entries,
+                          sizeof(struct ble_ll_scan_dup_entry), mem, name);
+    BLE_LL_ASSERT(err == 0);
+
+    TAILQ_INIT(&tbl->lru);
+
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    BLE_LL_ASSERT(num_buckets > 0);
+
+    tbl->buckets = buckets;
+    tbl->num_buckets = num_buckets;
+    memset(buckets, 0, num_buckets * sizeof(buckets[0]));
+#endif
+}
+
+void
+ble_ll_scan_dup_table_clear(struct ble_ll_scan_dup_table *tbl)
+{
+    os_mempool_clear(&tbl->pool);
+
+    TAILQ_INIT(&tbl->lru);
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    memset(tbl->buckets, 0, tbl->num_buckets * sizeof(tbl->buckets[0]));
+#endif
+}
+
+struct ble_ll_scan_dup_entry *
+ble_ll_scan_dup_table_get(struct ble_ll_scan_dup_table *tbl, uint8_t type,
+                          const uint8_t *addr, int *created)
+{
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    struct ble_ll_scan_dup_bucket *bucket;
+#endif
+    struct ble_ll_scan_dup_entry *e;
+
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    bucket = ble_ll_scan_dup_bucket(tbl, type, addr);
+    e = ble_ll_scan_dup_find(bucket, type, addr);
+#else
+    e = ble_ll_scan_dup_find(tbl, type, addr);
+#endif
+    if (e) {
+        if (e != TAILQ_FIRST(&tbl->lru)) {
+            TAILQ_REMOVE(&tbl->lru, e, lru_link);
+            TAILQ_INSERT_HEAD(&tbl->lru, e, lru_link);
+        }
+
+        *created = 0;
+        return e;
+    }
+
+    /* Once the table is full every miss reuses the least recently used
+     * entry, without asking the pool first.
+     */
+    if (tbl->pool.mp_num_free) {
+        e = os_memblock_get(&tbl->pool);
+        BLE_LL_ASSERT(e);
+    } else {
+        e = TAILQ_LAST(&tbl->lru, ble_ll_scan_dup_lru);
+        BLE_LL_ASSERT(e);
+
+        TAILQ_REMOVE(&tbl->lru, e, lru_link);
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+        LIST_REMOVE(e, hash_link);
+#endif
+    }
+
+    e->type = type;
+    memcpy(e->addr, addr, BLE_DEV_ADDR_LEN);
+    e->flags = 0;
+#if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
+    e->adi = 0;
+#endif
+
+    TAILQ_INSERT_HEAD(&tbl->lru, e, lru_link);
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    LIST_INSERT_HEAD(bucket, e, hash_link);
+#endif
+
+    *created = 1;
+    return e;
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_BLE_LL_SCAN_DUP_PRIV_
+#define H_BLE_LL_SCAN_DUP_PRIV_
+
+#include <stdint.h>
+#include "syscfg/syscfg.h"
+#include "os/os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Duplicate filter table for the scanner.
+ *
+ * Entries are keyed by type and address and kept on an LRU list: the entry
+ * used last is at the head, and the one at the tail is evicted to make room
+ * for a new advertiser once the table is full.  By default an advertiser is
+ * looked up by walking the LRU list.  With BLE_LL_SCAN_DUP_HASH enabled the
+ * entries are also found through a hash table, so the cost of a lookup does
+ * not grow with the number of advertisers remembered.
+ */
+
+struct ble_ll_scan_dup_entry {
+    uint8_t type;       /* entry type, see BLE_LL_SCAN_ENTRY_TYPE_* */
+    uint8_t addr[6];
+    uint8_t flags;      /* use BLE_LL_SCAN_DUP_F_xxx */
+#if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
+    uint16_t adi;
+#endif
+    TAILQ_ENTRY(ble_ll_scan_dup_entry) lru_link;
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    LIST_ENTRY(ble_ll_scan_dup_entry) hash_link;
+#endif
+};
+
+TAILQ_HEAD(ble_ll_scan_dup_lru, ble_ll_scan_dup_entry);
+LIST_HEAD(ble_ll_scan_dup_bucket, ble_ll_scan_dup_entry);
+
+struct ble_ll_scan_dup_table {
+    struct os_mempool pool;
+    struct ble_ll_scan_dup_lru lru;
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+    struct ble_ll_scan_dup_bucket *buckets;
+    uint16_t num_buckets;
+#endif
+};
+
+/* Size of the memory block to pass to ble_ll_scan_dup_table_init() */
+#define BLE_LL_SCAN_DUP_TABLE_MEM_SIZE(num_entries) \
+    OS_MEMPOOL_SIZE(num_entries, sizeof(struct ble_ll_scan_dup_entry))
+
+/**
+ * Initializes an empty duplicate filter table.
+ *
+ * @param tbl           The table to initialize.
+ * @param mem           Storage for the entries, of
+ *                          BLE_LL_SCAN_DUP_TABLE_MEM_SIZE(num_entries)
+ *                          os_membuf_t elements.
+ * @param num_entries   The maximum number of entries.
+ * @param buckets       The hash buckets.  One bucket per entry keeps chains
+ *                          short.  Unused, and may be NULL, without
+ *                          BLE_LL_SCAN_DUP_HASH.
+ * @param num_buckets   The number of elements in buckets.
+ * @param name          The name of the entry pool.
+ */
+void ble_ll_scan_dup_table_init(struct ble_ll_scan_dup_table *tbl,
+                                os_membuf_t *mem, uint16_t num_entries,
+                                struct ble_ll_scan_dup_bucket *buckets,
+                                uint16_t num_buckets, char *name);
+
+/**
+ * Removes all entries from a table.
+ */
+void ble_ll_scan_dup_table_clear(struct ble_ll_scan_dup_table *tbl);
+
+/**
+ * Finds the entry for an advertiser and moves it to the head of the LRU list.
+ * If there is none, a zeroed entry is created for it, evicting the least
+ * recently used one if the table is full.
+ *
+ * @param tbl           The table to search.
+ * @param type          The entry type.
+ * @param addr          The advertiser's address.
+ * @param created       On return, 1 if the entry is new; 0 if it existed.
+ *
+ * @return              The entry; never NULL.
+ */
+struct ble_ll_scan_dup_entry *
+ble_ll_scan_dup_table_get(struct ble_ll_scan_dup_table *tbl, uint8_t type,
+                          const uint8_t *addr, int *created);
+
+/**
+ * Retrieves the entry returned by the last call to
+ * ble_ll_scan_dup_table_get(), or NULL if the table is empty.
+ */
+static inline struct ble_ll_scan_dup_entry *
+ble_ll_scan_dup_table_head(struct ble_ll_scan_dup_table *tbl)
+{
+    return TAILQ_FIRST(&tbl->lru);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BLE_LL_SCAN_DUP_PRIV_ */
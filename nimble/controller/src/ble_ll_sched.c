@@ -38,6 +38,7 @@
 #endif
 #include "ble_ll_priv.h"
 #include "ble_ll_conn_priv.h"
+#include "ble_ll_sched_q_priv.h"
 
 #define BLE_LL_SCHED_MAX_DELAY_ANY      (0x7fffffff)
 
@@ -84,7 +85,8 @@ static struct ble_ll_sched_css g_ble_ll_sched_css = {
  */
 
 /* Queue for timers */
-static TAILQ_HEAD(ll_sched_qhead, ble_ll_sched_item) g_ble_ll_sched_q;
+static struct ble_ll_sched_q g_ble_ll_sched_q =
+    BLE_LL_SCHED_Q_INITIALIZER(g_ble_ll_sched_q);
 static uint8_t g_ble_ll_sched_q_head_changed;
 
 static int
@@ -124,17 +126,6 @@ preempt_any_except_big(struct ble_ll_sched_item *sch, struct ble_ll_sched_item *
     return 1;
 }
 
-static inline int
-ble_ll_sched_check_overlap(struct ble_ll_sched_item *sch1,
-                           struct ble_ll_sched_item *sch2)
-{
-    /* Note: item ranges are defined as [start, end) so items do not overlap
-     *       if one item starts at the same time as another ends.
-     */
-    return LL_TMR_GT(sch1->end_time, sch2->start_time) &&
-           LL_TMR_GT(sch2->end_time, sch1->start_time);
-}
-
 static void
 ble_ll_sched_preempt(struct ble_ll_sched_item *sch,
                      struct ble_ll_sched_item *first)
@@ -148,10 +139,13 @@ ble_ll_sched_preempt(struct ble_ll_sched_item *sch,
     entry = first;
 
     do {
-        next = TAILQ_NEXT(entry, link);
+        next = ble_ll_sched_q_next(entry);
+
+        ble_ll_sched_q_remove(&g_ble_ll_sched_q, entry);
 
-        TAILQ_REMOVE(&g_ble_ll_sched_q, entry, link);
-        entry->enqueued = 0;
+        ble_ll_trace_sched(BLE_HCI_VS_SCHED_TRACE_PREEMPT, entry->sched_type,
+                           sch->sched_type, entry->start_time,
+                           entry->end_time);
 
         switch (entry->sched_type) {
 #if MYNEWT_VAL(BLE_LL_ROLE_CENTRAL) || MYNEWT_VAL(BLE_LL_ROLE_PERIPHERAL)
@@ -225,7 +219,7 @@ ble_ll_sched_restart(void)
 
     g_ble_ll_sched_q_head_changed = 0;
 
-    first = TAILQ_FIRST(&g_ble_ll_sched_q);
+    first = ble_ll_sched_q_first(&g_ble_ll_sched_q);
 
     ble_ll_rfmgmt_sched_changed(first);
 
@@ -239,75 +233,18 @@ ble_ll_sched_insert(struct ble_ll_sched_item *sch, uint32_t max_delay,
                     ble_ll_sched_preempt_cb_t preempt_cb)
 {
     struct ble_ll_sched_item *preempt_first;
-    struct ble_ll_sched_item *first;
-    struct ble_ll_sched_item *entry;
-    uint32_t max_start_time;
-    uint32_t duration;
+    int rc;
 
     OS_ASSERT_CRITICAL();
 
-    preempt_first = NULL;
-
-    max_start_time = sch->start_time + max_delay;
-    duration = sch->end_time - sch->start_time;
-
-    first = TAILQ_FIRST(&g_ble_ll_sched_q);
-    if (!first) {
-        TAILQ_INSERT_HEAD(&g_ble_ll_sched_q, sch, link);
-        sch->enqueued = 1;
-        goto done;
+    /* Queue can look for a free slot faster if nothing can be preempted */
+    if (preempt_cb == preempt_none) {
+        preempt_cb = NULL;
     }
 
-    TAILQ_FOREACH(entry, &g_ble_ll_sched_q, link) {
-        if (LL_TMR_LEQ(sch->end_time, entry->start_time)) {
-            TAILQ_INSERT_BEFORE(entry, sch, link);
-            sch->enqueued = 1;
-            goto done;
-        }
+    rc = ble_ll_sched_q_insert(&g_ble_ll_sched_q, sch, max_delay, preempt_cb,
+                               &preempt_first);
 
-        /* If current item overlaps our item check if we can preempt. If we
-         * cannot preempt, move our item past current item and see if it's
-         * still within allowed range.
-         */
-
-        if (ble_ll_sched_check_overlap(sch, entry)) {
-            if (preempt_cb(sch, entry)) {
-                if (!preempt_first) {
-                    preempt_first = entry;
-                }
-            } else {
-                preempt_first = NULL;
-                /*
-                 * For the 32768 Hz crystal in nrf chip, 1 tick is 30.517us.
-                 * The connection state machine use anchor point to store the
-                 * cpu ticks and anchor_point_usec to store the remainder.
-                 * Therefore, to compensate the inaccuracy of the crystal, the
-                 * ticks of anchor_point will be add with 1 once the value of
-                 * anchor_point_usec exceed 31. If two connections have same
-                 * connection interval, the time difference between the two
-                 * start of schedule item will decreased 1, which lead to
-                 * an overlap. To prevent this from happenning, we set the
-                 * start_time of sch to 1 cpu tick after the end_time of entry.
-                 */
-                sch->start_time = entry->end_time + 1;
-
-                if ((max_delay == 0) || LL_TMR_GEQ(sch->start_time,
-                                                    max_start_time)) {
-                    sch->enqueued = 0;
-                    goto done;
-                }
-
-                sch->end_time = sch->start_time + duration;
-            }
-        }
-    }
-
-    if (!entry) {
-        TAILQ_INSERT_TAIL(&g_ble_ll_sched_q, sch, link);
-        sch->enqueued = 1;
-    }
-
-done:
     if (preempt_first) {
         BLE_LL_ASSERT(sch->enqueued);
         ble_ll_sched_preempt(sch, preempt_first);
@@ -316,12 +253,12 @@ done:
     /* Pause scheduler if inserted as 1st item, we do not want to miss this
      * one. Caller should restart outside critical section.
      */
-    if (TAILQ_FIRST(&g_ble_ll_sched_q) == sch) {
+    if (ble_ll_sched_q_first(&g_ble_ll_sched_q) == sch) {
         BLE_LL_ASSERT(sch->enqueued);
         ble_ll_sched_q_head_changed();
     }
 
-    return sch->enqueued ? 0 : -1;
+    return rc;
 }
 
 /*
@@ -789,7 +726,7 @@ ble_ll_sched_adv_reschedule(struct ble_ll_sched_item *sch,
 
     rc = ble_ll_sched_insert(sch, max_delay_ticks, preempt_none);
     if (rc == 0) {
-        next = TAILQ_NEXT(sch, link);
+        next = ble_ll_sched_q_next(sch);
         if (next) {
             if (LL_TMR_LT(next->start_time, max_end_time)) {
                 max_end_time = next->start_time;
@@ -803,8 +740,7 @@ ble_ll_sched_adv_reschedule(struct ble_ll_sched_item *sch,
             rand_ticks = ble_ll_rand() % rand_ticks;
         }
 
-        sch->start_time += rand_ticks;
-        sch->end_time += rand_ticks;
+        ble_ll_sched_q_delay(&g_ble_ll_sched_q, sch, rand_ticks);
     }
 
     OS_EXIT_CRITICAL(sr);
@@ -898,12 +834,11 @@ ble_ll_sched_rmv_elem(struct ble_ll_sched_item *sch)
     first_removed = 0;
 
     if (sch->enqueued) {
-        if (sch == TAILQ_FIRST(&g_ble_ll_sched_q)) {
+        if (sch == ble_ll_sched_q_first(&g_ble_ll_sched_q)) {
             first_removed = 1;
         }
 
-        TAILQ_REMOVE(&g_ble_ll_sched_q, sch, link);
-        sch->enqueued = 0;
+        ble_ll_sched_q_remove(&g_ble_ll_sched_q, sch);
 
         rc = 0;
     } else {
@@ -926,12 +861,13 @@ ble_ll_sched_rmv_elem_type(uint8_t type, sched_remove_cb_func remove_cb)
 {
     struct ble_ll_sched_item *first;
     struct ble_ll_sched_item *entry;
+    struct ble_ll_sched_item *next;
     uint8_t first_removed;
     os_sr_t sr;
 
     OS_ENTER_CRITICAL(sr);
 
-    first = TAILQ_FIRST(&g_ble_ll_sched_q);
+    first = ble_ll_sched_q_first(&g_ble_ll_sched_q);
     if (!first) {
         OS_EXIT_CRITICAL(sr);
         return;
@@ -939,13 +875,13 @@ ble_ll_sched_rmv_elem_type(uint8_t type, sched_remove_cb_func remove_cb)
 
     first_removed = first->sched_type == type;
 
-    TAILQ_FOREACH(entry, &g_ble_ll_sched_q, link) {
+    for (entry = first; entry; entry = next) {
+        next = ble_ll_sched_q_next(entry);
         if (entry->sched_type != type) {
             continue;
         }
-        TAILQ_REMOVE(&g_ble_ll_sched_q, entry, link);
+        ble_ll_sched_q_remove(&g_ble_ll_sched_q, entry);
         remove_cb(entry);
-        entry->enqueued = 0;
     }
 
     if (first_removed) {
@@ -976,6 +912,8 @@ ble_ll_sched_execute_item(struct ble_ll_sched_item *sch)
 
     ble_ll_trace_u32x3(BLE_LL_TRACE_ID_SCHED, lls, ble_ll_tmr_get(),
                        sch->start_time);
+    ble_ll_trace_sched(BLE_HCI_VS_SCHED_TRACE_EXEC, sch->sched_type, lls,
+                       sch->start_time, sch->end_time);
 
     if (lls == BLE_LL_STATE_STANDBY) {
         goto sched;
@@ -1062,7 +1000,7 @@ ble_ll_sched_run(void *arg)
     BLE_LL_DEBUG_GPIO(SCHED_RUN, 1);
 
     /* Look through schedule queue */
-    sch = TAILQ_FIRST(&g_ble_ll_sched_q);
+    sch = ble_ll_sched_q_first(&g_ble_ll_sched_q);
     if (sch) {
 #if (BLE_LL_SCHED_DEBUG == 1)
         int32_t dt;
@@ -1078,8 +1016,7 @@ ble_ll_sched_run(void *arg)
 #endif
 
         /* Remove schedule item and execute the callback */
-        TAILQ_REMOVE(&g_ble_ll_sched_q, sch, link);
-        sch->enqueued = 0;
+        ble_ll_sched_q_remove(&g_ble_ll_sched_q, sch);
         g_ble_ll_sched_q_head_changed = 1;
 
         ble_ll_sched_execute_item(sch);
@@ -1109,7 +1046,7 @@ ble_ll_sched_next_time(uint32_t *next_event_time)
 
     rc = 0;
     OS_ENTER_CRITICAL(sr);
-    first = TAILQ_FIRST(&g_ble_ll_sched_q);
+    first = ble_ll_sched_q_first(&g_ble_ll_sched_q);
     if (first) {
         *next_event_time = first->start_time;
         rc = 1;
@@ -0,0 +1,583 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "syscfg/syscfg.h"
+#include "os/os.h"
+#include "nimble/ble.h"
+#include "controller/ble_ll_sched.h"
+#include "controller/ble_ll_tmr.h"
+#include "ble_ll_sched_q_priv.h"
+
+static inline int
+ble_ll_sched_q_check_overlap(struct ble_ll_sched_item *sch1,
+                             struct ble_ll_sched_item *sch2)
+{
+    /* Note: item ranges are defined as [start, end) so items do not overlap
+     *       if one item starts at the same time as another ends.
+     */
+    return LL_TMR_GT(sch1->end_time, sch2->start_time) &&
+           LL_TMR_GT(sch2->end_time, sch1->start_time);
+}
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+/*
+ * Number of ticks between the end of the previous item and the start of this
+ * one that another item can use; see ble_ll_sched_q_insert() for why the
+ * first tick after an item is not used.
+ */
+static uint32_t
+ble_ll_sched_q_gap(struct ble_ll_sched_item *sch)
+{
+    struct ble_ll_sched_item *prev;
+    int32_t gap;
+
+    prev = TAILQ_PREV(sch, ble_ll_sched_qhead, link);
+    if (!prev) {
+        return 0;
+    }
+
+    gap = (int32_t)(sch->start_time - prev->end_time - 1);
+
+    return gap > 0 ? gap : 0;
+}
+
+static void
+ble_ll_sched_q_update_max_gap(struct ble_ll_sched_item *sch)
+{
+    uint32_t max_gap;
+
+    max_gap = ble_ll_sched_q_gap(sch);
+
+    if (sch->rb_left && (sch->rb_left->rb_max_gap > max_gap)) {
+        max_gap = sch->rb_left->rb_max_gap;
+    }
+    if (sch->rb_right && (sch->rb_right->rb_max_gap > max_gap)) {
+        max_gap = sch->rb_right->rb_max_gap;
+    }
+
+    sch->rb_max_gap = max_gap;
+}
+
+static void
+ble_ll_sched_q_update_path(struct ble_ll_sched_item *sch)
+{
+    while (sch) {
+        ble_ll_sched_q_update_max_gap(sch);
+        sch = sch->rb_parent;
+    }
+}
+
+static void
+ble_ll_sched_q_replace(struct ble_ll_sched_q *q, struct ble_ll_sched_item *old,
+                       struct ble_ll_sched_item *new)
+{
+    struct ble_ll_sched_item *parent;
+
+    parent = old->rb_parent;
+
+    if (!parent) {
+        q->root = new;
+    } else if (parent->rb_left == old) {
+        parent->rb_left = new;
+    } else {
+        parent->rb_right = new;
+    }
+
+    if (new) {
+        new->rb_parent = parent;
+    }
+}
+
+static void
+ble_ll_sched_q_rotate_left(struct ble_ll_sched_q *q,
+                           struct ble_ll_sched_item *x)
+{
+    struct ble_ll_sched_item *y;
+
+    y = x->rb_right;
+
+    x->rb_right = y->rb_left;
+    if (y->rb_left) {
+        y->rb_left->rb_parent = x;
+    }
+
+    ble_ll_sched_q_replace(q, x, y);
+
+    y->rb_left = x;
+    x->rb_parent = y;
+
+    ble_ll_sched_q_update_max_gap(x);
+    ble_ll_sched_q_update_max_gap(y);
+}
+
+static void
+ble_ll_sched_q_rotate_right(struct ble_ll_sched_q *q,
+                            struct ble_ll_sched_item *x)
+{
+    struct ble_ll_sched_item *y;
+
+    y = x->rb_left;
+
+    x->rb_left = y->rb_right;
+    if (y->rb_right) {
+        y->rb_right->rb_parent = x;
+    }
+
+    ble_ll_sched_q_replace(q, x, y);
+
+    y->rb_right = x;
+    x->rb_parent = y;
+
+    ble_ll_sched_q_update_max_gap(x);
+    ble_ll_sched_q_update_max_gap(y);
+}
+
+static inline int
+ble_ll_sched_q_is_red(struct ble_ll_sched_item *sch)
+{
+    return sch && sch->rb_red;
+}
+
+static void
+ble_ll_sched_q_tree_insert(struct ble_ll_sched_q *q,
+                           struct ble_ll_sched_item *sch,
+                           struct ble_ll_sched_item *next)
+{
+    struct ble_ll_sched_item *parent;
+    struct ble_ll_sched_item *gparent;
+    struct ble_ll_sched_item *uncle;
+
+    sch->rb_left = NULL;
+    sch->rb_right = NULL;
+    sch->rb_red = 1;
+
+    /* Item is already on the list, so its place in tree is right after its
+     * predecessor or right before its successor, whichever has a free slot.
+     */
+    if (!q->root) {
+        sch->rb_parent = NULL;
+        q->root = sch;
+    } else if (next && !next->rb_left) {
+        sch->rb_parent = next;
+        next->rb_left = sch;
+    } else {
+        parent = TAILQ_PREV(sch, ble_ll_sched_qhead, link);
+        BLE_LL_ASSERT(parent && !parent->rb_right);
+        sch->rb_parent = parent;
+        parent->rb_right = sch;
+    }
+
+    ble_ll_sched_q_update_path(sch);
+    if (next) {
+        ble_ll_sched_q_update_path(next);
+    }
+
+    while (ble_ll_sched_q_is_red(sch->rb_parent)) {
+        parent = sch->rb_parent;
+        gparent = parent->rb_parent;
+
+        if (parent == gparent->rb_left) {
+            uncle = gparent->rb_right;
+            if (ble_ll_sched_q_is_red(uncle)) {
+                parent->rb_red = 0;
+                uncle->rb_red = 0;
+                gparent->rb_red = 1;
+                sch = gparent;
+                continue;
+            }
+
+            if (sch == parent->rb_right) {
+                ble_ll_sched_q_rotate_left(q, parent);
+                sch = parent;
+                parent = sch->rb_parent;
+            }
+
+            parent->rb_red = 0;
+            gparent->rb_red = 1;
+            ble_ll_sched_q_rotate_right(q, gparent);
+        } else {
+            uncle = gparent->rb_left;
+            if (ble_ll_sched_q_is_red(uncle)) {
+                parent->rb_red = 0;
+                uncle->rb_red = 0;
+                gparent->rb_red = 1;
+                sch = gparent;
+                continue;
+            }
+
+            if (sch == parent->rb_left) {
+                ble_ll_sched_q_rotate_right(q, parent);
+                sch = parent;
+                parent = sch->rb_parent;
+            }
+
+            parent->rb_red = 0;
+            gparent->rb_red = 1;
+            ble_ll_sched_q_rotate_left(q, gparent);
+        }
+    }
+
+    q->root->rb_red = 0;
+}
+
+static void
+ble_ll_sched_q_tree_remove(struct ble_ll_sched_q *q,
+                           struct ble_ll_sched_item *sch,
+                           struct ble_ll_sched_item *next)
+{
+    struct ble_ll_sched_item *child;
+    struct ble_ll_sched_item *parent;
+    struct ble_ll_sched_item *sibling;
+    struct ble_ll_sched_item *y;
+    uint8_t removed_red;
+
+    if (!sch->rb_left || !sch->rb_right) {
+        child = sch->rb_left ? sch->rb_left : sch->rb_right;
+        parent = sch->rb_parent;
+        removed_red = sch->rb_red;
+        ble_ll_sched_q_replace(q, sch, child);
+    } else {
+        /* Successor in tree is the next item on the list */
+        y = next;
+        BLE_LL_ASSERT(y && !y->rb_left);
+
+        child = y->rb_right;
+        removed_red = y->rb_red;
+
+        if (y->rb_parent == sch) {
+            parent = y;
+        } else {
+            parent = y->rb_parent;
+            ble_ll_sched_q_replace(q, y, child);
+            y->rb_right = sch->rb_right;
+            y->rb_right->rb_parent = y;
+        }
+
+        ble_ll_sched_q_replace(q, sch, y);
+        y->rb_left = sch->rb_left;
+        y->rb_left->rb_parent = y;
+        y->rb_red = sch->rb_red;
+    }
+
+    ble_ll_sched_q_update_path(parent);
+
+    if (!removed_red) {
+        while ((child != q->root) && !ble_ll_sched_q_is_red(child)) {
+            if (child == parent->rb_left) {
+                sibling = parent->rb_right;
+                if (sibling->rb_red) {
+                    sibling->rb_red = 0;
+                    parent->rb_red = 1;
+                    ble_ll_sched_q_rotate_left(q, parent);
+                    sibling = parent->rb_right;
+                }
+
+                if (!ble_ll_sched_q_is_red(sibling->rb_left) &&
+                    !ble_ll_sched_q_is_red(sibling->rb_right)) {
+                    sibling->rb_red = 1;
+                    child = parent;
+                    parent = child->rb_parent;
+                    continue;
+                }
+
+                if (!ble_ll_sched_q_is_red(sibling->rb_right)) {
+                    sibling->rb_left->rb_red = 0;
+                    sibling->rb_red = 1;
+                    ble_ll_sched_q_rotate_right(q, sibling);
+                    sibling = parent->rb_right;
+                }
+
+                sibling->rb_red = parent->rb_red;
+                parent->rb_red = 0;
+                sibling->rb_right->rb_red = 0;
+                ble_ll_sched_q_rotate_left(q, parent);
+            } else {
+                sibling = parent->rb_left;
+                if (sibling->rb_red) {
+                    sibling->rb_red = 0;
+                    parent->rb_red = 1;
+                    ble_ll_sched_q_rotate_right(q, parent);
+                    sibling = parent->rb_left;
+                }
+
+                if (!ble_ll_sched_q_is_red(sibling->rb_left) &&
+                    !ble_ll_sched_q_is_red(sibling->rb_right)) {
+                    sibling->rb_red = 1;
+                    child = parent;
+                    parent = child->rb_parent;
+                    continue;
+                }
+
+                if (!ble_ll_sched_q_is_red(sibling->rb_left)) {
+                    sibling->rb_right->rb_red = 0;
+                    sibling->rb_red = 1;
+                    ble_ll_sched_q_rotate_left(q, sibling);
+                    sibling = parent->rb_left;
+                }
+
+                sibling->rb_red = parent->rb_red;
+                parent->rb_red = 0;
+                sibling->rb_left->rb_red = 0;
+                ble_ll_sched_q_rotate_right(q, parent);
+            }
+
+            child = q->root;
+        }
+
+        if (child) {
+            child->rb_red = 0;
+        }
+    }
+
+    /* Gap before next item now starts at end of our predecessor */
+    if (next) {
+        ble_ll_sched_q_update_path(next);
+    }
+}
+
+/* Finds the first item that ends after given time */
+static struct ble_ll_sched_item *
+ble_ll_sched_q_find(struct ble_ll_sched_q *q, uint32_t time)
+{
+    struct ble_ll_sched_item *found;
+    struct ble_ll_sched_item *sch;
+
+    found = NULL;
+    sch = q->root;
+
+    while (sch) {
+        if (LL_TMR_GT(sch->end_time, time)) {
+            found = sch;
+            sch = sch->rb_left;
+        } else {
+            sch = sch->rb_right;
+        }
+    }
+
+    return found;
+}
+
+/* Finds the first item in subtree with at least given gap before it */
+static struct ble_ll_sched_item *
+ble_ll_sched_q_find_gap_in(struct ble_ll_sched_item *sch, uint32_t gap)
+{
+    while (sch) {
+        if (sch->rb_left && (sch->rb_left->rb_max_gap >= gap)) {
+            sch = sch->rb_left;
+        } else if (ble_ll_sched_q_gap(sch) >= gap) {
+            return sch;
+        } else {
+            sch = sch->rb_right;
+        }
+    }
+
+    return NULL;
+}
+
+/* Finds the first item after given one with at least given gap before it */
+static struct ble_ll_sched_item *
+ble_ll_sched_q_find_gap(struct ble_ll_sched_item *sch, uint32_t gap)
+{
+    struct ble_ll_sched_item *parent;
+
+    if (sch->rb_right && (sch->rb_right->rb_max_gap >= gap)) {
+        return ble_ll_sched_q_find_gap_in(sch->rb_right, gap);
+    }
+
+    /* Go up until we come from left subtree, then parent and its right
+     * subtree are after the item.
+     */
+    for (parent = sch->rb_parent; parent;
+         sch = parent, parent = sch->rb_parent) {
+        if (sch != parent->rb_left) {
+            continue;
+        }
+
+        if (ble_ll_sched_q_gap(parent) >= gap) {
+            return parent;
+        }
+
+        if (parent->rb_right && (parent->rb_right->rb_max_gap >= gap)) {
+            return ble_ll_sched_q_find_gap_in(parent->rb_right, gap);
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/* Inserts item before next, or at tail if next is NULL */
+static void
+ble_ll_sched_q_link(struct ble_ll_sched_q *q, struct ble_ll_sched_item *sch,
+                    struct ble_ll_sched_item *next)
+{
+    if (next) {
+        TAILQ_INSERT_BEFORE(next, sch, link);
+    } else {
+        TAILQ_INSERT_TAIL(&q->list, sch, link);
+    }
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    ble_ll_sched_q_tree_insert(q, sch, next);
+#endif
+
+    sch->enqueued = 1;
+}
+
+void
+ble_ll_sched_q_init(struct ble_ll_sched_q *q)
+{
+    TAILQ_INIT(&q->list);
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    q->root = NULL;
+#endif
+}
+
+int
+ble_ll_sched_q_insert(struct ble_ll_sched_q *q,
+                      struct ble_ll_sched_item *sch, uint32_t max_delay,
+                      ble_ll_sched_preempt_cb_t preempt_cb,
+                      struct ble_ll_sched_item **preempt_first)
+{
+    struct ble_ll_sched_item *entry;
+    uint32_t max_start_time;
+    uint32_t duration;
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    struct ble_ll_sched_item *prev;
+#endif
+
+    *preempt_first = NULL;
+
+    max_start_time = sch->start_time + max_delay;
+    duration = sch->end_time - sch->start_time;
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    /* Items which end before our item starts do not matter */
+    entry = ble_ll_sched_q_find(q, sch->start_time);
+
+    /* If our item overlaps an item it cannot preempt, it goes to the first
+     * gap large enough after that item.
+     */
+    if (!preempt_cb && entry && LL_TMR_GT(sch->end_time, entry->start_time)) {
+        prev = entry;
+        if (max_delay) {
+            entry = ble_ll_sched_q_find_gap(entry, duration);
+            prev = entry ? TAILQ_PREV(entry, ble_ll_sched_qhead, link) :
+                           TAILQ_LAST(&q->list, ble_ll_sched_qhead);
+        }
+
+        sch->start_time = prev->end_time + 1;
+
+        if ((max_delay == 0) || LL_TMR_GEQ(sch->start_time, max_start_time)) {
+            sch->enqueued = 0;
+            return -1;
+        }
+
+        sch->end_time = sch->start_time + duration;
+
+        ble_ll_sched_q_link(q, sch, entry);
+        return 0;
+    }
+#else
+    entry = TAILQ_FIRST(&q->list);
+#endif
+
+    for (; entry; entry = TAILQ_NEXT(entry, link)) {
+        if (LL_TMR_LEQ(sch->end_time, entry->start_time)) {
+            break;
+        }
+
+        /* If current item overlaps our item check if we can preempt. If we
+         * cannot preempt, move our item past current item and see if it's
+         * still within allowed range.
+         */
+
+        if (ble_ll_sched_q_check_overlap(sch, entry)) {
+            if (preempt_cb && preempt_cb(sch, entry)) {
+                if (!*preempt_first) {
+                    *preempt_first = entry;
+                }
+            } else {
+                *preempt_first = NULL;
+                /*
+                 * For the 32768 Hz crystal in nrf chip, 1 tick is 30.517us.
+                 * The connection state machine use anchor point to store the
+                 * cpu ticks and anchor_point_usec to store the remainder.
+                 * Therefore, to compensate the inaccuracy of the crystal, the
+                 * ticks of anchor_point will be add with 1 once the value of
+                 * anchor_point_usec exceed 31. If two connections have same
+                 * connection interval, the time difference between the two
+                 * start of schedule item will decreased 1, which lead to
+                 * an overlap. To prevent this from happenning, we set the
+                 * start_time of sch to 1 cpu tick after the end_time of entry.
+                 */
+                sch->start_time = entry->end_time + 1;
+
+                if ((max_delay == 0) || LL_TMR_GEQ(sch->start_time,
+                                                    max_start_time)) {
+                    sch->enqueued = 0;
+                    return -1;
+                }
+
+                sch->end_time = sch->start_time + duration;
+            }
+        }
+    }
+
+    ble_ll_sched_q_link(q, sch, entry);
+
+    return 0;
+}
+
+void
+ble_ll_sched_q_remove(struct ble_ll_sched_q *q, struct ble_ll_sched_item *sch)
+{
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    struct ble_ll_sched_item *next;
+
+    next = TAILQ_NEXT(sch, link);
+#endif
+
+    TAILQ_REMOVE(&q->list, sch, link);
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    ble_ll_sched_q_tree_remove(q, sch, next);
+#endif
+
+    sch->enqueued = 0;
+}
+
+void
+ble_ll_sched_q_delay(struct ble_ll_sched_q *q, struct ble_ll_sched_item *sch,
+                     uint32_t ticks)
+{
+    sch->start_time += ticks;
+    sch->end_time += ticks;
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    ble_ll_sched_q_update_path(sch);
+    if (TAILQ_NEXT(sch, link)) {
+        ble_ll_sched_q_update_path(TAILQ_NEXT(sch, link));
+    }
+#else
+    (void)q;
+#endif
+}
@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_BLE_LL_SCHED_Q_PRIV_
+#define H_BLE_LL_SCHED_Q_PRIV_
+
+#include <stdint.h>
+#include "syscfg/syscfg.h"
+#include "os/os.h"
+#include "nimble/ble.h"
+#include "controller/ble_ll_sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Scheduler queue.
+ *
+ * Items on the queue do not overlap and are kept on a list sorted by time.
+ * With BLE_LL_SCHED_TREE enabled the same items are also kept in a red-black
+ * tree in list order, where each node stores the largest free gap between
+ * two consecutive items in its subtree.  This lets an insertion skip the
+ * items that end before the new one starts, and find the first gap that is
+ * large enough for an item which cannot preempt anything, in O(log n) time
+ * rather than by walking the list.
+ */
+
+TAILQ_HEAD(ble_ll_sched_qhead, ble_ll_sched_item);
+
+struct ble_ll_sched_q {
+    struct ble_ll_sched_qhead list;
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    struct ble_ll_sched_item *root;
+#endif
+};
+
+#define BLE_LL_SCHED_Q_INITIALIZER(q) \
+    { .list = TAILQ_HEAD_INITIALIZER((q).list) }
+
+/** Initializes an empty queue. */
+void ble_ll_sched_q_init(struct ble_ll_sched_q *q);
+
+/**
+ * Inserts an item into the queue.
+ *
+ * If the item overlaps items on the queue, preempt_cb is called for each of
+ * them.  If all can be preempted the item is inserted at its start time and
+ * the first of the overlapped items is returned in preempt_first; these are
+ * still on the queue, before the item, and it is up to the caller to remove
+ * them.  Otherwise the item is moved after the item that cannot be
+ * preempted, as long as its start time is not delayed by max_delay ticks or
+ * more.
+ *
+ * @param q             The queue.
+ * @param sch           The item to insert.  Its start and end time may be
+ *                          changed even if it is not inserted.
+ * @param max_delay     Maximum delay of the item start time, in ticks.  0
+ *                          means the item has to start on time.
+ * @param preempt_cb    Called to check whether an overlapped item can be
+ *                          preempted by sch.  NULL if no item can be.
+ * @param preempt_first On return, the first item to preempt, or NULL.
+ *
+ * @return              0 if inserted, -1 otherwise.
+ */
+int ble_ll_sched_q_insert(struct ble_ll_sched_q *q,
+                          struct ble_ll_sched_item *sch, uint32_t max_delay,
+                          ble_ll_sched_preempt_cb_t preempt_cb,
+                          struct ble_ll_sched_item **preempt_first);
+
+/** Removes an item from the queue. */
+void ble_ll_sched_q_remove(struct ble_ll_sched_q *q,
+                           struct ble_ll_sched_item *sch);
+
+/**
+ * Delays an item on the queue by the given number of ticks.  The caller has
+ * to make sure it does not overlap the next item afterwards.
+ */
+void ble_ll_sched_q_delay(struct ble_ll_sched_q *q,
+                          struct ble_ll_sched_item *sch, uint32_t ticks);
+
+static inline struct ble_ll_sched_item *
+ble_ll_sched_q_first(struct ble_ll_sched_q *q)
+{
+    return TAILQ_FIRST(&q->list);
+}
+
+static inline struct ble_ll_sched_item *
+ble_ll_sched_q_next(struct ble_ll_sched_item *sch)
+{
+    return TAILQ_NEXT(sch, link);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BLE_LL_SCHED_Q_PRIV_ */
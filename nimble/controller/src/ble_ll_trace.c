@@ -21,6 +21,12 @@
 #include "syscfg/syscfg.h"
 #include "os/os_trace_api.h"
 #include "controller/ble_ll_trace.h"
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+#include "nimble/hci_common.h"
+#include "controller/ble_ll.h"
+#include "controller/ble_ll_ctrl.h"
+#include "controller/ble_ll_tmr.h"
+#endif
 
 #if MYNEWT_VAL(BLE_LL_SYSVIEW)
 
@@ -54,3 +60,167 @@ ble_ll_trace_init(void)
                                      ble_ll_trace_module_send_desc);
 }
 #endif
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TRACE)
+
+#define BLE_LL_TRACE_SCHED_CNT      MYNEWT_VAL(BLE_LL_SCHED_TRACE_CNT)
+
+/* Number of records that fit in single HCI event */
+#define BLE_LL_TRACE_SCHED_EV_CNT                                   \
+    ((BLE_HCI_MAX_DATA_LEN - sizeof(struct ble_hci_ev_vs) -         \
+      sizeof(struct ble_hci_ev_vs_sched_trace)) /                   \
+     sizeof(struct ble_hci_vs_sched_trace_rec))
+
+/* Number of records buffered before host is notified; a ring smaller than
+ * single HCI event is sent once full.
+ */
+#define BLE_LL_TRACE_SCHED_POST_CNT                                 \
+    (BLE_LL_TRACE_SCHED_EV_CNT < BLE_LL_TRACE_SCHED_CNT ?           \
+     BLE_LL_TRACE_SCHED_EV_CNT : BLE_LL_TRACE_SCHED_CNT)
+
+struct ble_ll_trace_sched {
+    uint8_t enabled;
+    uint16_t first;
+    uint16_t count;
+    uint16_t lost;
+    struct ble_npl_event ev;
+    struct ble_hci_vs_sched_trace_rec recs[BLE_LL_TRACE_SCHED_CNT];
+};
+
+static struct ble_ll_trace_sched g_ble_ll_trace_sched;
+
+static void
+ble_ll_trace_sched_send(int flush)
+{
+    struct ble_ll_trace_sched *ts = &g_ble_ll_trace_sched;
+    uint16_t first;
+    uint16_t count;
+    uint16_t lost;
+    os_sr_t sr;
+
+    while (1) {
+        OS_ENTER_CRITICAL(sr);
+        first = ts->first;
+        count = ts->count;
+        lost = ts->lost;
+        OS_EXIT_CRITICAL(sr);
+
+        if ((count == 0) || (!flush && (count < BLE_LL_TRACE_SCHED_POST_CNT))) {
+            break;
+        }
+
+        /* Records are not overwritten until consumed, so no need to copy
+         * them in critical section. Event ends on ring wrap.
+         */
+        if (count > BLE_LL_TRACE_SCHED_EV_CNT) {
+            count = BLE_LL_TRACE_SCHED_EV_CNT;
+        }
+        if (count > BLE_LL_TRACE_SCHED_CNT - first) {
+            count = BLE_LL_TRACE_SCHED_CNT - first;
+        }
+
+        if (ble_ll_hci_ev_send_vs_sched_trace(&ts->recs[first], count, lost)) {
+            break;
+        }
+
+        OS_ENTER_CRITICAL(sr);
+        ts->first += count;
+        if (ts->first == BLE_LL_TRACE_SCHED_CNT) {
+            ts->first = 0;
+        }
+        ts->count -= count;
+        ts->lost -= lost;
+        OS_EXIT_CRITICAL(sr);
+    }
+}
+
+static void
+ble_ll_trace_sched_ev(struct ble_npl_event *ev)
+{
+    ble_ll_trace_sched_send(0);
+}
+
+void
+ble_ll_trace_sched(uint8_t event, uint8_t sched_type, uint8_t reason,
+                   uint32_t start_time, uint32_t end_time)
+{
+    struct ble_ll_trace_sched *ts = &g_ble_ll_trace_sched;
+    struct ble_hci_vs_sched_trace_rec *rec;
+    uint32_t timestamp;
+    uint16_t idx;
+    os_sr_t sr;
+
+    if (!ts->enabled) {
+        return;
+    }
+
+    timestamp = ble_ll_tmr_get();
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (ts->count == BLE_LL_TRACE_SCHED_CNT) {
+        if (ts->lost < UINT16_MAX) {
+            ts->lost++;
+        }
+        /* Nothing else will post while full, so retry a failed send */
+        ble_ll_event_add(&ts->ev);
+        OS_EXIT_CRITICAL(sr);
+        return;
+    }
+
+    idx = ts->first + ts->count;
+    if (idx >= BLE_LL_TRACE_SCHED_CNT) {
+        idx -= BLE_LL_TRACE_SCHED_CNT;
+    }
+    ts->count++;
+
+    rec = &ts->recs[idx];
+    rec->event = event;
+    rec->sched_type = sched_type;
+    rec->reason = reason;
+    rec->reserved = 0;
+    rec->start_time = htole32(start_time);
+    rec->timestamp = htole32(timestamp);
+    rec->end_time = htole32(end_time);
+
+    if (ts->count >= BLE_LL_TRACE_SCHED_POST_CNT) {
+        ble_ll_event_add(&ts->ev);
+    }
+
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+ble_ll_trace_sched_enable(uint8_t enable)
+{
+    struct ble_ll_trace_sched *ts = &g_ble_ll_trace_sched;
+
+    ts->enabled = enable;
+
+    /* Send whatever is left so host has complete trace */
+    if (!enable) {
+        ble_ll_trace_sched_send(1);
+    }
+}
+
+void
+ble_ll_trace_sched_reset(void)
+{
+    struct ble_ll_trace_sched *ts = &g_ble_ll_trace_sched;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    ts->enabled = 0;
+    ts->first = 0;
+    ts->count = 0;
+    ts->lost = 0;
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+ble_ll_trace_sched_init(void)
+{
+    ble_npl_event_init(&g_ble_ll_trace_sched.ev, ble_ll_trace_sched_ev, NULL);
+    ble_ll_trace_sched_reset();
+}
+#endif
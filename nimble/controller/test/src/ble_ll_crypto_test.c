@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include <controller/ble_ll_crypto.h>
+#include <ble/xcvr.h>
 #include <testutil/testutil.h>
 
 TEST_CASE_SELF(ble_ll_crypto_test_h6) {
@@ -139,9 +140,18 @@ TEST_CASE_SELF(ble_ll_crypto_test_gskd) {
     TEST_ASSERT(rc == 0);
 }
 
+TEST_CASE_SELF(ble_ll_crypto_test_hw_aes) {
+    int rc;
+
+    /* Software AES of the native driver the unit tests run on */
+    rc = ble_hw_aes_selftest();
+    TEST_ASSERT(rc == 0);
+}
+
 TEST_SUITE(ble_ll_crypto_test_suite) {
     ble_ll_crypto_test_h6();
     ble_ll_crypto_test_h7();
     ble_ll_crypto_test_h8();
     ble_ll_crypto_test_gskd();
+    ble_ll_crypto_test_hw_aes();
 }
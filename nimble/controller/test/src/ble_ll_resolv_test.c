@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <testutil/testutil.h>
+#include <nimble/hci_common.h>
+#include <controller/ble_ll.h>
+#include <controller/ble_ll_resolv.h>
+
+#if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_PRIVACY) && \
+    MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE) && \
+    MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+
+/*
+ * The cache has no accessors, so these tests change an IRK on the resolving
+ * list behind its back: a stale result shows the cache was used, a fresh one
+ * that it was flushed.
+ */
+
+#define RESOLV_TEST_PEER_A      (0)
+#define RESOLV_TEST_PEER_B      (1)
+
+/* Peer RPAs generated with the IRKs of peers A and B */
+static uint8_t resolv_test_rpa[2][BLE_DEV_ADDR_LEN];
+
+/* Peer IRKs as stored on the resolving list */
+static uint8_t resolv_test_irk[2][16];
+
+static void
+resolv_test_id_addr(uint8_t peer, uint8_t *addr)
+{
+    memcpy(addr, ((uint8_t[]){ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 }),
+           BLE_DEV_ADDR_LEN);
+    addr[0] = peer;
+}
+
+static void
+resolv_test_add(uint8_t peer)
+{
+    struct ble_hci_le_add_resolv_list_cp cmd;
+    int rc;
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.peer_addr_type = BLE_ADDR_PUBLIC;
+    resolv_test_id_addr(peer, cmd.peer_id_addr);
+    memset(cmd.peer_irk, 0xa0 + peer, sizeof(cmd.peer_irk));
+    cmd.peer_irk[0] = peer;
+
+    rc = ble_ll_resolv_list_add((uint8_t *)&cmd, sizeof(cmd));
+    TEST_ASSERT_FATAL(rc == BLE_ERR_SUCCESS);
+}
+
+static void
+resolv_test_rmv(uint8_t peer)
+{
+    struct ble_hci_le_rmv_resolve_list_cp cmd;
+    int rc;
+
+    cmd.peer_addr_type = BLE_ADDR_PUBLIC;
+    resolv_test_id_addr(peer, cmd.peer_id_addr);
+
+    rc = ble_ll_resolv_list_rmv((uint8_t *)&cmd, sizeof(cmd));
+    TEST_ASSERT_FATAL(rc == BLE_ERR_SUCCESS);
+}
+
+static void
+resolv_test_set_irk(int rl_idx, uint8_t peer)
+{
+    memcpy(g_ble_ll_resolv_list[rl_idx].rl_peer_irk, resolv_test_irk[peer],
+           16);
+}
+
+/**
+ * Generates an RPA for each peer and leaves the resolving list empty.
+ */
+static void
+resolv_test_init(void)
+{
+    uint8_t addr[BLE_DEV_ADDR_LEN];
+    uint8_t peer;
+    int rc;
+
+    ble_ll_rand_init();
+    ble_ll_resolv_init();
+    ble_ll_resolv_list_clr();
+
+    for (peer = RESOLV_TEST_PEER_A; peer <= RESOLV_TEST_PEER_B; peer++) {
+        resolv_test_add(peer);
+
+        resolv_test_id_addr(peer, addr);
+        rc = ble_ll_resolv_gen_rpa(addr, BLE_ADDR_PUBLIC,
+                                   resolv_test_rpa[peer], 0);
+        TEST_ASSERT_FATAL(rc == 1);
+        memcpy(resolv_test_irk[peer], g_ble_ll_resolv_list[peer].rl_peer_irk,
+               16);
+    }
+
+    rc = ble_ll_resolv_list_clr();
+    TEST_ASSERT_FATAL(rc == BLE_ERR_SUCCESS);
+}
+
+TEST_CASE_SELF(ble_ll_resolv_test_cache_add)
+{
+    resolv_test_init();
+
+    resolv_test_add(RESOLV_TEST_PEER_A);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == -1);
+
+    /* Both results are remembered */
+    resolv_test_set_irk(0, RESOLV_TEST_PEER_B);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == -1);
+    resolv_test_set_irk(0, RESOLV_TEST_PEER_A);
+
+    /* New IRK makes an unresolvable RPA resolvable */
+    resolv_test_add(RESOLV_TEST_PEER_B);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == 1);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+
+    ble_ll_resolv_list_reset();
+}
+
+TEST_CASE_SELF(ble_ll_resolv_test_cache_rmv)
+{
+    resolv_test_init();
+
+    resolv_test_add(RESOLV_TEST_PEER_A);
+    resolv_test_add(RESOLV_TEST_PEER_B);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == 1);
+
+    /* Removing A moves B to index 0 */
+    resolv_test_rmv(RESOLV_TEST_PEER_A);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == 0);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == -1);
+
+    resolv_test_rmv(RESOLV_TEST_PEER_B);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == -1);
+
+    ble_ll_resolv_list_reset();
+}
+
+TEST_CASE_SELF(ble_ll_resolv_test_cache_clr)
+{
+    resolv_test_init();
+
+    resolv_test_add(RESOLV_TEST_PEER_A);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+
+    TEST_ASSERT_FATAL(ble_ll_resolv_list_clr() == BLE_ERR_SUCCESS);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == -1);
+
+    /* Reset clears the list as well */
+    resolv_test_add(RESOLV_TEST_PEER_A);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+    ble_ll_resolv_list_reset();
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == -1);
+
+    ble_ll_resolv_list_reset();
+}
+
+TEST_CASE_SELF(ble_ll_resolv_test_cache_rpa_tmo)
+{
+    resolv_test_init();
+
+    resolv_test_add(RESOLV_TEST_PEER_A);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == -1);
+
+    /* Results are kept until the RPA timer expires */
+    resolv_test_set_irk(0, RESOLV_TEST_PEER_B);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == 0);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == -1);
+
+    ble_ll_resolv_rpa_timer_expire();
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[0]) == -1);
+    TEST_ASSERT(ble_ll_resolv_peer_rpa_any(resolv_test_rpa[1]) == 0);
+
+    ble_ll_resolv_list_reset();
+}
+
+#endif
+
+TEST_SUITE(ble_ll_resolv_test_suite)
+{
+#if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_PRIVACY) && \
+    MYNEWT_VAL(BLE_LL_RESOLV_CACHE_SIZE) && \
+    MYNEWT_VAL(BLE_LL_RESOLV_NEG_CACHE_SIZE)
+    ble_ll_resolv_test_cache_add();
+    ble_ll_resolv_test_cache_rmv();
+    ble_ll_resolv_test_cache_clr();
+    ble_ll_resolv_test_cache_rpa_tmo();
+#endif
+}
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <testutil/testutil.h>
+#include "ble_ll_scan_dup_priv.h"
+
+#define SCAN_DUP_TEST_NUM_ENTRIES   (4)
+
+static os_membuf_t scan_dup_test_mem[
+    BLE_LL_SCAN_DUP_TABLE_MEM_SIZE(SCAN_DUP_TEST_NUM_ENTRIES)];
+static struct ble_ll_scan_dup_bucket
+    scan_dup_test_buckets[SCAN_DUP_TEST_NUM_ENTRIES];
+static struct ble_ll_scan_dup_table scan_dup_test_tbl;
+
+static void
+scan_dup_test_init(uint16_t num_buckets)
+{
+    ble_ll_scan_dup_table_init(&scan_dup_test_tbl, scan_dup_test_mem,
+                               SCAN_DUP_TEST_NUM_ENTRIES,
+                               scan_dup_test_buckets, num_buckets,
+                               "scan_dup_test");
+}
+
+static void
+scan_dup_test_addr(uint8_t *addr, uint8_t id)
+{
+    memcpy(addr, ((uint8_t[]){ 0x00, 0x11, 0x22, 0x33, 0x44, 0xc0 }), 6);
+    addr[0] = id;
+}
+
+static struct ble_ll_scan_dup_entry *
+scan_dup_test_get(uint8_t type, uint8_t id, int expected_created)
+{
+    struct ble_ll_scan_dup_entry *e;
+    uint8_t addr[6];
+    int created;
+
+    scan_dup_test_addr(addr, id);
+
+    e = ble_ll_scan_dup_table_get(&scan_dup_test_tbl, type, addr, &created);
+    TEST_ASSERT_FATAL(e != NULL);
+    TEST_ASSERT(created == expected_created);
+    TEST_ASSERT(e->type == type);
+    TEST_ASSERT(memcmp(e->addr, addr, 6) == 0);
+    TEST_ASSERT(ble_ll_scan_dup_table_head(&scan_dup_test_tbl) == e);
+
+    return e;
+}
+
+static void
+scan_dup_test_hit_miss(uint16_t num_buckets)
+{
+    struct ble_ll_scan_dup_entry *e;
+    int i;
+
+    scan_dup_test_init(num_buckets);
+    TEST_ASSERT(ble_ll_scan_dup_table_head(&scan_dup_test_tbl) == NULL);
+
+    for (i = 0; i < SCAN_DUP_TEST_NUM_ENTRIES; i++) {
+        e = scan_dup_test_get(0, i, 1);
+        TEST_ASSERT(e->flags == 0);
+        e->flags = i + 1;
+    }
+
+    /* Existing entries keep their state */
+    for (i = 0; i < SCAN_DUP_TEST_NUM_ENTRIES; i++) {
+        e = scan_dup_test_get(0, i, 0);
+        TEST_ASSERT(e->flags == i + 1);
+    }
+
+    /* Same address with another type is another entry; 0 is the oldest */
+    e = scan_dup_test_get(1, 1, 1);
+    TEST_ASSERT(e->flags == 0);
+    scan_dup_test_get(0, 1, 0);
+    scan_dup_test_get(1, 1, 0);
+}
+
+TEST_CASE_SELF(ble_ll_scan_dup_test_hit_miss)
+{
+    scan_dup_test_hit_miss(SCAN_DUP_TEST_NUM_ENTRIES);
+}
+
+TEST_CASE_SELF(ble_ll_scan_dup_test_single_bucket)
+{
+    /* All entries share one chain, eviction has to unlink from its middle */
+    scan_dup_test_hit_miss(1);
+}
+
+TEST_CASE_SELF(ble_ll_scan_dup_test_lru)
+{
+    int i;
+
+    scan_dup_test_init(SCAN_DUP_TEST_NUM_ENTRIES);
+
+    for (i = 0; i < SCAN_DUP_TEST_NUM_ENTRIES; i++) {
+        scan_dup_test_get(0, i, 1);
+    }
+
+    /* Use 0 so that 1 becomes the least recently used entry */
+    scan_dup_test_get(0, 0, 0);
+    scan_dup_test_get(0, 10, 1);
+
+    scan_dup_test_get(0, 0, 0);
+    scan_dup_test_get(0, 2, 0);
+    scan_dup_test_get(0, 3, 0);
+    scan_dup_test_get(0, 10, 0);
+
+    /* 1 was evicted; adding it back evicts 0 */
+    scan_dup_test_get(0, 1, 1);
+    scan_dup_test_get(0, 2, 0);
+    scan_dup_test_get(0, 3, 0);
+    scan_dup_test_get(0, 10, 0);
+    scan_dup_test_get(0, 0, 1);
+}
+
+TEST_CASE_SELF(ble_ll_scan_dup_test_clear)
+{
+    int i;
+
+    scan_dup_test_init(SCAN_DUP_TEST_NUM_ENTRIES);
+
+    for (i = 0; i < SCAN_DUP_TEST_NUM_ENTRIES; i++) {
+        scan_dup_test_get(0, i, 1);
+    }
+
+    ble_ll_scan_dup_table_clear(&scan_dup_test_tbl);
+    TEST_ASSERT(ble_ll_scan_dup_table_head(&scan_dup_test_tbl) == NULL);
+
+    for (i = 0; i < SCAN_DUP_TEST_NUM_ENTRIES; i++) {
+        scan_dup_test_get(0, i, 1);
+    }
+}
+
+TEST_SUITE(ble_ll_scan_dup_test_suite)
+{
+    ble_ll_scan_dup_test_hit_miss();
+    ble_ll_scan_dup_test_single_bucket();
+    ble_ll_scan_dup_test_lru();
+    ble_ll_scan_dup_test_clear();
+}
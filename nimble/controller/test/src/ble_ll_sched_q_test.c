@@ -0,0 +1,426 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <testutil/testutil.h>
+#include "controller/ble_ll_tmr.h"
+#include "ble_ll_sched_q_priv.h"
+
+#define SCHED_Q_TEST_NUM_ITEMS      (1024)
+#define SCHED_Q_TEST_NUM_OPS        (20000)
+
+/* Items of this type can be preempted by sched_q_test_preempt_cb() */
+#define SCHED_Q_TEST_TYPE_PREEMPTABLE   (1)
+
+static struct ble_ll_sched_q sched_q_test_q;
+static struct ble_ll_sched_item sched_q_test_items[SCHED_Q_TEST_NUM_ITEMS];
+
+static int
+sched_q_test_preempt_cb(struct ble_ll_sched_item *sch,
+                        struct ble_ll_sched_item *item)
+{
+    return item->sched_type == SCHED_Q_TEST_TYPE_PREEMPTABLE;
+}
+
+static void
+sched_q_test_item(struct ble_ll_sched_item *sch, uint32_t start,
+                  uint32_t duration, uint8_t type)
+{
+    memset(sch, 0, sizeof(*sch));
+    sch->sched_type = type;
+    sch->start_time = start;
+    sch->end_time = start + duration;
+}
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+/* Checks subtree and returns its black height */
+static int
+sched_q_test_check_node(struct ble_ll_sched_item *sch,
+                        struct ble_ll_sched_item **in_order)
+{
+    struct ble_ll_sched_item *prev;
+    uint32_t max_gap;
+    int32_t gap;
+    int left;
+    int right;
+
+    if (!sch) {
+        return 1;
+    }
+
+    if (sch->rb_red) {
+        TEST_ASSERT_FATAL(!sch->rb_left || !sch->rb_left->rb_red);
+        TEST_ASSERT_FATAL(!sch->rb_right || !sch->rb_right->rb_red);
+    }
+    if (sch->rb_left) {
+        TEST_ASSERT_FATAL(sch->rb_left->rb_parent == sch);
+    }
+    if (sch->rb_right) {
+        TEST_ASSERT_FATAL(sch->rb_right->rb_parent == sch);
+    }
+
+    left = sched_q_test_check_node(sch->rb_left, in_order);
+
+    /* Tree order is the list order */
+    TEST_ASSERT_FATAL(*in_order == sch);
+    *in_order = ble_ll_sched_q_next(sch);
+
+    right = sched_q_test_check_node(sch->rb_right, in_order);
+
+    TEST_ASSERT_FATAL(left == right);
+
+    max_gap = 0;
+    prev = TAILQ_PREV(sch, ble_ll_sched_qhead, link);
+    if (prev) {
+        gap = (int32_t)(sch->start_time - prev->end_time - 1);
+        max_gap = gap > 0 ? gap : 0;
+    }
+    if (sch->rb_left && (sch->rb_left->rb_max_gap > max_gap)) {
+        max_gap = sch->rb_left->rb_max_gap;
+    }
+    if (sch->rb_right && (sch->rb_right->rb_max_gap > max_gap)) {
+        max_gap = sch->rb_right->rb_max_gap;
+    }
+    TEST_ASSERT_FATAL(sch->rb_max_gap == max_gap);
+
+    return left + !sch->rb_red;
+}
+#endif
+
+static void
+sched_q_test_check(void)
+{
+    struct ble_ll_sched_item *prev;
+    struct ble_ll_sched_item *sch;
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    struct ble_ll_sched_item *in_order;
+#endif
+
+    prev = NULL;
+    for (sch = ble_ll_sched_q_first(&sched_q_test_q); sch;
+         sch = ble_ll_sched_q_next(sch)) {
+        TEST_ASSERT_FATAL(sch->enqueued);
+        if (prev) {
+            TEST_ASSERT_FATAL(LL_TMR_LEQ(prev->end_time, sch->start_time));
+        }
+        prev = sch;
+    }
+
+#if MYNEWT_VAL(BLE_LL_SCHED_TREE)
+    if (sched_q_test_q.root) {
+        TEST_ASSERT_FATAL(!sched_q_test_q.root->rb_parent);
+        TEST_ASSERT_FATAL(!sched_q_test_q.root->rb_red);
+    }
+    in_order = ble_ll_sched_q_first(&sched_q_test_q);
+    sched_q_test_check_node(sched_q_test_q.root, &in_order);
+    TEST_ASSERT_FATAL(in_order == NULL);
+#endif
+}
+
+/*
+ * Reference insertion: the walk over all items on the list that the queue
+ * did before it could skip items.  Returns where and when the item would be
+ * inserted without inserting it.
+ */
+static int
+sched_q_test_ref(struct ble_ll_sched_item *sch, uint32_t max_delay,
+                 ble_ll_sched_preempt_cb_t preempt_cb, uint32_t *start,
+                 struct ble_ll_sched_item **next,
+                 struct ble_ll_sched_item **preempt_first)
+{
+    struct ble_ll_sched_item tmp;
+    struct ble_ll_sched_item *entry;
+    uint32_t max_start_time;
+    uint32_t duration;
+
+    tmp = *sch;
+    *preempt_first = NULL;
+    max_start_time = tmp.start_time + max_delay;
+    duration = tmp.end_time - tmp.start_time;
+
+    for (entry = ble_ll_sched_q_first(&sched_q_test_q); entry;
+         entry = ble_ll_sched_q_next(entry)) {
+        if (LL_TMR_LEQ(tmp.end_time, entry->start_time)) {
+            break;
+        }
+
+        if (LL_TMR_GT(tmp.end_time, entry->start_time) &&
+            LL_TMR_GT(entry->end_time, tmp.start_time)) {
+            if (preempt_cb && preempt_cb(&tmp, entry)) {
+                if (!*preempt_first) {
+                    *preempt_first = entry;
+                }
+            } else {
+                *preempt_first = NULL;
+                tmp.start_time = entry->end_time + 1;
+                if ((max_delay == 0) ||
+                    LL_TMR_GEQ(tmp.start_time, max_start_time)) {
+                    return -1;
+                }
+                tmp.end_time = tmp.start_time + duration;
+            }
+        }
+    }
+
+    *start = tmp.start_time;
+    *next = entry;
+
+    return 0;
+}
+
+static void
+sched_q_test_preempt(struct ble_ll_sched_item *sch,
+                     struct ble_ll_sched_item *first)
+{
+    struct ble_ll_sched_item *next;
+
+    do {
+        next = ble_ll_sched_q_next(first);
+        TEST_ASSERT_FATAL(first->sched_type == SCHED_Q_TEST_TYPE_PREEMPTABLE);
+        ble_ll_sched_q_remove(&sched_q_test_q, first);
+        first = next;
+    } while (first != sch);
+}
+
+static int
+sched_q_test_insert(struct ble_ll_sched_item *sch, uint32_t max_delay,
+                    ble_ll_sched_preempt_cb_t preempt_cb)
+{
+    struct ble_ll_sched_item *exp_preempt_first;
+    struct ble_ll_sched_item *preempt_first;
+    struct ble_ll_sched_item *exp_next;
+    uint32_t exp_start;
+    uint32_t duration;
+    int exp_rc;
+    int rc;
+
+    duration = sch->end_time - sch->start_time;
+
+    exp_rc = sched_q_test_ref(sch, max_delay, preempt_cb, &exp_start,
+                              &exp_next, &exp_preempt_first);
+
+    rc = ble_ll_sched_q_insert(&sched_q_test_q, sch, max_delay, preempt_cb,
+                               &preempt_first);
+
+    TEST_ASSERT_FATAL(rc == exp_rc);
+    TEST_ASSERT_FATAL(sch->enqueued == (rc == 0));
+
+    if (rc == 0) {
+        TEST_ASSERT_FATAL(sch->start_time == exp_start);
+        TEST_ASSERT_FATAL(sch->end_time - sch->start_time == duration);
+        TEST_ASSERT_FATAL(ble_ll_sched_q_next(sch) == exp_next);
+        TEST_ASSERT_FATAL(preempt_first == exp_preempt_first);
+
+        if (preempt_first) {
+            sched_q_test_preempt(sch, preempt_first);
+        }
+    } else {
+        TEST_ASSERT_FATAL(preempt_first == NULL);
+    }
+
+    sched_q_test_check();
+
+    return rc;
+}
+
+TEST_CASE_SELF(ble_ll_sched_q_test_order)
+{
+    static const uint32_t starts[] = { 500, 100, 900, 300, 700 };
+    struct ble_ll_sched_item *sch;
+    uint32_t prev;
+    int i;
+
+    ble_ll_sched_q_init(&sched_q_test_q);
+    TEST_ASSERT(ble_ll_sched_q_first(&sched_q_test_q) == NULL);
+
+    for (i = 0; i < ARRAY_SIZE(starts); i++) {
+        sched_q_test_item(&sched_q_test_items[i], starts[i], 100, 0);
+        TEST_ASSERT(sched_q_test_insert(&sched_q_test_items[i], 0,
+                                        NULL) == 0);
+    }
+
+    prev = 0;
+    i = 0;
+    for (sch = ble_ll_sched_q_first(&sched_q_test_q); sch;
+         sch = ble_ll_sched_q_next(sch)) {
+        TEST_ASSERT(LL_TMR_GT(sch->start_time, prev));
+        prev = sch->start_time;
+        i++;
+    }
+    TEST_ASSERT(i == ARRAY_SIZE(starts));
+
+    /* Remove from the middle and the head */
+    ble_ll_sched_q_remove(&sched_q_test_q, &sched_q_test_items[0]);
+    TEST_ASSERT(!sched_q_test_items[0].enqueued);
+    sched_q_test_check();
+    ble_ll_sched_q_remove(&sched_q_test_q, &sched_q_test_items[1]);
+    sched_q_test_check();
+    TEST_ASSERT(ble_ll_sched_q_first(&sched_q_test_q) ==
+                &sched_q_test_items[3]);
+}
+
+TEST_CASE_SELF(ble_ll_sched_q_test_delay)
+{
+    struct ble_ll_sched_item *sch;
+    int i;
+
+    ble_ll_sched_q_init(&sched_q_test_q);
+
+    /* Items at 0, 100, 200 and 300, 50 ticks long */
+    for (i = 0; i < 4; i++) {
+        sched_q_test_item(&sched_q_test_items[i], i * 100, 50, 0);
+        TEST_ASSERT(sched_q_test_insert(&sched_q_test_items[i], 0,
+                                        NULL) == 0);
+    }
+
+    /* Cannot preempt, so must start on time or in a gap large enough */
+    sch = &sched_q_test_items[4];
+    sched_q_test_item(sch, 20, 40, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 0, NULL) == -1);
+
+    sched_q_test_item(sch, 20, 60, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 30, NULL) == -1);
+    sched_q_test_item(sch, 20, 60, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 1000, NULL) == 0);
+    TEST_ASSERT(sch->start_time == 351);
+    ble_ll_sched_q_remove(&sched_q_test_q, sch);
+
+    sched_q_test_item(sch, 20, 40, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 1000, NULL) == 0);
+    TEST_ASSERT(sch->start_time == 51);
+    TEST_ASSERT(ble_ll_sched_q_next(sch) == &sched_q_test_items[1]);
+
+    /* Delaying an item makes the gap before it large enough */
+    ble_ll_sched_q_remove(&sched_q_test_q, sch);
+    ble_ll_sched_q_delay(&sched_q_test_q, &sched_q_test_items[1], 30);
+    sched_q_test_check();
+
+    sched_q_test_item(sch, 20, 60, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 1000, NULL) == 0);
+    TEST_ASSERT(sch->start_time == 51);
+    TEST_ASSERT(ble_ll_sched_q_next(sch) == &sched_q_test_items[1]);
+}
+
+TEST_CASE_SELF(ble_ll_sched_q_test_preempt)
+{
+    struct ble_ll_sched_item *sch;
+    int i;
+
+    ble_ll_sched_q_init(&sched_q_test_q);
+
+    /* Items at 0, 100, 200 and 300, 50 ticks long; 1 and 2 preemptable */
+    for (i = 0; i < 4; i++) {
+        sched_q_test_item(&sched_q_test_items[i], i * 100, 50,
+                          (i == 1) || (i == 2) ?
+                          SCHED_Q_TEST_TYPE_PREEMPTABLE : 0);
+        TEST_ASSERT(sched_q_test_insert(&sched_q_test_items[i], 0,
+                                        NULL) == 0);
+    }
+
+    /* Overlaps 0 which cannot be preempted */
+    sch = &sched_q_test_items[4];
+    sched_q_test_item(sch, 40, 200, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 0, sched_q_test_preempt_cb) == -1);
+    TEST_ASSERT(sched_q_test_items[0].enqueued);
+
+    /* Preempts 1 and 2 */
+    sched_q_test_item(sch, 60, 200, 0);
+    TEST_ASSERT(sched_q_test_insert(sch, 0, sched_q_test_preempt_cb) == 0);
+    TEST_ASSERT(!sched_q_test_items[1].enqueued);
+    TEST_ASSERT(!sched_q_test_items[2].enqueued);
+    TEST_ASSERT(ble_ll_sched_q_next(&sched_q_test_items[0]) == sch);
+    TEST_ASSERT(ble_ll_sched_q_next(sch) == &sched_q_test_items[3]);
+}
+
+TEST_CASE_SELF(ble_ll_sched_q_test_stress)
+{
+    struct ble_ll_sched_item *sch;
+    uint32_t base;
+    uint32_t start;
+    uint32_t next_start;
+    int inserted;
+    int op;
+    int i;
+
+    ble_ll_sched_q_init(&sched_q_test_q);
+    memset(sched_q_test_items, 0, sizeof(sched_q_test_items));
+    srand(1);
+
+    /* Times wrap around in the middle of the test */
+    base = 0xfff00000;
+    inserted = 0;
+
+    for (op = 0; op < SCHED_Q_TEST_NUM_OPS; op++) {
+        sch = &sched_q_test_items[rand() % SCHED_Q_TEST_NUM_ITEMS];
+
+        if (!sch->enqueued) {
+            sched_q_test_item(sch, base + rand() % 0x20000, 2 + rand() % 64,
+                              rand() % 2);
+
+            switch (rand() % 3) {
+            case 0:
+                i = sched_q_test_insert(sch, 0, NULL);
+                break;
+            case 1:
+                i = sched_q_test_insert(sch, rand() % 0x10000, NULL);
+                break;
+            default:
+                i = sched_q_test_insert(sch, 0, sched_q_test_preempt_cb);
+                break;
+            }
+
+            inserted += (i == 0);
+        } else if (rand() % 4) {
+            ble_ll_sched_q_remove(&sched_q_test_q, sch);
+            sched_q_test_check();
+        } else {
+            /* Delay within the gap to the next item */
+            if (ble_ll_sched_q_next(sch)) {
+                next_start = ble_ll_sched_q_next(sch)->start_time;
+            } else {
+                next_start = sch->end_time + 100;
+            }
+            start = next_start - sch->end_time;
+            if (start) {
+                ble_ll_sched_q_delay(&sched_q_test_q, sch, rand() % start);
+                sched_q_test_check();
+            }
+        }
+
+        base += 16;
+    }
+
+    /* Make sure the queue was actually filled up a few times over */
+    TEST_ASSERT(inserted > SCHED_Q_TEST_NUM_ITEMS);
+
+    while ((sch = ble_ll_sched_q_first(&sched_q_test_q))) {
+        ble_ll_sched_q_remove(&sched_q_test_q, sch);
+    }
+    sched_q_test_check();
+}
+
+TEST_SUITE(ble_ll_sched_q_test_suite)
+{
+    ble_ll_sched_q_test_order();
+    ble_ll_sched_q_test_delay();
+    ble_ll_sched_q_test_preempt();
+    ble_ll_sched_q_test_stress();
+}
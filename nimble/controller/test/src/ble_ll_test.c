@@ -28,6 +28,9 @@ TEST_SUITE_DECL(ble_ll_csa2_test_suite);
 TEST_SUITE_DECL(ble_ll_isoal_test_suite);
 TEST_SUITE_DECL(ble_ll_iso_test_suite);
 TEST_SUITE_DECL(ble_ll_cs_drbg_test_suite);
+TEST_SUITE_DECL(ble_ll_scan_dup_test_suite);
+TEST_SUITE_DECL(ble_ll_sched_q_test_suite);
+TEST_SUITE_DECL(ble_ll_resolv_test_suite);
 
 int
 main(int argc, char **argv)
@@ -38,6 +41,9 @@ main(int argc, char **argv)
     ble_ll_isoal_test_suite();
     ble_ll_iso_test_suite();
     ble_ll_cs_drbg_test_suite();
+    ble_ll_scan_dup_test_suite();
+    ble_ll_sched_q_test_suite();
+    ble_ll_resolv_test_suite();
 
     return tu_any_failed;
 }
@@ -39,6 +39,14 @@ extern "C" {
  */
 #define BLE_HW_WHITE_LIST_SIZE        (0)
 
+/*
+ * Checks both software AES implementations against FIPS-197 C.1, one block
+ * and batches of up to 65 blocks. Built with SELFTEST only.
+ *
+ * @return 0 on success, -1 on mismatch.
+ */
+int ble_hw_aes_selftest(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -134,7 +134,10 @@ ble_hw_whitelist_match(void)
 int
 ble_hw_encrypt_block(struct ble_encryption_block *ecb)
 {
-    return -1;
+    const uint8_t *key = ecb->key;
+
+    return ble_hw_encrypt_block_batch(ecb->plain_text, &key,
+                                      &ecb->cipher_text, 1);
 }
 
 /**
@@ -0,0 +1,639 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Software AES-128 for the native driver.
+ *
+ * Blocks are encrypted with AES-NI when the host CPU supports it. Otherwise
+ * a bitsliced implementation is used: bit n of every byte of up to 64 blocks
+ * is kept in one 64-bit word, one bit per block, so that each operation of
+ * the cipher processes all blocks at once. This is what makes checking one
+ * RPA against a long resolving list cheap, as all IRKs are tried together.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "syscfg/syscfg.h"
+#include "os/os.h"
+#include "nimble/ble.h"
+#include "controller/ble_hw.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    MYNEWT_VAL(BLE_HW_NATIVE_AES_NI)
+#define BLE_HW_AES_NI   (1)
+#include <wmmintrin.h>
+#else
+#define BLE_HW_AES_NI   (0)
+#endif
+
+/* Number of blocks encrypted at once by bitsliced implementation */
+#define BLE_HW_AES_BS_LANES     (64)
+
+/*
+ * Bitsliced state: [byte][bit], where byte is in FIPS-197 order and bit 0 is
+ * the least significant bit of a byte.
+ */
+typedef uint64_t ble_hw_aes_bs_t[BLE_ENC_BLOCK_SIZE][8];
+
+/* Too big for the stack of LL task, so these are shared and locked */
+static ble_hw_aes_bs_t g_ble_hw_aes_bs_rk;
+static ble_hw_aes_bs_t g_ble_hw_aes_bs_st;
+
+/*
+ * S-box circuit by Boyar and Peralta, "A depth-16 circuit for the AES S-box".
+ * U0 and S0 are the most significant bits.
+ */
+static void
+ble_hw_aes_bs_sbox(uint64_t *q)
+{
+    uint64_t U0, U1, U2, U3, U4, U5, U6, U7;
+    uint64_t T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14;
+    uint64_t T15, T16, T17, T18, T19, T20, T21, T22, T23, T24, T25, T26;
+    uint64_t T27;
+    uint64_t M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14;
+    uint64_t M15, M16, M17, M18, M19, M20, M21, M22, M23, M24, M25, M26;
+    uint64_t M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38;
+    uint64_t M39, M40, M41, M42, M43, M44, M45, M46, M47, M48, M49, M50;
+    uint64_t M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62;
+    uint64_t M63;
+    uint64_t L0, L1, L2, L3, L4, L5, L6, L7, L8, L9, L10, L11, L12, L13;
+    uint64_t L14, L15, L16, L17, L18, L19, L20, L21, L22, L23, L24, L25;
+    uint64_t L26, L27, L28, L29;
+
+    U0 = q[7];
+    U1 = q[6];
+    U2 = q[5];
+    U3 = q[4];
+    U4 = q[3];
+    U5 = q[2];
+    U6 = q[1];
+    U7 = q[0];
+
+    /* Top linear transformation */
+    T1 = U0 ^ U3;
+    T2 = U0 ^ U5;
+    T3 = U0 ^ U6;
+    T4 = U3 ^ U5;
+    T5 = U4 ^ U6;
+    T6 = T1 ^ T5;
+    T7 = U1 ^ U2;
+    T8 = U7 ^ T6;
+    T9 = U7 ^ T7;
+    T10 = T6 ^ T7;
+    T11 = U1 ^ U5;
+    T12 = U2 ^ U5;
+    T13 = T3 ^ T4;
+    T14 = T6 ^ T11;
+    T15 = T5 ^ T11;
+    T16 = T5 ^ T12;
+    T17 = T9 ^ T16;
+    T18 = U3 ^ U7;
+    T19 = T7 ^ T18;
+    T20 = T1 ^ T19;
+    T21 = U6 ^ U7;
+    T22 = T7 ^ T21;
+    T23 = T2 ^ T22;
+    T24 = T2 ^ T10;
+    T25 = T20 ^ T17;
+    T26 = T3 ^ T16;
+    T27 = T1 ^ T12;
+
+    /* Non-linear section */
+    M1 = T13 & T6;
+    M2 = T23 & T8;
+    M3 = T14 ^ M1;
+    M4 = T19 & U7;
+    M5 = M4 ^ M1;
+    M6 = T3 & T16;
+    M7 = T22 & T9;
+    M8 = T26 ^ M6;
+    M9 = T20 & T17;
+    M10 = M9 ^ M6;
+    M11 = T1 & T15;
+    M12 = T4 & T27;
+    M13 = M12 ^ M11;
+    M14 = T2 & T10;
+    M15 = M14 ^ M11;
+    M16 = M3 ^ M2;
+    M17 = M5 ^ T24;
+    M18 = M8 ^ M7;
+    M19 = M10 ^ M15;
+    M20 = M16 ^ M13;
+    M21 = M17 ^ M15;
+    M22 = M18 ^ M13;
+    M23 = M19 ^ T25;
+    M24 = M22 ^ M23;
+    M25 = M22 & M20;
+    M26 = M21 ^ M25;
+    M27 = M20 ^ M21;
+    M28 = M23 ^ M25;
+    M29 = M28 & M27;
+    M30 = M26 & M24;
+    M31 = M20 & M23;
+    M32 = M27 & M31;
+    M33 = M27 ^ M25;
+    M34 = M21 & M22;
+    M35 = M24 & M34;
+    M36 = M24 ^ M25;
+    M37 = M21 ^ M29;
+    M38 = M32 ^ M33;
+    M39 = M23 ^ M30;
+    M40 = M35 ^ M36;
+    M41 = M38 ^ M40;
+    M42 = M37 ^ M39;
+    M43 = M37 ^ M38;
+    M44 = M39 ^ M40;
+    M45 = M42 ^ M41;
+    M46 = M44 & T6;
+    M47 = M40 & T8;
+    M48 = M39 & U7;
+    M49 = M43 & T16;
+    M50 = M38 & T9;
+    M51 = M37 & T17;
+    M52 = M42 & T15;
+    M53 = M45 & T27;
+    M54 = M41 & T10;
+    M55 = M44 & T13;
+    M56 = M40 & T23;
+    M57 = M39 & T19;
+    M58 = M43 & T3;
+    M59 = M38 & T22;
+    M60 = M37 & T20;
+    M61 = M42 & T1;
+    M62 = M45 & T4;
+    M63 = M41 & T2;
+
+    /* Bottom linear transformation */
+    L0 = M61 ^ M62;
+    L1 = M50 ^ M56;
+    L2 = M46 ^ M48;
+    L3 = M47 ^ M55;
+    L4 = M54 ^ M58;
+    L5 = M49 ^ M61;
+    L6 = M62 ^ L5;
+    L7 = M46 ^ L3;
+    L8 = M51 ^ M59;
+    L9 = M52 ^ M53;
+    L10 = M53 ^ L4;
+    L11 = M60 ^ L2;
+    L12 = M48 ^ M51;
+    L13 = M50 ^ L0;
+    L14 = M52 ^ M61;
+    L15 = M55 ^ L1;
+    L16 = M56 ^ L0;
+    L17 = M57 ^ L1;
+    L18 = M58 ^ L8;
+    L19 = M63 ^ L4;
+    L20 = L0 ^ L1;
+    L21 = L1 ^ L7;
+    L22 = L3 ^ L12;
+    L23 = L18 ^ L2;
+    L24 = L15 ^ L9;
+    L25 = L6 ^ L10;
+    L26 = L7 ^ L9;
+    L27 = L8 ^ L10;
+    L28 = L11 ^ L14;
+    L29 = L11 ^ L17;
+
+    q[7] = L6 ^ L24;
+    q[6] = ~(L16 ^ L26);
+    q[5] = ~(L19 ^ L28);
+    q[4] = L6 ^ L21;
+    q[3] = L20 ^ L22;
+    q[2] = L25 ^ L29;
+    q[1] = ~(L13 ^ L27);
+    q[0] = ~(L6 ^ L23);
+}
+
+static void
+ble_hw_aes_bs_shift_rows(ble_hw_aes_bs_t st)
+{
+    uint64_t tmp[8];
+
+    /* Row 1 is rotated left by one byte */
+    memcpy(tmp, st[1], sizeof(tmp));
+    memcpy(st[1], st[5], sizeof(tmp));
+    memcpy(st[5], st[9], sizeof(tmp));
+    memcpy(st[9], st[13], sizeof(tmp));
+    memcpy(st[13], tmp, sizeof(tmp));
+
+    /* Row 2 by two bytes */
+    memcpy(tmp, st[2], sizeof(tmp));
+    memcpy(st[2], st[10], sizeof(tmp));
+    memcpy(st[10], tmp, sizeof(tmp));
+    memcpy(tmp, st[6], sizeof(tmp));
+    memcpy(st[6], st[14], sizeof(tmp));
+    memcpy(st[14], tmp, sizeof(tmp));
+
+    /* Row 3 by three bytes, i.e. right by one */
+    memcpy(tmp, st[15], sizeof(tmp));
+    memcpy(st[15], st[11], sizeof(tmp));
+    memcpy(st[11], st[7], sizeof(tmp));
+    memcpy(st[7], st[3], sizeof(tmp));
+    memcpy(st[3], tmp, sizeof(tmp));
+}
+
+static void
+ble_hw_aes_bs_mix_columns(ble_hw_aes_bs_t st)
+{
+    uint64_t a[4][8];
+    uint64_t t[8];
+    int col;
+    int row;
+    int b;
+
+    for (col = 0; col < 4; col++) {
+        memcpy(a, st[col * 4], sizeof(a));
+
+        for (row = 0; row < 4; row++) {
+            /* t = a[row] ^ a[row + 1], multiplied by x */
+            for (b = 0; b < 8; b++) {
+                t[b] = a[row][b] ^ a[(row + 1) % 4][b];
+            }
+            st[col * 4 + row][7] = t[6];
+            st[col * 4 + row][6] = t[5];
+            st[col * 4 + row][5] = t[4];
+            st[col * 4 + row][4] = t[3] ^ t[7];
+            st[col * 4 + row][3] = t[2] ^ t[7];
+            st[col * 4 + row][2] = t[1];
+            st[col * 4 + row][1] = t[0] ^ t[7];
+            st[col * 4 + row][0] = t[7];
+
+            for (b = 0; b < 8; b++) {
+                st[col * 4 + row][b] ^= a[(row + 1) % 4][b] ^
+                                        a[(row + 2) % 4][b] ^
+                                        a[(row + 3) % 4][b];
+            }
+        }
+    }
+}
+
+static void
+ble_hw_aes_bs_add_round_key(ble_hw_aes_bs_t st, ble_hw_aes_bs_t rk)
+{
+    int i;
+    int b;
+
+    for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+        for (b = 0; b < 8; b++) {
+            st[i][b] ^= rk[i][b];
+        }
+    }
+}
+
+/* Replaces round key with the key of the next round */
+static void
+ble_hw_aes_bs_next_round_key(ble_hw_aes_bs_t rk, uint8_t rcon)
+{
+    uint64_t t[4][8];
+    int i;
+    int b;
+
+    /* SubWord(RotWord(w)) of the last word */
+    for (i = 0; i < 4; i++) {
+        memcpy(t[i], rk[12 + (i + 1) % 4], sizeof(t[0]));
+        ble_hw_aes_bs_sbox(t[i]);
+    }
+
+    for (b = 0; b < 8; b++) {
+        if (rcon & (1 << b)) {
+            t[0][b] = ~t[0][b];
+        }
+    }
+
+    for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+        for (b = 0; b < 8; b++) {
+            rk[i][b] ^= (i < 4) ? t[i][b] : rk[i - 4][b];
+        }
+    }
+}
+
+/*
+ * Transposes 8x8 bit matrix with rows in bytes, i.e. bit c of byte r becomes
+ * bit r of byte c.
+ */
+static uint64_t
+ble_hw_aes_bs_transpose8(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+    x ^= t ^ (t << 28);
+
+    return x;
+}
+
+static void
+ble_hw_aes_bs_encrypt(const uint8_t *plain_text, const uint8_t * const *keys,
+                      uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE], int num)
+{
+    static const uint8_t rcon[10] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+    };
+    uint64_t (*rk)[8] = g_ble_hw_aes_bs_rk;
+    uint64_t (*st)[8] = g_ble_hw_aes_bs_st;
+    os_sr_t sr;
+    uint64_t x;
+    int round;
+    int lane;
+    int i;
+    int b;
+
+    OS_ENTER_CRITICAL(sr);
+
+    /* The plain text is the same in every lane */
+    for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+        for (b = 0; b < 8; b++) {
+            st[i][b] = (plain_text[i] & (1 << b)) ? UINT64_MAX : 0;
+        }
+    }
+
+    /* Keys are transposed into bit planes 8 lanes at a time; unused lanes
+     * get an all-zero key.
+     */
+    memset(rk, 0, sizeof(g_ble_hw_aes_bs_rk));
+    for (lane = 0; lane < num; lane += 8) {
+        for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+            x = 0;
+            for (b = 0; (b < 8) && (lane + b < num); b++) {
+                x |= (uint64_t)keys[lane + b][i] << (b * 8);
+            }
+            x = ble_hw_aes_bs_transpose8(x);
+            for (b = 0; b < 8; b++) {
+                rk[i][b] |= ((x >> (b * 8)) & 0xff) << lane;
+            }
+        }
+    }
+
+    ble_hw_aes_bs_add_round_key(st, rk);
+
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+            ble_hw_aes_bs_sbox(st[i]);
+        }
+        ble_hw_aes_bs_shift_rows(st);
+        if (round < 9) {
+            ble_hw_aes_bs_mix_columns(st);
+        }
+        ble_hw_aes_bs_next_round_key(rk, rcon[round]);
+        ble_hw_aes_bs_add_round_key(st, rk);
+    }
+
+    for (lane = 0; lane < num; lane += 8) {
+        for (i = 0; i < BLE_ENC_BLOCK_SIZE; i++) {
+            x = 0;
+            for (b = 0; b < 8; b++) {
+                x |= ((st[i][b] >> lane) & 0xff) << (b * 8);
+            }
+            x = ble_hw_aes_bs_transpose8(x);
+            for (b = 0; (b < 8) && (lane + b < num); b++) {
+                cipher_text[lane + b][i] = x >> (b * 8);
+            }
+        }
+    }
+
+    OS_EXIT_CRITICAL(sr);
+}
+
+#if BLE_HW_AES_NI
+#define BLE_HW_AES_NI_TARGET    __attribute__((target("aes,sse2")))
+
+static BLE_HW_AES_NI_TARGET inline __m128i
+ble_hw_aes_ni_next_round_key(__m128i key, __m128i assist)
+{
+    assist = _mm_shuffle_epi32(assist, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+
+    return _mm_xor_si128(key, assist);
+}
+
+/* rcon has to be an immediate value, hence a macro */
+#define BLE_HW_AES_NI_NEXT_ROUND_KEY(rcon) \
+    key = ble_hw_aes_ni_next_round_key(key, \
+                                       _mm_aeskeygenassist_si128(key, rcon))
+
+#define BLE_HW_AES_NI_ROUND(rcon)               \
+    do {                                        \
+        BLE_HW_AES_NI_NEXT_ROUND_KEY(rcon);     \
+        st = _mm_aesenc_si128(st, key);         \
+    } while (0)
+
+static BLE_HW_AES_NI_TARGET void
+ble_hw_aes_ni_encrypt(const uint8_t *plain_text, const uint8_t * const *keys,
+                      uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE], int num)
+{
+    __m128i pt;
+    __m128i key;
+    __m128i st;
+    int i;
+
+    pt = _mm_loadu_si128((const __m128i *)plain_text);
+
+    /* Keys are expanded on the fly; the blocks are independent so the CPU
+     * can overlap the work of consecutive iterations.
+     */
+    for (i = 0; i < num; i++) {
+        key = _mm_loadu_si128((const __m128i *)keys[i]);
+        st = _mm_xor_si128(pt, key);
+
+        BLE_HW_AES_NI_ROUND(0x01);
+        BLE_HW_AES_NI_ROUND(0x02);
+        BLE_HW_AES_NI_ROUND(0x04);
+        BLE_HW_AES_NI_ROUND(0x08);
+        BLE_HW_AES_NI_ROUND(0x10);
+        BLE_HW_AES_NI_ROUND(0x20);
+        BLE_HW_AES_NI_ROUND(0x40);
+        BLE_HW_AES_NI_ROUND(0x80);
+        BLE_HW_AES_NI_ROUND(0x1b);
+        BLE_HW_AES_NI_NEXT_ROUND_KEY(0x36);
+        st = _mm_aesenclast_si128(st, key);
+
+        _mm_storeu_si128((__m128i *)cipher_text[i], st);
+    }
+}
+
+static int
+ble_hw_aes_ni_supported(void)
+{
+    static int supported = -1;
+
+    if (supported < 0) {
+        supported = !!__builtin_cpu_supports("aes");
+    }
+
+    return supported;
+}
+#endif
+
+static void
+ble_hw_aes_bs_encrypt_batch(const uint8_t *plain_text,
+                            const uint8_t * const *keys,
+                            uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE],
+                            int num)
+{
+    int chunk;
+
+    while (num > 0) {
+        chunk = num < BLE_HW_AES_BS_LANES ? num : BLE_HW_AES_BS_LANES;
+
+        ble_hw_aes_bs_encrypt(plain_text, keys, cipher_text, chunk);
+
+        keys += chunk;
+        cipher_text += chunk;
+        num -= chunk;
+    }
+}
+
+int
+ble_hw_encrypt_block_batch(const uint8_t *plain_text,
+                           const uint8_t * const *keys,
+                           uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE],
+                           int num)
+{
+#if BLE_HW_AES_NI
+    if (ble_hw_aes_ni_supported()) {
+        ble_hw_aes_ni_encrypt(plain_text, keys, cipher_text, num);
+        return 0;
+    }
+#endif
+
+    ble_hw_aes_bs_encrypt_batch(plain_text, keys, cipher_text, num);
+
+    return 0;
+}
+
+#if MYNEWT_VAL(SELFTEST)
+#define BLE_HW_AES_TEST_MAX_BATCH   (BLE_HW_AES_BS_LANES + 1)
+
+typedef void (*ble_hw_aes_test_fn)(const uint8_t *plain_text,
+                                   const uint8_t * const *keys,
+                                   uint8_t (*cipher_text)[BLE_ENC_BLOCK_SIZE],
+                                   int num);
+
+/* FIPS-197 appendix C.1 */
+static const uint8_t g_ble_hw_aes_test_key[BLE_ENC_BLOCK_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t g_ble_hw_aes_test_pt[BLE_ENC_BLOCK_SIZE] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const uint8_t g_ble_hw_aes_test_ct[BLE_ENC_BLOCK_SIZE] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+static uint8_t g_ble_hw_aes_test_keys[BLE_HW_AES_TEST_MAX_BATCH]
+                                     [BLE_ENC_BLOCK_SIZE];
+static const uint8_t *g_ble_hw_aes_test_key_ptrs[BLE_HW_AES_TEST_MAX_BATCH];
+static uint8_t g_ble_hw_aes_test_out[BLE_HW_AES_TEST_MAX_BATCH]
+                                    [BLE_ENC_BLOCK_SIZE];
+
+/**
+ * Encrypts the C.1 plain text with a batch of num keys. The first key is the
+ * C.1 key, and each of the others differs from it; their lanes are checked
+ * against a single block encryption with the same key.
+ */
+static int
+ble_hw_aes_test_batch(ble_hw_aes_test_fn fn, int num)
+{
+    uint8_t single[1][BLE_ENC_BLOCK_SIZE];
+    int i;
+
+    for (i = 0; i < num; i++) {
+        memcpy(g_ble_hw_aes_test_keys[i], g_ble_hw_aes_test_key,
+               BLE_ENC_BLOCK_SIZE);
+        g_ble_hw_aes_test_keys[i][i % BLE_ENC_BLOCK_SIZE] ^= i;
+        g_ble_hw_aes_test_key_ptrs[i] = g_ble_hw_aes_test_keys[i];
+    }
+
+    fn(g_ble_hw_aes_test_pt, g_ble_hw_aes_test_key_ptrs,
+       g_ble_hw_aes_test_out, num);
+
+    if (memcmp(g_ble_hw_aes_test_out[0], g_ble_hw_aes_test_ct,
+               BLE_ENC_BLOCK_SIZE)) {
+        return -1;
+    }
+
+    for (i = 1; i < num; i++) {
+        fn(g_ble_hw_aes_test_pt, &g_ble_hw_aes_test_key_ptrs[i], single, 1);
+        if (memcmp(g_ble_hw_aes_test_out[i], single[0], BLE_ENC_BLOCK_SIZE)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+ble_hw_aes_test_impl(ble_hw_aes_test_fn fn)
+{
+    static const int batch_sizes[] = { 1, 8, BLE_HW_AES_BS_LANES,
+                                       BLE_HW_AES_BS_LANES + 1 };
+    int i;
+
+    for (i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+        if (ble_hw_aes_test_batch(fn, batch_sizes[i])) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int
+ble_hw_aes_selftest(void)
+{
+#if BLE_HW_AES_NI
+    static uint8_t bs[BLE_HW_AES_TEST_MAX_BATCH][BLE_ENC_BLOCK_SIZE];
+#endif
+    int rc;
+
+    rc = ble_hw_aes_test_impl(ble_hw_aes_bs_encrypt_batch);
+    if (rc) {
+        return rc;
+    }
+
+#if BLE_HW_AES_NI
+    if (ble_hw_aes_ni_supported()) {
+        rc = ble_hw_aes_test_impl(ble_hw_aes_ni_encrypt);
+        if (rc) {
+            return rc;
+        }
+
+        /* Both implementations agree on every lane of the last batch */
+        ble_hw_aes_bs_encrypt_batch(g_ble_hw_aes_test_pt,
+                                    g_ble_hw_aes_test_key_ptrs, bs,
+                                    BLE_HW_AES_TEST_MAX_BATCH);
+        if (memcmp(bs, g_ble_hw_aes_test_out, sizeof(bs))) {
+            return -1;
+        }
+    }
+#endif
+
+    return 0;
+}
+#endif
@@ -2400,6 +2400,54 @@ int ble_gap_encryption_initiate(uint16_t conn_handle, uint8_t key_size,
  */
 int ble_gap_conn_rssi(uint16_t conn_handle, int8_t *out_rssi);
 
+/** Host transmit statistics for a single connection. */
+struct ble_gap_conn_tx_stats {
+    /** Bytes currently waiting for controller buffers. */
+    uint32_t queued_bytes;
+
+    /** Largest number of bytes that have been waiting at once. */
+    uint32_t queued_bytes_max;
+
+    /** Total bytes handed to the controller. */
+    uint32_t tx_bytes;
+
+    /** Average time a queued byte waited for a controller buffer (ms). */
+    uint32_t wait_avg_ms;
+
+    /** Longest time a packet spent at the head of the queue (ms). */
+    uint32_t wait_max_ms;
+};
+
+/**
+ * Sets the transmit weight of a connection.  When several connections have
+ * data waiting for controller buffers, each is given a share of the
+ * available buffers proportional to its weight.  New connections have a
+ * weight of 1.
+ *
+ * @param conn_handle           The connection to configure.
+ * @param weight                The weight to assign; must be nonzero.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOTCONN if there is no connection
+ *                                  with the specified handle;
+ *                              BLE_HS_EINVAL if the weight is 0.
+ */
+int ble_gap_conn_set_tx_weight(uint16_t conn_handle, uint8_t weight);
+
+/**
+ * Retrieves host transmit statistics for a connection.  Statistics
+ * accumulate for the lifetime of the connection.
+ *
+ * @param conn_handle           The connection to query.
+ * @param out_stats             On success, the statistics are written here.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOTCONN if there is no connection
+ *                                  with the specified handle.
+ */
+int ble_gap_conn_tx_stats(uint16_t conn_handle,
+                          struct ble_gap_conn_tx_stats *out_stats);
+
 /**
  * Unpairs a device with the specified address. The keys related to that peer
  * device are removed from storage and peer address is removed from the resolve
@@ -690,7 +690,9 @@ int ble_gatts_notify_custom(uint16_t conn_handle, uint16_t att_handle,
  * Function tries to send minimum amount of PDUs. If PDU can't contain all
  * of the characteristic values, multiple notifications are sent. If only one
  * handle-value pair fits into PDU, or only one characteristic remains in the
- * list, regular characteristic notification is sent.
+ * list, regular characteristic notification is sent. If the peer has not
+ * declared support for multiple handle value notifications, a regular
+ * notification is sent for each characteristic.
  *
  * If value of characteristic is not specified it will be read from local
  * GATT database.
@@ -728,7 +730,9 @@ int ble_gatts_notify(uint16_t conn_handle, uint16_t chr_val_handle);
  * send minimum amount of PDUs. If PDU can't contain all of the
  * characteristic values, multiple notifications are sent. If only one
  * handle-value pair fits into PDU, or only one characteristic remains in the
- * list, regular characteristic notification is sent.
+ * list, regular characteristic notification is sent. If the peer has not
+ * declared support for multiple handle value notifications, a regular
+ * notification is sent for each characteristic.
  *
  * @param conn_handle           The connection over which to execute the
  *                                  procedure.
@@ -828,6 +832,19 @@ struct ble_gatt_chr_def {
      * attribute handle.
      */
     uint16_t *val_handle;
+
+    /**
+     * Optional constant value.  If non-NULL, reads of this characteristic
+     * (Read, Read Blob and Read Multiple) are served directly from this
+     * buffer and access_cb is not executed for them; writes are still
+     * passed to access_cb.  The buffer must remain valid for as long as the
+     * service is registered.  access_cb may be NULL if the characteristic
+     * is not writable.
+     */
+    const void *static_val;
+
+    /** Length of static_val, in bytes. */
+    uint16_t static_val_len;
 };
 
 /** Represents the definition of a GATT service. */
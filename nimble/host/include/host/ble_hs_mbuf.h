@@ -71,6 +71,110 @@ struct os_mbuf *ble_hs_mbuf_from_flat(const void *buf, uint16_t len);
 int ble_hs_mbuf_to_flat(const struct os_mbuf *om, void *flat, uint16_t max_len,
                         uint16_t *out_copy_len);
 
+/**
+ * A read position within an mbuf chain.  Reading through a cursor continues
+ * where the previous read stopped, instead of walking the chain from its
+ * head the way os_mbuf_copydata() does for every call.  The chain must not
+ * be modified while a cursor refers to it.
+ */
+struct ble_hs_mbuf_cursor {
+    /** The mbuf containing the next byte; NULL at the end of the chain. */
+    const struct os_mbuf *om;
+
+    /** The offset of the next byte within om. */
+    uint16_t off;
+};
+
+/** One contiguous piece of an mbuf chain. */
+struct ble_hs_mbuf_iov {
+    const uint8_t *base;
+    uint16_t len;
+};
+
+/**
+ * Positions a cursor at the specified offset of an mbuf chain.  The chain
+ * does not need a packet header.
+ *
+ * @param cur           The cursor to initialize.
+ * @param om            The mbuf chain to read.
+ * @param off           The offset within the chain to start reading from.
+ *
+ * @return              0 on success;
+ *                      BLE_HS_EBADDATA if the chain is shorter than off.
+ */
+int ble_hs_mbuf_cursor_init(struct ble_hs_mbuf_cursor *cur,
+                            const struct os_mbuf *om, uint16_t off);
+
+/**
+ * Copies data out of an mbuf chain and advances the cursor past it.
+ *
+ * @param cur           The cursor to read from.
+ * @param dst           The destination buffer.
+ * @param len           The number of bytes to read.
+ *
+ * @return              0 on success;
+ *                      BLE_HS_EBADDATA if fewer than len bytes remain; the
+ *                          cursor is left unchanged.
+ */
+int ble_hs_mbuf_cursor_read(struct ble_hs_mbuf_cursor *cur, void *dst,
+                            uint16_t len);
+
+/**
+ * Advances a cursor without copying any data.
+ *
+ * @param cur           The cursor to advance.
+ * @param len           The number of bytes to skip.
+ *
+ * @return              0 on success;
+ *                      BLE_HS_EBADDATA if fewer than len bytes remain; the
+ *                          cursor is left unchanged.
+ */
+int ble_hs_mbuf_cursor_skip(struct ble_hs_mbuf_cursor *cur, uint16_t len);
+
+/**
+ * Retrieves a pointer to the data at a cursor without copying it.  This only
+ * succeeds if the requested bytes are contiguous, i.e., they do not span an
+ * mbuf boundary.  The cursor is not advanced.
+ *
+ * @param cur           The cursor to read from.
+ * @param len           The number of bytes the caller needs.
+ *
+ * @return              A pointer to len bytes of data on success;
+ *                      NULL if the data is not contiguous or is not there.
+ */
+const void *ble_hs_mbuf_cursor_peek(const struct ble_hs_mbuf_cursor *cur,
+                                    uint16_t len);
+
+/**
+ * Indicates whether a cursor has reached the end of its mbuf chain.
+ *
+ * @param cur           The cursor to check.
+ *
+ * @return              1 if no data remains; 0 otherwise.
+ */
+int ble_hs_mbuf_cursor_at_end(const struct ble_hs_mbuf_cursor *cur);
+
+/**
+ * Describes a range of an mbuf chain as a list of contiguous pieces, e.g.,
+ * for handing a packet to code that processes scattered data without
+ * flattening it first.  No data is copied; the pieces point into the chain.
+ *
+ * @param om            The mbuf chain to describe.
+ * @param off           The offset of the first byte of the range.
+ * @param len           The length of the range, in bytes.
+ * @param iov           The array to fill.
+ * @param num_iov       On input, the number of elements in iov.  On success,
+ *                          the number of elements filled in.
+ *
+ * @return              0 on success;
+ *                      BLE_HS_EBADDATA if the range extends past the end of
+ *                          the chain;
+ *                      BLE_HS_ENOMEM if the range spans more than *num_iov
+ *                          pieces.
+ */
+int ble_hs_mbuf_to_iov(const struct os_mbuf *om, uint16_t off, uint16_t len,
+                       struct ble_hs_mbuf_iov *iov, int *num_iov);
+
 #ifdef __cplusplus
 }
 #endif
@@ -444,10 +444,13 @@ struct ble_l2cap_event {
 
             /**
              * The status of the send attempt which was stalled due to
-             * lack of credits; This can be non zero only if there
-             * is an issue with memory allocation for following SDU fragments.
-             * In such a case last SDU has been partially sent to peer device
-             * and it is up to application to decide how to handle it.
+             * lack of credits; This can be non zero only if an SDU accepted
+             * by an earlier ble_l2cap_send() call could not be sent, e.g.
+             * due to an issue with memory allocation for following SDU
+             * fragments.  In such a case that SDU has been dropped, possibly
+             * after being partially sent to peer device, and it is up to
+             * application to decide how to handle it.  Transmission carries
+             * on with the next queued SDU.
              */
             int status;
         } tx_unstalled;
@@ -602,14 +605,40 @@ int ble_l2cap_disconnect(struct ble_l2cap_chan *chan);
  * @param chan          Pointer to the L2CAP channel structure representing the channel to send the SDU on.
  * @param sdu_tx        Pointer to the os_mbuf structure containing the SDU (Service Data Unit) to send.
  *
+ * Up to MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_LEN) SDUs can be queued on a channel. Once an SDU
+ * is sent, segmentation continues straight into the next queued one while credits remain.
+ * Failures of SDUs queued by earlier calls are not returned; they are reported with
+ * 'BLE_L2CAP_EVENT_COC_TX_UNSTALLED'.
+ *
  * @return              0 on success;
- *                      BLE_HS_ESTALLED: if there was not enough credits available to send whole SDU.
+ *                      BLE_HS_ESTALLED: if the SDU was queued but the queue is now full or above
+ *                      MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER) bytes because there was not
+ *                      enough credits available to send the queued data.
  *                      The application needs to wait for the event 'BLE_L2CAP_EVENT_COC_TX_UNSTALLED'
  *                      before being able to transmit more data;
+ *                      BLE_HS_EBUSY: if the queue is full; the SDU is not consumed;
  *                      Another non-zero value on failure.
  */
 int ble_l2cap_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_tx);
 
+/**
+ * @brief Get the amount of data queued for transmission on an L2CAP channel.
+ *
+ * This function reports the SDUs accepted by ble_l2cap_send() that have not been fully sent yet,
+ * e.g., so that the application can keep just enough data queued to fill every connection event.
+ *
+ * @param chan          Pointer to the L2CAP channel structure to query.
+ * @param out_sdus      On success, the number of queued SDUs, including a partially sent one, is
+ *                      written here. Pass NULL if this value is not needed.
+ * @param out_bytes     On success, the number of SDU bytes not sent yet is written here. Pass NULL
+ *                      if this value is not needed.
+ *
+ * @return              0 on success;
+ *                      A non-zero value on failure.
+ */
+int ble_l2cap_get_tx_queued(struct ble_l2cap_chan *chan, uint16_t *out_sdus,
+                            uint32_t *out_bytes);
+
 /**
  * @brief Check if the L2CAP channel is ready to receive an SDU.
  *
@@ -29,6 +29,7 @@
 
 #include <inttypes.h>
 #include "nimble/ble.h"
+#include "host/ble_uuid.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,9 @@ extern "C" {
 /** Object type: Client Characteristic Configuration Descriptor. */
 #define BLE_STORE_OBJ_TYPE_CCCD         3
 
+/** Object type: GATT client attribute cache entry. */
+#define BLE_STORE_OBJ_TYPE_GATT_CACHE   4
+
 /** @} */
 
 /**
@@ -115,6 +119,14 @@ struct ble_store_value_sec {
     unsigned authenticated:1;
     /** Flag indicating Secure Connections support. */
     uint8_t sc:1;
+
+    /** Client Supported Features the peer enabled on the GATT server. */
+    uint8_t cl_sup_feat;
+    /**
+     * Flag indicating the peer has not seen the current GATT database
+     * (Robust Caching change-unaware state).
+     */
+    uint8_t change_unaware:1;
 };
 
 /**
@@ -154,6 +166,104 @@ struct ble_store_value_cccd {
     unsigned value_changed:1;
 };
 
+/**
+ * @defgroup bt_store_gatt_cache_types GATT Cache Entry Types
+ * @ingroup bt_host
+ * @{
+ */
+/** Database Hash of the peer; one per peer. */
+#define BLE_STORE_GATT_CACHE_TYPE_HASH  1
+
+/** Primary service. */
+#define BLE_STORE_GATT_CACHE_TYPE_SVC   2
+
+/** Characteristic. */
+#define BLE_STORE_GATT_CACHE_TYPE_CHR   3
+
+/** Characteristic descriptor. */
+#define BLE_STORE_GATT_CACHE_TYPE_DSC   4
+
+/** @} */
+
+/**
+ * Set on a GATT cache entry once all of its children have been stored: the
+ * primary services for a hash entry, the characteristics for a service entry
+ * or the descriptors for a characteristic entry.
+ */
+#define BLE_STORE_GATT_CACHE_F_COMPLETE 0x01
+
+/**
+ * Used as a key for lookups of GATT client cache entries.  This struct
+ * corresponds to the BLE_STORE_OBJ_TYPE_GATT_CACHE store object type.
+ * Entries matching a key that names both a peer and a type are retrieved in
+ * ascending handle order.
+ */
+struct ble_store_key_gatt_cache {
+    /**
+     * Key by peer identity address;
+     * peer_addr=BLE_ADDR_ANY means don't key off peer.
+     */
+    ble_addr_t peer_addr;
+
+    /**
+     * Key by entry type (BLE_STORE_GATT_CACHE_TYPE_[...]);
+     * type=0 means don't key off type.
+     */
+    uint8_t type;
+
+    /**
+     * Key by entry handle range (inclusive);
+     * end_handle=0 means don't key off handle.
+     */
+    uint16_t start_handle;
+    uint16_t end_handle;
+
+    /** Number of results to skip; 0 means retrieve the first match. */
+    uint16_t idx;
+};
+
+/**
+ * Represents a stored GATT client cache entry.  This struct corresponds to
+ * the BLE_STORE_OBJ_TYPE_GATT_CACHE store object type.  An entry is
+ * identified by its peer address, type and handle.
+ */
+struct ble_store_value_gatt_cache {
+    /** The peer identity address the entry belongs to. */
+    ble_addr_t peer_addr;
+
+    /** Entry type; one of the BLE_STORE_GATT_CACHE_TYPE_[...] codes. */
+    uint8_t type;
+
+    /** BLE_STORE_GATT_CACHE_F_[...] flags. */
+    uint8_t flags;
+
+    /** Characteristic properties (characteristic entries only). */
+    uint8_t properties;
+
+    /**
+     * Service start handle, characteristic definition handle or descriptor
+     * handle; 0 for the hash entry.
+     */
+    uint16_t handle;
+
+    /**
+     * Service end handle, or the last handle searched for descriptors of a
+     * characteristic.
+     */
+    uint16_t end_handle;
+
+    /** Characteristic value handle (characteristic entries only). */
+    uint16_t val_handle;
+
+    union {
+        /** Attribute UUID (service, characteristic and descriptor entries). */
+        ble_uuid_any_t uuid;
+
+        /** Database Hash (hash entry). */
+        uint8_t db_hash[16];
+    };
+};
+
 /**
  * Used as a key for store lookups.  This union must be accompanied by an
  * object type code to indicate which field is valid.
@@ -163,6 +273,8 @@ union ble_store_key {
     struct ble_store_key_sec sec;
     /** Key for Client Characteristic Configuration Descriptor store lookups. */
     struct ble_store_key_cccd cccd;
+    /** Key for GATT client cache store lookups. */
+    struct ble_store_key_gatt_cache gatt_cache;
 };
 
 /**
@@ -174,6 +286,8 @@ union ble_store_value {
     struct ble_store_value_sec sec;
     /** Stored Client Characteristic Configuration Descriptor. */
     struct ble_store_value_cccd cccd;
+    /** Stored GATT client cache entry. */
+    struct ble_store_value_gatt_cache gatt_cache;
 };
 
 /** Represents an event associated with the BLE Store. */
@@ -556,6 +670,45 @@ int ble_store_write_cccd(const struct ble_store_value_cccd *value);
  */
 int ble_store_delete_cccd(const struct ble_store_key_cccd *key);
 
+/**
+ * @brief Reads a GATT client cache entry from a storage.
+ *
+ * @param key                   A pointer to a `ble_store_key_gatt_cache`
+ *                                  structure identifying the entry to read.
+ * @param out_value             A pointer to a `ble_store_value_gatt_cache`
+ *                                  structure to store the entry read from a
+ *                                  storage.
+ *
+ * @return                      0 if the entry was successfully read;
+ *                              BLE_HS_ENOENT if no matching entry was found;
+ *                              Non-zero on error.
+ */
+int ble_store_read_gatt_cache(const struct ble_store_key_gatt_cache *key,
+                              struct ble_store_value_gatt_cache *out_value);
+
+/**
+ * @brief Writes a GATT client cache entry to a storage.
+ *
+ * @param value                 A pointer to a `ble_store_value_gatt_cache`
+ *                                  structure representing the entry to write.
+ *
+ * @return                      0 if the entry was successfully written;
+ *                              Non-zero on error.
+ */
+int ble_store_write_gatt_cache(const struct ble_store_value_gatt_cache *value);
+
+/**
+ * @brief Deletes a GATT client cache entry from a storage.
+ *
+ * @param key                   A pointer to a `ble_store_key_gatt_cache`
+ *                                  structure identifying the entry to delete.
+ *
+ * @return                      0 if the entry was successfully deleted;
+ *                              BLE_HS_ENOENT if no matching entry was found;
+ *                              Non-zero on error.
+ */
+int ble_store_delete_gatt_cache(const struct ble_store_key_gatt_cache *key);
+
 
 /**
  * @brief Generates a storage key for a security material entry from its value.
@@ -587,6 +740,23 @@ void ble_store_key_from_value_sec(struct ble_store_key_sec *out_key,
 void ble_store_key_from_value_cccd(struct ble_store_key_cccd *out_key,
                                    const struct ble_store_value_cccd *value);
 
+/**
+ * @brief Generates a storage key for a GATT client cache entry from its value.
+ *
+ * The generated key matches only the entry with the same peer, type and
+ * handle.
+ *
+ * @param out_key               A pointer to a `ble_store_key_gatt_cache`
+ *                                  structure where the generated key will be
+ *                                  stored.
+ * @param value                 A pointer to a `ble_store_value_gatt_cache`
+ *                                  structure containing the entry from which
+ *                                  the key will be generated.
+ */
+void ble_store_key_from_value_gatt_cache(
+    struct ble_store_key_gatt_cache *out_key,
+    const struct ble_store_value_gatt_cache *value);
+
 
 /**
  * @brief Generates a storage key from a value based on the object type.
@@ -102,11 +102,13 @@ static bool service_registered;
 static int gatt_recv_proxy(uint16_t conn_handle, uint16_t attr_handle,
 			 struct ble_gatt_access_ctxt *ctxt, void *arg)
 {
-	const uint8_t *data = ctxt->om->om_data;
-	uint16_t len = ctxt->om->om_len;
 	struct bt_mesh_proxy_client *client = find_client(conn_handle);
+	uint8_t data[1];
 
-	if (len < 1) {
+	/* The write may span several mbufs; only the header is looked at
+	 * here.
+	 */
+	if (os_mbuf_copydata(ctxt->om, 0, sizeof(data), data)) {
 		BT_WARN("Too small Proxy PDU");
 		return -EINVAL;
 	}
@@ -116,21 +118,20 @@ static int gatt_recv_proxy(uint16_t conn_handle, uint16_t attr_handle,
 		return -EINVAL;
 	}
 
-	return bt_mesh_proxy_msg_recv(client->cli, data, len);
+	return bt_mesh_proxy_msg_recv(client->cli, ctxt->om);
 }
 
 static int gatt_recv_prov(uint16_t conn_handle, uint16_t attr_handle,
 		     struct ble_gatt_access_ctxt *ctxt, void *arg)
 {
-	const uint8_t *data = ctxt->om->om_data;
-	uint16_t len = ctxt->om->om_len;
+	uint8_t data[1];
 
 	if (conn_handle != cli->conn_handle) {
 		BT_WARN("conn_handle != cli->conn_handle");
 		return -ENOTCONN;
 	}
 
-	if (len < 1) {
+	if (os_mbuf_copydata(ctxt->om, 0, sizeof(data), data)) {
 		BT_WARN("Too small Proxy PDU");
 		return -EINVAL;
 	}
@@ -140,7 +141,7 @@ static int gatt_recv_prov(uint16_t conn_handle, uint16_t attr_handle,
 		return -EINVAL;
 	}
 
-	return bt_mesh_proxy_msg_recv(cli, data, len);
+	return bt_mesh_proxy_msg_recv(cli, ctxt->om);
 }
 
 void gatt_connected_pb_gatt(uint16_t conn_handle, uint8_t err)
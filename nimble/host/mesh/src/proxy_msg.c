@@ -68,10 +68,29 @@ static void proxy_sar_timeout(struct ble_npl_event *work)
 	}
 }
 
+static void proxy_msg_add(struct bt_mesh_proxy_role *role,
+			  struct ble_hs_mbuf_cursor *cur, uint16_t len)
+{
+	/* Copy straight from the received chain into the SAR buffer; the
+	 * caller has checked that it fits.
+	 */
+	(void)ble_hs_mbuf_cursor_read(cur, net_buf_simple_add(role->buf, len),
+				      len);
+}
+
 int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
-			       const void *buf, uint16_t len)
+			   const struct os_mbuf *om)
 {
-	const uint8_t *data = buf;
+	struct ble_hs_mbuf_cursor cur;
+	uint8_t data[1];
+	uint16_t len;
+
+	len = OS_MBUF_PKTLEN(om);
+
+	ble_hs_mbuf_cursor_init(&cur, om, 0);
+	if (ble_hs_mbuf_cursor_read(&cur, data, sizeof(data))) {
+		return -EINVAL;
+	}
 
 	if (net_buf_simple_tailroom(role->buf) < len - 1) {
 		BT_WARN("Proxy role buffer overflow");
@@ -86,7 +105,7 @@ int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
 		}
 
 		role->msg_type = PDU_TYPE(data);
-		net_buf_simple_add_mem(role->buf, data + 1, len - 1);
+		proxy_msg_add(role, &cur, len - 1);
 		role->cb.recv(role);
 		net_buf_simple_reset(role->buf);
 		break;
@@ -99,7 +118,7 @@ int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
 
 		k_work_reschedule(&role->sar_timer, PROXY_SAR_TIMEOUT);
 		role->msg_type = PDU_TYPE(data);
-		net_buf_simple_add_mem(role->buf, data + 1, len - 1);
+		proxy_msg_add(role, &cur, len - 1);
 		break;
 
 	case SAR_CONT:
@@ -114,7 +133,7 @@ int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
 		}
 
 		k_work_reschedule(&role->sar_timer, PROXY_SAR_TIMEOUT);
-		net_buf_simple_add_mem(role->buf, data + 1, len - 1);
+		proxy_msg_add(role, &cur, len - 1);
 		break;
 
 	case SAR_LAST:
@@ -132,7 +151,7 @@ int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
 		 * active SAR buffer.
 		 */
 		(void)k_work_cancel_delayable(&role->sar_timer);
-		net_buf_simple_add_mem(role->buf, data + 1, len - 1);
+		proxy_msg_add(role, &cur, len - 1);
 		role->cb.recv(role);
 		net_buf_simple_reset(role->buf);
 		break;
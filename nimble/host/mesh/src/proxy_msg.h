@@ -57,7 +57,7 @@ struct bt_mesh_proxy_client {
 };
 
 int bt_mesh_proxy_msg_recv(struct bt_mesh_proxy_role *role,
-	const void *buf, uint16_t len);
+	const struct os_mbuf *om);
 int bt_mesh_proxy_msg_send(struct bt_mesh_proxy_role *role, uint8_t type, struct os_mbuf *msg);
 void bt_mesh_proxy_role_cleanup(struct bt_mesh_proxy_role *role);
 struct bt_mesh_proxy_role *bt_mesh_proxy_role_setup(uint16_t conn_handle,
@@ -523,6 +523,52 @@ ble_att_send_outstanding_after_response(uint16_t conn_handle)
     ble_hs_unlock();
 }
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+/**
+ * Applies the Robust Caching rules to an incoming PDU.  Only PDUs addressed to
+ * the GATT server are subject to them; a client may always read the Database
+ * Hash by type, as that is how it resynchronizes.
+ *
+ * @return                      1 if the PDU may be processed; 0 otherwise.
+ */
+static int
+ble_att_rx_change_aware(uint16_t conn_handle, uint8_t op,
+                        const struct os_mbuf *om)
+{
+    uint8_t uuid16[2];
+
+    switch (op) {
+    case BLE_ATT_OP_READ_TYPE_REQ:
+        /* op(1) + start handle(2) + end handle(2) + uuid16(2) */
+        if (OS_MBUF_PKTLEN(om) == 7 &&
+            os_mbuf_copydata(om, 5, 2, uuid16) == 0 &&
+            get_le16(uuid16) == BLE_GATT_CHR_DB_HASH_UUID16) {
+
+            return 1;
+        }
+        /* Fall through. */
+    case BLE_ATT_OP_FIND_INFO_REQ:
+    case BLE_ATT_OP_FIND_TYPE_VALUE_REQ:
+    case BLE_ATT_OP_READ_REQ:
+    case BLE_ATT_OP_READ_BLOB_REQ:
+    case BLE_ATT_OP_READ_MULT_REQ:
+    case BLE_ATT_OP_READ_MULT_VAR_REQ:
+    case BLE_ATT_OP_READ_GROUP_TYPE_REQ:
+    case BLE_ATT_OP_WRITE_REQ:
+    case BLE_ATT_OP_PREP_WRITE_REQ:
+    case BLE_ATT_OP_EXEC_WRITE_REQ:
+        return ble_gatts_conn_change_aware(conn_handle, 1);
+
+    case BLE_ATT_OP_WRITE_CMD:
+    case BLE_ATT_OP_SIGNED_WRITE_CMD:
+        return ble_gatts_conn_change_aware(conn_handle, 0);
+
+    default:
+        return 1;
+    }
+}
+#endif
+
 static int
 ble_att_rx_extended(uint16_t conn_handle, uint16_t cid, struct os_mbuf **om)
 {
@@ -541,14 +587,29 @@ ble_att_rx_extended(uint16_t conn_handle, uint16_t cid, struct os_mbuf **om)
         ble_att_send_outstanding_after_response(conn_handle);
     }
 
+    ble_att_inc_rx_stat(op);
+
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    if (!ble_att_rx_change_aware(conn_handle, op, *om)) {
+        /* Commands (bit6 set) from a change-unaware client are silently
+         * ignored.
+         */
+        if (!(op & 0x40)) {
+            os_mbuf_adj(*om, OS_MBUF_PKTLEN(*om));
+            ble_att_svr_tx_error_rsp(conn_handle, cid, *om, op, 0,
+                                     BLE_ATT_ERR_DB_OUT_OF_SYNC);
+            *om = NULL;
+        }
+        return BLE_HS_EREJECT;
+    }
+#endif
+
     entry = ble_att_rx_dispatch_entry_find(op);
     if (entry == NULL) {
         ble_att_rx_handle_unknown_request(op, conn_handle, cid, om);
         return BLE_HS_ENOTSUP;
     }
 
-    ble_att_inc_rx_stat(op);
-
     /* Strip L2CAP ATT header from the front of the mbuf. */
     os_mbuf_adj(*om, 1);
 
@@ -582,13 +643,27 @@ ble_att_preferred_mtu(void)
     return ble_att_preferred_mtu_val;
 }
 
-int
-ble_att_set_preferred_mtu(uint16_t mtu)
+static int
+ble_att_set_preferred_mtu_conn(struct ble_hs_conn *conn, void *arg)
 {
     struct ble_l2cap_chan *chan;
-    struct ble_hs_conn *conn;
-    int i;
+    uint16_t mtu;
+
+    mtu = *(uint16_t *)arg;
 
+    chan = ble_hs_conn_chan_find_by_scid(conn, BLE_L2CAP_CID_ATT);
+    BLE_HS_DBG_ASSERT(chan != NULL);
+
+    if (!(chan->flags & BLE_L2CAP_CHAN_F_TXED_MTU)) {
+        chan->my_mtu = mtu;
+    }
+
+    return 0;
+}
+
+int
+ble_att_set_preferred_mtu(uint16_t mtu)
+{
     if (mtu < BLE_ATT_MTU_DFLT) {
         return BLE_HS_EINVAL;
     }
@@ -601,17 +676,7 @@ ble_att_set_preferred_mtu(uint16_t mtu)
     /* Set my_mtu for established connections that haven't exchanged. */
     ble_hs_lock();
 
-    i = 0;
-    while ((conn = ble_hs_conn_find_by_idx(i)) != NULL) {
-        chan = ble_hs_conn_chan_find_by_scid(conn, BLE_L2CAP_CID_ATT);
-        BLE_HS_DBG_ASSERT(chan != NULL);
-
-        if (!(chan->flags & BLE_L2CAP_CHAN_F_TXED_MTU)) {
-            chan->my_mtu = mtu;
-        }
-
-        i++;
-    }
+    ble_hs_conn_foreach(ble_att_set_preferred_mtu_conn, &mtu);
 
     ble_hs_unlock();
 
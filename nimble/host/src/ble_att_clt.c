@@ -178,53 +178,39 @@ ble_att_clt_tx_find_info(uint16_t conn_handle, uint16_t cid, uint16_t start_hand
 }
 
 static int
-ble_att_clt_parse_find_info_entry(struct os_mbuf **rxom, uint8_t rsp_format,
+ble_att_clt_parse_find_info_entry(struct ble_hs_mbuf_cursor *cur,
+                                  uint8_t rsp_format,
                                   struct ble_att_find_info_idata *idata)
 {
-    int entry_len;
+    uint8_t entry[2 + 16];
+    int uuid_len;
     int rc;
 
     switch (rsp_format) {
     case BLE_ATT_FIND_INFO_RSP_FORMAT_16BIT:
-        entry_len = 2 + 2;
+        uuid_len = 2;
         break;
 
     case BLE_ATT_FIND_INFO_RSP_FORMAT_128BIT:
-        entry_len = 2 + 16;
+        uuid_len = 16;
         break;
 
     default:
         return BLE_HS_EBADDATA;
     }
 
-    rc = ble_hs_mbuf_pullup_base(rxom, entry_len);
+    rc = ble_hs_mbuf_cursor_read(cur, entry, 2 + uuid_len);
     if (rc != 0) {
         return rc;
     }
 
-    idata->attr_handle = get_le16((*rxom)->om_data);
+    idata->attr_handle = get_le16(entry);
 
-    switch (rsp_format) {
-    case BLE_ATT_FIND_INFO_RSP_FORMAT_16BIT:
-        rc = ble_uuid_init_from_att_mbuf(&idata->uuid, *rxom, 2, 2);
-        if (rc != 0) {
-            return BLE_HS_EBADDATA;
-        }
-        break;
-
-    case BLE_ATT_FIND_INFO_RSP_FORMAT_128BIT:
-        rc = ble_uuid_init_from_att_mbuf(&idata->uuid, *rxom, 2, 16);
-        if (rc != 0) {
-            return BLE_HS_EBADDATA;
-        }
-        break;
-
-    default:
-        BLE_HS_DBG_ASSERT(0);
-        break;
+    rc = ble_uuid_init_from_att_buf(&idata->uuid, entry + 2, uuid_len);
+    if (rc != 0) {
+        return BLE_HS_EBADDATA;
     }
 
-    os_mbuf_adj(*rxom, entry_len);
     return 0;
 }
 
@@ -236,21 +222,22 @@ ble_att_clt_rx_find_info(uint16_t conn_handle, uint16_t cid, struct os_mbuf **om
 #endif
 
     struct ble_att_find_info_idata idata;
-    struct ble_att_find_info_rsp *rsp;
+    struct ble_att_find_info_rsp rsp;
+    struct ble_hs_mbuf_cursor cur;
     int rc;
 
-    rc = ble_hs_mbuf_pullup_base(om, sizeof(*rsp));
+    /* Walk the response with a cursor rather than pulling up each entry; an
+     * entry that straddles two ACL fragments is copied out as is.
+     */
+    ble_hs_mbuf_cursor_init(&cur, *om, 0);
+
+    rc = ble_hs_mbuf_cursor_read(&cur, &rsp, sizeof(rsp));
     if (rc != 0) {
         goto done;
     }
 
-    rsp = (struct ble_att_find_info_rsp *)(*om)->om_data;
-
-    /* Strip the response base from the front of the mbuf. */
-    os_mbuf_adj((*om), sizeof(*rsp));
-
-    while (OS_MBUF_PKTLEN(*om) > 0) {
-        rc = ble_att_clt_parse_find_info_entry(om, rsp->bafp_format, &idata);
+    while (!ble_hs_mbuf_cursor_at_end(&cur)) {
+        rc = ble_att_clt_parse_find_info_entry(&cur, rsp.bafp_format, &idata);
         if (rc != 0) {
             goto done;
         }
@@ -308,22 +295,18 @@ ble_att_clt_tx_find_type_value(uint16_t conn_handle, uint16_t cid,
 
 static int
 ble_att_clt_parse_find_type_value_hinfo(
-    struct os_mbuf **om, struct ble_att_find_type_value_hinfo *dst)
+    struct ble_hs_mbuf_cursor *cur, struct ble_att_find_type_value_hinfo *dst)
 {
-    struct ble_att_handle_group *group;
+    struct ble_att_handle_group group;
     int rc;
 
-    rc = ble_hs_mbuf_pullup_base(om, sizeof(*group));
+    rc = ble_hs_mbuf_cursor_read(cur, &group, sizeof(group));
     if (rc != 0) {
         return BLE_HS_EBADDATA;
     }
 
-    group = (struct ble_att_handle_group *)(*om)->om_data;
-
-    dst->attr_handle = le16toh(group->attr_handle);
-    dst->group_end_handle = le16toh(group->group_end_handle);
-
-    os_mbuf_adj((*om), sizeof(*group));
+    dst->attr_handle = le16toh(group.attr_handle);
+    dst->group_end_handle = le16toh(group.group_end_handle);
 
     return 0;
 }
@@ -336,12 +319,14 @@ ble_att_clt_rx_find_type_value(uint16_t conn_handle, uint16_t cid, struct os_mbu
 #endif
 
     struct ble_att_find_type_value_hinfo hinfo;
+    struct ble_hs_mbuf_cursor cur;
     int rc;
 
     /* Parse the Handles-Information-List field, passing each entry to GATT. */
     rc = 0;
-    while (OS_MBUF_PKTLEN(*rxom) > 0) {
-        rc = ble_att_clt_parse_find_type_value_hinfo(rxom, &hinfo);
+    ble_hs_mbuf_cursor_init(&cur, *rxom, 0);
+    while (!ble_hs_mbuf_cursor_at_end(&cur)) {
+        rc = ble_att_clt_parse_find_type_value_hinfo(&cur, &hinfo);
         if (rc != 0) {
             break;
         }
@@ -934,9 +919,7 @@ ble_att_clt_tx_notify(uint16_t conn_handle, uint16_t handle,
     os_mbuf_concat(txom2, txom);
 
     cid = ble_eatt_get_available_chan_cid(conn_handle, BLE_GATT_OP_DUMMY);
-    rc = ble_att_tx(conn_handle, cid, txom2);
-    ble_eatt_release_chan(conn_handle, BLE_GATT_OP_DUMMY);
-    return rc;
+    return ble_att_tx(conn_handle, cid, txom2);
 
 err:
     os_mbuf_free_chain(txom);
@@ -1017,12 +1000,7 @@ ble_att_clt_tx_notify_mult(uint16_t conn_handle, struct os_mbuf *txom)
     os_mbuf_concat(txom2, txom);
 
     cid = ble_eatt_get_available_chan_cid(conn_handle, BLE_GATT_OP_DUMMY);
-    rc = ble_att_tx(conn_handle, cid, txom2);
-    if (cid != BLE_L2CAP_CID_ATT) {
-        ble_eatt_release_chan(conn_handle, BLE_GATT_OP_DUMMY);
-    }
-
-    return rc;
+    return ble_att_tx(conn_handle, cid, txom2);
 
 err:
     os_mbuf_free_chain(txom);
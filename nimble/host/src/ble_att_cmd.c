@@ -50,7 +50,7 @@ ble_att_cmd_prepare(uint8_t opcode, size_t len, struct os_mbuf *txom)
 void *
 ble_att_cmd_get(uint8_t opcode, size_t len, struct os_mbuf **txom)
 {
-    *txom = ble_hs_mbuf_l2cap_pkt();
+    *txom = ble_hs_mbuf_l2cap_pkt_sized(sizeof(struct ble_att_hdr) + len);
     if (*txom == NULL) {
         return NULL;
     }
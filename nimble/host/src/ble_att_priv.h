@@ -148,10 +148,14 @@ int ble_att_svr_register(const ble_uuid_t *uuid, uint8_t flags,
 struct ble_att_svr_entry {
     STAILQ_ENTRY(ble_att_svr_entry) ha_next;
 
+    /* Next entry in the same 16-bit UUID bucket, in handle order. */
+    STAILQ_ENTRY(ble_att_svr_entry) ha_uuid16_next;
+
     const ble_uuid_t *ha_uuid;
     uint8_t ha_flags;
     uint8_t ha_min_key_size;
     uint16_t ha_handle_id;
+    uint8_t ha_hidden;
     ble_att_svr_access_fn *ha_cb;
     void *ha_cb_arg;
 };
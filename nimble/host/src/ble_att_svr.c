@@ -55,6 +55,20 @@ static uint16_t ble_att_svr_id;
 static void *ble_att_svr_entry_mem;
 static struct os_mempool ble_att_svr_entry_pool;
 
+/**
+ * Dense handle index.  Handles are allocated sequentially starting at 1, so
+ * the entry for handle h lives at index h - 1.  Hidden entries stay in the
+ * index; lookups check ha_hidden.
+ */
+static struct ble_att_svr_entry **ble_att_svr_handle_idx;
+static uint16_t ble_att_svr_handle_idx_sz;
+
+/** Secondary index of attributes with 16-bit UUIDs, bucketed by UUID. */
+#define BLE_ATT_SVR_UUID16_BUCKETS      16
+
+static struct ble_att_svr_entry_list
+    ble_att_svr_uuid16_idx[BLE_ATT_SVR_UUID16_BUCKETS];
+
 static os_membuf_t ble_att_svr_prep_entry_mem[
     OS_MEMPOOL_SIZE(MYNEWT_VAL(BLE_ATT_SVR_MAX_PREP_ENTRIES),
                     sizeof (struct ble_att_prep_entry))
@@ -94,6 +108,44 @@ ble_att_svr_next_id(void)
     return ++ble_att_svr_id;
 }
 
+static struct ble_att_svr_entry_list *
+ble_att_svr_uuid16_bucket(uint16_t uuid16)
+{
+    return &ble_att_svr_uuid16_idx[(uuid16 ^ (uuid16 >> 8)) %
+                                   BLE_ATT_SVR_UUID16_BUCKETS];
+}
+
+static void
+ble_att_svr_idx_insert(struct ble_att_svr_entry *entry)
+{
+    struct ble_att_svr_entry_list *bucket;
+
+    if (entry->ha_handle_id <= ble_att_svr_handle_idx_sz) {
+        ble_att_svr_handle_idx[entry->ha_handle_id - 1] = entry;
+    }
+
+    /* Handles only grow, so appending keeps each bucket sorted. */
+    if (entry->ha_uuid->type == BLE_UUID_TYPE_16) {
+        bucket = ble_att_svr_uuid16_bucket(BLE_UUID16(entry->ha_uuid)->value);
+        STAILQ_INSERT_TAIL(bucket, entry, ha_uuid16_next);
+    }
+}
+
+static void
+ble_att_svr_idx_reset(void)
+{
+    int i;
+
+    if (ble_att_svr_handle_idx != NULL) {
+        memset(ble_att_svr_handle_idx, 0,
+               ble_att_svr_handle_idx_sz * sizeof *ble_att_svr_handle_idx);
+    }
+
+    for (i = 0; i < BLE_ATT_SVR_UUID16_BUCKETS; i++) {
+        STAILQ_INIT(&ble_att_svr_uuid16_idx[i]);
+    }
+}
+
 /**
  * Register a host attribute with the BLE stack.
  *
@@ -125,6 +177,7 @@ ble_att_svr_register(const ble_uuid_t *uuid, uint8_t flags,
     entry->ha_cb_arg = cb_arg;
 
     STAILQ_INSERT_TAIL(&ble_att_svr_list, entry, ha_next);
+    ble_att_svr_idx_insert(entry);
 
     if (handle_id != NULL) {
         *handle_id = entry->ha_handle_id;
@@ -158,11 +211,100 @@ ble_att_svr_find_by_handle(uint16_t handle_id)
 {
     struct ble_att_svr_entry *entry;
 
-    for (entry = STAILQ_FIRST(&ble_att_svr_list);
-         entry != NULL;
-         entry = STAILQ_NEXT(entry, ha_next)) {
+    if (handle_id == 0 || handle_id > ble_att_svr_id) {
+        return NULL;
+    }
+
+    if (handle_id > ble_att_svr_handle_idx_sz) {
+        STAILQ_FOREACH(entry, &ble_att_svr_list, ha_next) {
+            if (entry->ha_handle_id == handle_id) {
+                return entry;
+            }
+        }
+
+        return NULL;
+    }
+
+    entry = ble_att_svr_handle_idx[handle_id - 1];
+    if (entry == NULL || entry->ha_hidden) {
+        return NULL;
+    }
+
+    return entry;
+}
+
+/**
+ * Finds the first visible attribute with a handle greater than or equal to
+ * the specified one.
+ *
+ * @param start_handle          The handle to start searching at.
+ *
+ * @return                      The matching entry; NULL if there is none.
+ */
+static struct ble_att_svr_entry *
+ble_att_svr_find_first(uint16_t start_handle)
+{
+    struct ble_att_svr_entry *entry;
+    uint32_t handle;
+
+    if (start_handle == 0) {
+        start_handle = 1;
+    }
+
+    if (ble_att_svr_id > ble_att_svr_handle_idx_sz) {
+        STAILQ_FOREACH(entry, &ble_att_svr_list, ha_next) {
+            if (entry->ha_handle_id >= start_handle) {
+                return entry;
+            }
+        }
+
+        return NULL;
+    }
 
-        if (entry->ha_handle_id == handle_id) {
+    /* Only hidden entries need to be skipped, so this is usually a single
+     * lookup.
+     */
+    for (handle = start_handle; handle <= ble_att_svr_id; handle++) {
+        entry = ble_att_svr_handle_idx[handle - 1];
+        if (entry != NULL && !entry->ha_hidden) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static struct ble_att_svr_entry *
+ble_att_svr_find_by_uuid16(struct ble_att_svr_entry *prev,
+                           const ble_uuid_t *uuid, uint16_t end_handle)
+{
+    struct ble_att_svr_entry_list *bucket;
+    struct ble_att_svr_entry *entry;
+
+    bucket = ble_att_svr_uuid16_bucket(BLE_UUID16(uuid)->value);
+
+    /* Continue along the bucket if the previous match is in it; otherwise
+     * skip ahead to the first entry following it.
+     */
+    if (prev != NULL && prev->ha_uuid->type == BLE_UUID_TYPE_16 &&
+        ble_att_svr_uuid16_bucket(BLE_UUID16(prev->ha_uuid)->value) ==
+        bucket) {
+
+        entry = STAILQ_NEXT(prev, ha_uuid16_next);
+    } else {
+        entry = STAILQ_FIRST(bucket);
+        while (prev != NULL && entry != NULL &&
+               entry->ha_handle_id <= prev->ha_handle_id) {
+
+            entry = STAILQ_NEXT(entry, ha_uuid16_next);
+        }
+    }
+
+    for (;
+         entry != NULL && entry->ha_handle_id <= end_handle;
+         entry = STAILQ_NEXT(entry, ha_uuid16_next)) {
+
+        if (!entry->ha_hidden && ble_uuid_cmp(entry->ha_uuid, uuid) == 0) {
             return entry;
         }
     }
@@ -191,6 +333,10 @@ ble_att_svr_find_by_uuid(struct ble_att_svr_entry *prev, const ble_uuid_t *uuid,
 {
     struct ble_att_svr_entry *entry;
 
+    if (uuid != NULL && uuid->type == BLE_UUID_TYPE_16) {
+        return ble_att_svr_find_by_uuid16(prev, uuid, end_handle);
+    }
+
     if (prev == NULL) {
         entry = STAILQ_FIRST(&ble_att_svr_list);
     } else {
@@ -819,7 +965,10 @@ ble_att_svr_fill_info(uint16_t start_handle, uint16_t end_handle,
     num_entries = 0;
     rc = 0;
 
-    STAILQ_FOREACH(ha, &ble_att_svr_list, ha_next) {
+    for (ha = ble_att_svr_find_first(start_handle);
+         ha != NULL;
+         ha = STAILQ_NEXT(ha, ha_next)) {
+
         if (ha->ha_handle_id > end_handle) {
             rc = 0;
             goto done;
@@ -1110,10 +1259,9 @@ ble_att_svr_fill_type_value(uint16_t conn_handle,
      * matching group.  For each attribute entry, determine if data needs to be
      * written to the response.
      */
-    STAILQ_FOREACH(ha, &ble_att_svr_list, ha_next) {
-        if (ha->ha_handle_id < start_handle) {
-            continue;
-        }
+    for (ha = ble_att_svr_find_first(start_handle);
+         ha != NULL;
+         ha = STAILQ_NEXT(ha, ha_next)) {
 
         /* Continue to look for end of group in case group is in progress. */
         if (!first && ha->ha_handle_id > end_handle) {
@@ -1620,7 +1768,9 @@ ble_att_svr_build_read_mult_rsp(uint16_t conn_handle, uint16_t cid,
                                 uint8_t *att_err,
                                 uint16_t *err_handle)
 {
+    struct ble_hs_mbuf_cursor cur;
     struct os_mbuf *txom;
+    uint8_t handle_buf[2];
     uint16_t handle;
     uint16_t mtu;
     int rc;
@@ -1644,21 +1794,12 @@ ble_att_svr_build_read_mult_rsp(uint16_t conn_handle, uint16_t cid,
      * for each.  Stop when there are no more handles to process, or the
      * response is full.
      */
-    while (OS_MBUF_PKTLEN(*rxom) >= 2 && OS_MBUF_PKTLEN(txom) < mtu) {
-        /* Ensure the full 16-bit handle is contiguous at the start of the
-         * mbuf.
-         */
-        rc = ble_att_svr_pullup_req_base(rxom, 2, att_err);
-        if (rc != 0) {
-            *err_handle = 0;
-            goto done;
-        }
+    ble_hs_mbuf_cursor_init(&cur, *rxom, 0);
+    while (OS_MBUF_PKTLEN(txom) < mtu &&
+           ble_hs_mbuf_cursor_read(&cur, handle_buf,
+                                   sizeof(handle_buf)) == 0) {
 
-        /* Extract the 16-bit handle and strip it from the front of the
-         * mbuf.
-         */
-        handle = get_le16((*rxom)->om_data);
-        os_mbuf_adj(*rxom, 2);
+        handle = get_le16(handle_buf);
 
         rc = ble_att_svr_read_handle(conn_handle, handle, 0, txom, att_err);
         if (rc != 0) {
@@ -1705,7 +1846,9 @@ ble_att_svr_build_read_mult_rsp_var(uint16_t conn_handle, uint16_t cid,
                                     uint8_t *att_err,
                                     uint16_t *err_handle)
 {
+    struct ble_hs_mbuf_cursor cur;
     struct os_mbuf *txom;
+    uint8_t handle_buf[2];
     uint16_t handle;
     uint16_t mtu;
     uint16_t tuple_len;
@@ -1732,21 +1875,10 @@ ble_att_svr_build_read_mult_rsp_var(uint16_t conn_handle, uint16_t cid,
     /* Iterate through requested handles, reading the corresponding attribute
      * for each.  Stop when there are no more handles to process.
      */
-    while (OS_MBUF_PKTLEN(*rxom) >= 2) {
-        /* Ensure the full 16-bit handle is contiguous at the start of the
-         * mbuf.
-         */
-        rc = ble_att_svr_pullup_req_base(rxom, 2, att_err);
-        if (rc != 0) {
-            *err_handle = 0;
-            goto done;
-        }
-
-        /* Extract the 16-bit handle and strip it from the front of the
-         * mbuf.
-         */
-        handle = get_le16((*rxom)->om_data);
-        os_mbuf_adj(*rxom, 2);
+    ble_hs_mbuf_cursor_init(&cur, *rxom, 0);
+    while (ble_hs_mbuf_cursor_read(&cur, handle_buf,
+                                   sizeof(handle_buf)) == 0) {
+        handle = get_le16(handle_buf);
 
         rc = ble_att_svr_read_handle(conn_handle, handle, 0, tmp, att_err);
         if (rc != 0) {
@@ -1927,10 +2059,10 @@ ble_att_svr_build_read_group_type_rsp(uint16_t conn_handle, uint16_t cid,
     }
 
     rsp->bagp_length = 0;
-    STAILQ_FOREACH(entry, &ble_att_svr_list, ha_next) {
-        if (entry->ha_handle_id < start_handle) {
-            continue;
-        }
+    for (entry = ble_att_svr_find_first(start_handle);
+         entry != NULL;
+         entry = STAILQ_NEXT(entry, ha_next)) {
+
         if (entry->ha_handle_id > end_handle) {
             /* The full input range has been searched. */
             rc = 0;
@@ -2841,6 +2973,11 @@ ble_att_svr_rx_indicate(uint16_t conn_handle, uint16_t cid, struct os_mbuf **rxo
     /* Strip the request base from the front of the mbuf. */
     os_mbuf_adj(*rxom, sizeof(*req));
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    /* A Service Changed indication invalidates the client cache. */
+    ble_gattc_cache_rx_indicate(conn_handle, handle);
+#endif
+
     ble_gap_notify_rx_event(conn_handle, handle, *rxom, 1);
     *rxom = NULL;
 
@@ -2887,6 +3024,8 @@ ble_att_svr_move_entries(struct ble_att_svr_entry_list *src,
 
     /* Move elements */
     while (entry && entry->ha_handle_id <= end_handle) {
+        entry->ha_hidden = (dst == &ble_att_svr_hidden_list);
+
         /* Remove either from head or after prev (which is current one) */
         if (remove == NULL) {
             STAILQ_REMOVE_HEAD(src, ha_next);
@@ -2941,8 +3080,9 @@ ble_att_svr_reset(void)
         ble_att_svr_entry_free(entry);
     }
 
+    ble_att_svr_idx_reset();
     ble_att_svr_id = 0;
-    
+
     /* Note: prep entries do not get freed here because it is assumed there are
      * no established connections.
      */
@@ -2953,6 +3093,10 @@ ble_att_svr_free_start_mem(void)
 {
     free(ble_att_svr_entry_mem);
     ble_att_svr_entry_mem = NULL;
+
+    free(ble_att_svr_handle_idx);
+    ble_att_svr_handle_idx = NULL;
+    ble_att_svr_handle_idx_sz = 0;
 }
 
 int
@@ -2978,8 +3122,18 @@ ble_att_svr_start(void)
             rc = BLE_HS_EOS;
             goto err;
         }
+
+        ble_att_svr_handle_idx =
+            malloc(ble_hs_max_attrs * sizeof *ble_att_svr_handle_idx);
+        if (ble_att_svr_handle_idx == NULL) {
+            rc = BLE_HS_ENOMEM;
+            goto err;
+        }
+        ble_att_svr_handle_idx_sz = ble_hs_max_attrs;
     }
 
+    ble_att_svr_idx_reset();
+
     return 0;
 
 err:
@@ -3005,6 +3159,7 @@ ble_att_svr_init(void)
 
     STAILQ_INIT(&ble_att_svr_list);
     STAILQ_INIT(&ble_att_svr_hidden_list);
+    ble_att_svr_idx_reset();
 
     ble_att_svr_id = 0;
 
@@ -32,12 +32,20 @@
 #include "ble_eatt_priv.h"
 #include "services/gatt/ble_svc_gatt.h"
 
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
 struct ble_eatt {
     SLIST_ENTRY(ble_eatt) next;
     uint16_t conn_handle;
     struct ble_l2cap_chan *chan;
     uint8_t client_op;
 
+    /* Bearer scheduler state, see ble_eatt_get_available_chan_cid() */
+    uint32_t sched_weight;
+    int32_t sched_cur;
+
     /* Packet transmit queue */
     STAILQ_HEAD(, os_mbuf_pkthdr) eatt_tx_q;
 
@@ -77,20 +85,6 @@ static struct ble_npl_event g_read_sup_cl_feat_ev;
 static void ble_eatt_setup_cb(struct ble_npl_event *ev);
 static void ble_eatt_start(uint16_t conn_handle);
 
-static struct ble_eatt *
-ble_eatt_find_not_busy(uint16_t conn_handle)
-{
-    struct ble_eatt *eatt;
-
-    SLIST_FOREACH(eatt, &g_ble_eatt_list, next) {
-        if ((eatt->conn_handle == conn_handle) && !eatt->client_op) {
-            return eatt;
-        }
-    }
-
-    return NULL;
-}
-
 static struct ble_eatt *
 ble_eatt_find_by_conn_handle(uint16_t conn_handle)
 {
@@ -105,18 +99,20 @@ ble_eatt_find_by_conn_handle(uint16_t conn_handle)
     return NULL;
 }
 
-static struct ble_eatt *
-ble_eatt_find_by_conn_handle_and_busy_op(uint16_t conn_handle, uint8_t op)
+static int
+ble_eatt_count_by_conn_handle(uint16_t conn_handle)
 {
     struct ble_eatt *eatt;
+    int cnt;
 
+    cnt = 0;
     SLIST_FOREACH(eatt, &g_ble_eatt_list, next) {
-        if (eatt->conn_handle == conn_handle && eatt->client_op == op) {
-            return eatt;
+        if (eatt->conn_handle == conn_handle) {
+            cnt++;
         }
     }
 
-    return NULL;
+    return cnt;
 }
 
 static struct ble_eatt *
@@ -194,6 +190,8 @@ ble_eatt_alloc(void)
     eatt->conn_handle = BLE_HS_CONN_HANDLE_NONE;
     eatt->chan = NULL;
     eatt->client_op = 0;
+    eatt->sched_weight = 0;
+    eatt->sched_cur = 0;
 
     STAILQ_INIT(&eatt->eatt_tx_q);
     ble_npl_event_init(&eatt->setup_ev, ble_eatt_setup_cb, eatt);
@@ -239,11 +237,8 @@ ble_eatt_l2cap_event_fn(struct ble_l2cap_event *event, void *arg)
         break;
     case BLE_L2CAP_EVENT_COC_ACCEPT:
         BLE_EATT_LOG_DEBUG("eatt: Accept request\n");
-        eatt = ble_eatt_find_by_conn_handle(event->accept.conn_handle);
-        if (eatt) {
-            /* For now we accept only one additional coc channel per ACL
-             * TODO: improve it
-             */
+        if (ble_eatt_count_by_conn_handle(event->accept.conn_handle) >=
+            MYNEWT_VAL(BLE_EATT_CHAN_PER_CONN)) {
             return BLE_HS_ENOMEM;
         }
 
@@ -438,30 +433,149 @@ ble_eatt_gap_event(struct ble_gap_event *event, void *arg)
     return 0;
 }
 
+/**
+ * Computes the scheduling weight of an EATT bearer: how much of an ATT_MTU
+ * sized PDU the peer's credits let go out right away, once the data already
+ * queued on the channel is accounted for.  Must be called with the host lock
+ * held, as credits and queue are updated from the host task.
+ */
+static uint32_t
+ble_eatt_chan_weight(struct ble_eatt *eatt)
+{
+    struct ble_l2cap_chan *chan;
+    uint32_t credit_bytes;
+    uint32_t queued;
+    int rc;
+
+    chan = eatt->chan;
+    credit_bytes = (uint32_t)chan->coc_tx.credits * chan->peer_coc_mps;
+
+    rc = ble_l2cap_coc_tx_queued_nolock(chan, NULL, &queued);
+    if (rc != 0 || credit_bytes <= queued) {
+        return 0;
+    }
+
+    return min(credit_bytes - queued, ble_att_chan_mtu(chan));
+}
+
+/**
+ * Picks the ATT bearer for a GATT operation on the given connection.
+ *
+ * Candidates are the fixed ATT channel and every open EATT channel; a client
+ * procedure (or indication) only considers EATT channels with no procedure of
+ * their own, as the response has to come back on the same bearer.  Each
+ * candidate is weighted by ble_eatt_chan_weight(), the fixed channel by its
+ * ATT_MTU divided among the procedures already assigned to it, and the
+ * bearer is chosen by smooth weighted round-robin so that operations get
+ * spread in proportion to the weights.  The fixed channel is the fallback
+ * when no EATT channel is usable.
+ *
+ * @param conn_handle           The connection to pick a bearer on.
+ * @param op                    The GATT procedure op, or BLE_GATT_OP_DUMMY
+ *                                  for an operation that expects no
+ *                                  response.  A bearer picked for a
+ *                                  procedure stays assigned to it until
+ *                                  ble_eatt_release_chan() is called.
+ *
+ * @return                      The source CID of the chosen bearer.
+ */
 uint16_t
 ble_eatt_get_available_chan_cid(uint16_t conn_handle, uint8_t op)
 {
-    struct ble_eatt * eatt;
+    struct ble_l2cap_chan *chan;
+    struct ble_hs_conn *conn;
+    struct ble_eatt *best;
+    struct ble_eatt *eatt;
+    uint32_t weight;
+    uint32_t total;
+    int32_t best_cur;
+    uint16_t cid;
+    int client;
+    int rc;
 
-    eatt = ble_eatt_find_not_busy(conn_handle);
-    if (!eatt) {
+    client = op != BLE_GATT_OP_DUMMY;
+
+    ble_hs_lock();
+
+    rc = ble_att_conn_chan_find(conn_handle, BLE_L2CAP_CID_ATT, &conn, &chan);
+    if (rc != 0) {
+        ble_hs_unlock();
         return BLE_L2CAP_CID_ATT;
     }
 
-    eatt->client_op = op;
+    SLIST_FOREACH(eatt, &g_ble_eatt_list, next) {
+        eatt->sched_weight = 0;
+        if (eatt->conn_handle != conn_handle || !eatt->chan ||
+            (client && eatt->client_op)) {
+            continue;
+        }
+
+        eatt->sched_weight = ble_eatt_chan_weight(eatt);
+    }
+
+    weight = ble_att_chan_mtu(chan);
+    if (client) {
+        weight /= 1 + conn->client_att_procs;
+    }
+    conn->att_sched_cur += weight;
+    total = weight;
 
-    return eatt->chan->scid;
+    best = NULL;
+    best_cur = conn->att_sched_cur;
+
+    SLIST_FOREACH(eatt, &g_ble_eatt_list, next) {
+        if (eatt->conn_handle != conn_handle || eatt->sched_weight == 0) {
+            continue;
+        }
+
+        eatt->sched_cur += eatt->sched_weight;
+        total += eatt->sched_weight;
+        if (eatt->sched_cur > best_cur) {
+            best = eatt;
+            best_cur = eatt->sched_cur;
+        }
+    }
+
+    if (best == NULL) {
+        conn->att_sched_cur -= total;
+        if (client) {
+            conn->client_att_procs++;
+        }
+        cid = BLE_L2CAP_CID_ATT;
+    } else {
+        best->sched_cur -= total;
+        if (client) {
+            best->client_op = op;
+        }
+        cid = best->chan->scid;
+    }
+
+    ble_hs_unlock();
+
+    return cid;
 }
 
 void
-ble_eatt_release_chan(uint16_t conn_handle, uint8_t op)
+ble_eatt_release_chan(uint16_t conn_handle, uint16_t cid)
 {
-    struct ble_eatt * eatt;
+    struct ble_hs_conn *conn;
+    struct ble_eatt *eatt;
+
+    if (cid == BLE_L2CAP_CID_ATT) {
+        ble_hs_lock();
+        conn = ble_hs_conn_find(conn_handle);
+        if (conn != NULL && conn->client_att_procs > 0) {
+            conn->client_att_procs--;
+        }
+        ble_hs_unlock();
+        return;
+    }
 
-    eatt = ble_eatt_find_by_conn_handle_and_busy_op(conn_handle, op);
+    eatt = ble_eatt_find(conn_handle, cid);
     if (!eatt) {
         BLE_EATT_LOG_WARN("ble_eatt_release_chan:"
-                          "EATT not found for conn_handle 0x%04x, operation 0x%02\n", conn_handle, op);
+                          "EATT not found for conn_handle 0x%04x, cid 0x%04x\n",
+                          conn_handle, cid);
         return;
     }
 
@@ -512,6 +626,7 @@ ble_eatt_start(uint16_t conn_handle)
     struct ble_gap_conn_desc desc;
     struct ble_eatt *eatt;
     int rc;
+    int i;
 
     rc = ble_gap_conn_find(conn_handle, &desc);
     assert(rc == 0);
@@ -522,15 +637,17 @@ ble_eatt_start(uint16_t conn_handle)
         return;
     }
 
-    eatt = ble_eatt_alloc();
-    if (!eatt) {
-        return;
-    }
+    for (i = 0; i < MYNEWT_VAL(BLE_EATT_CHAN_PER_CONN); i++) {
+        eatt = ble_eatt_alloc();
+        if (!eatt) {
+            return;
+        }
 
-    eatt->conn_handle = conn_handle;
+        eatt->conn_handle = conn_handle;
 
-    /* Setup EATT  */
-    ble_npl_eventq_put(ble_hs_evq_get(), &eatt->setup_ev);
+        /* Setup EATT  */
+        ble_npl_eventq_put(ble_hs_evq_get(), &eatt->setup_ev);
+    }
 }
 
 void
@@ -538,6 +655,8 @@ ble_eatt_init(ble_eatt_att_rx_fn att_rx_cb)
 {
     int rc;
 
+    SLIST_INIT(&g_ble_eatt_list);
+
     rc = mem_init_mbuf_pool(ble_eatt_sdu_coc_mem,
                             &ble_eatt_sdu_mbuf_mempool,
                             &ble_eatt_sdu_os_mbuf_pool,
@@ -6769,6 +6769,19 @@ ble_gap_conn_rssi(uint16_t conn_handle, int8_t *out_rssi)
     return rc;
 }
 
+int
+ble_gap_conn_set_tx_weight(uint16_t conn_handle, uint8_t weight)
+{
+    return ble_hs_tx_sched_set_weight(conn_handle, weight);
+}
+
+int
+ble_gap_conn_tx_stats(uint16_t conn_handle,
+                      struct ble_gap_conn_tx_stats *out_stats)
+{
+    return ble_hs_tx_sched_stats(conn_handle, out_stats);
+}
+
 /*****************************************************************************
  * $notify                                                                   *
  *****************************************************************************/
@@ -66,6 +66,9 @@ STATS_SECT_START(ble_gattc_stats)
     STATS_SECT_ENTRY(write_reliable_fail)
     STATS_SECT_ENTRY(notify)
     STATS_SECT_ENTRY(notify_fail)
+    STATS_SECT_ENTRY(notify_mult)
+    STATS_SECT_ENTRY(notify_mult_fail)
+    STATS_SECT_ENTRY(notify_mult_saved)
     STATS_SECT_ENTRY(indicate)
     STATS_SECT_ENTRY(indicate_fail)
     STATS_SECT_ENTRY(proc_timeout)
@@ -95,6 +98,20 @@ extern STATS_SECT_DECL(ble_gatts_stats) ble_gatts_stats;
  */
 #define BLE_GATT_CHR_CLI_SUP_FEAT_MASK  7
 
+/** Client supports Robust Caching. */
+#define BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING    0x01
+/** Client supports Multiple Handle Value Notifications. */
+#define BLE_GATT_CHR_CLI_SUP_FEAT_MULT_NTF  0x04
+
+#define BLE_GATT_CHR_SVC_CHANGED_UUID16 0x2a05
+#define BLE_GATT_CHR_DB_HASH_UUID16     0x2b2a
+#define BLE_GATT_DB_HASH_SZ             16
+
+/** The database changed since the client last synchronized with it. */
+#define BLE_GATTS_CONN_F_CHANGE_UNAWARE     0x01
+/** The client becomes change-aware with its next request. */
+#define BLE_GATTS_CONN_F_AWARE_PENDING      0x02
+
 typedef uint8_t ble_gatts_conn_flags;
 
 struct ble_gatts_conn {
@@ -103,6 +120,12 @@ struct ble_gatts_conn {
 
     uint16_t indicate_val_handle;
 
+    /* Robust Caching state; BLE_GATTS_CONN_F_[...]. */
+    ble_gatts_conn_flags flags;
+
+    /* Slot in the CCCD subscription index, plus one; 0 if none assigned. */
+    uint8_t sub_slot;
+
     /**
      * For now only 3 bits in one octet are defined, but specification expects
      * this service to be variable length with no upper bound. Let's make this
@@ -150,6 +173,42 @@ int32_t ble_gattc_timer(void);
 int ble_gattc_any_jobs(void);
 int ble_gattc_init(void);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+/** The peer's Database Hash has not been read yet. */
+#define BLE_GATTC_CACHE_UNKNOWN         0
+/** The peer's Database Hash is being read. */
+#define BLE_GATTC_CACHE_PENDING         1
+/** The cache matches the peer's database. */
+#define BLE_GATTC_CACHE_VALID           2
+/** Caching is unavailable for this connection. */
+#define BLE_GATTC_CACHE_OFF             3
+
+uint8_t ble_gattc_cache_state(uint16_t conn_handle);
+void ble_gattc_cache_set_state(uint16_t conn_handle, uint8_t state);
+int ble_gattc_cache_validate(uint16_t conn_handle, const uint8_t *db_hash);
+void ble_gattc_cache_add_svc(uint16_t conn_handle,
+                             const struct ble_gatt_svc *svc);
+void ble_gattc_cache_add_chr(uint16_t conn_handle,
+                             const struct ble_gatt_chr *chr);
+void ble_gattc_cache_add_dsc(uint16_t conn_handle,
+                             const struct ble_gatt_dsc *dsc);
+void ble_gattc_cache_svcs_done(uint16_t conn_handle);
+void ble_gattc_cache_chrs_done(uint16_t conn_handle, uint16_t start_handle,
+                               uint16_t end_handle);
+void ble_gattc_cache_dscs_done(uint16_t conn_handle, uint16_t chr_val_handle,
+                               uint16_t end_handle);
+int ble_gattc_cache_covers_svcs(uint16_t conn_handle);
+int ble_gattc_cache_covers_chrs(uint16_t conn_handle, uint16_t start_handle,
+                                uint16_t end_handle);
+int ble_gattc_cache_covers_dscs(uint16_t conn_handle, uint16_t chr_val_handle,
+                                uint16_t end_handle);
+int ble_gattc_cache_read(uint16_t conn_handle, uint8_t type,
+                         uint16_t start_handle, uint16_t end_handle, int idx,
+                         struct ble_store_value_gatt_cache *out_value);
+void ble_gattc_cache_rx_indicate(uint16_t conn_handle, uint16_t attr_handle);
+void ble_gattc_cache_conn_broken(uint16_t conn_handle);
+#endif
+
 /*** @server. */
 #define BLE_GATTS_CLT_CFG_F_NOTIFY   0x0001
 #define BLE_GATTS_CLT_CFG_F_INDICATE 0x0002
@@ -212,6 +271,10 @@ int ble_gatts_clt_cfg_access(uint16_t conn_handle, uint16_t attr_handle,
 
 int ble_gatts_peer_cl_sup_feat_update(uint16_t conn_handle,
                                       struct os_mbuf *om);
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+int ble_gatts_db_hash_read(uint16_t conn_handle, uint8_t *out_hash);
+int ble_gatts_conn_change_aware(uint16_t conn_handle, int is_req);
+#endif
 /*** @misc. */
 int ble_gatts_conn_can_alloc(void);
 int ble_gatts_conn_init(struct ble_gatts_conn *gatts_conn);
@@ -36,13 +36,13 @@
  * Notes on thread-safety:
  * 1. The ble_hs mutex must never be locked when an application callback is
  *    executed.  A callback is free to initiate additional host procedures.
- * 2. The only resource protected by the mutex is the list of active procedures
- *    (ble_gattc_procs).  Thread-safety is achieved by locking the mutex during
- *    removal and insertion operations.  Procedure objects are only modified
- *    while they are not in the list.  This is sufficient, as the host parent
- *    task is the only task which inspects or modifies individual procedure
- *    entries.  Tasks have the following permissions regarding procedure
- *    entries:
+ * 2. The only resources protected by the mutex are the lists of active
+ *    procedures (ble_gattc_procs and ble_gattc_proc_hash).  Thread-safety is
+ *    achieved by locking the mutex during removal and insertion operations.
+ *    Procedure objects are only modified while they are not in the list.
+ *    This is sufficient, as the host parent task is the only task which
+ *    inspects or modifies individual procedure entries.  Tasks have the
+ *    following permissions regarding procedure entries:
  *
  *                | insert  | remove    | inspect   | modify
  *    ------------+---------+-----------|-----------|---------
@@ -103,10 +103,30 @@
 /** Procedure stalled due to resource exhaustion. */
 #define BLE_GATTC_PROC_F_STALLED                0x01
 
+/** Discovery waiting for the peer's Database Hash to be read. */
+#define BLE_GATTC_PROC_F_CACHE_WAIT             0x02
+
+/** Discovery to be answered from the GATT client cache. */
+#define BLE_GATTC_PROC_F_CACHED                 0x04
+
+/** Procedure holds a bearer picked by ble_eatt_get_available_chan_cid(). */
+#define BLE_GATTC_PROC_F_BEARER                 0x08
+
+/** Procedure has no request in flight and must not match any response. */
+#define BLE_GATTC_PROC_F_DEFERRED               \
+    (BLE_GATTC_PROC_F_CACHE_WAIT | BLE_GATTC_PROC_F_CACHED)
+
 /** Represents an in-progress GATT procedure. */
 struct ble_gattc_proc {
+    /* Used for temporary lists of procedures extracted from the active set. */
     STAILQ_ENTRY(ble_gattc_proc) next;
 
+    /* Entry in the connection handle hash. */
+    TAILQ_ENTRY(ble_gattc_proc) hash_next;
+
+    /* Entry in the expiry-ordered list of all active procedures. */
+    TAILQ_ENTRY(ble_gattc_proc) exp_next;
+
     uint32_t exp_os_ticks;
     uint16_t conn_handle;
     uint16_t cid;
@@ -144,6 +164,7 @@ struct ble_gattc_proc {
         } find_inc_svcs;
 
         struct {
+            uint16_t start_handle;
             uint16_t prev_handle;
             uint16_t end_handle;
             ble_gatt_chr_fn *cb;
@@ -225,6 +246,7 @@ struct ble_gattc_proc {
 };
 
 STAILQ_HEAD(ble_gattc_proc_list, ble_gattc_proc);
+TAILQ_HEAD(ble_gattc_proc_tailq, ble_gattc_proc);
 
 /**
  * Error functions - these handle an incoming ATT error response and apply it
@@ -429,14 +451,40 @@ static os_membuf_t ble_gattc_proc_mem[
 
 static struct os_mempool ble_gattc_proc_pool;
 
-/* The list of active GATT client procedures. */
-static struct ble_gattc_proc_list ble_gattc_procs;
+/**
+ * Number of buckets in the procedure hash.  Procedures are keyed by
+ * connection handle; the (connection, channel) pair is matched within the
+ * bucket.
+ */
+#if MYNEWT_VAL(BLE_MAX_CONNECTIONS) > 0
+#define BLE_GATTC_PROC_HASH_SIZE    MYNEWT_VAL(BLE_MAX_CONNECTIONS)
+#else
+#define BLE_GATTC_PROC_HASH_SIZE    1
+#endif
+
+/* All active GATT client procedures, sorted by expiry time. */
+static struct ble_gattc_proc_tailq ble_gattc_procs;
+
+/* Active GATT client procedures, hashed by connection handle.  Within a
+ * bucket, procedures are kept in the order responses are matched against
+ * them.
+ */
+static struct ble_gattc_proc_tailq
+    ble_gattc_proc_hash[BLE_GATTC_PROC_HASH_SIZE];
 
 /* The time when we should attempt to resume stalled procedures, in OS ticks.
  * A value of 0 indicates no stalled procedures.
  */
 static ble_npl_time_t ble_gattc_resume_at;
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+/* Answers discoveries flagged BLE_GATTC_PROC_F_CACHED. */
+static struct ble_npl_event ble_gattc_cache_ev;
+
+static int ble_gattc_cache_defer(struct ble_gattc_proc *proc);
+static void ble_gattc_cache_sched(void);
+#endif
+
 /* Statistics. */
 STATS_SECT_DECL(ble_gattc_stats) ble_gattc_stats;
 STATS_NAME_START(ble_gattc_stats)
@@ -472,6 +520,9 @@ STATS_NAME_START(ble_gattc_stats)
     STATS_NAME(ble_gattc_stats, write_reliable_fail)
     STATS_NAME(ble_gattc_stats, notify)
     STATS_NAME(ble_gattc_stats, notify_fail)
+    STATS_NAME(ble_gattc_stats, notify_mult)
+    STATS_NAME(ble_gattc_stats, notify_mult_fail)
+    STATS_NAME(ble_gattc_stats, notify_mult_saved)
     STATS_NAME(ble_gattc_stats, indicate)
     STATS_NAME(ble_gattc_stats, indicate_fail)
     STATS_NAME(ble_gattc_stats, proc_timeout)
@@ -489,7 +540,7 @@ ble_gattc_dbg_assert_proc_not_inserted(struct ble_gattc_proc *proc)
 
     ble_hs_lock();
 
-    STAILQ_FOREACH(cur, &ble_gattc_procs, next) {
+    TAILQ_FOREACH(cur, &ble_gattc_procs, exp_next) {
         BLE_HS_DBG_ASSERT(cur != proc);
     }
 
@@ -706,6 +757,7 @@ ble_gattc_proc_prepare(struct ble_gattc_proc *proc, uint16_t conn_handle, uint8_
     proc->conn_handle = conn_handle;
     proc->op = op;
     proc->cid = ble_eatt_get_available_chan_cid(conn_handle, op);
+    proc->flags |= BLE_GATTC_PROC_F_BEARER;
 }
 
 /**
@@ -740,8 +792,8 @@ ble_gattc_proc_free(struct ble_gattc_proc *proc)
         }
 
 #if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 0
-        if (proc->cid != BLE_L2CAP_CID_ATT) {
-            ble_eatt_release_chan(proc->conn_handle, proc->op);
+        if (proc->flags & BLE_GATTC_PROC_F_BEARER) {
+            ble_eatt_release_chan(proc->conn_handle, proc->cid);
         }
 #endif
 
@@ -753,20 +805,60 @@ ble_gattc_proc_free(struct ble_gattc_proc *proc)
     }
 }
 
+static struct ble_gattc_proc_tailq *
+ble_gattc_proc_hash_bucket(uint16_t conn_handle)
+{
+    return &ble_gattc_proc_hash[conn_handle % BLE_GATTC_PROC_HASH_SIZE];
+}
+
 static void
 ble_gattc_proc_insert(struct ble_gattc_proc *proc, bool insert_head)
 {
+    struct ble_gattc_proc_tailq *bucket;
+    struct ble_gattc_proc *cur;
+
     ble_gattc_dbg_assert_proc_not_inserted(proc);
 
     ble_hs_lock();
+
+    bucket = ble_gattc_proc_hash_bucket(proc->conn_handle);
     if (insert_head) {
-        STAILQ_INSERT_HEAD(&ble_gattc_procs, proc, next);
+        TAILQ_INSERT_HEAD(bucket, proc, hash_next);
+    } else {
+        TAILQ_INSERT_TAIL(bucket, proc, hash_next);
+    }
+
+    /* Keep the active list sorted by expiry time.  Every procedure is armed
+     * with the same timeout, so the new entry almost always belongs at the
+     * tail.
+     */
+    cur = TAILQ_LAST(&ble_gattc_procs, ble_gattc_proc_tailq);
+    while (cur != NULL &&
+           (int32_t)(cur->exp_os_ticks - proc->exp_os_ticks) > 0) {
+
+        cur = TAILQ_PREV(cur, ble_gattc_proc_tailq, exp_next);
+    }
+    if (cur == NULL) {
+        TAILQ_INSERT_HEAD(&ble_gattc_procs, proc, exp_next);
     } else {
-        STAILQ_INSERT_TAIL(&ble_gattc_procs, proc, next);
+        TAILQ_INSERT_AFTER(&ble_gattc_procs, cur, proc, exp_next);
     }
+
     ble_hs_unlock();
 }
 
+/**
+ * Removes the specified procedure from the active lists.  The caller must
+ * hold the host lock.
+ */
+static void
+ble_gattc_proc_remove(struct ble_gattc_proc *proc)
+{
+    TAILQ_REMOVE(ble_gattc_proc_hash_bucket(proc->conn_handle), proc,
+                 hash_next);
+    TAILQ_REMOVE(&ble_gattc_procs, proc, exp_next);
+}
+
 static void
 ble_gattc_proc_set_exp_timer(struct ble_gattc_proc *proc)
 {
@@ -804,6 +896,11 @@ ble_gattc_process_status(struct ble_gattc_proc *proc, int status, bool insert_he
 
         ble_gattc_proc_insert(proc, insert_head);
         ble_hs_timer_resched();
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+        if (proc->flags & BLE_GATTC_PROC_F_CACHED) {
+            ble_gattc_cache_sched();
+        }
+#endif
         break;
 
     default:
@@ -916,38 +1013,15 @@ ble_gattc_proc_matches_conn_cid_op(struct ble_gattc_proc *proc, void *arg)
         return 0;
     }
 
-    if (criteria->op != proc->op && criteria->op != BLE_GATT_OP_NONE) {
+    if (proc->flags & BLE_GATTC_PROC_F_DEFERRED) {
         return 0;
     }
 
-    return 1;
-}
-
-struct ble_gattc_criteria_exp {
-    ble_npl_time_t now;
-    int32_t next_exp_in;
-};
-
-static int
-ble_gattc_proc_matches_expired(struct ble_gattc_proc *proc, void *arg)
-{
-    struct ble_gattc_criteria_exp *criteria;
-    int32_t time_diff;
-
-    criteria = arg;
-
-    time_diff = proc->exp_os_ticks - criteria->now;
-
-    if (time_diff <= 0) {
-        /* Procedure is expired. */
-        return 1;
+    if (criteria->op != proc->op && criteria->op != BLE_GATT_OP_NONE) {
+        return 0;
     }
 
-    /* Procedure isn't expired; determine if it is the next to expire. */
-    if (time_diff < criteria->next_exp_in) {
-        criteria->next_exp_in = time_diff;
-    }
-    return 0;
+    return 1;
 }
 
 struct ble_gattc_criteria_conn_rx_entry {
@@ -974,6 +1048,10 @@ ble_gattc_proc_matches_conn_rx_entry(struct ble_gattc_proc *proc, void *arg)
         return 0;
     }
 
+    if (proc->flags & BLE_GATTC_PROC_F_DEFERRED) {
+        return 0;
+    }
+
     /* Entry matches; indicate corresponding rx entry. */
     criteria->matching_rx_entry = ble_gattc_rx_entry_find(
         proc->op, criteria->rx_entries, criteria->num_rx_entries);
@@ -981,34 +1059,46 @@ ble_gattc_proc_matches_conn_rx_entry(struct ble_gattc_proc *proc, void *arg)
     return (criteria->matching_rx_entry != NULL);
 }
 
+/**
+ * Removes procedures matching the specified callback from the active lists
+ * and appends them to dst_list.  If a connection handle is specified, only
+ * that connection's hash bucket is searched; otherwise every active procedure
+ * is examined.
+ */
 static void
-ble_gattc_extract(ble_gattc_match_fn *cb, void *arg, int max_procs,
-                  struct ble_gattc_proc_list *dst_list)
+ble_gattc_extract(uint16_t conn_handle, ble_gattc_match_fn *cb, void *arg,
+                  int max_procs, struct ble_gattc_proc_list *dst_list)
 {
     struct ble_gattc_proc *proc;
-    struct ble_gattc_proc *prev;
     struct ble_gattc_proc *next;
     int num_extracted;
+    int by_conn;
 
     /* Only the parent task is allowed to remove entries from the list. */
     BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
     STAILQ_INIT(dst_list);
     num_extracted = 0;
+    by_conn = conn_handle != BLE_HS_CONN_HANDLE_NONE;
 
     ble_hs_lock();
 
-    prev = NULL;
-    proc = STAILQ_FIRST(&ble_gattc_procs);
+    if (by_conn) {
+        proc = TAILQ_FIRST(ble_gattc_proc_hash_bucket(conn_handle));
+    } else {
+        proc = TAILQ_FIRST(&ble_gattc_procs);
+    }
     while (proc != NULL) {
-        next = STAILQ_NEXT(proc, next);
+        if (by_conn) {
+            next = TAILQ_NEXT(proc, hash_next);
+        } else {
+            next = TAILQ_NEXT(proc, exp_next);
+        }
 
-        if (cb(proc, arg)) {
-            if (prev == NULL) {
-                STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
-            } else {
-                STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
-            }
+        if ((!by_conn || proc->conn_handle == conn_handle) &&
+            cb(proc, arg)) {
+
+            ble_gattc_proc_remove(proc);
             STAILQ_INSERT_TAIL(dst_list, proc, next);
 
             if (max_procs > 0) {
@@ -1017,8 +1107,6 @@ ble_gattc_extract(ble_gattc_match_fn *cb, void *arg, int max_procs,
                     break;
                 }
             }
-        } else {
-            prev = proc;
         }
 
         proc = next;
@@ -1028,11 +1116,11 @@ ble_gattc_extract(ble_gattc_match_fn *cb, void *arg, int max_procs,
 }
 
 static struct ble_gattc_proc *
-ble_gattc_extract_one(ble_gattc_match_fn *cb, void *arg)
+ble_gattc_extract_one(uint16_t conn_handle, ble_gattc_match_fn *cb, void *arg)
 {
     struct ble_gattc_proc_list dst_list;
 
-    ble_gattc_extract(cb, arg, 1, &dst_list);
+    ble_gattc_extract(conn_handle, cb, arg, 1, &dst_list);
     return STAILQ_FIRST(&dst_list);
 }
 
@@ -1045,7 +1133,8 @@ ble_gattc_extract_by_conn_op(uint16_t conn_handle, uint8_t op, int max_procs,
     criteria.conn_handle = conn_handle;
     criteria.op = op;
 
-    ble_gattc_extract(ble_gattc_proc_matches_conn_op, &criteria, max_procs, dst_list);
+    ble_gattc_extract(conn_handle, ble_gattc_proc_matches_conn_op, &criteria,
+                      max_procs, dst_list);
 }
 
 static void
@@ -1059,7 +1148,8 @@ ble_gattc_extract_by_conn_cid_op(uint16_t conn_handle, uint16_t psm, uint8_t op,
     criteria.op = op;
     criteria.psm = psm;
 
-    ble_gattc_extract(ble_gattc_proc_matches_conn_cid_op, &criteria, max_procs, dst_list);
+    ble_gattc_extract(conn_handle, ble_gattc_proc_matches_conn_cid_op,
+                      &criteria, max_procs, dst_list);
 }
 
 static struct ble_gattc_proc *
@@ -1080,7 +1170,8 @@ ble_gattc_proc_matches_stalled(struct ble_gattc_proc *proc, void *unused)
 static void
 ble_gattc_extract_stalled(struct ble_gattc_proc_list *dst_list)
 {
-    ble_gattc_extract(ble_gattc_proc_matches_stalled, NULL, 0, dst_list);
+    ble_gattc_extract(BLE_HS_CONN_HANDLE_NONE, ble_gattc_proc_matches_stalled,
+                      NULL, 0, dst_list);
 }
 
 /**
@@ -1090,15 +1181,38 @@ ble_gattc_extract_stalled(struct ble_gattc_proc_list *dst_list)
 static int32_t
 ble_gattc_extract_expired(struct ble_gattc_proc_list *dst_list)
 {
-    struct ble_gattc_criteria_exp criteria;
+    struct ble_gattc_proc *proc;
+    ble_npl_time_t now;
+    int32_t next_exp_in;
+    int32_t time_diff;
+
+    /* Only the parent task is allowed to remove entries from the list. */
+    BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
-    criteria.now = ble_npl_time_get();
-    criteria.next_exp_in = BLE_HS_FOREVER;
+    now = ble_npl_time_get();
+    next_exp_in = BLE_HS_FOREVER;
 
     STAILQ_INIT(dst_list);
-    ble_gattc_extract(ble_gattc_proc_matches_expired, &criteria, 0, dst_list);
 
-    return criteria.next_exp_in;
+    ble_hs_lock();
+
+    /* The active list is sorted by expiry time; stop at the first procedure
+     * that has not expired yet.
+     */
+    while ((proc = TAILQ_FIRST(&ble_gattc_procs)) != NULL) {
+        time_diff = proc->exp_os_ticks - now;
+        if (time_diff > 0) {
+            next_exp_in = time_diff;
+            break;
+        }
+
+        ble_gattc_proc_remove(proc);
+        STAILQ_INSERT_TAIL(dst_list, proc, next);
+    }
+
+    ble_hs_unlock();
+
+    return next_exp_in;
 }
 
 static struct ble_gattc_proc *
@@ -1115,7 +1229,8 @@ ble_gattc_extract_with_rx_entry(uint16_t conn_handle, uint16_t cid,
     criteria.num_rx_entries = num_rx_entries;
     criteria.matching_rx_entry = NULL;
 
-    proc = ble_gattc_extract_one(ble_gattc_proc_matches_conn_rx_entry,
+    proc = ble_gattc_extract_one(conn_handle,
+                                 ble_gattc_proc_matches_conn_rx_entry,
                                  &criteria);
     *out_rx_entry = criteria.matching_rx_entry;
 
@@ -1432,6 +1547,16 @@ ble_gattc_disc_all_svcs_cb(struct ble_gattc_proc *proc,
         STATS_INC(ble_gattc_stats, disc_all_svcs_fail);
     }
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (!(proc->flags & BLE_GATTC_PROC_F_CACHED)) {
+        if (status == 0) {
+            ble_gattc_cache_add_svc(proc->conn_handle, service);
+        } else if (status == BLE_HS_EDONE) {
+            ble_gattc_cache_svcs_done(proc->conn_handle);
+        }
+    }
+#endif
+
     if (proc->disc_all_svcs.cb == NULL) {
         rc = 0;
     } else {
@@ -1617,6 +1742,13 @@ ble_gattc_disc_all_svcs(uint16_t conn_handle, ble_gatt_disc_svc_fn *cb,
 
     ble_gattc_log_proc_init("discover all services\n");
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (ble_gattc_cache_defer(proc)) {
+        rc = 0;
+        goto done;
+    }
+#endif
+
     rc = ble_gattc_disc_all_svcs_tx(proc);
     if (rc != 0) {
         goto done;
@@ -1657,6 +1789,12 @@ ble_gattc_disc_svc_uuid_cb(struct ble_gattc_proc *proc, int status,
         STATS_INC(ble_gattc_stats, disc_svc_uuid_fail);
     }
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (!(proc->flags & BLE_GATTC_PROC_F_CACHED) && status == 0) {
+        ble_gattc_cache_add_svc(proc->conn_handle, service);
+    }
+#endif
+
     if (proc->disc_svc_uuid.cb == NULL) {
         rc = 0;
     } else {
@@ -1831,6 +1969,13 @@ ble_gattc_disc_svc_by_uuid(uint16_t conn_handle, const ble_uuid_t *uuid,
 
     ble_gattc_log_disc_svc_uuid(proc);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (ble_gattc_cache_defer(proc)) {
+        rc = 0;
+        goto done;
+    }
+#endif
+
     rc = ble_gattc_disc_svc_uuid_tx(proc);
     if (rc != 0) {
         goto done;
@@ -2186,6 +2331,18 @@ ble_gattc_disc_all_chrs_cb(struct ble_gattc_proc *proc, int status,
         STATS_INC(ble_gattc_stats, disc_all_chrs_fail);
     }
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (!(proc->flags & BLE_GATTC_PROC_F_CACHED)) {
+        if (status == 0) {
+            ble_gattc_cache_add_chr(proc->conn_handle, chr);
+        } else if (status == BLE_HS_EDONE) {
+            ble_gattc_cache_chrs_done(proc->conn_handle,
+                                      proc->disc_all_chrs.start_handle,
+                                      proc->disc_all_chrs.end_handle);
+        }
+    }
+#endif
+
     if (proc->disc_all_chrs.cb == NULL) {
         rc = 0;
     } else {
@@ -2373,6 +2530,7 @@ ble_gattc_disc_all_chrs(uint16_t conn_handle, uint16_t start_handle,
 
     ble_gattc_proc_prepare(proc, conn_handle, BLE_GATT_OP_DISC_ALL_CHRS);
 
+    proc->disc_all_chrs.start_handle = start_handle;
     proc->disc_all_chrs.prev_handle = start_handle - 1;
     proc->disc_all_chrs.end_handle = end_handle;
     proc->disc_all_chrs.cb = cb;
@@ -2380,6 +2538,13 @@ ble_gattc_disc_all_chrs(uint16_t conn_handle, uint16_t start_handle,
 
     ble_gattc_log_disc_all_chrs(proc);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (ble_gattc_cache_defer(proc)) {
+        rc = 0;
+        goto done;
+    }
+#endif
+
     rc = ble_gattc_disc_all_chrs_tx(proc);
     if (rc != 0) {
         goto done;
@@ -2419,6 +2584,12 @@ ble_gattc_disc_chr_uuid_cb(struct ble_gattc_proc *proc, int status,
         STATS_INC(ble_gattc_stats, disc_chrs_uuid_fail);
     }
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (!(proc->flags & BLE_GATTC_PROC_F_CACHED) && status == 0) {
+        ble_gattc_cache_add_chr(proc->conn_handle, chr);
+    }
+#endif
+
     if (proc->disc_chr_uuid.cb == NULL) {
         rc = 0;
     } else {
@@ -2620,6 +2791,13 @@ ble_gattc_disc_chrs_by_uuid(uint16_t conn_handle, uint16_t start_handle,
 
     ble_gattc_log_disc_chr_uuid(proc);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (ble_gattc_cache_defer(proc)) {
+        rc = 0;
+        goto done;
+    }
+#endif
+
     rc = ble_gattc_disc_chr_uuid_tx(proc);
     if (rc != 0) {
         goto done;
@@ -2659,6 +2837,18 @@ ble_gattc_disc_all_dscs_cb(struct ble_gattc_proc *proc, int status,
         STATS_INC(ble_gattc_stats, disc_all_dscs_fail);
     }
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (!(proc->flags & BLE_GATTC_PROC_F_CACHED)) {
+        if (status == 0) {
+            ble_gattc_cache_add_dsc(proc->conn_handle, dsc);
+        } else if (status == BLE_HS_EDONE) {
+            ble_gattc_cache_dscs_done(proc->conn_handle,
+                                      proc->disc_all_dscs.chr_val_handle,
+                                      proc->disc_all_dscs.end_handle);
+        }
+    }
+#endif
+
     if (proc->disc_all_dscs.cb == NULL) {
         rc = 0;
     } else {
@@ -2830,6 +3020,13 @@ ble_gattc_disc_all_dscs(uint16_t conn_handle, uint16_t start_handle,
 
     ble_gattc_log_disc_all_dscs(proc);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    if (ble_gattc_cache_defer(proc)) {
+        rc = 0;
+        goto done;
+    }
+#endif
+
     rc = ble_gattc_disc_all_dscs_tx(proc);
     if (rc != 0) {
         goto done;
@@ -2844,6 +3041,339 @@ done:
     return rc;
 }
 
+/*****************************************************************************
+ * $cache                                                                    *
+ *****************************************************************************/
+
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+
+/**
+ * Indicates whether the cache holds the complete result of the specified
+ * discovery procedure.
+ */
+static int
+ble_gattc_cache_covers(struct ble_gattc_proc *proc)
+{
+    switch (proc->op) {
+    case BLE_GATT_OP_DISC_ALL_SVCS:
+    case BLE_GATT_OP_DISC_SVC_UUID:
+        return ble_gattc_cache_covers_svcs(proc->conn_handle);
+
+    case BLE_GATT_OP_DISC_ALL_CHRS:
+        return ble_gattc_cache_covers_chrs(proc->conn_handle,
+                                           proc->disc_all_chrs.prev_handle + 1,
+                                           proc->disc_all_chrs.end_handle);
+
+    case BLE_GATT_OP_DISC_CHR_UUID:
+        return ble_gattc_cache_covers_chrs(proc->conn_handle,
+                                           proc->disc_chr_uuid.prev_handle + 1,
+                                           proc->disc_chr_uuid.end_handle);
+
+    case BLE_GATT_OP_DISC_ALL_DSCS:
+        return ble_gattc_cache_covers_dscs(proc->conn_handle,
+                                           proc->disc_all_dscs.chr_val_handle,
+                                           proc->disc_all_dscs.end_handle);
+
+    default:
+        return 0;
+    }
+}
+
+static int
+ble_gattc_proc_matches_cache_wait(struct ble_gattc_proc *proc, void *unused)
+{
+    return proc->flags & BLE_GATTC_PROC_F_CACHE_WAIT;
+}
+
+static int
+ble_gattc_proc_matches_cached(struct ble_gattc_proc *proc, void *unused)
+{
+    return proc->flags & BLE_GATTC_PROC_F_CACHED;
+}
+
+/**
+ * Lets discoveries that were waiting for the Database Hash proceed, either
+ * from the cache or over the air.
+ */
+static void
+ble_gattc_cache_release(uint16_t conn_handle)
+{
+    struct ble_gattc_proc_list wait_list;
+    struct ble_gattc_proc *proc;
+    ble_gattc_resume_fn *resume_cb;
+    int rc;
+
+    ble_gattc_extract(conn_handle, ble_gattc_proc_matches_cache_wait, NULL, 0,
+                      &wait_list);
+
+    /* Each proc is moved back to the proc list (or served and freed) below,
+     * so detach it from the wait list first.
+     */
+    while ((proc = STAILQ_FIRST(&wait_list)) != NULL) {
+        STAILQ_REMOVE_HEAD(&wait_list, next);
+        proc->flags &= ~BLE_GATTC_PROC_F_CACHE_WAIT;
+
+        if (ble_gattc_cache_defer(proc)) {
+            rc = 0;
+        } else {
+            resume_cb = ble_gattc_resume_dispatch_get(proc->op);
+            BLE_HS_DBG_ASSERT(resume_cb != NULL);
+
+            rc = resume_cb(proc);
+        }
+
+        ble_gattc_process_status(proc, rc, false);
+    }
+}
+
+static int
+ble_gattc_cache_hash_cb(uint16_t conn_handle,
+                        const struct ble_gatt_error *error,
+                        struct ble_gatt_attr *attr, void *arg)
+{
+    uint8_t db_hash[16];
+    int rc;
+
+    if (ble_gattc_cache_state(conn_handle) != BLE_GATTC_CACHE_PENDING) {
+        return 0;
+    }
+
+    if (error->status == 0 && OS_MBUF_PKTLEN(attr->om) == sizeof db_hash) {
+        rc = os_mbuf_copydata(attr->om, 0, sizeof db_hash, db_hash);
+        BLE_HS_DBG_ASSERT_EVAL(rc == 0);
+
+        ble_gattc_cache_validate(conn_handle, db_hash);
+    } else {
+        /* No usable Database Hash; discover over the air. */
+        ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_OFF);
+    }
+
+    ble_gattc_cache_release(conn_handle);
+
+    return 0;
+}
+
+/**
+ * Called before a discovery procedure transmits its first request.  If the
+ * peer's Database Hash has not been read on this connection yet, the read is
+ * initiated and the procedure waits for its result.  If the cache is valid
+ * and holds the complete result, the procedure is answered from the cache.
+ *
+ * @return                      1 if the procedure must not transmit;
+ *                              0 if it should proceed over the air.
+ */
+static int
+ble_gattc_cache_defer(struct ble_gattc_proc *proc)
+{
+    ble_uuid16_t uuid = BLE_UUID16_INIT(BLE_GATT_CHR_DB_HASH_UUID16);
+    int rc;
+
+    switch (ble_gattc_cache_state(proc->conn_handle)) {
+    case BLE_GATTC_CACHE_VALID:
+        if (!ble_gattc_cache_covers(proc)) {
+            return 0;
+        }
+
+        proc->flags |= BLE_GATTC_PROC_F_CACHED;
+        return 1;
+
+    case BLE_GATTC_CACHE_UNKNOWN:
+        ble_gattc_cache_set_state(proc->conn_handle, BLE_GATTC_CACHE_PENDING);
+
+        rc = ble_gattc_read_by_uuid(proc->conn_handle, 1, 0xffff, &uuid.u,
+                                    ble_gattc_cache_hash_cb, NULL);
+        if (rc != 0) {
+            ble_gattc_cache_set_state(proc->conn_handle,
+                                      BLE_GATTC_CACHE_OFF);
+            return 0;
+        }
+
+        /* Fall through. */
+    case BLE_GATTC_CACHE_PENDING:
+        proc->flags |= BLE_GATTC_PROC_F_CACHE_WAIT;
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Delivers a cache entry (or, if the entry is null, the final status) to a
+ * discovery procedure's callback.
+ *
+ * @return                      The return code of the callback.
+ */
+static int
+ble_gattc_cache_serve_cb(struct ble_gattc_proc *proc, int status,
+                         const struct ble_store_value_gatt_cache *value)
+{
+    struct ble_gatt_svc svc;
+    struct ble_gatt_chr chr;
+    struct ble_gatt_dsc dsc;
+
+    switch (proc->op) {
+    case BLE_GATT_OP_DISC_ALL_SVCS:
+    case BLE_GATT_OP_DISC_SVC_UUID:
+        if (value == NULL) {
+            if (proc->op == BLE_GATT_OP_DISC_ALL_SVCS) {
+                return ble_gattc_disc_all_svcs_cb(proc, status, 0, NULL);
+            }
+            return ble_gattc_disc_svc_uuid_cb(proc, status, 0, NULL);
+        }
+
+        svc.start_handle = value->handle;
+        svc.end_handle = value->end_handle;
+        svc.uuid = value->uuid;
+
+        if (proc->op == BLE_GATT_OP_DISC_ALL_SVCS) {
+            return ble_gattc_disc_all_svcs_cb(proc, 0, 0, &svc);
+        }
+        if (ble_uuid_cmp(&svc.uuid.u,
+                         &proc->disc_svc_uuid.service_uuid.u) != 0) {
+            return 0;
+        }
+        return ble_gattc_disc_svc_uuid_cb(proc, 0, 0, &svc);
+
+    case BLE_GATT_OP_DISC_ALL_CHRS:
+    case BLE_GATT_OP_DISC_CHR_UUID:
+        if (value == NULL) {
+            if (proc->op == BLE_GATT_OP_DISC_ALL_CHRS) {
+                return ble_gattc_disc_all_chrs_cb(proc, status, 0, NULL);
+            }
+            return ble_gattc_disc_chr_uuid_cb(proc, status, 0, NULL);
+        }
+
+        chr.def_handle = value->handle;
+        chr.val_handle = value->val_handle;
+        chr.properties = value->properties;
+        chr.uuid = value->uuid;
+
+        if (proc->op == BLE_GATT_OP_DISC_ALL_CHRS) {
+            return ble_gattc_disc_all_chrs_cb(proc, 0, 0, &chr);
+        }
+        if (ble_uuid_cmp(&chr.uuid.u, &proc->disc_chr_uuid.chr_uuid.u) != 0) {
+            return 0;
+        }
+        return ble_gattc_disc_chr_uuid_cb(proc, 0, 0, &chr);
+
+    case BLE_GATT_OP_DISC_ALL_DSCS:
+        if (value == NULL) {
+            return ble_gattc_disc_all_dscs_cb(proc, status, 0, NULL);
+        }
+
+        dsc.handle = value->handle;
+        dsc.uuid = value->uuid;
+
+        return ble_gattc_disc_all_dscs_cb(proc, 0, 0, &dsc);
+
+    default:
+        BLE_HS_DBG_ASSERT(0);
+        return BLE_HS_EUNKNOWN;
+    }
+}
+
+/**
+ * Answers a discovery procedure from the cache.
+ */
+static void
+ble_gattc_cache_serve(struct ble_gattc_proc *proc)
+{
+    struct ble_store_value_gatt_cache value;
+    uint16_t start_handle;
+    uint16_t end_handle;
+    uint8_t type;
+    int rc;
+
+    switch (proc->op) {
+    case BLE_GATT_OP_DISC_ALL_SVCS:
+    case BLE_GATT_OP_DISC_SVC_UUID:
+        type = BLE_STORE_GATT_CACHE_TYPE_SVC;
+        start_handle = 0x0001;
+        end_handle = 0xffff;
+        break;
+
+    case BLE_GATT_OP_DISC_ALL_CHRS:
+        type = BLE_STORE_GATT_CACHE_TYPE_CHR;
+        start_handle = proc->disc_all_chrs.prev_handle + 1;
+        end_handle = proc->disc_all_chrs.end_handle;
+        break;
+
+    case BLE_GATT_OP_DISC_CHR_UUID:
+        type = BLE_STORE_GATT_CACHE_TYPE_CHR;
+        start_handle = proc->disc_chr_uuid.prev_handle + 1;
+        end_handle = proc->disc_chr_uuid.end_handle;
+        break;
+
+    case BLE_GATT_OP_DISC_ALL_DSCS:
+        type = BLE_STORE_GATT_CACHE_TYPE_DSC;
+        start_handle = proc->disc_all_dscs.chr_val_handle + 1;
+        end_handle = proc->disc_all_dscs.end_handle;
+        break;
+
+    default:
+        BLE_HS_DBG_ASSERT(0);
+        return;
+    }
+
+    /* The store returns a peer's entries of one type in handle order; each
+     * lookup resumes right after the previously delivered entry.
+     */
+    while (start_handle != 0 && start_handle <= end_handle) {
+        rc = ble_gattc_cache_read(proc->conn_handle, type, start_handle,
+                                  end_handle, 0, &value);
+        if (rc != 0) {
+            if (rc == BLE_HS_ENOENT) {
+                rc = BLE_HS_EDONE;
+            }
+            ble_gattc_cache_serve_cb(proc, rc, NULL);
+            return;
+        }
+
+        rc = ble_gattc_cache_serve_cb(proc, 0, &value);
+        if (rc != 0) {
+            /* Application aborted the procedure. */
+            return;
+        }
+
+        start_handle = value.handle + 1;
+    }
+
+    ble_gattc_cache_serve_cb(proc, BLE_HS_EDONE, NULL);
+}
+
+static void
+ble_gattc_cache_event_handle(struct ble_npl_event *ev)
+{
+    struct ble_gattc_proc_list cached_list;
+    struct ble_gattc_proc *proc;
+
+    ble_gattc_extract(BLE_HS_CONN_HANDLE_NONE, ble_gattc_proc_matches_cached,
+                      NULL, 0, &cached_list);
+
+    while ((proc = STAILQ_FIRST(&cached_list)) != NULL) {
+        STAILQ_REMOVE_HEAD(&cached_list, next);
+
+        ble_gattc_cache_serve(proc);
+        ble_gattc_proc_free(proc);
+    }
+}
+
+static void
+ble_gattc_cache_sched(void)
+{
+#if !MYNEWT_VAL(BLE_HS_REQUIRE_OS)
+    if (!ble_npl_os_started()) {
+        ble_gattc_cache_event_handle(NULL);
+        return;
+    }
+#endif
+
+    ble_npl_eventq_put(ble_hs_evq_get(), &ble_gattc_cache_ev);
+}
+
+#endif
+
 /*****************************************************************************
  * $read                                                                     *
  *****************************************************************************/
@@ -3622,7 +4152,6 @@ ble_gattc_write_no_rsp(uint16_t conn_handle, uint16_t attr_handle,
     if (rc != 0) {
         STATS_INC(ble_gattc_stats, write);
     }
-    ble_eatt_release_chan(conn_handle, BLE_GATT_OP_DUMMY);
 
     return rc;
 }
@@ -4427,6 +4956,75 @@ ble_gatts_notify(uint16_t conn_handle, uint16_t chr_val_handle)
     return rc;
 }
 
+/**
+ * Sends a run of handle-value tuples in a single PDU: a Multiple Handle Value
+ * Notification if there are several, or a regular notification if there is
+ * only one.  The tuple values are consumed regardless of the outcome.
+ */
+static int
+ble_gatts_notify_multiple_tx(uint16_t conn_handle,
+                             struct ble_gatt_notif *tuples, size_t count)
+{
+    struct os_mbuf *txom;
+    uint16_t le16[2];
+    size_t i;
+    int rc;
+
+    if (count == 1) {
+        rc = ble_gatts_notify_custom(conn_handle, tuples[0].handle,
+                                     tuples[0].value);
+        tuples[0].value = NULL;
+        return rc;
+    }
+
+    STATS_INC(ble_gattc_stats, notify_mult);
+
+    txom = ble_hs_mbuf_att_pkt();
+    if (txom == NULL) {
+        rc = BLE_HS_ENOMEM;
+        goto done;
+    }
+
+    for (i = 0; i < count; i++) {
+        ble_gattc_log_notify(tuples[i].handle);
+
+        le16[0] = htole16(tuples[i].handle);
+        le16[1] = htole16(os_mbuf_len(tuples[i].value));
+        rc = os_mbuf_append(txom, le16, sizeof le16);
+        if (rc != 0) {
+            rc = BLE_HS_ENOMEM;
+            goto done;
+        }
+
+        os_mbuf_concat(txom, tuples[i].value);
+        tuples[i].value = NULL;
+    }
+
+    rc = ble_att_clt_tx_notify_mult(conn_handle, txom);
+    txom = NULL;
+    if (rc == 0) {
+        STATS_INCN(ble_gattc_stats, notify_mult_saved, count - 1);
+    }
+
+done:
+    if (rc != 0) {
+        STATS_INC(ble_gattc_stats, notify_mult_fail);
+    }
+
+    /* Tell the application that a notification transmission was attempted
+     * for each of the characteristics.
+     */
+    for (i = 0; i < count; i++) {
+        ble_gap_notify_tx_event(rc, conn_handle, tuples[i].handle, 0);
+        os_mbuf_free_chain(tuples[i].value);
+        tuples[i].value = NULL;
+    }
+
+    os_mbuf_free_chain(txom);
+
+    return rc;
+}
+
 int
 ble_gatts_notify_multiple_custom(uint16_t conn_handle,
                                  size_t chr_count,
@@ -4436,22 +5034,24 @@ ble_gatts_notify_multiple_custom(uint16_t conn_handle,
     return BLE_HS_ENOTSUP;
 #endif
 
-    int rc;
-    size_t i;
-    struct os_mbuf *txom;
-    uint16_t le16;
     uint8_t supported;
-    uint16_t total = 1; /* opcode */
+    uint16_t mtu;
+    size_t count;
+    size_t i;
+    int total;
+    int len;
+    int rc;
+    int tx_rc;
 
     /* validate handles sanity */
     for (i = 0; i < chr_count; i++) {
-        if (tuples->handle == 0) {
+        if (tuples[i].handle == 0) {
             rc = BLE_HS_EINVAL;
             goto err;
         }
     }
 
-    if (chr_count < 2) {
+    if (chr_count == 0) {
         rc = BLE_HS_EINVAL;
         goto err;
     }
@@ -4461,11 +5061,6 @@ ble_gatts_notify_multiple_custom(uint16_t conn_handle,
         goto err;
     }
 
-    if ((supported & 0x04) == 0) {
-        rc = BLE_HS_EREJECT;
-        goto err;
-    }
-
     /* Read missing values */
     for (i = 0; i < chr_count; i++) {
         if (tuples[i].value == NULL) {
@@ -4476,37 +5071,45 @@ ble_gatts_notify_multiple_custom(uint16_t conn_handle,
         }
     }
 
-    /* check if this fits into MTU */
-    for (i = 0; i < chr_count; i++) {
-        total += sizeof(uint16_t); /* handle */
-        total += sizeof(uint16_t); /* length */
-        total += os_mbuf_len(tuples[i].value);
-    }
+    mtu = ble_att_mtu(conn_handle);
 
-    if (total > ble_att_mtu(conn_handle)) {
-        rc = BLE_HS_EMSGSIZE;
-        goto err;
-    }
+    /* Pack as many consecutive tuples as fit into each PDU.  A peer that
+     * doesn't support multiple handle notifications gets one regular
+     * notification per characteristic instead.
+     */
+    rc = 0;
+    i = 0;
+    while (i < chr_count) {
+        count = 1;
+
+        if (supported & BLE_GATT_CHR_CLI_SUP_FEAT_MULT_NTF) {
+            /* Opcode, then handle and length per tuple. */
+            total = 1 + 4 + os_mbuf_len(tuples[i].value);
+            while (i + count < chr_count) {
+                len = 4 + os_mbuf_len(tuples[i + count].value);
+                if (total + len > mtu) {
+                    break;
+                }
 
-    txom = ble_hs_mbuf_att_pkt();
-    if (txom == NULL) {
-        rc = BLE_HS_ENOMEM;
-        goto err;
-    }
+                total += len;
+                count++;
+            }
+        }
 
-    for (i = 0; i < chr_count; i++) {
-        le16 = htole16(tuples[i].handle);
-        os_mbuf_append(txom, &le16, sizeof(uint16_t));
-        le16 = htole16(tuples[i].value->om_len);
-        os_mbuf_append(txom, &le16, sizeof(uint16_t));
-        os_mbuf_concat(txom, tuples[i].value);
+        tx_rc = ble_gatts_notify_multiple_tx(conn_handle, tuples + i, count);
+        if (rc == 0) {
+            rc = tx_rc;
+        }
+
+        i += count;
     }
 
-    return ble_att_clt_tx_notify_mult(conn_handle, txom);
+    return rc;
 
 err:
     for (i = 0; i < chr_count; i++) {
         os_mbuf_free_chain(tuples[i].value);
+        tuples[i].value = NULL;
     }
 
     return rc;
@@ -5099,6 +5702,10 @@ ble_gatts_rx_indicate_rsp(uint16_t conn_handle, uint16_t cid)
 void
 ble_gattc_connection_broken(uint16_t conn_handle)
 {
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    ble_gattc_cache_conn_broken(conn_handle);
+#endif
+
     ble_gattc_fail_procs(conn_handle, BLE_GATT_OP_NONE, BLE_HS_ENOTCONN);
 }
 
@@ -5108,15 +5715,24 @@ ble_gattc_connection_broken(uint16_t conn_handle)
 int
 ble_gattc_any_jobs(void)
 {
-    return !STAILQ_EMPTY(&ble_gattc_procs);
+    return !TAILQ_EMPTY(&ble_gattc_procs);
 }
 
 int
 ble_gattc_init(void)
 {
     int rc;
+    int i;
 
-    STAILQ_INIT(&ble_gattc_procs);
+    TAILQ_INIT(&ble_gattc_procs);
+    for (i = 0; i < BLE_GATTC_PROC_HASH_SIZE; i++) {
+        TAILQ_INIT(&ble_gattc_proc_hash[i]);
+    }
+
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    ble_npl_event_init(&ble_gattc_cache_ev, ble_gattc_cache_event_handle,
+                       NULL);
+#endif
 
     if (MYNEWT_VAL(BLE_GATT_MAX_PROCS) > 0) {
         rc = os_mempool_init(&ble_gattc_proc_pool,
@@ -0,0 +1,552 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * GATT client attribute cache.
+ *
+ * The results of service, characteristic and descriptor discovery are
+ * recorded in the host store as BLE_STORE_OBJ_TYPE_GATT_CACHE entries, keyed
+ * by the peer's identity address.  Each peer has a single hash entry holding
+ * the Database Hash the records were taken against.  On the first discovery
+ * of a connection the client reads the peer's Database Hash; if it matches
+ * the stored one, discoveries whose results are fully cached are answered
+ * from the store without any ATT traffic.  Otherwise the peer's records are
+ * dropped and rebuilt as discoveries go over the air.
+ *
+ * A parent entry is flagged complete only after all of its children have been
+ * recorded, so a discovery is only served from the cache when the cached
+ * result is exhaustive.
+ */
+
+#include <string.h>
+#include "ble_hs_priv.h"
+
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+
+#define BLE_GATTC_CACHE_UUID_SVC_CHANGED    0x2a05
+
+/**
+ * Looks up the identity address and cache state of the specified connection.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOTCONN if the connection does not
+ *                                  exist.
+ */
+static int
+ble_gattc_cache_conn_info(uint16_t conn_handle, ble_addr_t *out_peer_addr,
+                          uint8_t *out_state)
+{
+    struct ble_hs_conn_addrs addrs;
+    struct ble_hs_conn *conn;
+    int rc;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL) {
+        rc = BLE_HS_ENOTCONN;
+    } else {
+        if (out_peer_addr != NULL) {
+            ble_hs_conn_addrs(conn, &addrs);
+            *out_peer_addr = addrs.peer_id_addr;
+        }
+        if (out_state != NULL) {
+            *out_state = conn->bhc_gattc_cache_state;
+        }
+        rc = 0;
+    }
+
+    ble_hs_unlock();
+
+    return rc;
+}
+
+/**
+ * Looks up the identity address of the specified connection, but only if its
+ * cache has been validated against the peer's Database Hash.
+ */
+static int
+ble_gattc_cache_valid_peer(uint16_t conn_handle, ble_addr_t *out_peer_addr)
+{
+    uint8_t state;
+    int rc;
+
+    rc = ble_gattc_cache_conn_info(conn_handle, out_peer_addr, &state);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (state != BLE_GATTC_CACHE_VALID) {
+        return BLE_HS_ENOENT;
+    }
+
+    return 0;
+}
+
+static void
+ble_gattc_cache_set_dirty(uint16_t conn_handle)
+{
+    struct ble_hs_conn *conn;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn != NULL) {
+        conn->bhc_gattc_cache_dirty = 1;
+    }
+
+    ble_hs_unlock();
+}
+
+uint8_t
+ble_gattc_cache_state(uint16_t conn_handle)
+{
+    uint8_t state;
+    int rc;
+
+    rc = ble_gattc_cache_conn_info(conn_handle, NULL, &state);
+    if (rc != 0) {
+        return BLE_GATTC_CACHE_OFF;
+    }
+
+    return state;
+}
+
+void
+ble_gattc_cache_set_state(uint16_t conn_handle, uint8_t state)
+{
+    struct ble_hs_conn *conn;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn != NULL) {
+        conn->bhc_gattc_cache_state = state;
+    }
+
+    ble_hs_unlock();
+}
+
+static int
+ble_gattc_cache_read_hash(const ble_addr_t *peer_addr,
+                          struct ble_store_value_gatt_cache *out_value)
+{
+    struct ble_store_key_gatt_cache key;
+
+    memset(&key, 0, sizeof key);
+    key.peer_addr = *peer_addr;
+    key.type = BLE_STORE_GATT_CACHE_TYPE_HASH;
+
+    return ble_store_read_gatt_cache(&key, out_value);
+}
+
+/**
+ * Drops every cache entry of the specified peer.  The hash entry goes first
+ * so that the persisted copy of the cache is invalidated before any of the
+ * other records disappear.
+ */
+static void
+ble_gattc_cache_clear_peer(const ble_addr_t *peer_addr)
+{
+    union ble_store_key key;
+
+    memset(&key, 0, sizeof key);
+    key.gatt_cache.peer_addr = *peer_addr;
+
+    key.gatt_cache.type = BLE_STORE_GATT_CACHE_TYPE_HASH;
+    ble_store_delete_gatt_cache(&key.gatt_cache);
+
+    key.gatt_cache.type = 0;
+    ble_store_util_delete_all(BLE_STORE_OBJ_TYPE_GATT_CACHE, &key);
+}
+
+int
+ble_gattc_cache_validate(uint16_t conn_handle, const uint8_t *db_hash)
+{
+    struct ble_store_value_gatt_cache value;
+    ble_addr_t peer_addr;
+    int rc;
+
+    rc = ble_gattc_cache_conn_info(conn_handle, &peer_addr, NULL);
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = ble_gattc_cache_read_hash(&peer_addr, &value);
+    if (rc == 0 && memcmp(value.db_hash, db_hash, 16) == 0) {
+        ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_VALID);
+        return 0;
+    }
+
+    /* The peer's database changed (or was never seen); start over. */
+    ble_gattc_cache_clear_peer(&peer_addr);
+
+    memset(&value, 0, sizeof value);
+    value.peer_addr = peer_addr;
+    value.type = BLE_STORE_GATT_CACHE_TYPE_HASH;
+    memcpy(value.db_hash, db_hash, 16);
+
+    rc = ble_store_write_gatt_cache(&value);
+    if (rc != 0) {
+        ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_OFF);
+        return rc;
+    }
+
+    ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_VALID);
+    return 0;
+}
+
+static void
+ble_gattc_cache_add(uint16_t conn_handle,
+                    struct ble_store_value_gatt_cache *value)
+{
+    int rc;
+
+    rc = ble_gattc_cache_valid_peer(conn_handle, &value->peer_addr);
+    if (rc != 0) {
+        return;
+    }
+
+    rc = ble_store_write_gatt_cache(value);
+    if (rc != 0) {
+        /* Stop recording; the entries written so far never get marked
+         * complete and so are never served.
+         */
+        ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_OFF);
+        return;
+    }
+
+    ble_gattc_cache_set_dirty(conn_handle);
+}
+
+void
+ble_gattc_cache_add_svc(uint16_t conn_handle, const struct ble_gatt_svc *svc)
+{
+    struct ble_store_value_gatt_cache value;
+
+    memset(&value, 0, sizeof value);
+    value.type = BLE_STORE_GATT_CACHE_TYPE_SVC;
+    value.handle = svc->start_handle;
+    value.end_handle = svc->end_handle;
+    value.uuid = svc->uuid;
+
+    ble_gattc_cache_add(conn_handle, &value);
+}
+
+void
+ble_gattc_cache_add_chr(uint16_t conn_handle, const struct ble_gatt_chr *chr)
+{
+    struct ble_store_value_gatt_cache value;
+
+    memset(&value, 0, sizeof value);
+    value.type = BLE_STORE_GATT_CACHE_TYPE_CHR;
+    value.properties = chr->properties;
+    value.handle = chr->def_handle;
+    value.val_handle = chr->val_handle;
+    value.uuid = chr->uuid;
+
+    ble_gattc_cache_add(conn_handle, &value);
+}
+
+void
+ble_gattc_cache_add_dsc(uint16_t conn_handle, const struct ble_gatt_dsc *dsc)
+{
+    struct ble_store_value_gatt_cache value;
+
+    memset(&value, 0, sizeof value);
+    value.type = BLE_STORE_GATT_CACHE_TYPE_DSC;
+    value.handle = dsc->handle;
+    value.uuid = dsc->uuid;
+
+    ble_gattc_cache_add(conn_handle, &value);
+}
+
+/**
+ * Reads the entry of the service that contains the specified handle.
+ */
+static int
+ble_gattc_cache_read_svc(uint16_t conn_handle, uint16_t handle,
+                         struct ble_store_value_gatt_cache *out_value)
+{
+    int rc;
+    int i;
+
+    /* Discovery within a service usually starts at the service itself. */
+    rc = ble_gattc_cache_read(conn_handle, BLE_STORE_GATT_CACHE_TYPE_SVC,
+                              handle, handle, 0, out_value);
+    if (rc != BLE_HS_ENOENT) {
+        return rc;
+    }
+
+    for (i = 0; ; i++) {
+        rc = ble_gattc_cache_read(conn_handle, BLE_STORE_GATT_CACHE_TYPE_SVC,
+                                  1, handle, i, out_value);
+        if (rc != 0) {
+            return rc;
+        }
+
+        if (out_value->end_handle >= handle) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * Reads the entry of the characteristic with the specified value handle.  The
+ * value declaration immediately follows the characteristic declaration, so
+ * this is a single keyed lookup.
+ */
+static int
+ble_gattc_cache_read_chr(uint16_t conn_handle, uint16_t chr_val_handle,
+                         struct ble_store_value_gatt_cache *out_value)
+{
+    int rc;
+
+    if (chr_val_handle <= 1) {
+        return BLE_HS_ENOENT;
+    }
+
+    rc = ble_gattc_cache_read(conn_handle, BLE_STORE_GATT_CACHE_TYPE_CHR,
+                              chr_val_handle - 1, chr_val_handle - 1, 0,
+                              out_value);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (out_value->val_handle != chr_val_handle) {
+        return BLE_HS_ENOENT;
+    }
+
+    return 0;
+}
+
+void
+ble_gattc_cache_svcs_done(uint16_t conn_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    ble_addr_t peer_addr;
+    int rc;
+
+    rc = ble_gattc_cache_valid_peer(conn_handle, &peer_addr);
+    if (rc != 0) {
+        return;
+    }
+
+    rc = ble_gattc_cache_read_hash(&peer_addr, &value);
+    if (rc != 0) {
+        return;
+    }
+
+    value.flags |= BLE_STORE_GATT_CACHE_F_COMPLETE;
+    ble_store_write_gatt_cache(&value);
+}
+
+void
+ble_gattc_cache_chrs_done(uint16_t conn_handle, uint16_t start_handle,
+                          uint16_t end_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    ble_addr_t peer_addr;
+    int rc;
+    int i;
+
+    rc = ble_gattc_cache_valid_peer(conn_handle, &peer_addr);
+    if (rc != 0) {
+        return;
+    }
+
+    /* Mark every service that lies entirely within the searched range. */
+    for (i = 0; ; i++) {
+        rc = ble_gattc_cache_read(conn_handle, BLE_STORE_GATT_CACHE_TYPE_SVC,
+                                  start_handle, end_handle, i, &value);
+        if (rc != 0) {
+            break;
+        }
+
+        if (value.end_handle <= end_handle &&
+            !(value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE)) {
+
+            value.flags |= BLE_STORE_GATT_CACHE_F_COMPLETE;
+            ble_store_write_gatt_cache(&value);
+        }
+    }
+}
+
+void
+ble_gattc_cache_dscs_done(uint16_t conn_handle, uint16_t chr_val_handle,
+                          uint16_t end_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    int rc;
+
+    rc = ble_gattc_cache_read_chr(conn_handle, chr_val_handle, &value);
+    if (rc != 0) {
+        return;
+    }
+
+    if (!(value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE) ||
+        value.end_handle < end_handle) {
+
+        value.flags |= BLE_STORE_GATT_CACHE_F_COMPLETE;
+        value.end_handle = end_handle;
+        ble_store_write_gatt_cache(&value);
+    }
+}
+
+int
+ble_gattc_cache_covers_svcs(uint16_t conn_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    ble_addr_t peer_addr;
+    int rc;
+
+    rc = ble_gattc_cache_valid_peer(conn_handle, &peer_addr);
+    if (rc != 0) {
+        return 0;
+    }
+
+    rc = ble_gattc_cache_read_hash(&peer_addr, &value);
+    if (rc != 0) {
+        return 0;
+    }
+
+    return !!(value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE);
+}
+
+int
+ble_gattc_cache_covers_chrs(uint16_t conn_handle, uint16_t start_handle,
+                            uint16_t end_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    int rc;
+
+    rc = ble_gattc_cache_read_svc(conn_handle, start_handle, &value);
+    if (rc != 0) {
+        return 0;
+    }
+
+    return (value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE) &&
+           value.end_handle >= end_handle;
+}
+
+int
+ble_gattc_cache_covers_dscs(uint16_t conn_handle, uint16_t chr_val_handle,
+                            uint16_t end_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    int rc;
+
+    rc = ble_gattc_cache_read_chr(conn_handle, chr_val_handle, &value);
+    if (rc != 0) {
+        return 0;
+    }
+
+    return (value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE) &&
+           value.end_handle >= end_handle;
+}
+
+int
+ble_gattc_cache_read(uint16_t conn_handle, uint8_t type,
+                     uint16_t start_handle, uint16_t end_handle, int idx,
+                     struct ble_store_value_gatt_cache *out_value)
+{
+    struct ble_store_key_gatt_cache key;
+    int rc;
+
+    memset(&key, 0, sizeof key);
+
+    rc = ble_gattc_cache_valid_peer(conn_handle, &key.peer_addr);
+    if (rc != 0) {
+        return rc;
+    }
+
+    key.type = type;
+    key.start_handle = start_handle;
+    key.end_handle = end_handle;
+    key.idx = idx;
+
+    return ble_store_read_gatt_cache(&key, out_value);
+}
+
+void
+ble_gattc_cache_rx_indicate(uint16_t conn_handle, uint16_t attr_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    ble_addr_t peer_addr;
+    uint8_t state;
+    int rc;
+
+    rc = ble_gattc_cache_conn_info(conn_handle, &peer_addr, &state);
+    if (rc != 0 || state != BLE_GATTC_CACHE_VALID) {
+        return;
+    }
+
+    rc = ble_gattc_cache_read_chr(conn_handle, attr_handle, &value);
+    if (rc != 0) {
+        /* The handle is not in the cache, so this may be a Service Changed
+         * characteristic that was never discovered.  Keep the entries but
+         * check the Database Hash again before serving them.
+         */
+        ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_UNKNOWN);
+        return;
+    }
+
+    if (ble_uuid_u16(&value.uuid.u) != BLE_GATTC_CACHE_UUID_SVC_CHANGED) {
+        return;
+    }
+
+    /* The peer's database changed; revalidate on the next discovery. */
+    ble_gattc_cache_clear_peer(&peer_addr);
+    ble_gattc_cache_set_state(conn_handle, BLE_GATTC_CACHE_UNKNOWN);
+}
+
+void
+ble_gattc_cache_conn_broken(uint16_t conn_handle)
+{
+    struct ble_store_value_gatt_cache value;
+    struct ble_hs_conn *conn;
+    ble_addr_t peer_addr;
+    int dirty;
+    int rc;
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find(conn_handle);
+    dirty = conn != NULL && conn->bhc_gattc_cache_dirty &&
+            conn->bhc_gattc_cache_state == BLE_GATTC_CACHE_VALID;
+    ble_hs_unlock();
+
+    if (!dirty) {
+        return;
+    }
+
+    rc = ble_gattc_cache_conn_info(conn_handle, &peer_addr, NULL);
+    if (rc != 0) {
+        return;
+    }
+
+    /* Rewriting the hash entry commits the records added during this
+     * connection to persistent storage.
+     */
+    rc = ble_gattc_cache_read_hash(&peer_addr, &value);
+    if (rc == 0) {
+        ble_store_write_gatt_cache(&value);
+    }
+}
+
+#endif
@@ -63,6 +63,37 @@ struct ble_gatts_clt_cfg {
 static struct ble_gatts_clt_cfg *ble_gatts_clt_cfgs;
 static int ble_gatts_num_cfgable_chrs;
 
+/** Maximum number of notifications gathered per connection and lock. */
+#define BLE_GATTS_TX_NOTIF_BATCH    16
+
+#define BLE_GATTS_CONN_MAP_WORDS    \
+    ((MYNEWT_VAL(BLE_MAX_CONNECTIONS) + 31) / 32)
+
+/** A set of connections, indexed by subscription slot. */
+struct ble_gatts_conn_map {
+    uint32_t words[BLE_GATTS_CONN_MAP_WORDS];
+};
+
+/**
+ * Reverse CCCD index.  For each configurable characteristic (in the same order
+ * as ble_gatts_clt_cfgs), the set of connections subscribed to notifications
+ * or indications.  Connections are assigned a slot on their first
+ * subscription and release it when they terminate.  Protected by the host
+ * lock.
+ */
+static struct ble_gatts_conn_map *ble_gatts_clt_cfg_subs;
+static struct ble_gatts_conn_map ble_gatts_sub_slots;
+static uint16_t ble_gatts_sub_conn_handles[MYNEWT_VAL(BLE_MAX_CONNECTIONS)];
+
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+static uint8_t ble_gatts_db_hash[BLE_GATT_DB_HASH_SZ];
+
+/* Set whenever the attribute table changes; the hash is recalculated lazily
+ * on its next read.
+ */
+static uint8_t ble_gatts_db_hash_stale;
+#endif
+
 STATS_SECT_DECL(ble_gatts_stats) ble_gatts_stats;
 STATS_NAME_START(ble_gatts_stats)
     STATS_NAME(ble_gatts_stats, svcs)
@@ -281,7 +312,16 @@ ble_gatts_chr_is_sane(const struct ble_gatt_chr_def *chr)
     }
 
     if (chr->access_cb == NULL) {
-        return 0;
+        /* Only a read-only characteristic with a static value can get by
+         * without an access callback.
+         */
+        if (chr->static_val == NULL ||
+            chr->flags & (BLE_GATT_CHR_F_WRITE_NO_RSP |
+                          BLE_GATT_CHR_F_WRITE |
+                          BLE_GATT_CHR_F_AUTH_SIGN_WRITE |
+                          BLE_GATT_CHR_F_RELIABLE_WRITE)) {
+            return 0;
+        }
     }
 
     /* XXX: Check properties. */
@@ -416,6 +456,35 @@ ble_gatts_val_access(uint16_t conn_handle, uint16_t attr_handle,
     }
 }
 
+/**
+ * Serves a read of a characteristic with a static value.  Only the requested
+ * slice of the value is copied into the response; the application is not
+ * involved and no temporary buffer is needed for non-zero offsets.  The
+ * response is trimmed to the MTU of the bearer that carries the request.
+ */
+static int
+ble_gatts_static_val_read(const struct ble_gatt_chr_def *chr_def,
+                          uint16_t offset, struct os_mbuf *om)
+{
+    int rc;
+
+    if (offset > chr_def->static_val_len) {
+        return BLE_ATT_ERR_INVALID_OFFSET;
+    }
+
+    if (offset == chr_def->static_val_len) {
+        return 0;
+    }
+
+    rc = os_mbuf_append(om, (const uint8_t *)chr_def->static_val + offset,
+                        chr_def->static_val_len - offset);
+    if (rc != 0) {
+        return BLE_ATT_ERR_INSUFFICIENT_RES;
+    }
+
+    return 0;
+}
+
 static int
 ble_gatts_chr_val_access(uint16_t conn_handle, uint16_t attr_handle,
                          uint8_t att_op, uint16_t offset,
@@ -426,13 +495,23 @@ ble_gatts_chr_val_access(uint16_t conn_handle, uint16_t attr_handle,
     int rc;
 
     chr_def = arg;
-    BLE_HS_DBG_ASSERT(chr_def != NULL && chr_def->access_cb != NULL);
+    BLE_HS_DBG_ASSERT(chr_def != NULL);
 
     gatt_ctxt.op = ble_gatts_chr_op(att_op);
     gatt_ctxt.chr = chr_def;
     gatt_ctxt.offset = offset;
 
     ble_gatts_chr_inc_val_stat(gatt_ctxt.op);
+
+    if (chr_def->static_val != NULL &&
+        gatt_ctxt.op == BLE_GATT_ACCESS_OP_READ_CHR) {
+        return ble_gatts_static_val_read(chr_def, offset, *om);
+    }
+
+    if (chr_def->access_cb == NULL) {
+        return BLE_ATT_ERR_WRITE_NOT_PERMITTED;
+    }
+
     rc = ble_gatts_val_access(conn_handle, attr_handle, offset, &gatt_ctxt, om,
                               chr_def->access_cb, chr_def->arg);
 
@@ -597,18 +676,37 @@ ble_gatts_register_dsc(const struct ble_gatt_svc_def *svc,
 
 }
 
+/**
+ * Looks up the client configuration entry for the specified characteristic.
+ * The cache is filled in handle order, so the cache and every per-connection
+ * copy of it are sorted by value handle.
+ *
+ * @return                      The index of the entry on success; -1 if the
+ *                                  characteristic is not configurable.
+ */
 static int
 ble_gatts_clt_cfg_find_idx(struct ble_gatts_clt_cfg *cfgs,
                            uint16_t chr_val_handle)
 {
-    struct ble_gatts_clt_cfg *cfg;
+    uint16_t cur;
+    int lo;
+    int hi;
     int i;
 
-    for (i = 0; i < ble_gatts_num_cfgable_chrs; i++) {
-        cfg = cfgs + i;
-        if (cfg->chr_val_handle == chr_val_handle) {
+    lo = 0;
+    hi = ble_gatts_num_cfgable_chrs - 1;
+    while (lo <= hi) {
+        i = (lo + hi) / 2;
+        cur = cfgs[i].chr_val_handle;
+        if (cur == chr_val_handle) {
             return i;
         }
+
+        if (cur < chr_val_handle) {
+            lo = i + 1;
+        } else {
+            hi = i - 1;
+        }
     }
 
     return -1;
@@ -628,6 +726,115 @@ ble_gatts_clt_cfg_find(struct ble_gatts_clt_cfg *cfgs,
     }
 }
 
+static int
+ble_gatts_conn_map_test(const struct ble_gatts_conn_map *map, int slot)
+{
+    return !!(map->words[slot / 32] & ((uint32_t)1 << (slot % 32)));
+}
+
+static void
+ble_gatts_conn_map_set(struct ble_gatts_conn_map *map, int slot)
+{
+    map->words[slot / 32] |= (uint32_t)1 << (slot % 32);
+}
+
+static void
+ble_gatts_conn_map_clear(struct ble_gatts_conn_map *map, int slot)
+{
+    map->words[slot / 32] &= ~((uint32_t)1 << (slot % 32));
+}
+
+/**
+ * @return                      The first slot in the map not lower than the
+ *                                  one specified; -1 if there is none.
+ */
+static int
+ble_gatts_conn_map_next(const struct ble_gatts_conn_map *map, int slot)
+{
+    uint32_t word;
+    int i;
+
+    for (i = slot / 32; i < BLE_GATTS_CONN_MAP_WORDS; i++) {
+        word = map->words[i];
+        if (i == slot / 32) {
+            word &= UINT32_MAX << (slot % 32);
+        }
+        if (word != 0) {
+            return i * 32 + __builtin_ctz(word);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Records a connection's new client configuration for a characteristic in the
+ * reverse CCCD index.  Must be called with the host lock held.
+ */
+static void
+ble_gatts_clt_cfg_subs_update(struct ble_hs_conn *conn, int clt_cfg_idx,
+                              uint8_t flags)
+{
+    struct ble_gatts_conn_map *subs;
+    int slot;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    subs = ble_gatts_clt_cfg_subs + clt_cfg_idx;
+
+    if (!(flags & (BLE_GATTS_CLT_CFG_F_NOTIFY |
+                   BLE_GATTS_CLT_CFG_F_INDICATE))) {
+        if (conn->bhc_gatt_svr.sub_slot != 0) {
+            ble_gatts_conn_map_clear(subs, conn->bhc_gatt_svr.sub_slot - 1);
+        }
+        return;
+    }
+
+    if (conn->bhc_gatt_svr.sub_slot == 0) {
+        /* First subscription for this connection; assign it a slot. */
+        for (slot = 0; slot < MYNEWT_VAL(BLE_MAX_CONNECTIONS); slot++) {
+            if (!ble_gatts_conn_map_test(&ble_gatts_sub_slots, slot)) {
+                break;
+            }
+        }
+        BLE_HS_DBG_ASSERT(slot < MYNEWT_VAL(BLE_MAX_CONNECTIONS));
+        if (slot >= MYNEWT_VAL(BLE_MAX_CONNECTIONS)) {
+            return;
+        }
+
+        ble_gatts_conn_map_set(&ble_gatts_sub_slots, slot);
+        ble_gatts_sub_conn_handles[slot] = conn->bhc_handle;
+        conn->bhc_gatt_svr.sub_slot = slot + 1;
+    }
+
+    ble_gatts_conn_map_set(subs, conn->bhc_gatt_svr.sub_slot - 1);
+}
+
+/**
+ * Removes a connection from the reverse CCCD index and releases its slot.
+ * Must be called with the host lock held.
+ */
+static void
+ble_gatts_clt_cfg_subs_remove(struct ble_hs_conn *conn)
+{
+    int slot;
+    int i;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    if (conn->bhc_gatt_svr.sub_slot == 0) {
+        return;
+    }
+
+    slot = conn->bhc_gatt_svr.sub_slot - 1;
+    for (i = 0; i < ble_gatts_num_cfgable_chrs; i++) {
+        ble_gatts_conn_map_clear(ble_gatts_clt_cfg_subs + i, slot);
+    }
+
+    ble_gatts_conn_map_clear(&ble_gatts_sub_slots, slot);
+    conn->bhc_gatt_svr.sub_slot = 0;
+}
+
 static void
 ble_gatts_subscribe_event(uint16_t conn_handle, uint16_t attr_handle,
                           uint8_t reason,
@@ -677,6 +884,7 @@ ble_gatts_clt_cfg_access_locked(struct ble_hs_conn *conn, uint16_t attr_handle,
     uint16_t flags;
     uint8_t gatt_op;
     uint8_t *buf;
+    int clt_cfg_idx;
 
     /* Assume nothing needs to be persisted. */
     out_cccd->chr_val_handle = 0;
@@ -690,11 +898,12 @@ ble_gatts_clt_cfg_access_locked(struct ble_hs_conn *conn, uint16_t attr_handle,
         return BLE_ATT_ERR_UNLIKELY;
     }
 
-    clt_cfg = ble_gatts_clt_cfg_find(conn->bhc_gatt_svr.clt_cfgs,
-                                     chr_val_handle);
-    if (clt_cfg == NULL) {
+    clt_cfg_idx = ble_gatts_clt_cfg_find_idx(conn->bhc_gatt_svr.clt_cfgs,
+                                             chr_val_handle);
+    if (clt_cfg_idx == -1) {
         return BLE_ATT_ERR_UNLIKELY;
     }
+    clt_cfg = conn->bhc_gatt_svr.clt_cfgs + clt_cfg_idx;
 
     /* Assume no change in flags. */
     *out_prev_clt_cfg_flags = clt_cfg->flags;
@@ -730,6 +939,7 @@ ble_gatts_clt_cfg_access_locked(struct ble_hs_conn *conn, uint16_t attr_handle,
         if (clt_cfg->flags != flags) {
             clt_cfg->flags = flags;
             *out_cur_clt_cfg_flags = flags;
+            ble_gatts_clt_cfg_subs_update(conn, clt_cfg_idx, flags);
 
             /* Successful writes get persisted for bonded connections. */
             if (conn->bhc_sec_state.bonded) {
@@ -1245,6 +1455,8 @@ ble_gatts_connection_broken(uint16_t conn_handle)
         clt_cfgs = conn->bhc_gatt_svr.clt_cfgs;
         num_clt_cfgs = conn->bhc_gatt_svr.num_clt_cfgs;
 
+        ble_gatts_clt_cfg_subs_remove(conn);
+
         conn->bhc_gatt_svr.clt_cfgs = NULL;
         conn->bhc_gatt_svr.num_clt_cfgs = 0;
     }
@@ -1288,6 +1500,9 @@ ble_gatts_free_mem(void)
     free(ble_gatts_clt_cfg_mem);
     ble_gatts_clt_cfg_mem = NULL;
 
+    free(ble_gatts_clt_cfg_subs);
+    ble_gatts_clt_cfg_subs = NULL;
+
     free(ble_gatts_svc_entries);
     ble_gatts_svc_entries = NULL;
 }
@@ -1348,6 +1563,10 @@ ble_gatts_start(void)
     }
     ble_gatts_free_svc_defs();
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    ble_gatts_db_hash_stale = 1;
+#endif
+
     if (ble_gatts_num_cfgable_chrs == 0) {
         rc = 0;
         goto done;
@@ -1372,6 +1591,15 @@ ble_gatts_start(void)
         goto done;
     }
 
+    /* Allocate the reverse CCCD index; no connections are subscribed yet. */
+    ble_gatts_clt_cfg_subs = calloc(ble_gatts_num_cfgable_chrs,
+                                    sizeof *ble_gatts_clt_cfg_subs);
+    if (ble_gatts_clt_cfg_subs == NULL) {
+        rc = BLE_HS_ENOMEM;
+        goto done;
+    }
+    memset(&ble_gatts_sub_slots, 0, sizeof ble_gatts_sub_slots);
+
     /* Fill the cache. */
     idx = 0;
     ha = NULL;
@@ -1527,6 +1755,121 @@ ble_gatts_send_next_indicate(uint16_t conn_handle)
     return 0;
 }
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+/**
+ * Writes the Robust Caching state of a bonded peer to its stored security
+ * material, so that it is kept across connections (Vol 3, Part G, 2.5.2.1).
+ * Nothing is written for unbonded peers or if the state is already stored.
+ */
+static void
+ble_gatts_change_aware_persist(uint16_t conn_handle)
+{
+    struct ble_store_value_sec value_sec;
+    struct ble_store_key_sec key_sec;
+    struct ble_hs_conn *conn;
+    uint8_t cl_sup_feat;
+    uint8_t unaware;
+    int rc;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL || !conn->bhc_sec_state.bonded) {
+        ble_hs_unlock();
+        return;
+    }
+
+    memset(&key_sec, 0, sizeof key_sec);
+    key_sec.peer_addr = conn->bhc_peer_addr;
+    key_sec.peer_addr.type =
+        ble_hs_misc_peer_addr_type_to_id(conn->bhc_peer_addr.type);
+    cl_sup_feat = conn->bhc_gatt_svr.peer_cl_sup_feat[0];
+    unaware = !!(conn->bhc_gatt_svr.flags & BLE_GATTS_CONN_F_CHANGE_UNAWARE);
+
+    ble_hs_unlock();
+
+    rc = ble_store_read_peer_sec(&key_sec, &value_sec);
+    if (rc != 0) {
+        return;
+    }
+
+    if (value_sec.cl_sup_feat == cl_sup_feat &&
+        value_sec.change_unaware == unaware) {
+
+        return;
+    }
+
+    value_sec.cl_sup_feat = cl_sup_feat;
+    value_sec.change_unaware = unaware;
+
+    /* Written directly rather than through ble_store_write_peer_sec(); the
+     * keys did not change, so the controller's resolving list is left alone.
+     */
+    ble_store_write(BLE_STORE_OBJ_TYPE_PEER_SEC,
+                    (union ble_store_value *)&value_sec);
+}
+
+/**
+ * Restores the Robust Caching state of a bonded peer once its bond is
+ * restored.  Features the peer enabled earlier on this connection are kept.
+ */
+static void
+ble_gatts_change_aware_restore(uint16_t conn_handle)
+{
+    struct ble_store_value_sec value_sec;
+    struct ble_store_key_sec key_sec;
+    struct ble_hs_conn *conn;
+    int rc;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL) {
+        ble_hs_unlock();
+        return;
+    }
+
+    memset(&key_sec, 0, sizeof key_sec);
+    key_sec.peer_addr = conn->bhc_peer_addr;
+    key_sec.peer_addr.type =
+        ble_hs_misc_peer_addr_type_to_id(conn->bhc_peer_addr.type);
+
+    ble_hs_unlock();
+
+    rc = ble_store_read_peer_sec(&key_sec, &value_sec);
+    if (rc != 0) {
+        return;
+    }
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn != NULL) {
+        conn->bhc_gatt_svr.peer_cl_sup_feat[0] |=
+            value_sec.cl_sup_feat & BLE_GATT_CHR_CLI_SUP_FEAT_MASK;
+        if (value_sec.change_unaware) {
+            conn->bhc_gatt_svr.flags |= BLE_GATTS_CONN_F_CHANGE_UNAWARE;
+        }
+    }
+
+    ble_hs_unlock();
+
+    ble_gatts_change_aware_persist(conn_handle);
+}
+
+static int
+ble_gatts_chr_is_svc_changed(uint16_t chr_val_handle)
+{
+    struct ble_att_svr_entry *entry;
+
+    entry = ble_att_svr_find_by_handle(chr_val_handle);
+    return entry != NULL &&
+           ble_uuid_cmp(entry->ha_uuid,
+                        BLE_UUID16_DECLARE(BLE_GATT_CHR_SVC_CHANGED_UUID16))
+           == 0;
+}
+#endif
+
 int
 ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle)
 {
@@ -1536,6 +1879,9 @@ ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle)
     int clt_cfg_idx;
     int persist;
     int rc;
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    int now_aware = 0;
+#endif
 
     clt_cfg_idx = ble_gatts_clt_cfg_find_idx(ble_gatts_clt_cfgs,
                                              chr_val_handle);
@@ -1561,6 +1907,19 @@ ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle)
         /* Mark that there is no longer an outstanding txed indicate. */
         conn->bhc_gatt_svr.indicate_val_handle = 0;
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+        /* A client which confirms Service Changed is change-aware
+         * (Vol 3, Part G, 2.5.2.1).
+         */
+        if (conn->bhc_gatt_svr.flags & BLE_GATTS_CONN_F_CHANGE_UNAWARE &&
+            ble_gatts_chr_is_svc_changed(chr_val_handle)) {
+
+            conn->bhc_gatt_svr.flags &= ~(BLE_GATTS_CONN_F_CHANGE_UNAWARE |
+                                          BLE_GATTS_CONN_F_AWARE_PENDING);
+            now_aware = 1;
+        }
+#endif
+
         /* Determine if we need to persist that there is no pending indication
          * for this peer-characteristic pair.  If the characteristic has not
          * been modified since we sent the indication, there is no indication
@@ -1593,6 +1952,12 @@ ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle)
         return rc;
     }
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    if (now_aware) {
+        ble_gatts_change_aware_persist(conn_handle);
+    }
+#endif
+
     if (persist) {
         rc = ble_store_write_cccd(&cccd_value);
         if (rc != 0) {
@@ -1608,13 +1973,14 @@ ble_gatts_chr_updated(uint16_t chr_val_handle)
 {
     struct ble_store_value_cccd cccd_value;
     struct ble_store_key_cccd cccd_key;
+    struct ble_gatts_conn_map *subs;
     struct ble_gatts_clt_cfg *clt_cfg;
     struct ble_hs_conn *conn;
-    int new_notifications = 0;
+    int new_notifications;
     int clt_cfg_idx;
     int persist;
+    int slot;
     int rc;
-    int i;
 
     /* Determine if notifications or indications are allowed for this
      * characteristic.  If not, return immediately.
@@ -1627,25 +1993,30 @@ ble_gatts_chr_updated(uint16_t chr_val_handle)
 
     /*** Send notifications and indications to connected devices. */
 
+    /* Only subscribed peers need to be visited; mark their CCCD entries as
+     * modified.
+     */
+    new_notifications = 0;
+
     ble_hs_lock();
-    for (i = 0; ; i++) {
-        /* XXX: This is inefficient when there are a lot of connections.
-         * Consider using a "foreach" function to walk the connection list.
-         */
-        conn = ble_hs_conn_find_by_idx(i);
+
+    subs = ble_gatts_clt_cfg_subs + clt_cfg_idx;
+    for (slot = ble_gatts_conn_map_next(subs, 0);
+         slot != -1;
+         slot = ble_gatts_conn_map_next(subs, slot + 1)) {
+
+        conn = ble_hs_conn_find(ble_gatts_sub_conn_handles[slot]);
+        BLE_HS_DBG_ASSERT(conn != NULL);
         if (conn == NULL) {
-            break;
+            continue;
         }
 
-        BLE_HS_DBG_ASSERT_EVAL(conn->bhc_gatt_svr.num_clt_cfgs >
-                               clt_cfg_idx);
+        BLE_HS_DBG_ASSERT_EVAL(conn->bhc_gatt_svr.num_clt_cfgs > clt_cfg_idx);
         clt_cfg = conn->bhc_gatt_svr.clt_cfgs + clt_cfg_idx;
-        BLE_HS_DBG_ASSERT_EVAL(clt_cfg->chr_val_handle == chr_val_handle);
-
-        /* Mark the CCCD entry as modified. */
         clt_cfg->flags |= BLE_GATTS_CLT_CFG_F_MODIFIED;
         new_notifications = 1;
     }
+
     ble_hs_unlock();
 
     if (new_notifications) {
@@ -1782,76 +2153,106 @@ ble_gatts_peer_cl_sup_feat_update(uint16_t conn_handle, struct os_mbuf *om)
 
 done:
     ble_hs_unlock();
+
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    if (rc == 0) {
+        ble_gatts_change_aware_persist(conn_handle);
+    }
+#endif
+
     return rc;
 }
 
 /**
- * Sends notifications or indications for the specified characteristic to all
- * connected devices.  The bluetooth spec does not allow more than one
- * concurrent indication for a single peer, so this function will hold off on
- * sending such indications.
+ * Sends a batch of pending notifications to a single peer.  If the peer
+ * supports it, the batch gets packed into Multiple Handle Value Notification
+ * PDUs.
+ */
+static void
+ble_gatts_tx_notifications_batch(uint16_t conn_handle,
+                                 struct ble_gatt_notif *tuples,
+                                 int num_tuples)
+{
+    int i;
+
+#if MYNEWT_VAL(BLE_GATT_NOTIFY_MULTIPLE)
+    if (num_tuples > 1) {
+        ble_gatts_notify_multiple_custom(conn_handle, num_tuples, tuples);
+        return;
+    }
+#endif
+
+    for (i = 0; i < num_tuples; i++) {
+        ble_gatts_notify(conn_handle, tuples[i].handle);
+    }
+}
+
+/**
+ * Sends all pending notifications and indications for the specified
+ * connection.  Pending notifications are gathered under a single lock
+ * acquisition and sent together.  The bluetooth spec does not allow more than
+ * one concurrent indication for a single peer, so only one indication is
+ * started; the rest are sent as the acknowledgements arrive.
  */
 static void
-ble_gatts_tx_notifications_one_chr(uint16_t chr_val_handle)
+ble_gatts_tx_notifications_conn(uint16_t conn_handle)
 {
+    struct ble_gatt_notif tuples[BLE_GATTS_TX_NOTIF_BATCH];
     struct ble_gatts_clt_cfg *clt_cfg;
     struct ble_hs_conn *conn;
-    uint16_t conn_handle;
+    uint16_t indicate_handle;
+    int num_tuples;
     uint8_t att_op;
-    int clt_cfg_idx;
     int i;
 
-    /* Determine if notifications / indications are enabled for this
-     * characteristic.
-     */
-    clt_cfg_idx = ble_gatts_clt_cfg_find_idx(ble_gatts_clt_cfgs,
-                                             chr_val_handle);
-    if (clt_cfg_idx == -1) {
-        return;
-    }
+    do {
+        num_tuples = 0;
+        indicate_handle = 0;
 
-    for (i = 0; ; i++) {
         ble_hs_lock();
 
-        conn = ble_hs_conn_find_by_idx(i);
+        conn = ble_hs_conn_find(conn_handle);
         if (conn != NULL) {
-            BLE_HS_DBG_ASSERT_EVAL(conn->bhc_gatt_svr.num_clt_cfgs >
-                                   clt_cfg_idx);
-            clt_cfg = conn->bhc_gatt_svr.clt_cfgs + clt_cfg_idx;
-            BLE_HS_DBG_ASSERT_EVAL(clt_cfg->chr_val_handle == chr_val_handle);
+            for (i = 0;
+                 i < conn->bhc_gatt_svr.num_clt_cfgs &&
+                 num_tuples < BLE_GATTS_TX_NOTIF_BATCH;
+                 i++) {
 
-            /* Determine what type of command should get sent, if any. */
-            att_op = ble_gatts_schedule_update(conn, clt_cfg);
-            conn_handle = conn->bhc_handle;
-        } else {
-            /* Silence some spurious gcc warnings. */
-            att_op = 0;
-            conn_handle = BLE_HS_CONN_HANDLE_NONE;
-        }
-        ble_hs_unlock();
+                clt_cfg = conn->bhc_gatt_svr.clt_cfgs + i;
+                if (indicate_handle != 0 &&
+                    !(clt_cfg->flags & BLE_GATTS_CLT_CFG_F_NOTIFY)) {
 
-        if (conn == NULL) {
-            /* No more connected devices. */
-            break;
-        }
+                    /* Leave it pending until the indication is acked. */
+                    continue;
+                }
 
-        switch (att_op) {
-        case 0:
-            break;
+                /* Determine what type of command should get sent, if any. */
+                att_op = ble_gatts_schedule_update(conn, clt_cfg);
+                switch (att_op) {
+                case BLE_ATT_OP_NOTIFY_REQ:
+                    tuples[num_tuples].handle = clt_cfg->chr_val_handle;
+                    tuples[num_tuples].value = NULL;
+                    num_tuples++;
+                    break;
+
+                case BLE_ATT_OP_INDICATE_REQ:
+                    indicate_handle = clt_cfg->chr_val_handle;
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
 
-        case BLE_ATT_OP_NOTIFY_REQ:
-            ble_gatts_notify(conn_handle, chr_val_handle);
-            break;
+        ble_hs_unlock();
 
-        case BLE_ATT_OP_INDICATE_REQ:
-            ble_gatts_indicate(conn_handle, chr_val_handle);
-            break;
+        ble_gatts_tx_notifications_batch(conn_handle, tuples, num_tuples);
 
-        default:
-            BLE_HS_DBG_ASSERT(0);
-            break;
+        if (indicate_handle != 0) {
+            ble_gatts_indicate(conn_handle, indicate_handle);
         }
-    }
+    } while (num_tuples == BLE_GATTS_TX_NOTIF_BATCH);
 }
 
 /**
@@ -1862,12 +2263,27 @@ ble_gatts_tx_notifications_one_chr(uint16_t chr_val_handle)
 void
 ble_gatts_tx_notifications(void)
 {
-    uint16_t chr_val_handle;
+    uint16_t conn_handles[MYNEWT_VAL(BLE_MAX_CONNECTIONS)];
+    int num_conns;
+    int slot;
     int i;
 
-    for (i = 0; i < ble_gatts_num_cfgable_chrs; i++) {
-        chr_val_handle = ble_gatts_clt_cfgs[i].chr_val_handle;
-        ble_gatts_tx_notifications_one_chr(chr_val_handle);
+    /* Only connections subscribed to something can have pending updates. */
+    num_conns = 0;
+
+    ble_hs_lock();
+
+    for (slot = ble_gatts_conn_map_next(&ble_gatts_sub_slots, 0);
+         slot != -1;
+         slot = ble_gatts_conn_map_next(&ble_gatts_sub_slots, slot + 1)) {
+
+        conn_handles[num_conns++] = ble_gatts_sub_conn_handles[slot];
+    }
+
+    ble_hs_unlock();
+
+    for (i = 0; i < num_conns; i++) {
+        ble_gatts_tx_notifications_conn(conn_handles[i]);
     }
 }
 
@@ -1910,11 +2326,16 @@ ble_gatts_bonding_established(uint16_t conn_handle)
     }
 
     ble_hs_unlock();
+
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    ble_gatts_change_aware_persist(conn_handle);
+#endif
 }
 
 /**
  * Called when bonding has been restored via the encryption procedure.  This
  * function:
+ *     o Restores the persisted Robust Caching state of the connected peer.
  *     o Restores persisted CCCD entries for the connected peer.
  *     o Sends all pending notifications to the connected peer.
  *     o Sends up to one pending indication to the connected peer; schedules
@@ -1928,6 +2349,7 @@ ble_gatts_bonding_restored(uint16_t conn_handle)
     struct ble_gatts_clt_cfg *clt_cfg;
     struct ble_hs_conn *conn;
     uint8_t att_op;
+    int clt_cfg_idx;
     int rc;
 
     ble_hs_lock();
@@ -1944,6 +2366,10 @@ ble_gatts_bonding_restored(uint16_t conn_handle)
 
     ble_hs_unlock();
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+    ble_gatts_change_aware_restore(conn_handle);
+#endif
+
     while (1) {
         rc = ble_store_read_cccd(&cccd_key, &cccd_value);
         if (rc != 0) {
@@ -1958,10 +2384,12 @@ ble_gatts_bonding_restored(uint16_t conn_handle)
         conn = ble_hs_conn_find(conn_handle);
         BLE_HS_DBG_ASSERT(conn != NULL);
 
-        clt_cfg = ble_gatts_clt_cfg_find(conn->bhc_gatt_svr.clt_cfgs,
-                                         cccd_value.chr_val_handle);
-        if (clt_cfg != NULL) {
+        clt_cfg_idx = ble_gatts_clt_cfg_find_idx(conn->bhc_gatt_svr.clt_cfgs,
+                                                 cccd_value.chr_val_handle);
+        if (clt_cfg_idx != -1) {
+            clt_cfg = conn->bhc_gatt_svr.clt_cfgs + clt_cfg_idx;
             clt_cfg->flags = cccd_value.flags;
+            ble_gatts_clt_cfg_subs_update(conn, clt_cfg_idx, clt_cfg->flags);
 
             if (cccd_value.value_changed) {
                 /* The characteristic's value changed while the device was
@@ -2185,6 +2613,230 @@ done:
     return rc;
 }
 
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+static int
+ble_gatts_db_changed_conn(struct ble_hs_conn *conn, void *arg)
+{
+    struct ble_gatts_conn *gatts_conn;
+
+    gatts_conn = &conn->bhc_gatt_svr;
+    if (gatts_conn->peer_cl_sup_feat[0] &
+        BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING) {
+
+        gatts_conn->flags |= BLE_GATTS_CONN_F_CHANGE_UNAWARE;
+        gatts_conn->flags &= ~BLE_GATTS_CONN_F_AWARE_PENDING;
+    }
+
+    return 0;
+}
+
+static int
+ble_gatts_db_changed_peer(int obj_type, union ble_store_value *val,
+                          void *cookie)
+{
+    struct ble_store_value_sec *value_sec;
+
+    value_sec = &val->sec;
+    if (value_sec->cl_sup_feat & BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING &&
+        !value_sec->change_unaware) {
+
+        value_sec->change_unaware = 1;
+        ble_store_write(BLE_STORE_OBJ_TYPE_PEER_SEC, val);
+    }
+
+    return 0;
+}
+
+/**
+ * Called whenever the set of visible attributes changes after the server has
+ * started.  The hash is recalculated on its next read; connected clients and
+ * bonded peers which enabled Robust Caching become change-unaware.
+ */
+static void
+ble_gatts_db_changed(void)
+{
+    ble_gatts_db_hash_stale = 1;
+
+    ble_hs_lock();
+    ble_hs_conn_foreach(ble_gatts_db_changed_conn, NULL);
+    ble_hs_unlock();
+
+    ble_store_iterate(BLE_STORE_OBJ_TYPE_PEER_SEC,
+                      ble_gatts_db_changed_peer, NULL);
+}
+
+/**
+ * Calculates the Database Hash over the visible attribute table.  Only the
+ * service, include, characteristic and descriptor declarations listed in
+ * Vol 3, Part G, 7.3.1 contribute; characteristic values do not.
+ */
+static int
+ble_gatts_db_hash_calc(void)
+{
+    struct ble_att_svr_entry *ha;
+    struct os_mbuf *om;
+    uint16_t uuid16;
+    uint8_t hdr[4];
+    int with_value;
+    int rc;
+
+    om = ble_hs_mbuf_bare_pkt();
+    if (om == NULL) {
+        return BLE_HS_ENOMEM;
+    }
+
+    ha = NULL;
+    while ((ha = ble_att_svr_find_by_uuid(ha, NULL, 0xffff)) != NULL) {
+        if (ha->ha_uuid->type != BLE_UUID_TYPE_16) {
+            continue;
+        }
+
+        uuid16 = BLE_UUID16(ha->ha_uuid)->value;
+        switch (uuid16) {
+        case BLE_ATT_UUID_PRIMARY_SERVICE:
+        case BLE_ATT_UUID_SECONDARY_SERVICE:
+        case BLE_ATT_UUID_INCLUDE:
+        case BLE_ATT_UUID_CHARACTERISTIC:
+        case BLE_GATT_DSC_EXT_PROP_UUID16:
+            with_value = 1;
+            break;
+
+        case 0x2901: /* Characteristic User Description */
+        case BLE_GATT_DSC_CLT_CFG_UUID16:
+        case 0x2903: /* Server Characteristic Configuration */
+        case 0x2904: /* Characteristic Presentation Format */
+        case 0x2905: /* Characteristic Aggregate Format */
+            with_value = 0;
+            break;
+
+        default:
+            continue;
+        }
+
+        put_le16(hdr + 0, ha->ha_handle_id);
+        put_le16(hdr + 2, uuid16);
+        rc = os_mbuf_append(om, hdr, sizeof hdr);
+        if (rc != 0) {
+            rc = BLE_HS_ENOMEM;
+            goto done;
+        }
+
+        if (with_value) {
+            rc = ble_att_svr_read_handle(BLE_HS_CONN_HANDLE_NONE,
+                                         ha->ha_handle_id, 0, om, NULL);
+            if (rc != 0) {
+                goto done;
+            }
+        }
+    }
+
+    rc = ble_sm_alg_db_hash(om, ble_gatts_db_hash);
+    if (rc == 0) {
+        ble_gatts_db_hash_stale = 0;
+    }
+
+done:
+    os_mbuf_free_chain(om);
+    return rc;
+}
+
+/**
+ * Reads the current Database Hash on behalf of the specified connection.  A
+ * change-unaware client which reads the hash becomes change-aware with its
+ * next request.
+ *
+ * @param conn_handle           The connection reading the hash, or
+ *                                  BLE_HS_CONN_HANDLE_NONE for a local read.
+ * @param out_hash              On success, the hash gets written here.  Must
+ *                                  hold BLE_GATT_DB_HASH_SZ bytes.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int
+ble_gatts_db_hash_read(uint16_t conn_handle, uint8_t *out_hash)
+{
+    struct ble_hs_conn *conn;
+    int rc;
+
+    if (ble_gatts_db_hash_stale) {
+        rc = ble_gatts_db_hash_calc();
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    memcpy(out_hash, ble_gatts_db_hash, BLE_GATT_DB_HASH_SZ);
+
+    if (conn_handle != BLE_HS_CONN_HANDLE_NONE) {
+        ble_hs_lock();
+        conn = ble_hs_conn_find(conn_handle);
+        if (conn != NULL &&
+            conn->bhc_gatt_svr.flags & BLE_GATTS_CONN_F_CHANGE_UNAWARE) {
+
+            conn->bhc_gatt_svr.flags |= BLE_GATTS_CONN_F_AWARE_PENDING;
+        }
+        ble_hs_unlock();
+    }
+
+    return 0;
+}
+
+/**
+ * Checks whether an incoming ATT PDU may be processed for the specified
+ * connection (Vol 3, Part G, 2.5.2.1).  A change-unaware client gets a single
+ * request rejected with Database Out Of Sync; the request following that
+ * rejection, or following a read of the hash, makes it change-aware again.
+ * Commands from a change-unaware client are always ignored.
+ *
+ * @param conn_handle           The connection the PDU was received on.
+ * @param is_req                Whether the PDU is a request (1) or a
+ *                                  command (0).
+ *
+ * @return                      1 if the PDU may be processed; 0 if it must be
+ *                                  rejected or ignored.
+ */
+int
+ble_gatts_conn_change_aware(uint16_t conn_handle, int is_req)
+{
+    struct ble_gatts_conn *gatts_conn;
+    struct ble_hs_conn *conn;
+    int now_aware = 0;
+    int aware;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL) {
+        aware = 1;
+        goto done;
+    }
+
+    gatts_conn = &conn->bhc_gatt_svr;
+    if (!(gatts_conn->flags & BLE_GATTS_CONN_F_CHANGE_UNAWARE)) {
+        aware = 1;
+    } else if (!is_req) {
+        aware = 0;
+    } else if (gatts_conn->flags & BLE_GATTS_CONN_F_AWARE_PENDING) {
+        gatts_conn->flags &= ~(BLE_GATTS_CONN_F_CHANGE_UNAWARE |
+                               BLE_GATTS_CONN_F_AWARE_PENDING);
+        now_aware = 1;
+        aware = 1;
+    } else {
+        gatts_conn->flags |= BLE_GATTS_CONN_F_AWARE_PENDING;
+        aware = 0;
+    }
+
+done:
+    ble_hs_unlock();
+
+    if (now_aware) {
+        ble_gatts_change_aware_persist(conn_handle);
+    }
+
+    return aware;
+}
+#endif
+
 int
 ble_gatts_svc_set_visibility(uint16_t handle, int visible)
 {
@@ -2199,6 +2851,9 @@ ble_gatts_svc_set_visibility(uint16_t handle, int visible)
             } else {
                 ble_att_svr_hide_range(entry->handle, entry->end_group_handle);
             }
+#if MYNEWT_VAL(BLE_GATT_DB_HASH)
+            ble_gatts_db_changed();
+#endif
             return 0;
         }
     }
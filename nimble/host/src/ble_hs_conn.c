@@ -27,7 +27,21 @@
 /** At least three channels required per connection (sig, att, sm). */
 #define BLE_HS_CONN_MIN_CHANS       3
 
-static SLIST_HEAD(, ble_hs_conn) ble_hs_conns;
+/**
+ * Number of buckets in the connection handle hash.  Controllers tend to hand
+ * out handles sequentially, so one bucket per connection keeps most chains at
+ * a single entry.
+ */
+#if MYNEWT_VAL(BLE_MAX_CONNECTIONS) > 0
+#define BLE_HS_CONN_HASH_SIZE       MYNEWT_VAL(BLE_MAX_CONNECTIONS)
+#else
+#define BLE_HS_CONN_HASH_SIZE       1
+#endif
+
+SLIST_HEAD(ble_hs_conn_list, ble_hs_conn);
+
+static struct ble_hs_conn_list ble_hs_conns;
+static struct ble_hs_conn_list ble_hs_conn_hash[BLE_HS_CONN_HASH_SIZE];
 static struct os_mempool ble_hs_conn_pool;
 
 static os_membuf_t ble_hs_conn_elem_mem[
@@ -37,6 +51,12 @@ static os_membuf_t ble_hs_conn_elem_mem[
 
 static const uint8_t ble_hs_conn_null_addr[6];
 
+static struct ble_hs_conn_list *
+ble_hs_conn_hash_bucket(uint16_t conn_handle)
+{
+    return &ble_hs_conn_hash[conn_handle % BLE_HS_CONN_HASH_SIZE];
+}
+
 int
 ble_hs_conn_can_alloc(void)
 {
@@ -194,6 +214,7 @@ ble_hs_conn_alloc(uint16_t conn_handle)
 
     STAILQ_INIT(&conn->bhc_tx_q);
     STAILQ_INIT(&conn->att_tx_q);
+    ble_hs_tx_sched_conn_init(conn);
 
     STATS_INC(ble_hs_stats, conn_create);
 
@@ -211,6 +232,11 @@ ble_hs_conn_delete_chan(struct ble_hs_conn *conn, struct ble_l2cap_chan *chan)
     ble_l2cap_chan_free(conn, chan);
 }
 
+/**
+ * Calls the specified function for each established connection.  Iteration
+ * stops early if the callback returns nonzero.  The caller must hold the host
+ * lock for the duration of the walk.
+ */
 void
 ble_hs_conn_foreach(ble_hs_conn_foreach_fn *cb, void *arg)
 {
@@ -279,6 +305,8 @@ ble_hs_conn_insert(struct ble_hs_conn *conn)
 
     BLE_HS_DBG_ASSERT_EVAL(ble_hs_conn_find(conn->bhc_handle) == NULL);
     SLIST_INSERT_HEAD(&ble_hs_conns, conn, bhc_next);
+    SLIST_INSERT_HEAD(ble_hs_conn_hash_bucket(conn->bhc_handle), conn,
+                      bhc_hash_next);
 }
 
 void
@@ -291,6 +319,9 @@ ble_hs_conn_remove(struct ble_hs_conn *conn)
     BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
 
     SLIST_REMOVE(&ble_hs_conns, conn, ble_hs_conn, bhc_next);
+    SLIST_REMOVE(ble_hs_conn_hash_bucket(conn->bhc_handle), conn, ble_hs_conn,
+                 bhc_hash_next);
+    ble_hs_tx_sched_conn_remove(conn);
 }
 
 struct ble_hs_conn *
@@ -304,7 +335,7 @@ ble_hs_conn_find(uint16_t conn_handle)
 
     BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
 
-    SLIST_FOREACH(conn, &ble_hs_conns, bhc_next) {
+    SLIST_FOREACH(conn, ble_hs_conn_hash_bucket(conn_handle), bhc_hash_next) {
         if (conn->bhc_handle == conn_handle) {
             return conn;
         }
@@ -557,6 +588,7 @@ int
 ble_hs_conn_init(void)
 {
     int rc;
+    int i;
 
     rc = os_mempool_init(&ble_hs_conn_pool, MYNEWT_VAL(BLE_MAX_CONNECTIONS),
                          sizeof (struct ble_hs_conn),
@@ -566,6 +598,9 @@ ble_hs_conn_init(void)
     }
 
     SLIST_INIT(&ble_hs_conns);
+    for (i = 0; i < BLE_HS_CONN_HASH_SIZE; i++) {
+        SLIST_INIT(&ble_hs_conn_hash[i]);
+    }
 
     return 0;
 }
@@ -24,6 +24,7 @@
 #include "ble_l2cap_priv.h"
 #include "ble_gatt_priv.h"
 #include "ble_att_priv.h"
+#include "ble_hs_tx_sched_priv.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -50,6 +51,8 @@ typedef uint8_t ble_hs_conn_flags_t;
 
 struct ble_hs_conn {
     SLIST_ENTRY(ble_hs_conn) bhc_next;
+    /* Next connection in the same handle hash bucket. */
+    SLIST_ENTRY(ble_hs_conn) bhc_hash_next;
     uint16_t bhc_handle;
     uint8_t bhc_our_addr_type;
 #if MYNEWT_VAL(BLE_EXT_ADV)
@@ -101,10 +104,19 @@ struct ble_hs_conn {
 
     /** Queue of outgoing packets that could not be sent. */
     STAILQ_HEAD(, os_mbuf_pkthdr) bhc_tx_q;
+    struct ble_hs_tx_sched_conn bhc_tx_sched;
 
     struct ble_att_svr_conn bhc_att_svr;
     struct ble_gatts_conn bhc_gatt_svr;
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    /** State of the GATT client cache (BLE_GATTC_CACHE_[...]). */
+    uint8_t bhc_gattc_cache_state;
+
+    /** Cache entries were recorded during this connection. */
+    uint8_t bhc_gattc_cache_dirty;
+#endif
+
     struct ble_gap_sec_state bhc_sec_state;
 
     ble_gap_event_fn *bhc_cb;
@@ -116,6 +128,14 @@ struct ble_hs_conn {
 
     STAILQ_HEAD(, os_mbuf_pkthdr) att_tx_q;
     bool client_att_busy;
+
+#if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 0
+    /* Client procedures the bearer scheduler assigned to the fixed ATT
+     * channel, and its smooth weighted round-robin state.
+     */
+    uint8_t client_att_procs;
+    int32_t att_sched_cur;
+#endif
 };
 
 struct ble_hs_conn_addrs {
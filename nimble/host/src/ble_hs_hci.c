@@ -40,6 +40,50 @@ static uint8_t ble_hs_hci_version;
 
 static struct ble_hs_hci_sup_cmd ble_hs_hci_sup_cmd;
 
+/**
+ * The number of commands the controller is currently willing to accept, as
+ * reported in the Num_HCI_Command_Packets field of the last Command Complete
+ * or Command Status event.  The host may assume one credit until told
+ * otherwise.  Updated from the transport context; access in a critical
+ * section.
+ */
+static uint8_t ble_hs_hci_cmd_credits = 1;
+
+/** An HCI command submitted with ble_hs_hci_cmd_tx_async(). */
+struct ble_hs_hci_async_cmd {
+    STAILQ_ENTRY(ble_hs_hci_async_cmd) next;
+
+    ble_hs_hci_cmd_cb *cb;
+    void *arg;
+    int status;
+    uint16_t opcode;
+
+    /* Command parameters until sent; return parameters once acked. */
+    uint8_t params_len;
+    uint8_t params[BLE_HS_HCI_CMD_ASYNC_PARAMS_MAX];
+};
+
+STAILQ_HEAD(ble_hs_hci_async_list, ble_hs_hci_async_cmd);
+
+static os_membuf_t ble_hs_hci_async_mem[
+    OS_MEMPOOL_SIZE(MYNEWT_VAL(BLE_HS_HCI_CMD_ASYNC_COUNT),
+                    sizeof (struct ble_hs_hci_async_cmd))
+];
+static struct os_mempool ble_hs_hci_async_pool;
+
+/* Queued but not yet sent; protected by the HCI mutex. */
+static struct ble_hs_hci_async_list ble_hs_hci_async_pending;
+
+/* Sent and awaiting an ack, or acked and awaiting their callback.  Both are
+ * shared with the transport context; protected by a critical section.
+ */
+static struct ble_hs_hci_async_list ble_hs_hci_async_inflight;
+static struct ble_hs_hci_async_list ble_hs_hci_async_done;
+
+/* Signalled whenever a command completes or a credit is returned. */
+static struct ble_npl_sem ble_hs_hci_async_sem;
+static struct ble_npl_event ble_hs_hci_async_ev;
+
 #if MYNEWT_VAL(BLE_CONTROLLER)
 #define BLE_HS_HCI_FRAG_DATABUF_SIZE    \
     (BLE_ACL_MAX_PKT_SIZE +             \
@@ -157,8 +201,6 @@ ble_hs_hci_rx_cmd_complete(const void *data, int len,
             return BLE_HS_ECONTROLLER;
         }
 
-        /* TODO Process num_pkts field. */
-
         out_ack->bha_status = 0;
         out_ack->bha_params = NULL;
         out_ack->bha_params_len = 0;
@@ -167,8 +209,6 @@ ble_hs_hci_rx_cmd_complete(const void *data, int len,
 
     opcode = le16toh(ev->opcode);
 
-    /* TODO Process num_pkts field. */
-
     out_ack->bha_opcode = opcode;
 
     out_ack->bha_status = BLE_HS_HCI_ERR(ev->status);
@@ -192,8 +232,6 @@ ble_hs_hci_rx_cmd_status(const void *data, int len,
         return BLE_HS_ECONTROLLER;
     }
 
-    /* XXX: Process num_pkts field. */
-
     out_ack->bha_opcode = le16toh(ev->opcode);
     out_ack->bha_params = NULL;
     out_ack->bha_params_len = 0;
@@ -203,38 +241,38 @@ ble_hs_hci_rx_cmd_status(const void *data, int len,
 }
 
 static int
-ble_hs_hci_process_ack(uint16_t expected_opcode,
-                       uint8_t *params_buf, uint8_t params_buf_len,
-                       struct ble_hs_hci_ack *out_ack)
+ble_hs_hci_ack_parse(const struct ble_hci_ev *ev,
+                     struct ble_hs_hci_ack *out_ack)
 {
-    int rc;
-
-    BLE_HS_DBG_ASSERT(ble_hs_hci_ack != NULL);
-
-    /* Count events received */
-    STATS_INC(ble_hs_stats, hci_event);
-
-
     /* Clear ack fields up front to silence spurious gcc warnings. */
     memset(out_ack, 0, sizeof *out_ack);
 
-    switch (ble_hs_hci_ack->opcode) {
+    switch (ev->opcode) {
     case BLE_HCI_EVCODE_COMMAND_COMPLETE:
-        rc = ble_hs_hci_rx_cmd_complete(ble_hs_hci_ack->data,
-                                        ble_hs_hci_ack->length, out_ack);
-        break;
+        return ble_hs_hci_rx_cmd_complete(ev->data, ev->length, out_ack);
 
     case BLE_HCI_EVCODE_COMMAND_STATUS:
-        rc = ble_hs_hci_rx_cmd_status(ble_hs_hci_ack->data,
-                                      ble_hs_hci_ack->length, out_ack);
-        break;
+        return ble_hs_hci_rx_cmd_status(ev->data, ev->length, out_ack);
 
     default:
         BLE_HS_DBG_ASSERT(0);
-        rc = BLE_HS_EUNKNOWN;
-        break;
+        return BLE_HS_EUNKNOWN;
     }
+}
+
+static int
+ble_hs_hci_process_ack(uint16_t expected_opcode,
+                       uint8_t *params_buf, uint8_t params_buf_len,
+                       struct ble_hs_hci_ack *out_ack)
+{
+    int rc;
+
+    BLE_HS_DBG_ASSERT(ble_hs_hci_ack != NULL);
+
+    /* Count events received */
+    STATS_INC(ble_hs_stats, hci_event);
 
+    rc = ble_hs_hci_ack_parse(ble_hs_hci_ack, out_ack);
     if (rc == 0) {
         if (params_buf == NULL || out_ack->bha_params == NULL) {
             out_ack->bha_params_len = 0;
@@ -259,19 +297,154 @@ ble_hs_hci_process_ack(uint16_t expected_opcode,
     return rc;
 }
 
+static void
+ble_hs_hci_async_signal(void)
+{
+    if (ble_npl_sem_get_count(&ble_hs_hci_async_sem) == 0) {
+        ble_npl_sem_release(&ble_hs_hci_async_sem);
+    }
+}
+
+/**
+ * Records the Num_HCI_Command_Packets value carried by a Command Complete or
+ * Command Status event.  The value is absolute: it replaces, rather than
+ * adds to, the current credit count.
+ */
+static void
+ble_hs_hci_cmd_credits_update(const struct ble_hci_ev *ev)
+{
+    const struct ble_hci_ev_command_complete_nop *cmd_complete;
+    const struct ble_hci_ev_command_status *cmd_status;
+    uint8_t num_pkts;
+    os_sr_t sr;
+
+    switch (ev->opcode) {
+    case BLE_HCI_EVCODE_COMMAND_COMPLETE:
+        if (ev->length < sizeof(*cmd_complete)) {
+            return;
+        }
+        cmd_complete = (const void *)ev->data;
+        num_pkts = cmd_complete->num_packets;
+        break;
+
+    case BLE_HCI_EVCODE_COMMAND_STATUS:
+        if (ev->length < sizeof(*cmd_status)) {
+            return;
+        }
+        cmd_status = (const void *)ev->data;
+        num_pkts = cmd_status->num_packets;
+        break;
+
+    default:
+        return;
+    }
+
+    OS_ENTER_CRITICAL(sr);
+    ble_hs_hci_cmd_credits = num_pkts;
+    OS_EXIT_CRITICAL(sr);
+}
+
+/**
+ * Consumes one command credit.
+ *
+ * @return                      1 if a credit was available; 0 otherwise.
+ */
 static int
-ble_hs_hci_wait_for_ack(void)
+ble_hs_hci_cmd_credit_take(void)
 {
+    os_sr_t sr;
     int rc;
 
+    OS_ENTER_CRITICAL(sr);
+    rc = ble_hs_hci_cmd_credits > 0;
+    if (rc) {
+        ble_hs_hci_cmd_credits--;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+static void
+ble_hs_hci_cmd_credit_give(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    ble_hs_hci_cmd_credits++;
+    OS_EXIT_CRITICAL(sr);
+}
+
+/**
+ * Blocks until the controller can accept another command.  Must be called
+ * with the HCI mutex held.
+ */
+static int
+ble_hs_hci_wait_for_credit(void)
+{
+    int rc;
+
+    while (!ble_hs_hci_cmd_credit_take()) {
+        rc = ble_npl_sem_pend(&ble_hs_hci_async_sem,
+                              ble_npl_time_ms_to_ticks32(
+                                  BLE_HCI_CMD_TIMEOUT_MS));
+        switch (rc) {
+        case 0:
+            /* The wakeup may have been meant for a task draining async
+             * commands; pass it on.
+             */
+            if (!STAILQ_EMPTY(&ble_hs_hci_async_done)) {
+                ble_hs_hci_async_signal();
+            }
+            break;
+        case OS_TIMEOUT:
+            STATS_INC(ble_hs_stats, hci_timeout);
+            return BLE_HS_ETIMEOUT_HCI;
+        default:
+            return BLE_HS_EOS;
+        }
+    }
+
+    return 0;
+}
+
 #if MYNEWT_VAL(BLE_HS_PHONY_HCI_ACKS)
+static int
+ble_hs_hci_phony_ack(struct ble_hci_ev **out_ev)
+{
+    struct ble_hci_ev *ev;
+    int rc;
+
+    *out_ev = NULL;
+
     if (ble_hs_hci_phony_ack_cb == NULL) {
         rc = BLE_HS_ETIMEOUT_HCI;
     } else {
-        ble_hs_hci_ack = ble_transport_alloc_cmd();
-        BLE_HS_DBG_ASSERT(ble_hs_hci_ack != NULL);
-        rc = ble_hs_hci_phony_ack_cb((void *)ble_hs_hci_ack, 260);
+        ev = ble_transport_alloc_cmd();
+        BLE_HS_DBG_ASSERT(ev != NULL);
+        rc = ble_hs_hci_phony_ack_cb((void *)ev, 260);
+        if (rc == 0) {
+            ble_hs_hci_cmd_credits_update(ev);
+        }
+        *out_ev = ev;
     }
+
+    if (rc != 0) {
+        /* Nothing will ever return the credit spent on this command. */
+        ble_hs_hci_cmd_credit_give();
+    }
+
+    return rc;
+}
+#endif
+
+static int
+ble_hs_hci_wait_for_ack(void)
+{
+    int rc;
+
+#if MYNEWT_VAL(BLE_HS_PHONY_HCI_ACKS)
+    rc = ble_hs_hci_phony_ack(&ble_hs_hci_ack);
 #else
     rc = ble_npl_sem_pend(&ble_hs_hci_sem,
                           ble_npl_time_ms_to_ticks32(BLE_HCI_CMD_TIMEOUT_MS));
@@ -316,8 +489,15 @@ ble_hs_hci_cmd_tx(uint16_t opcode, const void *cmd, uint8_t cmd_len,
     ble_hs_hci_lock();
     BLE_HS_DBG_ASSERT(ble_hs_hci_ack == NULL);
 
+    rc = ble_hs_hci_wait_for_credit();
+    if (rc != 0) {
+        ble_hs_sched_reset(rc);
+        goto done;
+    }
+
     rc = ble_hs_hci_cmd_send_buf(opcode, cmd, cmd_len);
     if (rc != 0) {
+        ble_hs_hci_cmd_credit_give();
         goto done;
     }
 
@@ -351,6 +531,327 @@ done:
     return rc;
 }
 
+/**
+ * Hands an ack to the in-flight async command it belongs to, if any.  The
+ * ack buffer is consumed on success.  Called from the transport context.
+ *
+ * @return                      0 if the ack was consumed;
+ *                              BLE_HS_ENOENT if no async command is waiting
+ *                                  for it.
+ */
+static int
+ble_hs_hci_async_rx_ack(struct ble_hci_ev *ev)
+{
+    struct ble_hs_hci_async_cmd *cmd;
+    struct ble_hs_hci_ack ack;
+    os_sr_t sr;
+    int rc;
+
+    rc = ble_hs_hci_ack_parse(ev, &ack);
+    if (rc != 0) {
+        return BLE_HS_ENOENT;
+    }
+
+    /* The controller may complete commands out of order; the oldest
+     * outstanding command with a matching opcode is the one being acked.
+     */
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(cmd, &ble_hs_hci_async_inflight, next) {
+        if (cmd->opcode == ack.bha_opcode) {
+            STAILQ_REMOVE(&ble_hs_hci_async_inflight, cmd,
+                          ble_hs_hci_async_cmd, next);
+            break;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    if (cmd == NULL) {
+        return BLE_HS_ENOENT;
+    }
+
+    cmd->status = ack.bha_status;
+    if (ack.bha_params_len > sizeof(cmd->params)) {
+        cmd->status = BLE_HS_ECONTROLLER;
+        cmd->params_len = 0;
+    } else {
+        cmd->params_len = ack.bha_params_len;
+        if (cmd->params_len > 0) {
+            memcpy(cmd->params, ack.bha_params, cmd->params_len);
+        }
+    }
+
+    ble_transport_free(ev);
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_INSERT_TAIL(&ble_hs_hci_async_done, cmd, next);
+    OS_EXIT_CRITICAL(sr);
+
+    ble_npl_eventq_put(ble_hs_evq_get(), &ble_hs_hci_async_ev);
+    ble_hs_hci_async_signal();
+
+    return 0;
+}
+
+static void
+ble_hs_hci_async_fail(struct ble_hs_hci_async_cmd *cmd, int status)
+{
+    os_sr_t sr;
+
+    cmd->status = status;
+    cmd->params_len = 0;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_INSERT_TAIL(&ble_hs_hci_async_done, cmd, next);
+    OS_EXIT_CRITICAL(sr);
+}
+
+/**
+ * Executes the callbacks of all acked async commands and frees them.
+ */
+static void
+ble_hs_hci_async_complete(void)
+{
+    struct ble_hs_hci_async_cmd *cmd;
+    os_sr_t sr;
+    int rc;
+
+    while (1) {
+        OS_ENTER_CRITICAL(sr);
+        cmd = STAILQ_FIRST(&ble_hs_hci_async_done);
+        if (cmd != NULL) {
+            STAILQ_REMOVE_HEAD(&ble_hs_hci_async_done, next);
+        }
+        OS_EXIT_CRITICAL(sr);
+
+        if (cmd == NULL) {
+            break;
+        }
+
+        if (cmd->cb != NULL) {
+            cmd->cb(cmd->opcode, cmd->status,
+                    cmd->params_len > 0 ? cmd->params : NULL,
+                    cmd->params_len, cmd->arg);
+        }
+
+        rc = os_memblock_put(&ble_hs_hci_async_pool, cmd);
+        BLE_HS_DBG_ASSERT_EVAL(rc == 0);
+    }
+}
+
+/**
+ * Sends queued async commands for as long as the controller has command
+ * credits available.
+ */
+static void
+ble_hs_hci_async_kick(void)
+{
+    struct ble_hs_hci_async_cmd *cmd;
+#if MYNEWT_VAL(BLE_HS_PHONY_HCI_ACKS)
+    struct ble_hci_ev *ev;
+#endif
+    os_sr_t sr;
+    int rc;
+
+    ble_hs_hci_lock();
+
+    while ((cmd = STAILQ_FIRST(&ble_hs_hci_async_pending)) != NULL) {
+        if (!ble_hs_hci_cmd_credit_take()) {
+            break;
+        }
+
+        STAILQ_REMOVE_HEAD(&ble_hs_hci_async_pending, next);
+
+        /* Track the command before sending it; the ack may arrive before
+         * the transport returns.
+         */
+        OS_ENTER_CRITICAL(sr);
+        STAILQ_INSERT_TAIL(&ble_hs_hci_async_inflight, cmd, next);
+        OS_EXIT_CRITICAL(sr);
+
+        rc = ble_hs_hci_cmd_send_buf(cmd->opcode, cmd->params,
+                                     cmd->params_len);
+        if (rc == BLE_HS_ENOMEM || rc == BLE_HS_ENOMEM_EVT) {
+            /* The transport is out of command buffers; retry once an
+             * outstanding command completes.
+             */
+            OS_ENTER_CRITICAL(sr);
+            STAILQ_REMOVE(&ble_hs_hci_async_inflight, cmd,
+                          ble_hs_hci_async_cmd, next);
+            OS_EXIT_CRITICAL(sr);
+
+            ble_hs_hci_cmd_credit_give();
+            STAILQ_INSERT_HEAD(&ble_hs_hci_async_pending, cmd, next);
+            break;
+        }
+
+        if (rc == 0) {
+#if MYNEWT_VAL(BLE_HS_PHONY_HCI_ACKS)
+            rc = ble_hs_hci_phony_ack(&ev);
+            if (rc == 0 && ble_hs_hci_async_rx_ack(ev) != 0) {
+                rc = BLE_HS_ECONTROLLER;
+            }
+            if (rc != 0 && ev != NULL) {
+                ble_transport_free(ev);
+            }
+#endif
+        } else {
+            ble_hs_hci_cmd_credit_give();
+        }
+
+        if (rc != 0) {
+            OS_ENTER_CRITICAL(sr);
+            STAILQ_REMOVE(&ble_hs_hci_async_inflight, cmd,
+                          ble_hs_hci_async_cmd, next);
+            OS_EXIT_CRITICAL(sr);
+
+            ble_hs_hci_async_fail(cmd, rc);
+            ble_npl_eventq_put(ble_hs_evq_get(), &ble_hs_hci_async_ev);
+        }
+    }
+
+    ble_hs_hci_unlock();
+}
+
+static void
+ble_hs_hci_async_event_fn(struct ble_npl_event *ev)
+{
+    ble_hs_hci_async_complete();
+    ble_hs_hci_async_kick();
+}
+
+/**
+ * Queues an HCI command for transmission without waiting for it to be
+ * acknowledged.  Commands are sent in submission order, as many at a time
+ * as the controller's Num_HCI_Command_Packets allows.  The callback is
+ * executed in the host task (or in ble_hs_hci_cmd_async_drain()) once the
+ * corresponding Command Complete or Command Status event is received.
+ *
+ * @return                      0 if the command was queued;
+ *                              BLE_HS_EINVAL if the command parameters are
+ *                                  too long to be queued;
+ *                              BLE_HS_ENOMEM if too many commands are
+ *                                  already queued.
+ */
+int
+ble_hs_hci_cmd_tx_async(uint16_t opcode, const void *cmd, uint8_t cmd_len,
+                        ble_hs_hci_cmd_cb *cb, void *arg)
+{
+    struct ble_hs_hci_async_cmd *entry;
+
+    if (cmd_len > BLE_HS_HCI_CMD_ASYNC_PARAMS_MAX) {
+        return BLE_HS_EINVAL;
+    }
+
+    entry = os_memblock_get(&ble_hs_hci_async_pool);
+    if (entry == NULL) {
+        return BLE_HS_ENOMEM;
+    }
+
+    entry->cb = cb;
+    entry->arg = arg;
+    entry->status = 0;
+    entry->opcode = opcode;
+    entry->params_len = cmd_len;
+    if (cmd_len > 0) {
+        memcpy(entry->params, cmd, cmd_len);
+    }
+
+    ble_hs_hci_lock();
+    STAILQ_INSERT_TAIL(&ble_hs_hci_async_pending, entry, next);
+    ble_hs_hci_unlock();
+
+    ble_hs_hci_async_kick();
+
+    return 0;
+}
+
+/**
+ * Blocks until every queued async command has been acknowledged and its
+ * callback executed.  Callbacks run in the calling task.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ETIMEOUT_HCI if the controller stopped
+ *                                  responding.  Outstanding commands are
+ *                                  completed with the same error.
+ */
+int
+ble_hs_hci_cmd_async_drain(void)
+{
+    os_sr_t sr;
+    int busy;
+    int rc;
+
+    while (1) {
+        ble_hs_hci_async_complete();
+        ble_hs_hci_async_kick();
+
+        OS_ENTER_CRITICAL(sr);
+        if (!STAILQ_EMPTY(&ble_hs_hci_async_done)) {
+            busy = -1;
+        } else {
+            busy = !STAILQ_EMPTY(&ble_hs_hci_async_pending) ||
+                   !STAILQ_EMPTY(&ble_hs_hci_async_inflight);
+        }
+        OS_EXIT_CRITICAL(sr);
+
+        if (busy < 0) {
+            continue;
+        }
+        if (!busy) {
+            return 0;
+        }
+
+        rc = ble_npl_sem_pend(&ble_hs_hci_async_sem,
+                              ble_npl_time_ms_to_ticks32(
+                                  BLE_HCI_CMD_TIMEOUT_MS));
+        if (rc == OS_TIMEOUT) {
+            STATS_INC(ble_hs_stats, hci_timeout);
+            ble_hs_hci_cmd_async_flush(BLE_HS_ETIMEOUT_HCI);
+            ble_hs_sched_reset(BLE_HS_ETIMEOUT_HCI);
+            return BLE_HS_ETIMEOUT_HCI;
+        }
+    }
+}
+
+/**
+ * Completes every queued and in-flight async command with the specified
+ * status and restores the initial command credit.  Used when the
+ * controller is reset or stops responding; any late acks are discarded.
+ */
+void
+ble_hs_hci_cmd_async_flush(int status)
+{
+    struct ble_hs_hci_async_cmd *cmd;
+    os_sr_t sr;
+
+    ble_hs_hci_lock();
+
+    while ((cmd = STAILQ_FIRST(&ble_hs_hci_async_pending)) != NULL) {
+        STAILQ_REMOVE_HEAD(&ble_hs_hci_async_pending, next);
+        ble_hs_hci_async_fail(cmd, status);
+    }
+
+    while (1) {
+        OS_ENTER_CRITICAL(sr);
+        cmd = STAILQ_FIRST(&ble_hs_hci_async_inflight);
+        if (cmd != NULL) {
+            STAILQ_REMOVE_HEAD(&ble_hs_hci_async_inflight, next);
+        } else {
+            ble_hs_hci_cmd_credits = 1;
+        }
+        OS_EXIT_CRITICAL(sr);
+
+        if (cmd == NULL) {
+            break;
+        }
+        ble_hs_hci_async_fail(cmd, status);
+    }
+
+    ble_hs_hci_unlock();
+
+    ble_hs_hci_async_complete();
+}
+
 #if MYNEWT_VAL(BLE_HCI_VS)
 int
 ble_hs_hci_send_vs_cmd(uint16_t ocf, const void *cmdbuf, uint8_t cmdlen,
@@ -368,6 +869,10 @@ ble_hs_hci_send_vs_cmd(uint16_t ocf, const void *cmdbuf, uint8_t cmdlen,
 static void
 ble_hs_hci_rx_ack(uint8_t *ack_ev)
 {
+    if (ble_hs_hci_async_rx_ack((struct ble_hci_ev *)ack_ev) == 0) {
+        return;
+    }
+
     if (ble_npl_sem_get_count(&ble_hs_hci_sem) > 0) {
         /* This ack is unexpected; ignore it. */
         ble_transport_free(ack_ev);
@@ -388,15 +893,20 @@ ble_hs_hci_rx_evt(uint8_t *hci_ev, void *arg)
     struct ble_hci_ev *ev = (void *) hci_ev;
     struct ble_hci_ev_command_complete *cmd_complete = (void *) ev->data;
     struct ble_hci_ev_command_status *cmd_status = (void *) ev->data;
+    int credits = 0;
     int enqueue;
 
     BLE_HS_DBG_ASSERT(hci_ev != NULL);
 
     switch (ev->opcode) {
     case BLE_HCI_EVCODE_COMMAND_COMPLETE:
+        ble_hs_hci_cmd_credits_update(ev);
+        credits = 1;
         enqueue = (cmd_complete->opcode == BLE_HCI_OPCODE_NOP);
         break;
     case BLE_HCI_EVCODE_COMMAND_STATUS:
+        ble_hs_hci_cmd_credits_update(ev);
+        credits = 1;
         enqueue = (cmd_status->opcode == BLE_HCI_OPCODE_NOP);
         break;
     default:
@@ -410,6 +920,14 @@ ble_hs_hci_rx_evt(uint8_t *hci_ev, void *arg)
         ble_hs_hci_rx_ack(hci_ev);
     }
 
+    /* Wake anyone waiting for a command credit.  This is done last so that
+     * the ack buffer, which some transports share with commands, has
+     * already been handed off.
+     */
+    if (credits && ble_hs_hci_cmd_credits > 0) {
+        ble_hs_hci_async_signal();
+    }
+
     return 0;
 }
 
@@ -618,8 +1136,13 @@ ble_hs_hci_acl_tx(struct ble_hs_conn *conn, struct os_mbuf **om)
 {
     BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
 
-    /* If this conn is already backed up, don't even try to send. */
-    if (STAILQ_FIRST(&conn->bhc_tx_q) != NULL) {
+    /* If this conn is already backed up, or other connections are waiting
+     * for controller buffers, don't even try to send; the packet has to go
+     * through the transmit scheduler.
+     */
+    if (STAILQ_FIRST(&conn->bhc_tx_q) != NULL ||
+        ble_hs_tx_sched_backlogged()) {
+
         return BLE_HS_EAGAIN;
     }
 
@@ -673,6 +1196,21 @@ ble_hs_hci_init(void)
     rc = ble_npl_mutex_init(&ble_hs_hci_mutex);
     BLE_HS_DBG_ASSERT_EVAL(rc == 0);
 
+    rc = ble_npl_sem_init(&ble_hs_hci_async_sem, 0);
+    BLE_HS_DBG_ASSERT_EVAL(rc == 0);
+
+    rc = os_mempool_init(&ble_hs_hci_async_pool,
+                         MYNEWT_VAL(BLE_HS_HCI_CMD_ASYNC_COUNT),
+                         sizeof (struct ble_hs_hci_async_cmd),
+                         ble_hs_hci_async_mem, "ble_hs_hci_async_pool");
+    BLE_HS_DBG_ASSERT_EVAL(rc == 0);
+
+    STAILQ_INIT(&ble_hs_hci_async_pending);
+    STAILQ_INIT(&ble_hs_hci_async_inflight);
+    STAILQ_INIT(&ble_hs_hci_async_done);
+    ble_npl_event_init(&ble_hs_hci_async_ev, ble_hs_hci_async_event_fn, NULL);
+    ble_hs_hci_cmd_credits = 1;
+
     rc = mem_init_mbuf_pool(ble_hs_hci_frag_data,
                             &ble_hs_hci_frag_mempool,
                             &ble_hs_hci_frag_mbuf_pool,
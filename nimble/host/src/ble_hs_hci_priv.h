@@ -85,10 +85,32 @@ struct ble_hs_hci_sup_cmd {
 
 extern uint16_t ble_hs_hci_avail_pkts;
 
+/* Largest command or response parameter block an async command can carry. */
+#define BLE_HS_HCI_CMD_ASYNC_PARAMS_MAX     64
+
+/**
+ * Called when an asynchronous HCI command completes.
+ *
+ * @param opcode                The opcode of the completed command.
+ * @param status                0 on success; a BLE_HS_E<...> error
+ *                                  (possibly BLE_HS_HCI_ERR()) otherwise.
+ * @param rsp                   The return parameters, excluding the status
+ *                                  byte; NULL if there are none.
+ * @param rsp_len               The length of rsp, in bytes.
+ * @param arg                   The argument passed at submission.
+ */
+typedef void ble_hs_hci_cmd_cb(uint16_t opcode, int status,
+                               const uint8_t *rsp, uint8_t rsp_len,
+                               void *arg);
+
 /* This function is not waiting for command status/complete HCI events */
 int ble_hs_hci_cmd_tx_no_rsp(uint16_t opcode, const void *cmd, uint8_t cmd_len);
 int ble_hs_hci_cmd_tx(uint16_t opcode, const void *cmd, uint8_t cmd_len,
                       void *rsp, uint8_t rsp_len);
+int ble_hs_hci_cmd_tx_async(uint16_t opcode, const void *cmd, uint8_t cmd_len,
+                            ble_hs_hci_cmd_cb *cb, void *arg);
+int ble_hs_hci_cmd_async_drain(void);
+void ble_hs_hci_cmd_async_flush(int status);
 void ble_hs_hci_init(void);
 
 void ble_hs_hci_set_le_supported_feat(uint32_t feat);
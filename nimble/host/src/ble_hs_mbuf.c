@@ -23,17 +23,30 @@
 
 /**
  * Allocates an mbuf for use by the nimble host.
+ *
+ * @param leading_space     The number of bytes to reserve for headers that
+ *                              get prepended later.
+ * @param len               The number of bytes the caller is about to write
+ *                              into the mbuf; 0 if unknown.  A known length
+ *                              lets msys pick the smallest block that fits
+ *                              rather than its biggest one.
  */
 static struct os_mbuf *
-ble_hs_mbuf_gen_pkt(uint16_t leading_space)
+ble_hs_mbuf_gen_pkt(uint16_t leading_space, uint16_t len)
 {
     struct os_mbuf *om;
+    uint16_t dsize;
     int rc;
 
+    dsize = 0;
+    if (len != 0) {
+        dsize = leading_space + len;
+    }
+
 #if MYNEWT_VAL(BLE_CONTROLLER)
-    om = os_msys_get_pkthdr(0, sizeof(struct ble_mbuf_hdr));
+    om = os_msys_get_pkthdr(dsize, sizeof(struct ble_mbuf_hdr));
 #else
-    om = os_msys_get_pkthdr(0, 0);
+    om = os_msys_get_pkthdr(dsize, 0);
 #endif
     if (om == NULL) {
         return NULL;
@@ -47,6 +60,15 @@ ble_hs_mbuf_gen_pkt(uint16_t leading_space)
 
     om->om_data += leading_space;
 
+    if (OS_MBUF_TRAILINGSPACE(om) < len) {
+        /* Every block that fits is in use.  Callers expect the requested
+         * length to be contiguous, so fall back to the biggest block.
+         */
+        rc = os_mbuf_free_chain(om);
+        BLE_HS_DBG_ASSERT_EVAL(rc == 0);
+        return ble_hs_mbuf_gen_pkt(leading_space, 0);
+    }
+
     return om;
 }
 
@@ -59,7 +81,7 @@ ble_hs_mbuf_gen_pkt(uint16_t leading_space)
 struct os_mbuf *
 ble_hs_mbuf_bare_pkt(void)
 {
-    return ble_hs_mbuf_gen_pkt(0);
+    return ble_hs_mbuf_gen_pkt(0, 0);
 }
 
 /**
@@ -71,7 +93,7 @@ ble_hs_mbuf_bare_pkt(void)
 struct os_mbuf *
 ble_hs_mbuf_acl_pkt(void)
 {
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ);
+    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ, 0);
 }
 
 /**
@@ -86,7 +108,23 @@ ble_hs_mbuf_acl_pkt(void)
 struct os_mbuf *
 ble_hs_mbuf_l2cap_pkt(void)
 {
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ);
+    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ, 0);
+}
+
+/**
+ * Allocates an mbuf suitable for an L2CAP data packet whose payload size is
+ * known up front.  The mbuf comes from the smallest msys pool that can hold
+ * the payload contiguously.
+ *
+ * @param len               The size of the L2CAP payload, in bytes.
+ *
+ * @return                  An empty mbuf on success; null on memory
+ *                              exhaustion.
+ */
+struct os_mbuf *
+ble_hs_mbuf_l2cap_pkt_sized(uint16_t len)
+{
+    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ, len);
 }
 
 struct os_mbuf *
@@ -97,7 +135,7 @@ ble_hs_mbuf_att_pkt(void)
      */
     return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ +
                                BLE_L2CAP_HDR_SZ +
-                               BLE_ATT_PREP_WRITE_CMD_BASE_SZ);
+                               BLE_ATT_PREP_WRITE_CMD_BASE_SZ, 0);
 }
 
 struct os_mbuf *
@@ -106,7 +144,9 @@ ble_hs_mbuf_from_flat(const void *buf, uint16_t len)
     struct os_mbuf *om;
     int rc;
 
-    om = ble_hs_mbuf_att_pkt();
+    om = ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ +
+                             BLE_L2CAP_HDR_SZ +
+                             BLE_ATT_PREP_WRITE_CMD_BASE_SZ, len);
     if (om == NULL) {
         return NULL;
     }
@@ -150,6 +190,140 @@ ble_hs_mbuf_to_flat(const struct os_mbuf *om, void *flat, uint16_t max_len,
     return rc;
 }
 
+/**
+ * Moves a cursor over empty mbufs and past the end of the mbuf it is
+ * finished with, so that it refers to the mbuf holding the next byte.
+ */
+static void
+ble_hs_mbuf_cursor_settle(struct ble_hs_mbuf_cursor *cur)
+{
+    while (cur->om != NULL && cur->off == cur->om->om_len) {
+        cur->om = SLIST_NEXT(cur->om, om_next);
+        cur->off = 0;
+    }
+}
+
+/**
+ * Advances a cursor by len bytes, copying them to dst if it is non-null.
+ */
+static int
+ble_hs_mbuf_cursor_advance(struct ble_hs_mbuf_cursor *cur, uint8_t *dst,
+                           uint16_t len)
+{
+    struct ble_hs_mbuf_cursor next;
+    uint16_t chunk;
+
+    next = *cur;
+    while (len > 0) {
+        ble_hs_mbuf_cursor_settle(&next);
+        if (next.om == NULL) {
+            return BLE_HS_EBADDATA;
+        }
+
+        chunk = next.om->om_len - next.off;
+        if (chunk > len) {
+            chunk = len;
+        }
+        if (dst != NULL) {
+            memcpy(dst, next.om->om_data + next.off, chunk);
+            dst += chunk;
+        }
+        next.off += chunk;
+        len -= chunk;
+    }
+
+    *cur = next;
+    return 0;
+}
+
+int
+ble_hs_mbuf_cursor_init(struct ble_hs_mbuf_cursor *cur,
+                        const struct os_mbuf *om, uint16_t off)
+{
+    cur->om = om;
+    cur->off = 0;
+
+    return ble_hs_mbuf_cursor_advance(cur, NULL, off);
+}
+
+int
+ble_hs_mbuf_cursor_read(struct ble_hs_mbuf_cursor *cur, void *dst,
+                        uint16_t len)
+{
+    return ble_hs_mbuf_cursor_advance(cur, dst, len);
+}
+
+int
+ble_hs_mbuf_cursor_skip(struct ble_hs_mbuf_cursor *cur, uint16_t len)
+{
+    return ble_hs_mbuf_cursor_advance(cur, NULL, len);
+}
+
+const void *
+ble_hs_mbuf_cursor_peek(const struct ble_hs_mbuf_cursor *cur, uint16_t len)
+{
+    struct ble_hs_mbuf_cursor pos;
+
+    pos = *cur;
+    ble_hs_mbuf_cursor_settle(&pos);
+    if (pos.om == NULL || pos.om->om_len - pos.off < len) {
+        return NULL;
+    }
+
+    return pos.om->om_data + pos.off;
+}
+
+int
+ble_hs_mbuf_cursor_at_end(const struct ble_hs_mbuf_cursor *cur)
+{
+    struct ble_hs_mbuf_cursor pos;
+
+    pos = *cur;
+    ble_hs_mbuf_cursor_settle(&pos);
+
+    return pos.om == NULL;
+}
+
+int
+ble_hs_mbuf_to_iov(const struct os_mbuf *om, uint16_t off, uint16_t len,
+                   struct ble_hs_mbuf_iov *iov, int *num_iov)
+{
+    struct ble_hs_mbuf_cursor cur;
+    uint16_t chunk;
+    int rc;
+    int i;
+
+    rc = ble_hs_mbuf_cursor_init(&cur, om, off);
+    if (rc != 0) {
+        return rc;
+    }
+
+    i = 0;
+    while (len > 0) {
+        ble_hs_mbuf_cursor_settle(&cur);
+        if (cur.om == NULL) {
+            return BLE_HS_EBADDATA;
+        }
+        if (i >= *num_iov) {
+            return BLE_HS_ENOMEM;
+        }
+
+        chunk = cur.om->om_len - cur.off;
+        if (chunk > len) {
+            chunk = len;
+        }
+        iov[i].base = cur.om->om_data + cur.off;
+        iov[i].len = chunk;
+        i++;
+
+        cur.off += chunk;
+        len -= chunk;
+    }
+
+    *num_iov = i;
+    return 0;
+}
+
 int
 ble_hs_mbuf_pullup_base(struct os_mbuf **om, int base_len)
 {
@@ -20,6 +20,8 @@
 #ifndef H_BLE_HS_MBUF_PRIV_
 #define H_BLE_HS_MBUF_PRIV_
 
+#include <inttypes.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +31,7 @@ struct os_mbuf;
 struct os_mbuf *ble_hs_mbuf_bare_pkt(void);
 struct os_mbuf *ble_hs_mbuf_acl_pkt(void);
 struct os_mbuf *ble_hs_mbuf_l2cap_pkt(void);
+struct os_mbuf *ble_hs_mbuf_l2cap_pkt_sized(uint16_t len);
 int ble_hs_mbuf_pullup_base(struct os_mbuf **om, int base_len);
 
 #ifdef __cplusplus
@@ -23,107 +23,157 @@
 #include "host/ble_hs_hci.h"
 #include "ble_hs_priv.h"
 
-#if !MYNEWT_VAL(BLE_CONTROLLER)
+/* First error reported by a startup command callback. */
+static int ble_hs_startup_status;
+
+#if MYNEWT_VAL(BLE_ROLE_CENTRAL) || MYNEWT_VAL(BLE_ROLE_PERIPHERAL)
+static uint16_t ble_hs_startup_le_pktlen;
+static uint8_t ble_hs_startup_le_max_pkts;
+#endif
+
+/**
+ * Checks the outcome of a startup command, recording the first failure.
+ *
+ * @return                      0 if the command succeeded with a response
+ *                                  of the expected length; nonzero
+ *                                  otherwise.
+ */
 static int
-ble_hs_startup_read_sup_f_tx(void)
+ble_hs_startup_rsp_check(int status, uint8_t rsp_len, uint8_t expected_len)
+{
+    if (status == 0 && rsp_len != expected_len) {
+        status = BLE_HS_ECONTROLLER;
+    }
+
+    if (status != 0 && ble_hs_startup_status == 0) {
+        ble_hs_startup_status = status;
+    }
+
+    return status;
+}
+
+/**
+ * Queues a startup command.  Commands are pipelined up to the controller's
+ * command credit; their results are collected by ble_hs_startup_drain().
+ */
+static void
+ble_hs_startup_tx(uint16_t opcode, const void *cmd, uint8_t cmd_len,
+                  ble_hs_hci_cmd_cb *cb)
 {
-    struct ble_hci_ip_rd_loc_supp_feat_rp rsp;
     int rc;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
-                                      BLE_HCI_OCF_IP_RD_LOC_SUPP_FEAT),
-                           NULL, 0, &rsp, sizeof(rsp));
+    rc = ble_hs_hci_cmd_tx_async(opcode, cmd, cmd_len, cb, NULL);
+    if (rc == BLE_HS_ENOMEM) {
+        /* Queue is full; let the outstanding commands complete first. */
+        rc = ble_hs_hci_cmd_async_drain();
+        if (rc == 0) {
+            rc = ble_hs_hci_cmd_tx_async(opcode, cmd, cmd_len, cb, NULL);
+        }
+    }
+
+    ble_hs_startup_rsp_check(rc, 0, 0);
+}
+
+static int
+ble_hs_startup_drain(void)
+{
+    int rc;
+
+    rc = ble_hs_hci_cmd_async_drain();
     if (rc != 0) {
         return rc;
     }
 
+    return ble_hs_startup_status;
+}
+
+static void
+ble_hs_startup_status_cb(uint16_t opcode, int status, const uint8_t *rsp,
+                         uint8_t rsp_len, void *arg)
+{
+    ble_hs_startup_rsp_check(status, rsp_len, 0);
+}
+
+#if !MYNEWT_VAL(BLE_CONTROLLER)
+static void
+ble_hs_startup_read_sup_f_cb(uint16_t opcode, int status, const uint8_t *rsp,
+                             uint8_t rsp_len, void *arg)
+{
+    const struct ble_hci_ip_rd_loc_supp_feat_rp *rp = (const void *)rsp;
+
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
+    }
+
     /* for now we don't use it outside of init sequence so check this here
      * LE Supported (Controller) byte 4, bit 6
      */
-    if (!(le64toh(rsp.features) & 0x0000006000000000)) {
+    if (!(le64toh(rp->features) & 0x0000006000000000)) {
         BLE_HS_LOG(ERROR, "Controller doesn't support LE\n");
-        return BLE_HS_ECONTROLLER;
+        ble_hs_startup_rsp_check(BLE_HS_ECONTROLLER, 0, 0);
     }
-
-    return 0;
 }
 #endif
 
-static int
-ble_hs_startup_read_local_ver_tx(void)
+static void
+ble_hs_startup_read_local_ver_cb(uint16_t opcode, int status,
+                                 const uint8_t *rsp, uint8_t rsp_len,
+                                 void *arg)
 {
-    struct ble_hci_ip_rd_local_ver_rp rsp;
-    int rc;
+    const struct ble_hci_ip_rd_local_ver_rp *rp = (const void *)rsp;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
-                                      BLE_HCI_OCF_IP_RD_LOCAL_VER),
-                           NULL, 0, &rsp, sizeof(rsp));
-    if (rc != 0) {
-        return rc;
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
     }
 
     /* For now we are interested only in HCI Version */
-    ble_hs_hci_set_hci_version(rsp.hci_ver);
-
-    return 0;
+    ble_hs_hci_set_hci_version(rp->hci_ver);
 }
 
-static int
-ble_hs_startup_read_sup_cmd_tx(void)
+static void
+ble_hs_startup_read_sup_cmd_cb(uint16_t opcode, int status,
+                               const uint8_t *rsp, uint8_t rsp_len,
+                               void *arg)
 {
-    struct ble_hci_ip_rd_loc_supp_cmd_rp rsp;
+    const struct ble_hci_ip_rd_loc_supp_cmd_rp *rp = (const void *)rsp;
     struct ble_hs_hci_sup_cmd sup_cmd;
-    int rc;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
-                                      BLE_HCI_OCF_IP_RD_LOC_SUPP_CMD),
-                           NULL, 0, &rsp, sizeof(rsp));
-    if (rc != 0) {
-        return rc;
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
     }
 
-    memcpy(&sup_cmd.commands, &rsp.commands, sizeof(sup_cmd));
+    memcpy(&sup_cmd.commands, &rp->commands, sizeof(sup_cmd));
     ble_hs_hci_set_hci_supported_cmd(sup_cmd);
-
-    return 0;
 }
 
-static int
-ble_hs_startup_le_read_sup_f_tx(void)
+static void
+ble_hs_startup_le_read_sup_f_cb(uint16_t opcode, int status,
+                                const uint8_t *rsp, uint8_t rsp_len,
+                                void *arg)
 {
-    struct ble_hci_le_rd_loc_supp_feat_rp rsp;
-    int rc;
+    const struct ble_hci_le_rd_loc_supp_feat_rp *rp = (const void *)rsp;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_LE,
-                                      BLE_HCI_OCF_LE_RD_LOC_SUPP_FEAT),
-                           NULL,0, &rsp, sizeof(rsp));
-    if (rc != 0) {
-        return rc;
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
     }
 
-    ble_hs_hci_set_le_supported_feat(le64toh(rsp.features));
-
-    return 0;
+    ble_hs_hci_set_le_supported_feat(le64toh(rp->features));
 }
 
 #if MYNEWT_VAL(BLE_ROLE_CENTRAL) || MYNEWT_VAL(BLE_ROLE_PERIPHERAL)
-static int
-ble_hs_startup_le_read_buf_sz_tx(uint16_t *out_pktlen, uint8_t *out_max_pkts)
+static void
+ble_hs_startup_le_read_buf_sz_cb(uint16_t opcode, int status,
+                                 const uint8_t *rsp, uint8_t rsp_len,
+                                 void *arg)
 {
-    struct ble_hci_le_rd_buf_size_rp rsp;
-    int rc;
+    const struct ble_hci_le_rd_buf_size_rp *rp = (const void *)rsp;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_LE,
-                                      BLE_HCI_OCF_LE_RD_BUF_SIZE), NULL, 0,
-                           &rsp, sizeof(rsp));
-    if (rc != 0) {
-        return rc;
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
     }
 
-    *out_pktlen = le16toh(rsp.data_len);
-    *out_max_pkts = rsp.data_packets;
-
-    return 0;
+    ble_hs_startup_le_pktlen = le16toh(rp->data_len);
+    ble_hs_startup_le_max_pkts = rp->data_packets;
 }
 
 static int
@@ -145,23 +195,20 @@ ble_hs_startup_read_buf_sz_tx(uint16_t *out_pktlen, uint16_t *out_max_pkts)
     return 0;
 }
 
+/**
+ * Applies the result of LE Read Buffer Size, falling back to the BR/EDR
+ * buffers if the controller shares them between transports.
+ */
 static int
-ble_hs_startup_read_buf_sz(void)
+ble_hs_startup_set_buf_sz(void)
 {
-    uint16_t le_pktlen = 0;
     uint16_t max_pkts = 0;
     uint16_t pktlen = 0;
-    uint8_t le_max_pkts = 0;
     int rc;
 
-    rc = ble_hs_startup_le_read_buf_sz_tx(&le_pktlen, &le_max_pkts);
-    if (rc != 0) {
-        return rc;
-    }
-
-    if (le_pktlen != 0) {
-        pktlen = le_pktlen;
-        max_pkts = le_max_pkts;
+    if (ble_hs_startup_le_pktlen != 0) {
+        pktlen = ble_hs_startup_le_pktlen;
+        max_pkts = ble_hs_startup_le_max_pkts;
     } else {
         rc = ble_hs_startup_read_buf_sz_tx(&pktlen, &max_pkts);
         if (rc != 0) {
@@ -178,30 +225,26 @@ ble_hs_startup_read_buf_sz(void)
 }
 #endif
 
-static int
-ble_hs_startup_read_bd_addr(void)
+static void
+ble_hs_startup_read_bd_addr_cb(uint16_t opcode, int status,
+                               const uint8_t *rsp, uint8_t rsp_len,
+                               void *arg)
 {
-    struct ble_hci_ip_rd_bd_addr_rp rsp;
-    int rc;
+    const struct ble_hci_ip_rd_bd_addr_rp *rp = (const void *)rsp;
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
-                                      BLE_HCI_OCF_IP_RD_BD_ADDR),
-                           NULL, 0, &rsp, sizeof(rsp));
-    if (rc != 0) {
-        return rc;
+    if (ble_hs_startup_rsp_check(status, rsp_len, sizeof(*rp)) != 0) {
+        return;
     }
 
-    ble_hs_id_set_pub(rsp.addr);
-    return 0;
+    ble_hs_id_set_pub(rp->addr);
 }
 
-static int
+static void
 ble_hs_startup_le_set_evmask_tx(void)
 {
     struct ble_hci_le_set_event_mask_cp cmd;
     uint8_t version;
     uint64_t mask;
-    int rc;
 
     version = ble_hs_hci_get_hci_version();
 
@@ -332,24 +375,18 @@ ble_hs_startup_le_set_evmask_tx(void)
 
     cmd.event_mask = htole64(mask);
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_LE,
-                                      BLE_HCI_OCF_LE_SET_EVENT_MASK),
-                           &cmd, sizeof(cmd), NULL, 0);
-    if (rc != 0) {
-        return rc;
-    }
-
-    return 0;
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_LE,
+                                 BLE_HCI_OCF_LE_SET_EVENT_MASK),
+                      &cmd, sizeof(cmd), ble_hs_startup_status_cb);
 }
 
-static int
+static void
 ble_hs_startup_set_evmask_tx(void)
 {
     struct ble_hci_cb_set_event_mask_cp cmd;
     struct ble_hci_cb_set_event_mask2_cp cmd2;
     uint8_t version;
     struct ble_hs_hci_sup_cmd sup_cmd;
-    int rc;
 
     version = ble_hs_hci_get_hci_version();
     sup_cmd = ble_hs_hci_get_hci_supported_cmd();
@@ -365,12 +402,9 @@ ble_hs_startup_set_evmask_tx(void)
      */
     cmd.event_mask = htole64(0x2000800002008090);
 
-    rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_CTLR_BASEBAND,
-                                      BLE_HCI_OCF_CB_SET_EVENT_MASK),
-                           &cmd, sizeof(cmd), NULL, 0);
-    if (rc != 0) {
-        return rc;
-    }
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_CTLR_BASEBAND,
+                                 BLE_HCI_OCF_CB_SET_EVENT_MASK),
+                      &cmd, sizeof(cmd), ble_hs_startup_status_cb);
 
     if ((version >= BLE_HCI_VER_BCS_4_1) && ((sup_cmd.commands[22] & 0x04) != 0)) {
         /**
@@ -378,15 +412,10 @@ ble_hs_startup_set_evmask_tx(void)
          *     0x0000000000800000 Authenticated Payload Timeout Event
          */
         cmd2.event_mask2 = htole64(0x0000000000800000);
-        rc = ble_hs_hci_cmd_tx(BLE_HCI_OP(BLE_HCI_OGF_CTLR_BASEBAND,
-                                          BLE_HCI_OCF_CB_SET_EVENT_MASK2),
-                               &cmd2, sizeof(cmd2), NULL, 0);
-        if (rc != 0) {
-            return rc;
-        }
+        ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_CTLR_BASEBAND,
+                                     BLE_HCI_OCF_CB_SET_EVENT_MASK2),
+                          &cmd2, sizeof(cmd2), ble_hs_startup_status_cb);
     }
-
-    return 0;
 }
 
 static int
@@ -408,56 +437,66 @@ ble_hs_startup_go(void)
         return rc;
     }
 
-    rc = ble_hs_startup_read_local_ver_tx();
-    if (rc != 0) {
-        return rc;
-    }
+    ble_hs_startup_status = 0;
+
+    /* Read the controller's capabilities; everything below depends on the
+     * version and supported commands.
+     */
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
+                                 BLE_HCI_OCF_IP_RD_LOCAL_VER),
+                      NULL, 0, ble_hs_startup_read_local_ver_cb);
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
+                                 BLE_HCI_OCF_IP_RD_LOC_SUPP_CMD),
+                      NULL, 0, ble_hs_startup_read_sup_cmd_cb);
 
-    /* Read local supported commands. */
-    rc = ble_hs_startup_read_sup_cmd_tx();
+    /* we need to check this only if using external controller */
+#if !MYNEWT_VAL(BLE_CONTROLLER)
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
+                                 BLE_HCI_OCF_IP_RD_LOC_SUPP_FEAT),
+                      NULL, 0, ble_hs_startup_read_sup_f_cb);
+#endif
+
+    rc = ble_hs_startup_drain();
     if (rc != 0) {
         return rc;
     }
 
-    /* we need to check this only if using external controller */
 #if !MYNEWT_VAL(BLE_CONTROLLER)
     if (ble_hs_hci_get_hci_version() < BLE_HCI_VER_BCS_4_0) {
         BLE_HS_LOG(ERROR, "Required controller version is 4.0 (6)\n");
         return BLE_HS_ECONTROLLER;
     }
-
-    rc = ble_hs_startup_read_sup_f_tx();
-    if (rc != 0) {
-        return rc;
-    }
 #endif
 
-    rc = ble_hs_startup_set_evmask_tx();
-    if (rc != 0) {
-        return rc;
-    }
-
-    rc = ble_hs_startup_le_set_evmask_tx();
-    if (rc != 0) {
-        return rc;
-    }
+    /* Configure events and read the LE parameters in a single batch. */
+    ble_hs_startup_set_evmask_tx();
+    ble_hs_startup_le_set_evmask_tx();
 
 #if MYNEWT_VAL(BLE_ROLE_CENTRAL) || MYNEWT_VAL(BLE_ROLE_PERIPHERAL)
-    rc = ble_hs_startup_read_buf_sz();
-    if (rc != 0) {
-        return rc;
-    }
+    ble_hs_startup_le_pktlen = 0;
+    ble_hs_startup_le_max_pkts = 0;
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_BUF_SIZE),
+                      NULL, 0, ble_hs_startup_le_read_buf_sz_cb);
 #endif
 
-    rc = ble_hs_startup_le_read_sup_f_tx();
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_LE,
+                                 BLE_HCI_OCF_LE_RD_LOC_SUPP_FEAT),
+                      NULL, 0, ble_hs_startup_le_read_sup_f_cb);
+    ble_hs_startup_tx(BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS,
+                                 BLE_HCI_OCF_IP_RD_BD_ADDR),
+                      NULL, 0, ble_hs_startup_read_bd_addr_cb);
+
+    rc = ble_hs_startup_drain();
     if (rc != 0) {
         return rc;
     }
 
-    rc = ble_hs_startup_read_bd_addr();
+#if MYNEWT_VAL(BLE_ROLE_CENTRAL) || MYNEWT_VAL(BLE_ROLE_PERIPHERAL)
+    rc = ble_hs_startup_set_buf_sz();
     if (rc != 0) {
         return rc;
     }
+#endif
 
     if (ble_hs_cfg.store_gen_key_cb) {
         memset(&gen_key, 0, sizeof(gen_key));
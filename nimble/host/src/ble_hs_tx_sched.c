@@ -0,0 +1,348 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * Host ACL transmit scheduler.
+ *
+ * When the controller runs out of ACL buffers, outgoing packets wait in their
+ * connection's bhc_tx_q.  Connections with waiting packets are kept on the
+ * backlogged list; as buffers are freed, the configured policy decides which
+ * connection's head packet goes next.
+ *
+ * The default policy is deficit round-robin: each backlogged connection is
+ * granted BLE_HS_TX_SCHED_QUANTUM * weight bytes per round and sends whole
+ * packets while its deficit covers them, so a bulk transfer cannot starve
+ * other connections.  The fifo policy drains connections in the order they
+ * became backlogged.
+ */
+
+#include <string.h>
+#include "host/ble_gap.h"
+#include "ble_hs_priv.h"
+
+static STAILQ_HEAD(, ble_hs_conn) ble_hs_tx_sched_active;
+
+/**
+ * Brings the queued-bytes time integral up to date and adjusts the queued
+ * byte count.  The integral divided by the number of bytes that went through
+ * the queue is the average queueing delay (Little's law).
+ */
+static void
+ble_hs_tx_sched_queued_adj(struct ble_hs_tx_sched_conn *sched, int32_t delta)
+{
+    ble_npl_time_t now;
+
+    now = ble_npl_time_get();
+    sched->queued_byte_ticks += (uint64_t)sched->queued_bytes *
+                                (ble_npl_time_t)(now - sched->queued_ts);
+    sched->queued_ts = now;
+
+    sched->queued_bytes += delta;
+    if (sched->queued_bytes > sched->queued_bytes_max) {
+        sched->queued_bytes_max = sched->queued_bytes;
+    }
+}
+
+static void
+ble_hs_tx_sched_deactivate(struct ble_hs_conn *conn)
+{
+    struct ble_hs_tx_sched_conn *sched;
+
+    sched = &conn->bhc_tx_sched;
+    if (sched->flags & BLE_HS_TX_SCHED_F_ACTIVE) {
+        STAILQ_REMOVE(&ble_hs_tx_sched_active, conn, ble_hs_conn,
+                      bhc_tx_sched.next);
+    }
+
+    sched->flags = 0;
+    sched->deficit = 0;
+}
+
+#if MYNEWT_VAL_CHOICE(BLE_HS_TX_SCHED, fifo)
+
+static struct ble_hs_conn *
+ble_hs_tx_sched_fifo_next(void)
+{
+    return STAILQ_FIRST(&ble_hs_tx_sched_active);
+}
+
+static void
+ble_hs_tx_sched_fifo_charge(struct ble_hs_conn *conn, uint16_t bytes)
+{
+}
+
+static const struct ble_hs_tx_sched_policy ble_hs_tx_sched_policy = {
+    .next = ble_hs_tx_sched_fifo_next,
+    .charge = ble_hs_tx_sched_fifo_charge,
+};
+
+#else
+
+static struct ble_hs_conn *
+ble_hs_tx_sched_drr_next(void)
+{
+    struct ble_hs_tx_sched_conn *sched;
+    struct os_mbuf_pkthdr *omp;
+    struct ble_hs_conn *conn;
+
+    while ((conn = STAILQ_FIRST(&ble_hs_tx_sched_active)) != NULL) {
+        if (conn->bhc_flags & BLE_HS_CONN_F_TX_FRAG) {
+            /* Already paid for; finish it. */
+            return conn;
+        }
+
+        sched = &conn->bhc_tx_sched;
+        if (!(sched->flags & BLE_HS_TX_SCHED_F_TURN)) {
+            sched->deficit += MYNEWT_VAL(BLE_HS_TX_SCHED_QUANTUM) *
+                              sched->weight;
+            sched->flags |= BLE_HS_TX_SCHED_F_TURN;
+        }
+
+        omp = STAILQ_FIRST(&conn->bhc_tx_q);
+        if (sched->deficit >= omp->omp_len) {
+            return conn;
+        }
+
+        /* Out of credit for this round; go to the back of the line. */
+        sched->flags &= ~BLE_HS_TX_SCHED_F_TURN;
+        STAILQ_REMOVE_HEAD(&ble_hs_tx_sched_active, bhc_tx_sched.next);
+        STAILQ_INSERT_TAIL(&ble_hs_tx_sched_active, conn, bhc_tx_sched.next);
+    }
+
+    return NULL;
+}
+
+static void
+ble_hs_tx_sched_drr_charge(struct ble_hs_conn *conn, uint16_t bytes)
+{
+    conn->bhc_tx_sched.deficit -= bytes;
+}
+
+static const struct ble_hs_tx_sched_policy ble_hs_tx_sched_policy = {
+    .next = ble_hs_tx_sched_drr_next,
+    .charge = ble_hs_tx_sched_drr_charge,
+};
+
+#endif
+
+void
+ble_hs_tx_sched_conn_init(struct ble_hs_conn *conn)
+{
+    memset(&conn->bhc_tx_sched, 0, sizeof conn->bhc_tx_sched);
+    conn->bhc_tx_sched.weight = 1;
+    conn->bhc_tx_sched.queued_ts = ble_npl_time_get();
+}
+
+/**
+ * Takes a connection off the backlogged list.  Its queued packets are freed
+ * along with the connection.
+ */
+void
+ble_hs_tx_sched_conn_remove(struct ble_hs_conn *conn)
+{
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    ble_hs_tx_sched_deactivate(conn);
+}
+
+/**
+ * Queues an ACL packet (or the unsent remainder of one) for later
+ * transmission.  The host mutex must be locked.
+ */
+void
+ble_hs_tx_sched_enqueue(struct ble_hs_conn *conn, struct os_mbuf *om)
+{
+    struct ble_hs_tx_sched_conn *sched;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    sched = &conn->bhc_tx_sched;
+
+    if (STAILQ_EMPTY(&conn->bhc_tx_q)) {
+        sched->head_ts = ble_npl_time_get();
+    }
+    STAILQ_INSERT_TAIL(&conn->bhc_tx_q, OS_MBUF_PKTHDR(om), omp_next);
+    ble_hs_tx_sched_queued_adj(sched, OS_MBUF_PKTLEN(om));
+
+    if (!(sched->flags & BLE_HS_TX_SCHED_F_ACTIVE)) {
+        sched->flags |= BLE_HS_TX_SCHED_F_ACTIVE;
+        STAILQ_INSERT_TAIL(&ble_hs_tx_sched_active, conn, bhc_tx_sched.next);
+    }
+}
+
+/**
+ * Records bytes that were sent to the controller without being queued.
+ */
+void
+ble_hs_tx_sched_account_tx(struct ble_hs_conn *conn, uint16_t bytes)
+{
+    conn->bhc_tx_sched.tx_bytes += bytes;
+}
+
+/**
+ * Indicates whether any connection has packets waiting for controller
+ * buffers.  New packets must then be queued behind them rather than sent
+ * directly, or they would jump the schedule.
+ */
+int
+ble_hs_tx_sched_backlogged(void)
+{
+    return !STAILQ_EMPTY(&ble_hs_tx_sched_active);
+}
+
+/**
+ * Sends queued ACL packets, in the order chosen by the scheduling policy,
+ * until the queues are empty or the controller's buffers are exhausted.
+ * The host mutex must be locked.
+ */
+void
+ble_hs_tx_sched_run(void)
+{
+    struct ble_hs_tx_sched_conn *sched;
+    struct os_mbuf_pkthdr *omp;
+    struct ble_hs_conn *conn;
+    struct os_mbuf *om;
+    ble_npl_time_t now;
+    uint16_t len;
+    int rc;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    while (ble_hs_hci_avail_pkts > 0) {
+        conn = ble_hs_tx_sched_policy.next();
+        if (conn == NULL) {
+            break;
+        }
+        sched = &conn->bhc_tx_sched;
+
+        omp = STAILQ_FIRST(&conn->bhc_tx_q);
+        BLE_HS_DBG_ASSERT(omp != NULL);
+        STAILQ_REMOVE_HEAD(&conn->bhc_tx_q, omp_next);
+
+        om = OS_MBUF_PKTHDR_TO_MBUF(omp);
+        len = OS_MBUF_PKTLEN(om);
+
+        rc = ble_hs_hci_acl_tx_now(conn, &om);
+        if (rc == BLE_HS_EAGAIN) {
+            /* Controller is at capacity.  The remainder is the first to get
+             * transmitted next time around.
+             */
+            STAILQ_INSERT_HEAD(&conn->bhc_tx_q, OS_MBUF_PKTHDR(om),
+                               omp_next);
+            len -= OS_MBUF_PKTLEN(om);
+        }
+
+        ble_hs_tx_sched_queued_adj(sched, -(int32_t)len);
+        sched->dequeued_bytes += len;
+        if (rc == 0 || rc == BLE_HS_EAGAIN) {
+            sched->tx_bytes += len;
+        }
+        ble_hs_tx_sched_policy.charge(conn, len);
+
+        if (rc == BLE_HS_EAGAIN) {
+            break;
+        }
+
+        /* The head packet is gone, either sent or dropped. */
+        now = ble_npl_time_get();
+        if ((ble_npl_time_t)(now - sched->head_ts) > sched->head_wait_max) {
+            sched->head_wait_max = now - sched->head_ts;
+        }
+        sched->head_ts = now;
+
+        if (STAILQ_EMPTY(&conn->bhc_tx_q)) {
+            ble_hs_tx_sched_deactivate(conn);
+        }
+    }
+}
+
+int
+ble_hs_tx_sched_set_weight(uint16_t conn_handle, uint8_t weight)
+{
+    struct ble_hs_conn *conn;
+    int rc;
+
+    if (weight == 0) {
+        return BLE_HS_EINVAL;
+    }
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL) {
+        rc = BLE_HS_ENOTCONN;
+    } else {
+        conn->bhc_tx_sched.weight = weight;
+        rc = 0;
+    }
+
+    ble_hs_unlock();
+
+    return rc;
+}
+
+int
+ble_hs_tx_sched_stats(uint16_t conn_handle,
+                      struct ble_gap_conn_tx_stats *out_stats)
+{
+    struct ble_hs_tx_sched_conn *sched;
+    struct ble_hs_conn *conn;
+    ble_npl_time_t head_wait;
+    uint64_t arrived;
+
+    ble_hs_lock();
+
+    conn = ble_hs_conn_find(conn_handle);
+    if (conn == NULL) {
+        ble_hs_unlock();
+        return BLE_HS_ENOTCONN;
+    }
+
+    sched = &conn->bhc_tx_sched;
+    ble_hs_tx_sched_queued_adj(sched, 0);
+
+    memset(out_stats, 0, sizeof *out_stats);
+    out_stats->queued_bytes = sched->queued_bytes;
+    out_stats->queued_bytes_max = sched->queued_bytes_max;
+    out_stats->tx_bytes = sched->tx_bytes;
+
+    arrived = (uint64_t)sched->dequeued_bytes + sched->queued_bytes;
+    if (arrived > 0) {
+        out_stats->wait_avg_ms = ble_npl_time_ticks_to_ms32(
+            (ble_npl_time_t)(sched->queued_byte_ticks / arrived));
+    }
+
+    head_wait = sched->head_wait_max;
+    if (!STAILQ_EMPTY(&conn->bhc_tx_q) &&
+        (ble_npl_time_t)(ble_npl_time_get() - sched->head_ts) > head_wait) {
+
+        head_wait = ble_npl_time_get() - sched->head_ts;
+    }
+    out_stats->wait_max_ms = ble_npl_time_ticks_to_ms32(head_wait);
+
+    ble_hs_unlock();
+
+    return 0;
+}
+
+void
+ble_hs_tx_sched_init(void)
+{
+    STAILQ_INIT(&ble_hs_tx_sched_active);
+}
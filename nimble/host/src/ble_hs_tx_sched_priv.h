@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_BLE_HS_TX_SCHED_PRIV_
+#define H_BLE_HS_TX_SCHED_PRIV_
+
+#include <inttypes.h>
+#include "os/queue.h"
+#include "nimble/nimble_npl.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ble_hs_conn;
+struct ble_gap_conn_tx_stats;
+struct os_mbuf;
+
+#define BLE_HS_TX_SCHED_F_ACTIVE    0x01 /* On the backlogged list. */
+#define BLE_HS_TX_SCHED_F_TURN      0x02 /* Quantum granted this round. */
+
+/** Per-connection state of the host ACL transmit scheduler. */
+struct ble_hs_tx_sched_conn {
+    STAILQ_ENTRY(ble_hs_conn) next;
+
+    /* Bytes this connection may still send in the current round. */
+    int32_t deficit;
+    uint8_t weight;
+    uint8_t flags;
+
+    /* Statistics; see struct ble_gap_conn_tx_stats. */
+    uint32_t queued_bytes;
+    uint32_t queued_bytes_max;
+    uint32_t tx_bytes;
+    uint32_t dequeued_bytes;
+    uint64_t queued_byte_ticks;
+    ble_npl_time_t queued_ts;
+    ble_npl_time_t head_ts;
+    ble_npl_time_t head_wait_max;
+};
+
+/**
+ * A transmit scheduling policy.  Both callbacks are executed with the host
+ * mutex locked.
+ */
+struct ble_hs_tx_sched_policy {
+    /**
+     * Selects the backlogged connection whose head packet is sent next.  A
+     * connection with a partially transmitted packet must be returned until
+     * the packet is complete; the controller reassembles it.
+     *
+     * @return                  The connection to service; NULL to stop.
+     */
+    struct ble_hs_conn *(*next)(void);
+
+    /** Accounts for bytes a connection just handed to the controller. */
+    void (*charge)(struct ble_hs_conn *conn, uint16_t bytes);
+};
+
+void ble_hs_tx_sched_conn_init(struct ble_hs_conn *conn);
+void ble_hs_tx_sched_conn_remove(struct ble_hs_conn *conn);
+void ble_hs_tx_sched_enqueue(struct ble_hs_conn *conn, struct os_mbuf *om);
+void ble_hs_tx_sched_account_tx(struct ble_hs_conn *conn, uint16_t bytes);
+int ble_hs_tx_sched_backlogged(void);
+void ble_hs_tx_sched_run(void);
+int ble_hs_tx_sched_set_weight(uint16_t conn_handle, uint8_t weight);
+int ble_hs_tx_sched_stats(uint16_t conn_handle,
+                          struct ble_gap_conn_tx_stats *out_stats);
+void ble_hs_tx_sched_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
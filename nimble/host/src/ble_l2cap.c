@@ -266,6 +266,17 @@ ble_l2cap_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu)
     return ble_l2cap_coc_send(chan, sdu);
 }
 
+int
+ble_l2cap_get_tx_queued(struct ble_l2cap_chan *chan, uint16_t *out_sdus,
+                        uint32_t *out_bytes)
+{
+    if (!chan) {
+        return BLE_HS_EINVAL;
+    }
+
+    return ble_l2cap_coc_tx_queued(chan, out_sdus, out_bytes);
+}
+
 int
 ble_l2cap_recv_ready(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_rx)
 {
@@ -459,6 +470,7 @@ int
 ble_l2cap_tx(struct ble_hs_conn *conn, struct ble_l2cap_chan *chan,
              struct os_mbuf *txom)
 {
+    uint16_t len;
     int rc;
 
     txom = ble_l2cap_prepend_hdr(txom, chan->dcid, OS_MBUF_PKTLEN(txom));
@@ -466,15 +478,23 @@ ble_l2cap_tx(struct ble_hs_conn *conn, struct ble_l2cap_chan *chan,
         return BLE_HS_ENOMEM;
     }
 
+    len = OS_MBUF_PKTLEN(txom);
+
     rc = ble_hs_hci_acl_tx(conn, &txom);
     switch (rc) {
     case 0:
         /* Success. */
+        ble_hs_tx_sched_account_tx(conn, len);
         return 0;
 
     case BLE_HS_EAGAIN:
-        /* Controller could not accommodate full packet.  Enqueue remainder. */
-        STAILQ_INSERT_TAIL(&conn->bhc_tx_q, OS_MBUF_PKTHDR(txom), omp_next);
+        /* Controller could not accommodate full packet, or other packets are
+         * waiting for it.  Enqueue remainder and let the scheduler decide
+         * what goes next.
+         */
+        ble_hs_tx_sched_account_tx(conn, len - OS_MBUF_PKTLEN(txom));
+        ble_hs_tx_sched_enqueue(conn, txom);
+        ble_hs_tx_sched_run();
         return 0;
 
     default:
@@ -350,6 +350,7 @@ ble_l2cap_coc_chan_alloc(struct ble_hs_conn *conn, uint16_t psm, uint16_t mtu,
         chan->coc_rx.sdus[i] = NULL;
     }
     chan->coc_rx.current_sdu_idx = 0;
+    STAILQ_INIT(&chan->coc_tx.sdu_q);
 
     if (BLE_L2CAP_SDU_BUFF_CNT == 1) {
         chan->coc_rx.next_sdu_alloc_idx = 0;
@@ -390,6 +391,57 @@ ble_l2cap_coc_create_srv_chan(struct ble_hs_conn *conn, uint16_t psm,
     return 0;
 }
 
+/**
+ * Makes the SDU at the head of the transmit queue the one being sent.
+ *
+ * @return                      The new current SDU; NULL if the queue is
+ *                                  empty.
+ */
+static struct os_mbuf *
+ble_l2cap_coc_tx_next(struct ble_l2cap_coc_endpoint *tx)
+{
+    struct os_mbuf_pkthdr *omp;
+
+    omp = STAILQ_FIRST(&tx->sdu_q);
+    if (omp == NULL) {
+        tx->sdus[0] = NULL;
+        return NULL;
+    }
+
+    STAILQ_REMOVE_HEAD(&tx->sdu_q, omp_next);
+    tx->sdu_q_cnt--;
+    tx->sdu_q_bytes -= omp->omp_len;
+
+    tx->sdus[0] = OS_MBUF_PKTHDR_TO_MBUF(omp);
+    return tx->sdus[0];
+}
+
+/**
+ * Indicates whether the transmit queue has reached its SDU limit or its
+ * high-water mark, i.e., whether the application should hold off until the
+ * channel gets unstalled.
+ */
+static int
+ble_l2cap_coc_tx_full(const struct ble_l2cap_coc_endpoint *tx)
+{
+    uint16_t cnt;
+
+    cnt = tx->sdu_q_cnt + (tx->sdus[0] != NULL);
+    if (cnt >= MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_LEN)) {
+        return 1;
+    }
+
+#if MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER) > 0
+    if (tx->sdus[0] != NULL &&
+        OS_MBUF_PKTLEN(tx->sdus[0]) + tx->sdu_q_bytes >=
+        MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER)) {
+        return 1;
+    }
+#endif
+
+    return 0;
+}
+
 static void
 ble_l2cap_event_coc_disconnected(struct ble_l2cap_chan *chan)
 {
@@ -426,6 +478,9 @@ ble_l2cap_coc_cleanup_chan(struct ble_hs_conn *conn, struct ble_l2cap_chan *chan
         os_mbuf_free_chain(chan->coc_rx.sdus[i]);
     }
     os_mbuf_free_chain(chan->coc_tx.sdus[0]);
+    while (ble_l2cap_coc_tx_next(&chan->coc_tx)) {
+        os_mbuf_free_chain(chan->coc_tx.sdus[0]);
+    }
 }
 
 static void
@@ -445,33 +500,135 @@ ble_l2cap_event_coc_unstalled(struct ble_l2cap_chan *chan, int status)
     chan->cb(&event, chan->cb_arg);
 }
 
-/* WARNING: this function is called from different task contexts. We expect the
- * host to be locked (ble_hs_lock()) before entering this function! */
+/**
+ * Moves the next len bytes of the SDU being sent into a K-frame.  Buffers
+ * lying entirely within the K-frame are unlinked from the SDU and linked into
+ * the K-frame rather than copied.  Only the data held by the SDU's first
+ * buffer, which carries the packet header and so has to stay in place, and
+ * the leading part of a buffer straddling the K-frame boundary get copied.
+ * The final K-frame takes the remainder of the SDU as is.
+ *
+ * @param tx                    The transmit endpoint.  When the final K-frame
+ *                                  is built, the SDU is consumed and its slot
+ *                                  gets cleared.
+ * @param txom                  The K-frame to extend.
+ * @param len                   The number of SDU bytes to move.
+ *
+ * @return                      0 on success; BLE_HS_ENOMEM on failure.
+ */
+static int
+ble_l2cap_coc_slice_sdu(struct ble_l2cap_coc_endpoint *tx,
+                        struct os_mbuf *txom, uint16_t len)
+{
+    struct os_mbuf *last;
+    struct os_mbuf *sdu;
+    struct os_mbuf *om;
+    uint16_t chunk;
+    int rc;
+
+    sdu = tx->sdus[0];
+
+    if (len == OS_MBUF_PKTLEN(sdu)) {
+        /* Drop the emptied first buffer rather than sending it. */
+        if (sdu->om_len == 0 && SLIST_NEXT(sdu, om_next) != NULL) {
+            om = SLIST_NEXT(sdu, om_next);
+            os_mbuf_free(sdu);
+            sdu = om;
+        }
+
+        os_mbuf_concat(txom, sdu);
+        tx->sdus[0] = NULL;
+        return 0;
+    }
+
+    chunk = min(sdu->om_len, len);
+    rc = os_mbuf_append(txom, sdu->om_data, chunk);
+    if (rc != 0) {
+        return BLE_HS_ENOMEM;
+    }
+    os_mbuf_adj(sdu, chunk);
+    len -= chunk;
+
+    last = txom;
+    while (SLIST_NEXT(last, om_next) != NULL) {
+        last = SLIST_NEXT(last, om_next);
+    }
+
+    while (len > 0) {
+        /* The SDU is longer than len, so there is always a next buffer. */
+        om = SLIST_NEXT(sdu, om_next);
+
+        if (om->om_len > len) {
+            rc = os_mbuf_append(txom, om->om_data, len);
+            if (rc != 0) {
+                return BLE_HS_ENOMEM;
+            }
+            os_mbuf_adj(sdu, len);
+            break;
+        }
+
+        SLIST_NEXT(sdu, om_next) = SLIST_NEXT(om, om_next);
+        SLIST_NEXT(om, om_next) = NULL;
+        SLIST_NEXT(last, om_next) = om;
+        last = om;
+
+        OS_MBUF_PKTHDR(sdu)->omp_len -= om->om_len;
+        OS_MBUF_PKTHDR(txom)->omp_len += om->om_len;
+        len -= om->om_len;
+    }
+
+    return 0;
+}
+
+/**
+ * Sends queued SDUs while credits remain.  An SDU which fails to go out is
+ * dropped and transmission carries on with the next one.  The failure is
+ * returned if the dropped SDU is sdu_own, i.e., the one the caller just
+ * queued; otherwise it is reported to the application with
+ * BLE_L2CAP_EVENT_COC_TX_UNSTALLED.
+ *
+ * WARNING: this function is called from different task contexts. We expect the
+ * host to be locked (ble_hs_lock()) before entering this function!  The host
+ * gets unlocked before this function returns.
+ *
+ * @param chan                  The channel to send on.
+ * @param sdu_own               The SDU queued by the caller; NULL if none.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ESTALLED if the queue is still full;
+ *                              the failure of sdu_own otherwise.
+ */
 static int
-ble_l2cap_coc_continue_tx(struct ble_l2cap_chan *chan)
+ble_l2cap_coc_continue_tx(struct ble_l2cap_chan *chan,
+                          const struct os_mbuf *sdu_own)
 {
     struct ble_l2cap_coc_endpoint *tx;
     uint16_t len;
     uint16_t left_to_send;
     struct os_mbuf *txom;
+    struct os_mbuf *sdu;
     struct ble_hs_conn *conn;
     uint16_t sdu_size_offset;
+    int unstalled;
+    int own_rc;
+    int err;
     int rc;
 
-    /* If there is no data to send, just return success */
     tx = &chan->coc_tx;
-    if (!tx->sdus[0]) {
-        ble_hs_unlock();
-        return 0;
-    }
+    own_rc = 0;
+    err = 0;
 
-    while (tx->credits) {
+    while (tx->sdus[0] && tx->credits) {
         sdu_size_offset = 0;
+        sdu = tx->sdus[0];
+        txom = NULL;
 
         BLE_HS_LOG(DEBUG, "Available credits %d\n", tx->credits);
 
-        /* lets calculate data we are going to send */
-        left_to_send = OS_MBUF_PKTLEN(tx->sdus[0]) - tx->data_offset;
+        /* lets calculate data we are going to send; sent data has already
+         * been removed from the SDU
+         */
+        left_to_send = OS_MBUF_PKTLEN(sdu);
 
         if (tx->data_offset == 0) {
             sdu_size_offset = BLE_L2CAP_SDU_SIZE;
@@ -491,10 +648,9 @@ ble_l2cap_coc_continue_tx(struct ble_l2cap_chan *chan)
 
         if (tx->data_offset == 0) {
             /* First packet needs SDU len first. Left to send */
-            uint16_t l = htole16(OS_MBUF_PKTLEN(tx->sdus[0]));
+            uint16_t l = htole16(OS_MBUF_PKTLEN(sdu));
 
-            BLE_HS_LOG(DEBUG, "Sending SDU len=%d\n",
-                       OS_MBUF_PKTLEN(tx->sdus[0]));
+            BLE_HS_LOG(DEBUG, "Sending SDU len=%d\n", OS_MBUF_PKTLEN(sdu));
             rc = os_mbuf_append(txom, &l, sizeof(uint16_t));
             if (rc) {
                 rc = BLE_HS_ENOMEM;
@@ -507,10 +663,8 @@ ble_l2cap_coc_continue_tx(struct ble_l2cap_chan *chan)
          * that for first packet we need to decrease data size by 2 bytes for sdu
          * size
          */
-        rc = os_mbuf_appendfrom(txom, tx->sdus[0], tx->data_offset,
-                                len - sdu_size_offset);
+        rc = ble_l2cap_coc_slice_sdu(tx, txom, len - sdu_size_offset);
         if (rc) {
-            rc = BLE_HS_ENOMEM;
             BLE_HS_LOG(DEBUG, "Could not append data rc=%d", rc);
             goto failed;
         }
@@ -523,56 +677,61 @@ ble_l2cap_coc_continue_tx(struct ble_l2cap_chan *chan)
         }
         rc = ble_l2cap_tx(conn, chan, txom);
 
+        /* txom is consumed by l2cap */
+        txom = NULL;
         if (rc) {
-            /* txom is consumed by l2cap */
-            txom = NULL;
             goto failed;
-        } else {
-            tx->credits--;
-            tx->data_offset += len - sdu_size_offset;
         }
 
+        tx->credits--;
+        tx->data_offset += len - sdu_size_offset;
+
         BLE_HS_LOG(DEBUG, "Sent %d bytes, credits=%d, to send %d bytes \n",
                    len, tx->credits,
-                   OS_MBUF_PKTLEN(tx->sdus[0]) - tx->data_offset);
+                   tx->sdus[0] ? OS_MBUF_PKTLEN(tx->sdus[0]) : 0);
 
-        if (tx->data_offset == OS_MBUF_PKTLEN(tx->sdus[0])) {
+        if (!tx->sdus[0]) {
             BLE_HS_LOG(DEBUG, "Complete package sent\n");
-            os_mbuf_free_chain(tx->sdus[0]);
-            tx->sdus[0] = NULL;
             tx->data_offset = 0;
-            break;
+
+            /* Carry on with the next queued SDU while credits remain */
+            ble_l2cap_coc_tx_next(tx);
         }
-    }
+        continue;
 
-    if (tx->sdus[0]) {
-        /* Not complete SDU sent, wait for credits */
-        tx->flags |= BLE_L2CAP_COC_FLAG_STALLED;
-        ble_hs_unlock();
-        return BLE_HS_ESTALLED;
+failed:
+        /* Drop the SDU and carry on with the next queued one */
+        os_mbuf_free_chain(txom);
+        os_mbuf_free_chain(tx->sdus[0]);
+        tx->data_offset = 0;
+        ble_l2cap_coc_tx_next(tx);
+
+        if (sdu == sdu_own) {
+            own_rc = rc;
+        } else if (err == 0) {
+            err = rc;
+        }
     }
 
-    if (tx->flags & BLE_L2CAP_COC_FLAG_STALLED) {
+    unstalled = 0;
+    if (ble_l2cap_coc_tx_full(tx)) {
+        /* Queue still full, wait for credits */
+        tx->flags |= BLE_L2CAP_COC_FLAG_STALLED;
+    } else if (tx->flags & BLE_L2CAP_COC_FLAG_STALLED) {
         tx->flags &= ~BLE_L2CAP_COC_FLAG_STALLED;
-        ble_hs_unlock();
-        ble_l2cap_event_coc_unstalled(chan, 0);
-    } else {
-        ble_hs_unlock();
+        unstalled = 1;
     }
 
-    return 0;
+    rc = own_rc;
+    if (rc == 0 && tx->flags & BLE_L2CAP_COC_FLAG_STALLED) {
+        rc = BLE_HS_ESTALLED;
+    }
 
-failed:
-    os_mbuf_free_chain(tx->sdus[0]);
-    tx->sdus[0] = NULL;
+    ble_hs_unlock();
 
-    os_mbuf_free_chain(txom);
-    if (tx->flags & BLE_L2CAP_COC_FLAG_STALLED) {
-        tx->flags &= ~BLE_L2CAP_COC_FLAG_STALLED;
-        ble_hs_unlock();
-        ble_l2cap_event_coc_unstalled(chan, rc);
-    } else {
-        ble_hs_unlock();
+    /* SDUs accepted earlier report their failure with the event */
+    if (unstalled || err != 0) {
+        ble_l2cap_event_coc_unstalled(chan, err);
     }
 
     return rc;
@@ -609,7 +768,7 @@ ble_l2cap_coc_le_credits_update(uint16_t conn_handle, uint16_t dcid,
     chan->coc_tx.credits += credits;
 
     /* leave the host locked on purpose when ble_l2cap_coc_continue_tx() */
-    ble_l2cap_coc_continue_tx(chan);
+    ble_l2cap_coc_continue_tx(chan, NULL);
 }
 
 int
@@ -661,14 +820,16 @@ ble_l2cap_coc_recv_ready(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_rx)
 }
 
 /**
- * Transmits a packet over a connection-oriented channel.  This function only
- * consumes the supplied mbuf on success.
+ * Transmits a packet over a connection-oriented channel.  The SDU is queued
+ * behind any SDUs still being sent.  This function only consumes the supplied
+ * mbuf on success.  Failures of SDUs queued earlier are not returned here;
+ * they are reported with BLE_L2CAP_EVENT_COC_TX_UNSTALLED.
  */
 int
 ble_l2cap_coc_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_tx)
 {
     struct ble_l2cap_coc_endpoint *tx;
-
+    uint16_t cnt;
 
     tx = &chan->coc_tx;
 
@@ -677,15 +838,61 @@ ble_l2cap_coc_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_tx)
     }
 
     ble_hs_lock();
-    if (tx->sdus[0]) {
+    cnt = tx->sdu_q_cnt + (tx->sdus[0] != NULL);
+    if (cnt >= MYNEWT_VAL(BLE_L2CAP_COC_TX_QUEUE_LEN)) {
         ble_hs_unlock();
         return BLE_HS_EBUSY;
     }
-    tx->sdus[0] = sdu_tx;
+
+    if (!tx->sdus[0]) {
+        tx->sdus[0] = sdu_tx;
+    } else {
+        STAILQ_INSERT_TAIL(&tx->sdu_q, OS_MBUF_PKTHDR(sdu_tx), omp_next);
+        tx->sdu_q_cnt++;
+        tx->sdu_q_bytes += OS_MBUF_PKTLEN(sdu_tx);
+    }
 
 
     /* leave the host locked on purpose when ble_l2cap_coc_continue_tx() */
-    return ble_l2cap_coc_continue_tx(chan);
+    return ble_l2cap_coc_continue_tx(chan, sdu_tx);
+}
+
+int
+ble_l2cap_coc_tx_queued_nolock(struct ble_l2cap_chan *chan,
+                               uint16_t *out_sdus, uint32_t *out_bytes)
+{
+    struct ble_l2cap_coc_endpoint *tx;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    tx = &chan->coc_tx;
+
+    if (out_sdus != NULL) {
+        *out_sdus = tx->sdu_q_cnt + (tx->sdus[0] != NULL);
+    }
+
+    if (out_bytes != NULL) {
+        *out_bytes = tx->sdu_q_bytes;
+        if (tx->sdus[0] != NULL) {
+            /* Data already sent has been removed from the current SDU */
+            *out_bytes += OS_MBUF_PKTLEN(tx->sdus[0]);
+        }
+    }
+
+    return 0;
+}
+
+int
+ble_l2cap_coc_tx_queued(struct ble_l2cap_chan *chan, uint16_t *out_sdus,
+                        uint32_t *out_bytes)
+{
+    int rc;
+
+    ble_hs_lock();
+    rc = ble_l2cap_coc_tx_queued_nolock(chan, out_sdus, out_bytes);
+    ble_hs_unlock();
+
+    return rc;
 }
 
 int
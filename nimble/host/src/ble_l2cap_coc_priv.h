@@ -46,6 +46,10 @@ struct ble_l2cap_coc_endpoint {
     uint16_t credits;
     uint16_t data_offset;
     uint8_t flags;
+    /* SDUs queued for transmission behind sdus[0]; transmit side only */
+    STAILQ_HEAD(, os_mbuf_pkthdr) sdu_q;
+    uint16_t sdu_q_cnt;
+    uint32_t sdu_q_bytes;
 };
 
 struct ble_l2cap_coc_srv {
@@ -74,6 +78,10 @@ void ble_l2cap_coc_le_credits_update(uint16_t conn_handle, uint16_t dcid,
 int ble_l2cap_coc_recv_ready(struct ble_l2cap_chan *chan,
                              struct os_mbuf *sdu_rx);
 int ble_l2cap_coc_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_tx);
+int ble_l2cap_coc_tx_queued(struct ble_l2cap_chan *chan, uint16_t *out_sdus,
+                            uint32_t *out_bytes);
+int ble_l2cap_coc_tx_queued_nolock(struct ble_l2cap_chan *chan,
+                                   uint16_t *out_sdus, uint32_t *out_bytes);
 void ble_l2cap_coc_set_new_mtu_mps(struct ble_l2cap_chan *chan, uint16_t mtu, uint16_t mps);
 #else
 static inline int
@@ -110,6 +118,20 @@ ble_l2cap_coc_send(struct ble_l2cap_chan *chan, struct os_mbuf *sdu_tx)
 {
     return BLE_HS_ENOTSUP;
 }
+
+static inline int
+ble_l2cap_coc_tx_queued(struct ble_l2cap_chan *chan, uint16_t *out_sdus,
+                        uint32_t *out_bytes)
+{
+    return BLE_HS_ENOTSUP;
+}
+
+static inline int
+ble_l2cap_coc_tx_queued_nolock(struct ble_l2cap_chan *chan,
+                               uint16_t *out_sdus, uint32_t *out_bytes)
+{
+    return BLE_HS_ENOTSUP;
+}
 #endif
 
 #ifdef __cplusplus
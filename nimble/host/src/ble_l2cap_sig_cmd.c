@@ -110,7 +110,7 @@ ble_l2cap_sig_cmd_get(uint8_t opcode, uint8_t id, uint16_t len,
 {
     struct ble_l2cap_sig_hdr *hdr;
 
-    *txom = ble_hs_mbuf_l2cap_pkt();
+    *txom = ble_hs_mbuf_l2cap_pkt_sized(sizeof(*hdr) + len);
     if (*txom == NULL) {
         return NULL;
     }
@@ -65,7 +65,8 @@
 
 STAILQ_HEAD(ble_sm_proc_list, ble_sm_proc);
 
-typedef void ble_sm_rx_fn(uint16_t conn_handle, struct os_mbuf **om,
+typedef void ble_sm_rx_fn(uint16_t conn_handle,
+                          struct ble_hs_mbuf_cursor *cur,
                           struct ble_sm_result *res);
 
 static ble_sm_rx_fn ble_sm_rx_noop;
@@ -715,7 +716,7 @@ ble_sm_extract_expired(struct ble_sm_proc_list *dst_list)
 }
 
 static void
-ble_sm_rx_noop(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_rx_noop(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                struct ble_sm_result *res)
 {
     res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_CMD_NOT_SUPP);
@@ -1479,27 +1480,25 @@ ble_sm_random_exec(struct ble_sm_proc *proc, struct ble_sm_result *res,
 }
 
 static void
-ble_sm_random_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_random_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                  struct ble_sm_result *res)
 {
-    struct ble_sm_pair_random *cmd;
+    struct ble_sm_pair_random cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_pair_random *)(*om)->om_data;
-
     ble_hs_lock();
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_RANDOM, -1, NULL);
     if (proc == NULL) {
         res->app_status = BLE_HS_ENOENT;
     } else {
-        memcpy(ble_sm_peer_pair_rand(proc), cmd->value, 16);
+        memcpy(ble_sm_peer_pair_rand(proc), cmd.value, 16);
 
         if (proc->flags & BLE_SM_PROC_F_SC) {
             ble_sm_sc_random_rx(proc, res);
@@ -1526,28 +1525,26 @@ ble_sm_confirm_exec(struct ble_sm_proc *proc, struct ble_sm_result *res,
 }
 
 static void
-ble_sm_confirm_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_confirm_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                   struct ble_sm_result *res)
 {
-    struct ble_sm_pair_confirm *cmd;
+    struct ble_sm_pair_confirm cmd;
     struct ble_sm_proc *proc;
     uint8_t ioact;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_pair_confirm *)(*om)->om_data;
-
     ble_hs_lock();
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_CONFIRM, -1, NULL);
     if (proc == NULL) {
         res->app_status = BLE_HS_ENOENT;
     } else {
-        memcpy(proc->confirm_peer, cmd->value, 16);
+        memcpy(proc->confirm_peer, cmd.value, 16);
 
         if (proc->flags & BLE_SM_PROC_F_INITIATOR) {
             proc->state = BLE_SM_PROC_STATE_RANDOM;
@@ -1772,10 +1769,10 @@ ble_sm_verify_auth_requirements(uint8_t cmd)
 }
 
 static void
-ble_sm_pair_req_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_pair_req_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                    struct ble_sm_result *res)
 {
-    struct ble_sm_pair_cmd *req;
+    struct ble_sm_pair_cmd req;
     struct ble_sm_proc *proc;
     struct ble_sm_proc *prev;
     struct ble_hs_conn *conn;
@@ -1787,13 +1784,11 @@ ble_sm_pair_req_rx(uint16_t conn_handle, struct os_mbuf **om,
     proc_flags = 0;
     key_size = 0;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*req));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &req, sizeof(req));
     if (res->app_status != 0) {
         return;
     }
 
-    req = (struct ble_sm_pair_cmd *)(*om)->om_data;
-
     ble_hs_lock();
 
     /* XXX: Check connection state; reject if not appropriate. */
@@ -1842,7 +1837,7 @@ ble_sm_pair_req_rx(uint16_t conn_handle, struct os_mbuf **om,
         ble_sm_insert(proc);
 
         proc->pair_req[0] = BLE_SM_OP_PAIR_REQ;
-        memcpy(proc->pair_req + 1, req, sizeof(*req));
+        memcpy(proc->pair_req + 1, &req, sizeof(req));
 
         conn = ble_hs_conn_find_assert(proc->conn_handle);
         if (conn->bhc_flags & BLE_HS_CONN_F_MASTER) {
@@ -1851,25 +1846,25 @@ ble_sm_pair_req_rx(uint16_t conn_handle, struct os_mbuf **om,
         } else if (MYNEWT_VAL(BLE_SM_LVL) == 1) {
             res->sm_err = BLE_SM_ERR_CMD_NOT_SUPP;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_CMD_NOT_SUPP);
-        } else if (req->max_enc_key_size < BLE_SM_PAIR_KEY_SZ_MIN) {
+        } else if (req.max_enc_key_size < BLE_SM_PAIR_KEY_SZ_MIN) {
             res->sm_err = BLE_SM_ERR_ENC_KEY_SZ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_ENC_KEY_SZ);
-        } else if (req->max_enc_key_size > BLE_SM_PAIR_KEY_SZ_MAX) {
+        } else if (req.max_enc_key_size > BLE_SM_PAIR_KEY_SZ_MAX) {
             res->sm_err = BLE_SM_ERR_INVAL;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_INVAL);
-        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && !(req->authreq & BLE_SM_PAIR_AUTHREQ_SC)) {
+        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && !(req.authreq & BLE_SM_PAIR_AUTHREQ_SC)) {
             /* Fail if Secure Connections Only mode is on and SC is not supported by peer
              */
             res->sm_err = BLE_SM_ERR_AUTHREQ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_AUTHREQ);
             res->enc_cb = 1;
-        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && (req->max_enc_key_size != BLE_SM_PAIR_KEY_SZ_MAX)) {
+        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && (req.max_enc_key_size != BLE_SM_PAIR_KEY_SZ_MAX)) {
             /* Fail if Secure Connections Only mode is on and key size is too small
              */
             res->sm_err = BLE_SM_ERR_ENC_KEY_SZ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_ENC_KEY_SZ);
             res->enc_cb = 1;
-        } else if (!ble_sm_verify_auth_requirements(req->authreq)) {
+        } else if (!ble_sm_verify_auth_requirements(req.authreq)) {
             res->sm_err = BLE_SM_ERR_AUTHREQ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_AUTHREQ);
         } else {
@@ -1904,41 +1899,39 @@ ble_sm_pair_req_rx(uint16_t conn_handle, struct os_mbuf **om,
 }
 
 static void
-ble_sm_pair_rsp_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_pair_rsp_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                    struct ble_sm_result *res)
 {
-    struct ble_sm_pair_cmd *rsp;
+    struct ble_sm_pair_cmd rsp;
     struct ble_sm_proc *proc;
     uint8_t ioact;
     int rc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*rsp));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &rsp, sizeof(rsp));
     if (res->app_status != 0) {
         res->enc_cb = 1;
         return;
     }
 
-    rsp = (struct ble_sm_pair_cmd *)(*om)->om_data;
-
     ble_hs_lock();
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_PAIR, 1, NULL);
     if (proc != NULL) {
         proc->pair_rsp[0] = BLE_SM_OP_PAIR_RSP;
-        memcpy(proc->pair_rsp + 1, rsp, sizeof(*rsp));
+        memcpy(proc->pair_rsp + 1, &rsp, sizeof(rsp));
 
-        if (rsp->max_enc_key_size < BLE_SM_PAIR_KEY_SZ_MIN) {
+        if (rsp.max_enc_key_size < BLE_SM_PAIR_KEY_SZ_MIN) {
             res->sm_err = BLE_SM_ERR_ENC_KEY_SZ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_ENC_KEY_SZ);
-        } else if (rsp->max_enc_key_size > BLE_SM_PAIR_KEY_SZ_MAX) {
+        } else if (rsp.max_enc_key_size > BLE_SM_PAIR_KEY_SZ_MAX) {
             res->sm_err = BLE_SM_ERR_INVAL;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_INVAL);
-        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && (rsp->max_enc_key_size != BLE_SM_PAIR_KEY_SZ_MAX)) {
+        } else if (MYNEWT_VAL(BLE_SM_SC_ONLY) && (rsp.max_enc_key_size != BLE_SM_PAIR_KEY_SZ_MAX)) {
             /* Fail if Secure Connections Only mode is on and remote does not meet
             * key size requirements - MITM was checked in last step
             */
             res->sm_err = BLE_SM_ERR_ENC_KEY_SZ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_ENC_KEY_SZ);
-        } else if (!ble_sm_verify_auth_requirements(rsp->authreq)) {
+        } else if (!ble_sm_verify_auth_requirements(rsp.authreq)) {
             res->sm_err = BLE_SM_ERR_AUTHREQ;
             res->app_status = BLE_HS_SM_US_ERR(BLE_SM_ERR_AUTHREQ);
         } else {
@@ -1991,26 +1984,24 @@ ble_sm_sec_req_exec(struct ble_sm_proc *proc, struct ble_sm_result *res,
 }
 
 static void
-ble_sm_sec_req_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_sec_req_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                   struct ble_sm_result *res)
 {
     struct ble_gap_sec_state bhc_sec_state;
     struct ble_store_value_sec value_sec;
     struct ble_store_key_sec key_sec;
     struct ble_hs_conn_addrs addrs;
-    struct ble_sm_sec_req *cmd;
+    struct ble_sm_sec_req cmd;
     struct ble_hs_conn *conn;
     bool start_pairing = false;
     bool authreq_mitm;
     bool authreq_lesc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         return;
     }
 
-    cmd = (struct ble_sm_sec_req *)(*om)->om_data;
-
     /* XXX: Reject if:
      *     o authreq-reserved flags set?
      */
@@ -2057,8 +2048,8 @@ ble_sm_sec_req_rx(uint16_t conn_handle, struct os_mbuf **om,
             /* we don't care about bond flag here as peer is already
              * authenticated and thus we allow any configuration in new pairing
              */
-            authreq_mitm = !!(cmd->authreq & BLE_SM_PAIR_AUTHREQ_MITM);
-            authreq_lesc = !!(cmd->authreq & BLE_SM_PAIR_AUTHREQ_SC);
+            authreq_mitm = !!(cmd.authreq & BLE_SM_PAIR_AUTHREQ_MITM);
+            authreq_lesc = !!(cmd.authreq & BLE_SM_PAIR_AUTHREQ_SC);
 
             /* start new pairing if security is to be elevated, otherwise
              * only refresh encryption
@@ -2334,21 +2325,19 @@ ble_sm_key_rxed(struct ble_sm_proc *proc, struct ble_sm_result *res)
 }
 
 static void
-ble_sm_enc_info_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_enc_info_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                    struct ble_sm_result *res)
 {
-    struct ble_sm_enc_info *cmd;
+    struct ble_sm_enc_info cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_enc_info *)(*om)->om_data;
-
     ble_hs_lock();
 
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_KEY_EXCH, -1, NULL);
@@ -2358,7 +2347,7 @@ ble_sm_enc_info_rx(uint16_t conn_handle, struct os_mbuf **om,
     } else {
         proc->rx_key_flags &= ~BLE_SM_KE_F_ENC_INFO;
         proc->peer_keys.ltk_valid = 1;
-        memcpy(proc->peer_keys.ltk, cmd->ltk, 16);
+        memcpy(proc->peer_keys.ltk, cmd.ltk, 16);
         proc->peer_keys.key_size = proc->key_size;
 
         ble_sm_key_rxed(proc, res);
@@ -2368,21 +2357,19 @@ ble_sm_enc_info_rx(uint16_t conn_handle, struct os_mbuf **om,
 }
 
 static void
-ble_sm_master_id_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_master_id_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                     struct ble_sm_result *res)
 {
-    struct ble_sm_master_id *cmd;
+    struct ble_sm_master_id cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_master_id *)(*om)->om_data;
-
     ble_hs_lock();
 
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_KEY_EXCH, -1, NULL);
@@ -2393,8 +2380,8 @@ ble_sm_master_id_rx(uint16_t conn_handle, struct os_mbuf **om,
         proc->rx_key_flags &= ~BLE_SM_KE_F_MASTER_ID;
         proc->peer_keys.ediv_rand_valid = 1;
 
-        proc->peer_keys.ediv = le16toh(cmd->ediv);
-        proc->peer_keys.rand_val = le64toh(cmd->rand_val);
+        proc->peer_keys.ediv = le16toh(cmd.ediv);
+        proc->peer_keys.rand_val = le64toh(cmd.rand_val);
 
         ble_sm_key_rxed(proc, res);
     }
@@ -2403,21 +2390,19 @@ ble_sm_master_id_rx(uint16_t conn_handle, struct os_mbuf **om,
 }
 
 static void
-ble_sm_id_info_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_id_info_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                   struct ble_sm_result *res)
 {
-    struct ble_sm_id_info *cmd;
+    struct ble_sm_id_info cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_id_info *)(*om)->om_data;
-
     ble_hs_lock();
 
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_KEY_EXCH, -1, NULL);
@@ -2427,7 +2412,7 @@ ble_sm_id_info_rx(uint16_t conn_handle, struct os_mbuf **om,
     } else {
         proc->rx_key_flags &= ~BLE_SM_KE_F_ID_INFO;
 
-        memcpy(proc->peer_keys.irk, cmd->irk, 16);
+        memcpy(proc->peer_keys.irk, cmd.irk, 16);
         proc->peer_keys.irk_valid = 1;
 
         ble_sm_key_rxed(proc, res);
@@ -2437,21 +2422,19 @@ ble_sm_id_info_rx(uint16_t conn_handle, struct os_mbuf **om,
 }
 
 static void
-ble_sm_id_addr_info_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_id_addr_info_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                        struct ble_sm_result *res)
 {
-    struct ble_sm_id_addr_info *cmd;
+    struct ble_sm_id_addr_info cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_id_addr_info *)(*om)->om_data;
-
     ble_hs_lock();
 
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_KEY_EXCH, -1, NULL);
@@ -2461,8 +2444,8 @@ ble_sm_id_addr_info_rx(uint16_t conn_handle, struct os_mbuf **om,
     } else {
         proc->rx_key_flags &= ~BLE_SM_KE_F_ADDR_INFO;
         proc->peer_keys.addr_valid = 1;
-        proc->peer_keys.addr_type = cmd->addr_type;
-        memcpy(proc->peer_keys.addr, cmd->bd_addr, 6);
+        proc->peer_keys.addr_type = cmd.addr_type;
+        memcpy(proc->peer_keys.addr, cmd.bd_addr, 6);
 
         ble_sm_key_rxed(proc, res);
     }
@@ -2471,21 +2454,19 @@ ble_sm_id_addr_info_rx(uint16_t conn_handle, struct os_mbuf **om,
 }
 
 static void
-ble_sm_sign_info_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_sign_info_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                     struct ble_sm_result *res)
 {
-    struct ble_sm_sign_info *cmd;
+    struct ble_sm_sign_info cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         res->enc_cb = 1;
         return;
     }
 
-    cmd = (struct ble_sm_sign_info *)(*om)->om_data;
-
     ble_hs_lock();
 
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_KEY_EXCH, -1, NULL);
@@ -2495,7 +2476,7 @@ ble_sm_sign_info_rx(uint16_t conn_handle, struct os_mbuf **om,
     } else {
         proc->rx_key_flags &= ~BLE_SM_KE_F_SIGN_INFO;
 
-        memcpy(proc->peer_keys.csrk, cmd->sig_key, 16);
+        memcpy(proc->peer_keys.csrk, cmd.sig_key, 16);
         proc->peer_keys.csrk_valid = 1;
 
         ble_sm_key_rxed(proc, res);
@@ -2509,19 +2490,17 @@ ble_sm_sign_info_rx(uint16_t conn_handle, struct os_mbuf **om,
  *****************************************************************************/
 
 static void
-ble_sm_fail_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_fail_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                struct ble_sm_result *res)
 {
-    struct ble_sm_pair_fail *cmd;
+    struct ble_sm_pair_fail cmd;
 
     res->enc_cb = 1;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status == 0) {
-        cmd = (struct ble_sm_pair_fail *)(*om)->om_data;
-
-        res->app_status = BLE_HS_SM_PEER_ERR(cmd->reason);
-        res->sm_err =  cmd->reason;
+        res->app_status = BLE_HS_SM_PEER_ERR(cmd.reason);
+        res->sm_err =  cmd.reason;
     }
 }
 
@@ -2710,6 +2689,7 @@ ble_sm_enc_initiate(uint16_t conn_handle, uint8_t key_size,
 static int
 ble_sm_rx(struct ble_l2cap_chan *chan, struct os_mbuf **om)
 {
+    struct ble_hs_mbuf_cursor cur;
     struct ble_sm_result res;
     ble_sm_rx_fn *rx_cb;
     uint8_t op;
@@ -2723,19 +2703,21 @@ ble_sm_rx(struct ble_l2cap_chan *chan, struct os_mbuf **om)
         return BLE_HS_ENOTCONN;
     }
 
-    rc = os_mbuf_copydata(*om, 0, 1, &op);
+    /* Handlers copy their command out through the cursor.  Keys split
+     * across ACL fragments are gathered without pulling the chain up.
+     */
+    ble_hs_mbuf_cursor_init(&cur, *om, 0);
+
+    rc = ble_hs_mbuf_cursor_read(&cur, &op, 1);
     if (rc != 0) {
         return BLE_HS_EBADDATA;
     }
 
-    /* Strip L2CAP SM header from the front of the mbuf. */
-    os_mbuf_adj(*om, 1);
-
     rx_cb = ble_sm_dispatch_get(op);
     if (rx_cb != NULL) {
         memset(&res, 0, sizeof res);
 
-        rx_cb(conn_handle, om, &res);
+        rx_cb(conn_handle, &cur, &res);
         ble_sm_process_result(conn_handle, &res, op == BLE_SM_OP_PAIR_FAIL ?
                               false : true);
         rc = res.app_status;
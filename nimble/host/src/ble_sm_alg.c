@@ -540,6 +540,48 @@ ble_sm_alg_csis_sih(const uint8_t *k, const uint8_t *r, uint8_t *out)
     return 0;
 }
 
+/**
+ * Calculates the GATT Database Hash (Vol 3, Part G, 7.3.1): AES-CMAC with a
+ * zero key over the concatenated attribute data.
+ *
+ * @param om                    Chain holding the concatenated attribute data.
+ * @param out                   Output; the 128-bit hash in little-endian.
+ */
+int
+ble_sm_alg_db_hash(const struct os_mbuf *om, uint8_t *out)
+{
+    mbedtls_cipher_context_t ctx;
+    const uint8_t k_zero[16] = {0};
+    int rc;
+
+    mbedtls_cipher_init(&ctx);
+
+    rc = mbedtls_cipher_setup(&ctx, mbedtls_cipher_info_from_type(
+                                        MBEDTLS_CIPHER_AES_128_ECB));
+    if (rc == 0) {
+        rc = mbedtls_cipher_cmac_starts(&ctx, k_zero, 128);
+    }
+
+    /* Feed the chain one buffer at a time; it is never flattened. */
+    for (; rc == 0 && om != NULL; om = SLIST_NEXT(om, om_next)) {
+        rc = mbedtls_cipher_cmac_update(&ctx, om->om_data, om->om_len);
+    }
+
+    if (rc == 0) {
+        rc = mbedtls_cipher_cmac_finish(&ctx, out);
+    }
+
+    mbedtls_cipher_free(&ctx);
+
+    if (rc != 0) {
+        return BLE_HS_EUNKNOWN;
+    }
+
+    swap_in_place(out, 16);
+
+    return 0;
+}
+
 int
 ble_sm_alg_rng(void *arg, unsigned char *buf, size_t size)
 {
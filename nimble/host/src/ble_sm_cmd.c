@@ -31,7 +31,7 @@ ble_sm_cmd_get(uint8_t opcode, size_t len, struct os_mbuf **txom)
     struct ble_sm_hdr *hdr;
     void *data;
 
-    *txom = ble_hs_mbuf_l2cap_pkt();
+    *txom = ble_hs_mbuf_l2cap_pkt_sized(sizeof(struct ble_sm_hdr) + len);
     if (*txom == NULL) {
         return NULL;
     }
@@ -32,6 +32,7 @@ extern "C" {
 struct ble_gap_sec_state;
 struct hci_le_lt_key_req;
 struct hci_encrypt_change;
+struct ble_hs_mbuf_cursor;
 
 #define BLE_SM_MTU                  65
 
@@ -322,6 +323,7 @@ int ble_sm_alg_csis_sef(const uint8_t *k, const uint8_t *plaintext_sirk,
 int ble_sm_alg_csis_sdf(const uint8_t *k, const uint8_t *enc_sirk,
                         uint8_t *out);
 int ble_sm_alg_csis_sih(const uint8_t *k, const uint8_t *r, uint8_t *out);
+int ble_sm_alg_db_hash(const struct os_mbuf *om, uint8_t *out);
 int ble_sm_alg_gen_dhkey(const uint8_t *peer_pub_key_x,
                          const uint8_t *peer_pub_key_y,
                          const uint8_t *our_priv_key, uint8_t *out_dhkey);
@@ -361,11 +363,13 @@ void ble_sm_sc_random_rx(struct ble_sm_proc *proc, struct ble_sm_result *res);
 void ble_sm_sc_public_key_exec(struct ble_sm_proc *proc,
                                struct ble_sm_result *res,
                                void *arg);
-void ble_sm_sc_public_key_rx(uint16_t conn_handle, struct os_mbuf **rxom,
+void ble_sm_sc_public_key_rx(uint16_t conn_handle,
+                             struct ble_hs_mbuf_cursor *cur,
                              struct ble_sm_result *res);
 void ble_sm_sc_dhkey_check_exec(struct ble_sm_proc *proc,
                                 struct ble_sm_result *res, void *arg);
-void ble_sm_sc_dhkey_check_rx(uint16_t conn_handle, struct os_mbuf **rxom,
+void ble_sm_sc_dhkey_check_rx(uint16_t conn_handle,
+                              struct ble_hs_mbuf_cursor *cur,
                               struct ble_sm_result *res);
 bool ble_sm_sc_oob_data_check(struct ble_sm_proc *proc,
                               bool oob_data_local_present,
@@ -590,15 +590,15 @@ ble_sm_sc_public_key_exec(struct ble_sm_proc *proc, struct ble_sm_result *res,
 }
 
 void
-ble_sm_sc_public_key_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_sc_public_key_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                         struct ble_sm_result *res)
 {
-    struct ble_sm_public_key *cmd;
+    struct ble_sm_public_key cmd;
     struct ble_sm_proc *proc;
     uint8_t ioact;
     int rc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->enc_cb = 1;
         return;
@@ -611,10 +611,9 @@ ble_sm_sc_public_key_rx(uint16_t conn_handle, struct os_mbuf **om,
         return;
     }
 
-    cmd = (struct ble_sm_public_key *)(*om)->om_data;
     /* Check if the peer public key is same as our generated public key.
      * Return fail if the public keys match. */
-    if (memcmp(cmd, ble_sm_sc_pub_key, 64) == 0) {
+    if (memcmp(&cmd, ble_sm_sc_pub_key, 64) == 0) {
         res->enc_cb = 1;
         res->sm_err = BLE_SM_ERR_AUTHREQ;
         return;
@@ -627,7 +626,7 @@ ble_sm_sc_public_key_rx(uint16_t conn_handle, struct os_mbuf **om,
         res->app_status = BLE_HS_ENOENT;
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
     } else {
-        memcpy(&proc->pub_key_peer, cmd, sizeof(*cmd));
+        memcpy(&proc->pub_key_peer, &cmd, sizeof(cmd));
         rc = ble_sm_alg_gen_dhkey(proc->pub_key_peer.x,
                                   proc->pub_key_peer.y,
                                   ble_sm_sc_priv_key,
@@ -831,28 +830,26 @@ ble_sm_dhkey_check_process(struct ble_sm_proc *proc,
 }
 
 void
-ble_sm_sc_dhkey_check_rx(uint16_t conn_handle, struct os_mbuf **om,
+ble_sm_sc_dhkey_check_rx(uint16_t conn_handle, struct ble_hs_mbuf_cursor *cur,
                          struct ble_sm_result *res)
 {
-    struct ble_sm_dhkey_check *cmd;
+    struct ble_sm_dhkey_check cmd;
     struct ble_sm_proc *proc;
 
-    res->app_status = ble_hs_mbuf_pullup_base(om, sizeof(*cmd));
+    res->app_status = ble_hs_mbuf_cursor_read(cur, &cmd, sizeof(cmd));
     if (res->app_status != 0) {
         res->enc_cb = 1;
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         return;
     }
 
-    cmd = (struct ble_sm_dhkey_check *)(*om)->om_data;
-
     ble_hs_lock();
     proc = ble_sm_proc_find(conn_handle, BLE_SM_PROC_STATE_DHKEY_CHECK, -1,
                             NULL);
     if (proc == NULL) {
         res->app_status = BLE_HS_ENOENT;
     } else {
-        ble_sm_dhkey_check_process(proc, cmd, res);
+        ble_sm_dhkey_check_process(proc, &cmd, res);
     }
     ble_hs_unlock();
 }
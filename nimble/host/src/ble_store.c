@@ -294,6 +294,54 @@ ble_store_key_from_value_cccd(struct ble_store_key_cccd *out_key,
     out_key->idx = 0;
 }
 
+int
+ble_store_read_gatt_cache(const struct ble_store_key_gatt_cache *key,
+                          struct ble_store_value_gatt_cache *out_value)
+{
+    union ble_store_value *store_value;
+    union ble_store_key *store_key;
+    int rc;
+
+    store_key = (void *)key;
+    store_value = (void *)out_value;
+    rc = ble_store_read(BLE_STORE_OBJ_TYPE_GATT_CACHE, store_key, store_value);
+    return rc;
+}
+
+int
+ble_store_write_gatt_cache(const struct ble_store_value_gatt_cache *value)
+{
+    union ble_store_value *store_value;
+    int rc;
+
+    store_value = (void *)value;
+    rc = ble_store_write(BLE_STORE_OBJ_TYPE_GATT_CACHE, store_value);
+    return rc;
+}
+
+int
+ble_store_delete_gatt_cache(const struct ble_store_key_gatt_cache *key)
+{
+    union ble_store_key *store_key;
+    int rc;
+
+    store_key = (void *)key;
+    rc = ble_store_delete(BLE_STORE_OBJ_TYPE_GATT_CACHE, store_key);
+    return rc;
+}
+
+void
+ble_store_key_from_value_gatt_cache(
+    struct ble_store_key_gatt_cache *out_key,
+    const struct ble_store_value_gatt_cache *value)
+{
+    out_key->peer_addr = value->peer_addr;
+    out_key->type = value->type;
+    out_key->start_handle = value->handle;
+    out_key->end_handle = value->handle;
+    out_key->idx = 0;
+}
+
 void
 ble_store_key_from_value_sec(struct ble_store_key_sec *out_key,
                              const struct ble_store_value_sec *value)
@@ -317,6 +365,11 @@ ble_store_key_from_value(int obj_type,
         ble_store_key_from_value_cccd(&out_key->cccd, &value->cccd);
         break;
 
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        ble_store_key_from_value_gatt_cache(&out_key->gatt_cache,
+                                            &value->gatt_cache);
+        break;
+
     default:
         BLE_HS_DBG_ASSERT(0);
         break;
@@ -331,7 +384,8 @@ ble_store_iterate(int obj_type,
     union ble_store_key key;
     union ble_store_value value;
     int idx = 0;
-    uint8_t *pidx;
+    uint8_t *pidx = NULL;
+    uint16_t *pidx16 = NULL;
     int rc;
 
     /* a magic value to retrieve anything */
@@ -346,13 +400,21 @@ ble_store_iterate(int obj_type,
         key.cccd.peer_addr = *BLE_ADDR_ANY;
         pidx = &key.cccd.idx;
         break;
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        key.gatt_cache.peer_addr = *BLE_ADDR_ANY;
+        pidx16 = &key.gatt_cache.idx;
+        break;
     default:
         BLE_HS_DBG_ASSERT(0);
         return BLE_HS_EINVAL;
     }
 
     while (1) {
-        *pidx = idx;
+        if (pidx16 != NULL) {
+            *pidx16 = idx;
+        } else {
+            *pidx = idx;
+        }
         rc = ble_store_read(obj_type, &key, &value);
         switch (rc) {
         case 0:
@@ -390,6 +452,7 @@ ble_store_clear(void)
         BLE_STORE_OBJ_TYPE_OUR_SEC,
         BLE_STORE_OBJ_TYPE_PEER_SEC,
         BLE_STORE_OBJ_TYPE_CCCD,
+        BLE_STORE_OBJ_TYPE_GATT_CACHE,
     };
     union ble_store_key key;
     int obj_type;
@@ -406,7 +469,12 @@ ble_store_clear(void)
             rc = ble_store_delete(obj_type, &key);
         } while (rc == 0);
 
-        /* BLE_HS_ENOENT means we deleted everything. */
+        /* BLE_HS_ENOENT means we deleted everything.  Not every store
+         * implements the GATT cache.
+         */
+        if (rc == BLE_HS_ENOTSUP && obj_type == BLE_STORE_OBJ_TYPE_GATT_CACHE) {
+            continue;
+        }
         if (rc != BLE_HS_ENOENT) {
             return rc;
         }
@@ -109,6 +109,14 @@ ble_store_util_delete_peer(const ble_addr_t *peer_id_addr)
         return rc;
     }
 
+    memset(&key, 0, sizeof key);
+    key.gatt_cache.peer_addr = *peer_id_addr;
+
+    rc = ble_store_util_delete_all(BLE_STORE_OBJ_TYPE_GATT_CACHE, &key);
+    if (rc != 0 && rc != BLE_HS_ENOTSUP) {
+        return rc;
+    }
+
     return 0;
 }
 
@@ -184,6 +192,61 @@ ble_store_util_delete_oldest_peer(void)
     return 0;
 }
 
+struct ble_store_util_gatt_cache_peer {
+    const ble_addr_t *except;
+    ble_addr_t peer_addr;
+    int found;
+};
+
+static int
+ble_store_util_iter_gatt_cache_peer(int obj_type,
+                                    union ble_store_value *val,
+                                    void *arg)
+{
+    struct ble_store_util_gatt_cache_peer *cookie;
+
+    cookie = arg;
+
+    if (ble_addr_cmp(&val->gatt_cache.peer_addr, cookie->except) == 0) {
+        return 0;
+    }
+
+    cookie->peer_addr = val->gatt_cache.peer_addr;
+    cookie->found = 1;
+
+    return 1;
+}
+
+/**
+ * Deletes the GATT cache of the first peer found in the store, other than the
+ * specified one.
+ */
+static int
+ble_store_util_delete_gatt_cache_except(const ble_addr_t *peer_id_addr)
+{
+    struct ble_store_util_gatt_cache_peer cookie;
+    union ble_store_key key;
+    int rc;
+
+    cookie.except = peer_id_addr;
+    cookie.found = 0;
+
+    rc = ble_store_iterate(BLE_STORE_OBJ_TYPE_GATT_CACHE,
+                           ble_store_util_iter_gatt_cache_peer, &cookie);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (!cookie.found) {
+        return BLE_HS_ESTORE_CAP;
+    }
+
+    memset(&key, 0, sizeof key);
+    key.gatt_cache.peer_addr = cookie.peer_addr;
+
+    return ble_store_util_delete_all(BLE_STORE_OBJ_TYPE_GATT_CACHE, &key);
+}
+
 int
 ble_store_util_status_rr(struct ble_store_status_event *event, void *arg)
 {
@@ -196,7 +259,10 @@ ble_store_util_status_rr(struct ble_store_status_event *event, void *arg)
         case BLE_STORE_OBJ_TYPE_CCCD:
             /* Try unpairing oldest peer except current peer */
             return ble_gap_unpair_oldest_except(&event->overflow.value->cccd.peer_addr);
-
+        case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+            /* The cache can always be rebuilt; drop another peer's. */
+            return ble_store_util_delete_gatt_cache_except(
+                &event->overflow.value->gatt_cache.peer_addr);
         default:
             return BLE_HS_EUNKNOWN;
         }
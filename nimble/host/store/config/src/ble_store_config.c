@@ -47,6 +47,13 @@ struct ble_store_value_cccd
 
 int ble_store_config_num_cccds;
 
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+struct ble_store_value_gatt_cache
+    ble_store_config_gatt_cache[MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)];
+#endif
+
+int ble_store_config_num_gatt_cache;
+
 /*****************************************************************************
  * $sec                                                                      *
  *****************************************************************************/
@@ -447,6 +454,236 @@ ble_store_config_write_cccd(const struct ble_store_value_cccd *value_cccd)
 #endif
 }
 
+/*****************************************************************************
+ * $gatt cache                                                               *
+ *****************************************************************************/
+
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+/**
+ * Entries are kept sorted by peer address, type and handle.  A key that
+ * names a peer therefore matches a contiguous run of entries which can be
+ * located with a binary search, and the entries of one type are retrieved in
+ * handle order.
+ */
+static int
+ble_store_config_cmp_gatt_cache(const struct ble_store_value_gatt_cache *entry,
+                                const ble_addr_t *peer_addr, uint8_t type,
+                                uint16_t handle)
+{
+    int rc;
+
+    rc = ble_addr_cmp(&entry->peer_addr, peer_addr);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (entry->type != type) {
+        return entry->type - type;
+    }
+
+    return entry->handle - handle;
+}
+
+/**
+ * Returns the index of the first entry that does not sort before the
+ * specified peer, type and handle.
+ */
+static int
+ble_store_config_lower_gatt_cache(const ble_addr_t *peer_addr, uint8_t type,
+                                  uint16_t handle)
+{
+    int lo;
+    int hi;
+    int mid;
+
+    lo = 0;
+    hi = ble_store_config_num_gatt_cache;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (ble_store_config_cmp_gatt_cache(ble_store_config_gatt_cache + mid,
+                                            peer_addr, type, handle) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static int
+ble_store_config_find_gatt_cache(const struct ble_store_key_gatt_cache *key)
+{
+    struct ble_store_value_gatt_cache *entry;
+    uint16_t start_handle;
+    int skipped;
+    int i;
+
+    if (ble_addr_cmp(&key->peer_addr, BLE_ADDR_ANY) &&
+        (key->type != 0 || key->end_handle == 0)) {
+
+        start_handle = key->end_handle != 0 ? key->start_handle : 0;
+        i = ble_store_config_lower_gatt_cache(&key->peer_addr, key->type,
+                                              start_handle) + key->idx;
+        if (i >= ble_store_config_num_gatt_cache) {
+            return -1;
+        }
+
+        entry = ble_store_config_gatt_cache + i;
+        if (ble_addr_cmp(&entry->peer_addr, &key->peer_addr) ||
+            (key->type != 0 && entry->type != key->type) ||
+            (key->end_handle != 0 && entry->handle > key->end_handle)) {
+
+            return -1;
+        }
+
+        return i;
+    }
+
+    /* Key does not map to a contiguous run of entries; scan them all. */
+    skipped = 0;
+    for (i = 0; i < ble_store_config_num_gatt_cache; i++) {
+        entry = ble_store_config_gatt_cache + i;
+
+        if (ble_addr_cmp(&key->peer_addr, BLE_ADDR_ANY)) {
+            if (ble_addr_cmp(&entry->peer_addr, &key->peer_addr)) {
+                continue;
+            }
+        }
+
+        if (key->type != 0) {
+            if (entry->type != key->type) {
+                continue;
+            }
+        }
+
+        if (key->end_handle != 0) {
+            if (entry->handle < key->start_handle ||
+                entry->handle > key->end_handle) {
+                continue;
+            }
+        }
+
+        if (key->idx > skipped) {
+            skipped++;
+            continue;
+        }
+
+        return i;
+    }
+    return -1;
+}
+
+/**
+ * Cache entries are written one attribute at a time while a discovery is in
+ * progress, so only changes to a peer's hash entry are persisted.  The
+ * client marks an entry complete only after its children have been written,
+ * so any snapshot taken this way is consistent.
+ */
+static int
+ble_store_config_persist_gatt_cache_if(uint8_t type)
+{
+    if (type != BLE_STORE_GATT_CACHE_TYPE_HASH) {
+        return 0;
+    }
+
+    return ble_store_config_persist_gatt_cache();
+}
+#endif
+
+static int
+ble_store_config_delete_gatt_cache(const struct ble_store_key_gatt_cache *key)
+{
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+    uint8_t type;
+    int idx;
+    int rc;
+
+    idx = ble_store_config_find_gatt_cache(key);
+    if (idx < 0) {
+        return BLE_HS_ENOENT;
+    }
+
+    type = ble_store_config_gatt_cache[idx].type;
+    rc = ble_store_config_delete_obj(ble_store_config_gatt_cache,
+                                     sizeof *ble_store_config_gatt_cache,
+                                     idx,
+                                     &ble_store_config_num_gatt_cache);
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = ble_store_config_persist_gatt_cache_if(type);
+    if (rc != 0) {
+        return rc;
+    }
+    return 0;
+#else
+    return BLE_HS_ENOENT;
+#endif
+}
+
+static int
+ble_store_config_read_gatt_cache(const struct ble_store_key_gatt_cache *key,
+                                 struct ble_store_value_gatt_cache *value)
+{
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+    int idx;
+
+    idx = ble_store_config_find_gatt_cache(key);
+    if (idx == -1) {
+        return BLE_HS_ENOENT;
+    }
+
+    *value = ble_store_config_gatt_cache[idx];
+    return 0;
+#else
+    return BLE_HS_ENOENT;
+#endif
+}
+
+static int
+ble_store_config_write_gatt_cache(
+    const struct ble_store_value_gatt_cache *value)
+{
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+    struct ble_store_key_gatt_cache key;
+    int idx;
+    int rc;
+
+    ble_store_key_from_value_gatt_cache(&key, value);
+    idx = ble_store_config_find_gatt_cache(&key);
+    if (idx == -1) {
+        if (ble_store_config_num_gatt_cache >=
+            MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)) {
+
+            BLE_HS_LOG(DEBUG, "error persisting gatt cache; too many entries "
+                              "(%d)\n", ble_store_config_num_gatt_cache);
+            return BLE_HS_ESTORE_CAP;
+        }
+
+        idx = ble_store_config_lower_gatt_cache(&value->peer_addr,
+                                                value->type, value->handle);
+        memmove(ble_store_config_gatt_cache + idx + 1,
+                ble_store_config_gatt_cache + idx,
+                (ble_store_config_num_gatt_cache - idx) *
+                sizeof *ble_store_config_gatt_cache);
+        ble_store_config_num_gatt_cache++;
+    }
+
+    ble_store_config_gatt_cache[idx] = *value;
+
+    rc = ble_store_config_persist_gatt_cache_if(value->type);
+    if (rc != 0) {
+        return rc;
+    }
+
+    return 0;
+#else
+    return BLE_HS_ENOENT;
+#endif
+}
+
 /*****************************************************************************
  * $api                                                                      *
  *****************************************************************************/
@@ -489,6 +726,10 @@ ble_store_config_read(int obj_type, const union ble_store_key *key,
         rc = ble_store_config_read_cccd(&key->cccd, &value->cccd);
         return rc;
 
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        rc = ble_store_config_read_gatt_cache(&key->gatt_cache, &value->gatt_cache);
+        return rc;
+
     default:
         return BLE_HS_ENOTSUP;
     }
@@ -518,6 +759,10 @@ ble_store_config_write(int obj_type, const union ble_store_value *val)
         rc = ble_store_config_write_cccd(&val->cccd);
         return rc;
 
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        rc = ble_store_config_write_gatt_cache(&val->gatt_cache);
+        return rc;
+
     default:
         return BLE_HS_ENOTSUP;
     }
@@ -541,6 +786,10 @@ ble_store_config_delete(int obj_type, const union ble_store_key *key)
         rc = ble_store_config_delete_cccd(&key->cccd);
         return rc;
 
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        rc = ble_store_config_delete_gatt_cache(&key->gatt_cache);
+        return rc;
+
     default:
         return BLE_HS_ENOTSUP;
     }
@@ -560,6 +809,7 @@ ble_store_config_init(void)
     ble_store_config_num_our_secs = 0;
     ble_store_config_num_peer_secs = 0;
     ble_store_config_num_cccds = 0;
+    ble_store_config_num_gatt_cache = 0;
 
     ble_store_config_conf_init();
 }
@@ -57,6 +57,19 @@ static struct conf_handler ble_store_config_conf_handler = {
 #define BLE_STORE_CONFIG_CCCD_SET_ENCODE_SZ \
     (MYNEWT_VAL(BLE_STORE_MAX_CCCDS) * BLE_STORE_CONFIG_CCCD_ENCODE_SZ + 1)
 
+#define BLE_STORE_CONFIG_GATT_CACHE_ENCODE_SZ       \
+    BASE64_ENCODE_SIZE(sizeof (struct ble_store_value_gatt_cache))
+
+#define BLE_STORE_CONFIG_GATT_CACHE_SET_ENCODE_SZ   \
+    (MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE) *         \
+     BLE_STORE_CONFIG_GATT_CACHE_ENCODE_SZ + 1)
+
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+/* The encoded cache is too large for the stack. */
+static char
+ble_store_config_gatt_cache_buf[BLE_STORE_CONFIG_GATT_CACHE_SET_ENCODE_SZ];
+#endif
+
 static void
 ble_store_config_serialize_arr(const void *arr, int obj_sz, int num_objs,
                                char *out_buf, int buf_sz)
@@ -118,6 +131,15 @@ ble_store_config_conf_set(int argc, char **argv, char *val)
                     sizeof *ble_store_config_cccds,
                     &ble_store_config_num_cccds);
             return rc;
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+        } else if (strcmp(argv[0], "gatt_cache") == 0) {
+            rc = ble_store_config_deserialize_arr(
+                    val,
+                    ble_store_config_gatt_cache,
+                    sizeof *ble_store_config_gatt_cache,
+                    &ble_store_config_num_gatt_cache);
+            return rc;
+#endif
         }
     }
     return OS_ENOENT;
@@ -153,6 +175,15 @@ ble_store_config_conf_export(void (*func)(char *name, char *val),
                                    sizeof buf.cccd);
     func("ble_hs/cccd", buf.cccd);
 
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+    ble_store_config_serialize_arr(ble_store_config_gatt_cache,
+                                   sizeof *ble_store_config_gatt_cache,
+                                   ble_store_config_num_gatt_cache,
+                                   ble_store_config_gatt_cache_buf,
+                                   sizeof ble_store_config_gatt_cache_buf);
+    func("ble_hs/gatt_cache", ble_store_config_gatt_cache_buf);
+#endif
+
     return 0;
 }
 
@@ -223,6 +254,26 @@ ble_store_config_persist_cccds(void)
     return 0;
 }
 
+int
+ble_store_config_persist_gatt_cache(void)
+{
+#if MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE)
+    int rc;
+
+    ble_store_config_serialize_arr(ble_store_config_gatt_cache,
+                                   sizeof *ble_store_config_gatt_cache,
+                                   ble_store_config_num_gatt_cache,
+                                   ble_store_config_gatt_cache_buf,
+                                   sizeof ble_store_config_gatt_cache_buf);
+    rc = conf_save_one("ble_hs/gatt_cache", ble_store_config_gatt_cache_buf);
+    if (rc != 0) {
+        return BLE_HS_ESTORE_FAIL;
+    }
+#endif
+
+    return 0;
+}
+
 void
 ble_store_config_conf_init(void)
 {
@@ -179,6 +179,62 @@ TEST_CASE_SELF(ble_att_clt_test_rx_find_info)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+TEST_CASE_SELF(ble_att_clt_test_rx_find_info_frag)
+{
+    struct ble_att_find_info_rsp rsp;
+    struct hci_data_hdr hci_hdr;
+    struct os_mbuf *om2;
+    struct os_mbuf *om;
+    uint16_t conn_handle;
+    uint8_t buf[64];
+    uint8_t uuid128_1[16] = { 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 };
+    int off;
+    int rc;
+
+    conn_handle = ble_att_clt_test_misc_init();
+
+    /* Two 128-bit UUIDs do not fit in the default MTU. */
+    ble_hs_test_util_set_att_mtu(conn_handle, 64);
+
+    /*** Two 128-bit UUIDs; the second one spans two mbufs. */
+    off = 0;
+    rsp.bafp_format = BLE_ATT_FIND_INFO_RSP_FORMAT_128BIT;
+    ble_att_find_info_rsp_write(buf + off, sizeof buf - off, &rsp);
+    off += BLE_ATT_FIND_INFO_RSP_BASE_SZ;
+
+    put_le16(buf + off, 1);
+    off += 2;
+    memcpy(buf + off, uuid128_1, 16);
+    off += 16;
+
+    put_le16(buf + off, 2);
+    off += 2;
+    memcpy(buf + off, uuid128_1, 16);
+    off += 16;
+
+    om = ble_hs_mbuf_l2cap_pkt();
+    TEST_ASSERT_FATAL(om != NULL);
+    rc = os_mbuf_append(om, buf, off - 7);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    om2 = os_msys_get(0, 0);
+    TEST_ASSERT_FATAL(om2 != NULL);
+    memcpy(om2->om_data, buf + off - 7, 7);
+    om2->om_len = 7;
+    os_mbuf_concat(om, om2);
+
+    hci_hdr.hdh_handle_pb_bc =
+        ble_hs_hci_util_handle_pb_bc_join(conn_handle,
+                                          BLE_HCI_PB_FIRST_FLUSH, 0);
+    hci_hdr.hdh_len = off;
+
+    rc = ble_hs_test_util_l2cap_rx_first_frag(conn_handle, BLE_L2CAP_CID_ATT,
+                                              &hci_hdr, om);
+    TEST_ASSERT(rc == 0);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
 static void
 ble_att_clt_test_case_tx_write_req_or_cmd(int is_req)
 {
@@ -553,6 +609,7 @@ TEST_SUITE(ble_att_clt_suite)
 {
     ble_att_clt_test_tx_find_info();
     ble_att_clt_test_rx_find_info();
+    ble_att_clt_test_rx_find_info_frag();
     ble_att_clt_test_tx_read();
     ble_att_clt_test_rx_read();
     ble_att_clt_test_tx_read_blob();
@@ -2262,6 +2262,80 @@ TEST_CASE_SELF(ble_att_svr_test_large_value)
     ble_att_svr_test_assert_mbufs_freed();
 }
 
+/**
+ * Verifies that handle and UUID lookups honour hidden attribute ranges.
+ */
+TEST_CASE_SELF(ble_att_svr_test_hidden_range)
+{
+    static const ble_uuid16_t uuid_svc =
+        BLE_UUID16_INIT(BLE_ATT_UUID_PRIMARY_SERVICE);
+    static const ble_uuid16_t uuid_chr =
+        BLE_UUID16_INIT(BLE_ATT_UUID_CHARACTERISTIC);
+    struct ble_att_svr_entry *entry;
+    uint16_t conn_handle;
+    int num_found;
+    int rc;
+    int i;
+
+    conn_handle = ble_att_svr_test_misc_init(0);
+
+    /* Alternate primary services and characteristic declarations. */
+    for (i = 1; i <= 12; i++) {
+        ble_att_svr_test_misc_register_uuid(i % 2 ? &uuid_svc.u : &uuid_chr.u,
+                                            HA_FLAG_PERM_RW, i,
+                                            ble_att_svr_test_misc_attr_fn_r_1);
+    }
+
+    for (i = 1; i <= 12; i++) {
+        entry = ble_att_svr_find_by_handle(i);
+        TEST_ASSERT_FATAL(entry != NULL);
+        TEST_ASSERT(entry->ha_handle_id == i);
+    }
+    TEST_ASSERT(ble_att_svr_find_by_handle(0) == NULL);
+    TEST_ASSERT(ble_att_svr_find_by_handle(13) == NULL);
+
+    ble_att_svr_hide_range(3, 6);
+
+    for (i = 3; i <= 6; i++) {
+        TEST_ASSERT(ble_att_svr_find_by_handle(i) == NULL);
+    }
+    TEST_ASSERT(ble_att_svr_find_by_handle(2) != NULL);
+    TEST_ASSERT(ble_att_svr_find_by_handle(7) != NULL);
+
+    num_found = 0;
+    entry = NULL;
+    while ((entry = ble_att_svr_find_by_uuid(entry, &uuid_chr.u,
+                                             0xffff)) != NULL) {
+
+        TEST_ASSERT(entry->ha_handle_id < 3 || entry->ha_handle_id > 6);
+        num_found++;
+    }
+    TEST_ASSERT(num_found == 4);
+
+    /* Reading a hidden attribute fails with invalid handle. */
+    rc = ble_hs_test_util_rx_att_read_req(conn_handle, 4);
+    TEST_ASSERT(rc != 0);
+    ble_hs_test_util_verify_tx_err_rsp(BLE_ATT_OP_READ_REQ, 4,
+                                       BLE_ATT_ERR_INVALID_HANDLE);
+
+    ble_att_svr_restore_range(3, 6);
+
+    for (i = 3; i <= 6; i++) {
+        TEST_ASSERT(ble_att_svr_find_by_handle(i) != NULL);
+    }
+
+    num_found = 0;
+    entry = NULL;
+    while ((entry = ble_att_svr_find_by_uuid(entry, &uuid_chr.u,
+                                             0xffff)) != NULL) {
+
+        num_found++;
+    }
+    TEST_ASSERT(num_found == 6);
+
+    ble_att_svr_test_assert_mbufs_freed();
+}
+
 TEST_SUITE(ble_att_svr_suite)
 {
     ble_att_svr_test_mtu();
@@ -2280,4 +2354,5 @@ TEST_SUITE(ble_att_svr_suite)
     ble_att_svr_test_oom();
     ble_att_svr_test_unsupported_req();
     ble_att_svr_test_large_value();
+    ble_att_svr_test_hidden_range();
 }
@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "testutil/testutil.h"
+#include "ble_hs_test.h"
+#include "ble_hs_test_util.h"
+
+#if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 1
+
+#define BLE_EATT_TEST_CONN_HANDLE   2
+
+/* Peer CIDs of the two EATT bearers. */
+#define BLE_EATT_TEST_PEER_CID_A    0x0040
+#define BLE_EATT_TEST_PEER_CID_B    0x0041
+
+static uint8_t ble_eatt_test_peer_addr[6] = { 1, 2, 3, 4, 5, 6 };
+
+/**
+ * Makes the peer open an EATT bearer with the given parameters.
+ *
+ * @return                      The local CID of the new bearer.
+ */
+static uint16_t
+ble_eatt_test_util_peer_connect(uint16_t peer_cid, uint16_t mps,
+                                uint16_t credits)
+{
+    struct ble_l2cap_sig_le_con_req req;
+    struct ble_l2cap_chan *chan;
+    struct ble_hs_conn *conn;
+    uint16_t cid;
+    int rc;
+
+    req.psm = htole16(BLE_EATT_PSM);
+    req.scid = htole16(peer_cid);
+    req.mtu = htole16(MYNEWT_VAL(BLE_EATT_MTU));
+    req.mps = htole16(mps);
+    req.credits = htole16(credits);
+
+    rc = ble_hs_test_util_inject_rx_l2cap_sig(
+        BLE_EATT_TEST_CONN_HANDLE, BLE_L2CAP_SIG_OP_LE_CREDIT_CONNECT_REQ,
+        1, &req, sizeof req);
+    TEST_ASSERT_FATAL(rc == 0);
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find_assert(BLE_EATT_TEST_CONN_HANDLE);
+    chan = ble_hs_conn_chan_find_by_dcid(conn, peer_cid);
+    TEST_ASSERT_FATAL(chan != NULL);
+    TEST_ASSERT_FATAL(chan->psm == BLE_EATT_PSM);
+    cid = chan->scid;
+    ble_hs_unlock();
+
+    return cid;
+}
+
+/**
+ * Sets up a connection with two EATT bearers.  Each bearer gets a single
+ * credit, so its weight is the peer MPS given here.
+ */
+static void
+ble_eatt_test_util_init(uint16_t mps_a, uint16_t mps_b,
+                        uint16_t *out_cid_a, uint16_t *out_cid_b)
+{
+    ble_hs_test_util_init();
+
+    ble_hs_test_util_create_conn(BLE_EATT_TEST_CONN_HANDLE,
+                                 ble_eatt_test_peer_addr, NULL, NULL);
+
+    *out_cid_a = ble_eatt_test_util_peer_connect(BLE_EATT_TEST_PEER_CID_A,
+                                                 mps_a, 1);
+    *out_cid_b = ble_eatt_test_util_peer_connect(BLE_EATT_TEST_PEER_CID_B,
+                                                 mps_b, 1);
+    TEST_ASSERT_FATAL(*out_cid_a != *out_cid_b);
+}
+
+static void
+ble_eatt_test_util_set_credits(uint16_t peer_cid, uint16_t credits)
+{
+    struct ble_l2cap_chan *chan;
+    struct ble_hs_conn *conn;
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find_assert(BLE_EATT_TEST_CONN_HANDLE);
+    chan = ble_hs_conn_chan_find_by_dcid(conn, peer_cid);
+    TEST_ASSERT_FATAL(chan != NULL);
+    chan->coc_tx.credits = credits;
+    ble_hs_unlock();
+}
+
+static uint8_t
+ble_eatt_test_util_client_procs(void)
+{
+    struct ble_hs_conn *conn;
+    uint8_t procs;
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find_assert(BLE_EATT_TEST_CONN_HANDLE);
+    procs = conn->client_att_procs;
+    ble_hs_unlock();
+
+    return procs;
+}
+
+TEST_CASE_SELF(ble_eatt_test_case_weight)
+{
+    uint16_t cid_a;
+    uint16_t cid_b;
+    uint16_t cid;
+    int num_att;
+    int num_a;
+    int num_b;
+    int i;
+
+    /* Bearer A lets twice as much data out as bearer B and the fixed channel,
+     * which both weigh 23 octets.
+     */
+    ble_eatt_test_util_init(2 * BLE_ATT_MTU_DFLT, BLE_ATT_MTU_DFLT,
+                            &cid_a, &cid_b);
+
+    /* Operations without a response are spread over all bearers in
+     * proportion to their weights: 46 for A, 23 for B and the fixed channel.
+     */
+    num_att = 0;
+    num_a = 0;
+    num_b = 0;
+    for (i = 0; i < 40; i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_DUMMY);
+        if (cid == cid_a) {
+            num_a++;
+        } else if (cid == cid_b) {
+            num_b++;
+        } else {
+            TEST_ASSERT(cid == BLE_L2CAP_CID_ATT);
+            num_att++;
+        }
+    }
+    TEST_ASSERT(num_a == 20);
+    TEST_ASSERT(num_b == 10);
+    TEST_ASSERT(num_att == 10);
+
+    /* A bearer the peer gave no credits to is not picked. */
+    ble_eatt_test_util_set_credits(BLE_EATT_TEST_PEER_CID_A, 0);
+    num_att = 0;
+    num_b = 0;
+    for (i = 0; i < 40; i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_DUMMY);
+        TEST_ASSERT(cid != cid_a);
+        if (cid == cid_b) {
+            num_b++;
+        } else {
+            num_att++;
+        }
+    }
+    TEST_ASSERT(num_b == 20);
+    TEST_ASSERT(num_att == 20);
+
+    /* Without any usable EATT bearer everything goes to the fixed channel. */
+    ble_eatt_test_util_set_credits(BLE_EATT_TEST_PEER_CID_B, 0);
+    for (i = 0; i < 4; i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_DUMMY);
+        TEST_ASSERT(cid == BLE_L2CAP_CID_ATT);
+    }
+
+    /* Unknown connection falls back to the fixed channel. */
+    cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE + 1,
+                                          BLE_GATT_OP_DUMMY);
+    TEST_ASSERT(cid == BLE_L2CAP_CID_ATT);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_eatt_test_case_release)
+{
+    uint16_t first;
+    uint16_t second;
+    uint16_t cid_a;
+    uint16_t cid_b;
+    uint16_t cid;
+    int num_a;
+    int num_b;
+    int i;
+
+    /* Both bearers outweigh the fixed channel. */
+    ble_eatt_test_util_init(MYNEWT_VAL(BLE_EATT_MTU), MYNEWT_VAL(BLE_EATT_MTU),
+                            &cid_a, &cid_b);
+
+    /* Each procedure holds its EATT bearer until released. */
+    first = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                            BLE_GATT_OP_SERVER);
+    second = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                             BLE_GATT_OP_SERVER);
+    TEST_ASSERT(first == cid_a || first == cid_b);
+    TEST_ASSERT(second == cid_a || second == cid_b);
+    TEST_ASSERT(first != second);
+
+    /* Both bearers busy; further procedures share the fixed channel. */
+    cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                          BLE_GATT_OP_SERVER);
+    TEST_ASSERT(cid == BLE_L2CAP_CID_ATT);
+    cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                          BLE_GATT_OP_SERVER);
+    TEST_ASSERT(cid == BLE_L2CAP_CID_ATT);
+    TEST_ASSERT(ble_eatt_test_util_client_procs() == 2);
+
+    /* A busy bearer still carries operations without a response. */
+    ble_eatt_test_util_set_credits(BLE_EATT_TEST_PEER_CID_B, 0);
+    for (i = 0; i < 4; i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_DUMMY);
+        TEST_ASSERT(cid != cid_b);
+        if (cid == cid_a) {
+            break;
+        }
+    }
+    TEST_ASSERT(i < 4);
+    ble_eatt_test_util_set_credits(BLE_EATT_TEST_PEER_CID_B, 1);
+
+    /* Released bearer is picked again; the fixed channel may get its turn
+     * first while the bearer pays back the weight it was picked with.
+     */
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, cid_b);
+    for (i = 0; i < 4; i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_SERVER);
+        if (cid != BLE_L2CAP_CID_ATT) {
+            break;
+        }
+    }
+    TEST_ASSERT(cid == cid_b);
+    TEST_ASSERT(ble_eatt_test_util_client_procs() == 2 + i);
+
+    /* Releasing the fixed channel drops its procedure count. */
+    for (; i >= 0; i--) {
+        ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT);
+    }
+    TEST_ASSERT(ble_eatt_test_util_client_procs() == 1);
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT);
+    TEST_ASSERT(ble_eatt_test_util_client_procs() == 0);
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT);
+    TEST_ASSERT(ble_eatt_test_util_client_procs() == 0);
+
+    /* Releasing an unknown bearer is harmless. */
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, 0x7fff);
+
+    /* With every procedure done, both bearers are free again. */
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, cid_a);
+    ble_eatt_release_chan(BLE_EATT_TEST_CONN_HANDLE, cid_b);
+    num_a = 0;
+    num_b = 0;
+    for (i = 0; i < 8 && (num_a == 0 || num_b == 0); i++) {
+        cid = ble_eatt_get_available_chan_cid(BLE_EATT_TEST_CONN_HANDLE,
+                                              BLE_GATT_OP_SERVER);
+        if (cid == cid_a) {
+            num_a++;
+        } else if (cid == cid_b) {
+            num_b++;
+        }
+    }
+    TEST_ASSERT(num_a == 1);
+    TEST_ASSERT(num_b == 1);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+#endif
+
+TEST_SUITE(ble_eatt_test_suite)
+{
+#if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 1
+    ble_eatt_test_case_weight();
+    ble_eatt_test_case_release();
+#endif
+}
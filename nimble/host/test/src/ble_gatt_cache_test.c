@@ -0,0 +1,707 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "testutil/testutil.h"
+#include "nimble/ble.h"
+#include "host/ble_gatt.h"
+#include "host/ble_uuid.h"
+#include "host/ble_store.h"
+#include "ble_hs_test.h"
+#include "ble_hs_test_util.h"
+
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+
+#define BLE_GATT_CACHE_TEST_CONN_HANDLE     2
+#define BLE_GATT_CACHE_TEST_MAX_RESULTS     8
+
+/*
+ * Peer database used by the tests:
+ *     0x0001-0x0005  service 0x1800
+ *         0x0002/0x0003  characteristic 0x2a00
+ *         0x0004/0x0005  characteristic 0x2a01
+ *     0x0006-0x0009  service 0x1801
+ *         0x0007/0x0008  characteristic 0x2a05 (Service Changed)
+ *         0x0009         descriptor 0x2902
+ */
+
+static uint8_t ble_gatt_cache_test_peer_addr[6] = { 1, 2, 3, 4, 5, 6 };
+static uint8_t ble_gatt_cache_test_peer2_addr[6] = { 2, 3, 4, 5, 6, 7 };
+
+static const uint8_t ble_gatt_cache_test_hash1[16] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+
+static const uint8_t ble_gatt_cache_test_hash2[16] = {
+    0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff, 0x00,
+};
+
+static uint16_t ble_gatt_cache_test_handles[BLE_GATT_CACHE_TEST_MAX_RESULTS];
+static int ble_gatt_cache_test_num_results;
+static int ble_gatt_cache_test_status;
+
+static void
+ble_gatt_cache_test_init(void)
+{
+    ble_hs_test_util_init();
+}
+
+static void
+ble_gatt_cache_test_reset_results(void)
+{
+    ble_gatt_cache_test_num_results = 0;
+    ble_gatt_cache_test_status = -1;
+}
+
+static void
+ble_gatt_cache_test_add_result(int status, uint16_t handle)
+{
+    TEST_ASSERT_FATAL(ble_gatt_cache_test_status == -1);
+
+    if (status != 0) {
+        ble_gatt_cache_test_status = status;
+        return;
+    }
+
+    TEST_ASSERT_FATAL(ble_gatt_cache_test_num_results <
+                      BLE_GATT_CACHE_TEST_MAX_RESULTS);
+    ble_gatt_cache_test_handles[ble_gatt_cache_test_num_results++] = handle;
+}
+
+static int
+ble_gatt_cache_test_svc_cb(uint16_t conn_handle,
+                           const struct ble_gatt_error *error,
+                           const struct ble_gatt_svc *service, void *arg)
+{
+    ble_gatt_cache_test_add_result(error->status,
+                                   service ? service->start_handle : 0);
+    return 0;
+}
+
+static int
+ble_gatt_cache_test_chr_cb(uint16_t conn_handle,
+                           const struct ble_gatt_error *error,
+                           const struct ble_gatt_chr *chr, void *arg)
+{
+    ble_gatt_cache_test_add_result(error->status, chr ? chr->val_handle : 0);
+    return 0;
+}
+
+static int
+ble_gatt_cache_test_dsc_cb(uint16_t conn_handle,
+                           const struct ble_gatt_error *error,
+                           uint16_t chr_val_handle,
+                           const struct ble_gatt_dsc *dsc, void *arg)
+{
+    ble_gatt_cache_test_add_result(error->status, dsc ? dsc->handle : 0);
+    return 0;
+}
+
+static void
+ble_gatt_cache_test_verify_results(const uint16_t *handles, int num_handles)
+{
+    int i;
+
+    TEST_ASSERT(ble_gatt_cache_test_status == BLE_HS_EDONE);
+    TEST_ASSERT_FATAL(ble_gatt_cache_test_num_results == num_handles);
+    for (i = 0; i < num_handles; i++) {
+        TEST_ASSERT(ble_gatt_cache_test_handles[i] == handles[i]);
+    }
+}
+
+static void
+ble_gatt_cache_test_connect(const uint8_t *peer_addr)
+{
+    ble_hs_test_util_create_conn(BLE_GATT_CACHE_TEST_CONN_HANDLE, peer_addr,
+                                 NULL, NULL);
+    ble_gattc_cache_set_state(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                              BLE_GATTC_CACHE_UNKNOWN);
+}
+
+/**
+ * Dequeues the request the client sent last and verifies its opcode.
+ */
+static struct os_mbuf *
+ble_gatt_cache_test_verify_tx(uint8_t op)
+{
+    struct os_mbuf *om;
+
+    om = ble_hs_test_util_prev_tx_dequeue_pullup();
+    TEST_ASSERT_FATAL(om != NULL);
+    TEST_ASSERT_FATAL(om->om_data[0] == op);
+
+    return om;
+}
+
+static void
+ble_gatt_cache_test_verify_no_tx(void)
+{
+    TEST_ASSERT(ble_hs_test_util_prev_tx_queue_sz() == 0);
+}
+
+/**
+ * Verifies that the client reads the Database Hash and answers the request.
+ */
+static void
+ble_gatt_cache_test_rx_hash(const uint8_t *hash)
+{
+    struct os_mbuf *om;
+    uint8_t buf[2 + 2 + 16];
+    int rc;
+
+    om = ble_gatt_cache_test_verify_tx(BLE_ATT_OP_READ_TYPE_REQ);
+    TEST_ASSERT(get_le16(om->om_data + 5) == BLE_GATT_CHR_DB_HASH_UUID16);
+
+    buf[0] = BLE_ATT_OP_READ_TYPE_RSP;
+    buf[1] = 2 + 16;
+    put_le16(buf + 2, 0x000a);
+    memcpy(buf + 4, hash, 16);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(
+        BLE_GATT_CACHE_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT, buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+}
+
+/**
+ * Answers the pending request with Attribute Not Found, if the client sent
+ * one.
+ */
+static void
+ble_gatt_cache_test_rx_not_found(uint8_t op)
+{
+    struct os_mbuf *om;
+
+    if (ble_hs_test_util_prev_tx_queue_sz() == 0) {
+        return;
+    }
+
+    om = ble_gatt_cache_test_verify_tx(op);
+    ble_hs_test_util_rx_att_err_rsp(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                    BLE_L2CAP_CID_ATT, op,
+                                    BLE_ATT_ERR_ATTR_NOT_FOUND,
+                                    get_le16(om->om_data + 1));
+}
+
+static void
+ble_gatt_cache_test_rx_svcs(void)
+{
+    uint8_t buf[2 + 2 * 6];
+    int rc;
+
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_READ_GROUP_TYPE_REQ);
+
+    buf[0] = BLE_ATT_OP_READ_GROUP_TYPE_RSP;
+    buf[1] = 6;
+    put_le16(buf + 2, 0x0001);
+    put_le16(buf + 4, 0x0005);
+    put_le16(buf + 6, 0x1800);
+    put_le16(buf + 8, 0x0006);
+    put_le16(buf + 10, 0x0009);
+    put_le16(buf + 12, 0x1801);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(
+        BLE_GATT_CACHE_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT, buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+
+    ble_gatt_cache_test_rx_not_found(BLE_ATT_OP_READ_GROUP_TYPE_REQ);
+}
+
+static void
+ble_gatt_cache_test_rx_chrs_svc1(void)
+{
+    uint8_t buf[2 + 2 * 7];
+    int rc;
+
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_READ_TYPE_REQ);
+
+    buf[0] = BLE_ATT_OP_READ_TYPE_RSP;
+    buf[1] = 7;
+    put_le16(buf + 2, 0x0002);
+    buf[4] = BLE_GATT_CHR_PROP_READ;
+    put_le16(buf + 5, 0x0003);
+    put_le16(buf + 7, 0x2a00);
+    put_le16(buf + 9, 0x0004);
+    buf[11] = BLE_GATT_CHR_PROP_READ;
+    put_le16(buf + 12, 0x0005);
+    put_le16(buf + 14, 0x2a01);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(
+        BLE_GATT_CACHE_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT, buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+
+    ble_gatt_cache_test_rx_not_found(BLE_ATT_OP_READ_TYPE_REQ);
+}
+
+static void
+ble_gatt_cache_test_rx_chrs_svc2(void)
+{
+    uint8_t buf[2 + 7];
+    int rc;
+
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_READ_TYPE_REQ);
+
+    buf[0] = BLE_ATT_OP_READ_TYPE_RSP;
+    buf[1] = 7;
+    put_le16(buf + 2, 0x0007);
+    buf[4] = BLE_GATT_CHR_PROP_INDICATE;
+    put_le16(buf + 5, 0x0008);
+    put_le16(buf + 7, 0x2a05);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(
+        BLE_GATT_CACHE_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT, buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+
+    ble_gatt_cache_test_rx_not_found(BLE_ATT_OP_READ_TYPE_REQ);
+}
+
+static void
+ble_gatt_cache_test_rx_dscs(void)
+{
+    uint8_t buf[2 + 4];
+    int rc;
+
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_FIND_INFO_REQ);
+
+    buf[0] = BLE_ATT_OP_FIND_INFO_RSP;
+    buf[1] = BLE_ATT_FIND_INFO_RSP_FORMAT_16BIT;
+    put_le16(buf + 2, 0x0009);
+    put_le16(buf + 4, 0x2902);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(
+        BLE_GATT_CACHE_TEST_CONN_HANDLE, BLE_L2CAP_CID_ATT, buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+
+    ble_gatt_cache_test_rx_not_found(BLE_ATT_OP_FIND_INFO_REQ);
+}
+
+static int
+ble_gatt_cache_test_read_entry(const uint8_t *peer_addr, uint8_t type,
+                               uint16_t handle,
+                               struct ble_store_value_gatt_cache *out_value)
+{
+    struct ble_store_key_gatt_cache key;
+
+    memset(&key, 0, sizeof key);
+    key.peer_addr.type = BLE_ADDR_PUBLIC;
+    memcpy(key.peer_addr.val, peer_addr, 6);
+    key.type = type;
+    key.start_handle = handle;
+    key.end_handle = handle;
+
+    return ble_store_read_gatt_cache(&key, out_value);
+}
+
+static void
+ble_gatt_cache_test_disc_svcs(void)
+{
+    int rc;
+
+    ble_gatt_cache_test_reset_results();
+    rc = ble_gattc_disc_all_svcs(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                 ble_gatt_cache_test_svc_cb, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+static void
+ble_gatt_cache_test_disc_chrs(uint16_t start_handle, uint16_t end_handle)
+{
+    int rc;
+
+    ble_gatt_cache_test_reset_results();
+    rc = ble_gattc_disc_all_chrs(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                 start_handle, end_handle,
+                                 ble_gatt_cache_test_chr_cb, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+static void
+ble_gatt_cache_test_disc_dscs(uint16_t chr_val_handle, uint16_t end_handle)
+{
+    int rc;
+
+    ble_gatt_cache_test_reset_results();
+    rc = ble_gattc_disc_all_dscs(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                 chr_val_handle, end_handle,
+                                 ble_gatt_cache_test_dsc_cb, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+/**
+ * Discovers the whole peer database over the air on a new connection whose
+ * cache does not hold the specified hash yet.
+ */
+static void
+ble_gatt_cache_test_populate(const uint8_t *hash)
+{
+    static const uint16_t svcs[] = { 0x0001, 0x0006 };
+    static const uint16_t chrs1[] = { 0x0003, 0x0005 };
+    static const uint16_t chrs2[] = { 0x0008 };
+    static const uint16_t dscs[] = { 0x0009 };
+
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_hash(hash);
+    ble_gatt_cache_test_rx_svcs();
+    ble_gatt_cache_test_verify_results(svcs, 2);
+
+    ble_gatt_cache_test_disc_chrs(0x0001, 0x0005);
+    ble_gatt_cache_test_rx_chrs_svc1();
+    ble_gatt_cache_test_verify_results(chrs1, 2);
+
+    ble_gatt_cache_test_disc_chrs(0x0006, 0x0009);
+    ble_gatt_cache_test_rx_chrs_svc2();
+    ble_gatt_cache_test_verify_results(chrs2, 1);
+
+    ble_gatt_cache_test_disc_dscs(0x0008, 0x0009);
+    ble_gatt_cache_test_rx_dscs();
+    ble_gatt_cache_test_verify_results(dscs, 1);
+
+    ble_gatt_cache_test_verify_no_tx();
+}
+
+/**
+ * Verifies that the whole peer database is served from the cache.
+ */
+static void
+ble_gatt_cache_test_verify_cached(void)
+{
+    static const uint16_t svcs[] = { 0x0001, 0x0006 };
+    static const uint16_t chrs1[] = { 0x0003, 0x0005 };
+    static const uint16_t chrs2[] = { 0x0008 };
+    static const uint16_t dscs[] = { 0x0009 };
+
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results(svcs, 2);
+
+    ble_gatt_cache_test_disc_chrs(0x0001, 0x0005);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results(chrs1, 2);
+
+    ble_gatt_cache_test_disc_chrs(0x0006, 0x0009);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results(chrs2, 1);
+
+    ble_gatt_cache_test_disc_dscs(0x0008, 0x0009);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results(dscs, 1);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_hash_match)
+{
+    ble_gatt_cache_test_init();
+
+    /*** First connection; nothing cached, discover over the air. */
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash1);
+
+    /*** Same connection; everything is answered from the cache. */
+    ble_gatt_cache_test_verify_cached();
+
+    /*** A partial range of a cached service is answered too. */
+    ble_gatt_cache_test_disc_chrs(0x0004, 0x0005);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0005 }, 1);
+
+    /*** Entries persist; next connection only reads the hash. */
+    ble_hs_test_util_conn_disconnect(BLE_GATT_CACHE_TEST_CONN_HANDLE);
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_hash(ble_gatt_cache_test_hash1);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    ble_gatt_cache_test_verify_cached();
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_hash_mismatch)
+{
+    struct ble_store_value_gatt_cache value;
+    int rc;
+
+    ble_gatt_cache_test_init();
+
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash1);
+    ble_hs_test_util_conn_disconnect(BLE_GATT_CACHE_TEST_CONN_HANDLE);
+
+    /*** The peer's database changed; stale entries are dropped. */
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_hash(ble_gatt_cache_test_hash2);
+
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_SVC, 0x0001,
+                                        &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_HASH, 0,
+                                        &value);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(value.db_hash, ble_gatt_cache_test_hash2, 16) == 0);
+    TEST_ASSERT(!(value.flags & BLE_STORE_GATT_CACHE_F_COMPLETE));
+
+    /*** Discovery goes over the air and rebuilds the cache. */
+    ble_gatt_cache_test_rx_svcs();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_no_hash)
+{
+    struct os_mbuf *om;
+
+    ble_gatt_cache_test_init();
+
+    /*** Peer without a Database Hash; caching is off for the connection. */
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_disc_svcs();
+
+    om = ble_gatt_cache_test_verify_tx(BLE_ATT_OP_READ_TYPE_REQ);
+    ble_hs_test_util_rx_att_err_rsp(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                    BLE_L2CAP_CID_ATT,
+                                    BLE_ATT_OP_READ_TYPE_REQ,
+                                    BLE_ATT_ERR_ATTR_NOT_FOUND,
+                                    get_le16(om->om_data + 1));
+    TEST_ASSERT(ble_gattc_cache_state(BLE_GATT_CACHE_TEST_CONN_HANDLE) ==
+                BLE_GATTC_CACHE_OFF);
+
+    ble_gatt_cache_test_rx_svcs();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    /* Nothing was recorded, so discovery keeps going over the air. */
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_svcs();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_svc_changed)
+{
+    struct ble_store_value_gatt_cache value;
+    uint8_t range[4];
+    int rc;
+
+    ble_gatt_cache_test_init();
+
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash1);
+
+    /*** Service Changed indication drops the peer's entries. */
+    put_le16(range + 0, 0x0001);
+    put_le16(range + 2, 0xffff);
+    rc = ble_hs_test_util_rx_att_indicate_req(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                              0x0008, range, sizeof range);
+    TEST_ASSERT(rc == 0);
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_INDICATE_RSP);
+
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_HASH, 0,
+                                        &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_CHR, 0x0007,
+                                        &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+
+    /*** Next discovery revalidates and goes over the air. */
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash2);
+    ble_gatt_cache_test_verify_cached();
+
+    /*** Indications of other characteristics leave the cache alone. */
+    rc = ble_hs_test_util_rx_att_indicate_req(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                              0x0003, range, sizeof range);
+    TEST_ASSERT(rc == 0);
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_INDICATE_RSP);
+    ble_gatt_cache_test_verify_cached();
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_svc_changed_uncached)
+{
+    uint8_t range[4];
+    int rc;
+
+    ble_gatt_cache_test_init();
+
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash1);
+
+    put_le16(range + 0, 0x0001);
+    put_le16(range + 2, 0xffff);
+
+    /*** Indication of a handle the cache does not know; recheck the hash. */
+    rc = ble_hs_test_util_rx_att_indicate_req(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                              0x0020, range, sizeof range);
+    TEST_ASSERT(rc == 0);
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_INDICATE_RSP);
+
+    /*** Unchanged hash; entries are kept and served again. */
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_hash(ble_gatt_cache_test_hash1);
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+    ble_gatt_cache_test_verify_cached();
+
+    /*** Changed hash; the database is discovered over the air. */
+    rc = ble_hs_test_util_rx_att_indicate_req(BLE_GATT_CACHE_TEST_CONN_HANDLE,
+                                              0x0020, range, sizeof range);
+    TEST_ASSERT(rc == 0);
+    ble_gatt_cache_test_verify_tx(BLE_ATT_OP_INDICATE_RSP);
+
+    ble_gatt_cache_test_populate(ble_gatt_cache_test_hash2);
+    ble_gatt_cache_test_verify_cached();
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_evict)
+{
+    struct ble_store_value_gatt_cache value;
+    int rc;
+    int i;
+
+    ble_gatt_cache_test_init();
+    ble_hs_cfg.store_status_cb = ble_store_util_status_rr;
+
+    /*** Another peer's cache fills all but one store slot. */
+    memset(&value, 0, sizeof value);
+    value.peer_addr.type = BLE_ADDR_PUBLIC;
+    memcpy(value.peer_addr.val, ble_gatt_cache_test_peer2_addr, 6);
+    value.type = BLE_STORE_GATT_CACHE_TYPE_HASH;
+    value.flags = BLE_STORE_GATT_CACHE_F_COMPLETE;
+    memcpy(value.db_hash, ble_gatt_cache_test_hash1, 16);
+    rc = ble_store_write_gatt_cache(&value);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (i = 0; i < MYNEWT_VAL(BLE_STORE_MAX_GATT_CACHE) - 2; i++) {
+        memset(&value.uuid, 0, sizeof value.uuid);
+        value.type = BLE_STORE_GATT_CACHE_TYPE_SVC;
+        value.handle = 0x10 * (i + 1);
+        value.end_handle = value.handle + 0x0f;
+        value.uuid.u16.u.type = BLE_UUID_TYPE_16;
+        value.uuid.u16.value = 0x180a;
+        rc = ble_store_write_gatt_cache(&value);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    /*** Recording this peer's services evicts the other peer's cache. */
+    ble_gatt_cache_test_connect(ble_gatt_cache_test_peer_addr);
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_rx_hash(ble_gatt_cache_test_hash1);
+    ble_gatt_cache_test_rx_svcs();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer2_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_HASH, 0,
+                                        &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+    rc = ble_gatt_cache_test_read_entry(ble_gatt_cache_test_peer2_addr,
+                                        BLE_STORE_GATT_CACHE_TYPE_SVC, 0x0010,
+                                        &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+
+    ble_gatt_cache_test_disc_svcs();
+    ble_gatt_cache_test_verify_no_tx();
+    ble_gatt_cache_test_verify_results((uint16_t[]){ 0x0001, 0x0006 }, 2);
+
+    ble_hs_cfg.store_status_cb = NULL;
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatt_cache_test_case_store_order)
+{
+    struct ble_store_value_gatt_cache value;
+    struct ble_store_key_gatt_cache key;
+    static const uint16_t handles[] = { 0x0020, 0x0030, 0x0040, 0x0050 };
+    int rc;
+    int i;
+
+    ble_gatt_cache_test_init();
+
+    /*** Entries written out of order are retrieved in handle order. */
+    memset(&value, 0, sizeof value);
+    value.peer_addr.type = BLE_ADDR_PUBLIC;
+    memcpy(value.peer_addr.val, ble_gatt_cache_test_peer_addr, 6);
+    value.type = BLE_STORE_GATT_CACHE_TYPE_SVC;
+
+    for (i = 0; i < 4; i++) {
+        value.handle = handles[(i * 3) % 4];
+        rc = ble_store_write_gatt_cache(&value);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    memset(&key, 0, sizeof key);
+    key.peer_addr = value.peer_addr;
+    key.type = BLE_STORE_GATT_CACHE_TYPE_SVC;
+
+    for (i = 0; i < 4; i++) {
+        key.idx = i;
+        rc = ble_store_read_gatt_cache(&key, &value);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(value.handle == handles[i]);
+    }
+
+    key.idx = 4;
+    rc = ble_store_read_gatt_cache(&key, &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+
+    /*** Handle range lookups start at the first entry in range. */
+    key.idx = 0;
+    key.start_handle = 0x0031;
+    key.end_handle = 0x0050;
+    rc = ble_store_read_gatt_cache(&key, &value);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(value.handle == 0x0040);
+
+    key.idx = 2;
+    rc = ble_store_read_gatt_cache(&key, &value);
+    TEST_ASSERT(rc == BLE_HS_ENOENT);
+}
+
+TEST_SUITE(ble_gatt_cache_test_suite)
+{
+    ble_gatt_cache_test_case_hash_match();
+    ble_gatt_cache_test_case_hash_mismatch();
+    ble_gatt_cache_test_case_no_hash();
+    ble_gatt_cache_test_case_svc_changed();
+    ble_gatt_cache_test_case_svc_changed_uncached();
+    ble_gatt_cache_test_case_evict();
+    ble_gatt_cache_test_case_store_order();
+}
+
+#else
+
+TEST_SUITE(ble_gatt_cache_test_suite)
+{
+}
+
+#endif
@@ -775,8 +775,74 @@ TEST_CASE_SELF(ble_gatt_conn_test_timeout)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+TEST_CASE_SELF(ble_gatt_conn_test_timeout_staggered)
+{
+    static const uint8_t peer_addr[6] = { 1, 2, 3, 4, 5, 6 };
+
+    struct ble_gatt_conn_test_arg read1_arg = { 1, BLE_HS_ETIMEOUT };
+    struct ble_gatt_conn_test_arg read2_arg = { 2, BLE_HS_ETIMEOUT };
+    struct ble_gatt_conn_test_arg read3_arg = { 3, BLE_HS_ETIMEOUT };
+    int32_t ticks_from_now;
+    int rc;
+
+    ble_gatt_conn_test_util_init();
+
+    ble_hs_test_util_create_conn(1, peer_addr, NULL, NULL);
+    ble_hs_test_util_create_conn(2, ((uint8_t[]){2,3,4,5,6,7}), NULL, NULL);
+    ble_hs_test_util_create_conn(3, ((uint8_t[]){3,4,5,6,7,8}), NULL, NULL);
+
+    /*** Start a read on each connection, ten seconds apart. */
+    rc = ble_gattc_read(3, BLE_GATT_BREAK_TEST_READ_ATTR_HANDLE,
+                        ble_gatt_conn_test_read_cb, &read3_arg);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    os_time_advance(10 * OS_TICKS_PER_SEC);
+    rc = ble_gattc_read(1, BLE_GATT_BREAK_TEST_READ_ATTR_HANDLE,
+                        ble_gatt_conn_test_read_cb, &read1_arg);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    os_time_advance(10 * OS_TICKS_PER_SEC);
+    rc = ble_gattc_read(2, BLE_GATT_BREAK_TEST_READ_ATTR_HANDLE,
+                        ble_gatt_conn_test_read_cb, &read2_arg);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ticks_from_now = ble_gattc_timer();
+    TEST_ASSERT(ticks_from_now == 10 * OS_TICKS_PER_SEC);
+
+    /*** Procedures expire in the order they were started. */
+    ble_hs_test_util_hci_ack_set_disconnect(0);
+    os_time_advance(10 * OS_TICKS_PER_SEC);
+    ticks_from_now = ble_gattc_timer();
+    TEST_ASSERT(ticks_from_now == 10 * OS_TICKS_PER_SEC);
+    TEST_ASSERT(read3_arg.called == 1);
+    TEST_ASSERT(read1_arg.called == 0);
+    TEST_ASSERT(read2_arg.called == 0);
+    ble_hs_test_util_hci_rx_disconn_complete_event(3, 0,
+                                                   BLE_ERR_REM_USER_CONN_TERM);
+
+    ble_hs_test_util_hci_ack_set_disconnect(0);
+    os_time_advance(10 * OS_TICKS_PER_SEC);
+    ticks_from_now = ble_gattc_timer();
+    TEST_ASSERT(ticks_from_now == 10 * OS_TICKS_PER_SEC);
+    TEST_ASSERT(read1_arg.called == 1);
+    TEST_ASSERT(read2_arg.called == 0);
+    ble_hs_test_util_hci_rx_disconn_complete_event(1, 0,
+                                                   BLE_ERR_REM_USER_CONN_TERM);
+
+    ble_hs_test_util_hci_ack_set_disconnect(0);
+    os_time_advance(10 * OS_TICKS_PER_SEC);
+    ticks_from_now = ble_gattc_timer();
+    TEST_ASSERT(ticks_from_now == BLE_HS_FOREVER);
+    TEST_ASSERT(read2_arg.called == 1);
+    ble_hs_test_util_hci_rx_disconn_complete_event(2, 0,
+                                                   BLE_ERR_REM_USER_CONN_TERM);
+
+    TEST_ASSERT(!ble_gattc_any_jobs());
+}
+
 TEST_SUITE(ble_gatt_conn_suite)
 {
     ble_gatt_conn_test_disconnect();
     ble_gatt_conn_test_timeout();
+    ble_gatt_conn_test_timeout_staggered();
 }
@@ -470,6 +470,41 @@ ble_gatts_notify_test_misc_verify_tx_i(uint16_t conn_handle,
     ble_gatts_notify_test_util_verify_tx_event(conn_handle, attr_handle, 0, 1);
 }
 
+static void
+ble_gatts_notify_test_misc_verify_tx_mult(uint16_t conn_handle)
+{
+    struct os_mbuf *om;
+    int off;
+
+    om = ble_hs_test_util_prev_tx_dequeue_pullup();
+    TEST_ASSERT_FATAL(om != NULL);
+    TEST_ASSERT_FATAL(om->om_len == 1 + 2 * 4 +
+                                    ble_gatts_notify_test_chr_1_len +
+                                    ble_gatts_notify_test_chr_2_len);
+    TEST_ASSERT(om->om_data[0] == BLE_ATT_OP_NOTIFY_MULTI_REQ);
+
+    off = 1;
+    TEST_ASSERT(get_le16(om->om_data + off) ==
+                ble_gatts_notify_test_chr_1_def_handle + 1);
+    TEST_ASSERT(get_le16(om->om_data + off + 2) ==
+                ble_gatts_notify_test_chr_1_len);
+    TEST_ASSERT(memcmp(om->om_data + off + 4, ble_gatts_notify_test_chr_1_val,
+                       ble_gatts_notify_test_chr_1_len) == 0);
+
+    off += 4 + ble_gatts_notify_test_chr_1_len;
+    TEST_ASSERT(get_le16(om->om_data + off) ==
+                ble_gatts_notify_test_chr_2_def_handle + 1);
+    TEST_ASSERT(get_le16(om->om_data + off + 2) ==
+                ble_gatts_notify_test_chr_2_len);
+    TEST_ASSERT(memcmp(om->om_data + off + 4, ble_gatts_notify_test_chr_2_val,
+                       ble_gatts_notify_test_chr_2_len) == 0);
+
+    ble_gatts_notify_test_util_verify_tx_event(
+        conn_handle, ble_gatts_notify_test_chr_1_def_handle + 1, 0, 0);
+    ble_gatts_notify_test_util_verify_tx_event(
+        conn_handle, ble_gatts_notify_test_chr_2_def_handle + 1, 0, 0);
+}
+
 static void
 ble_gatts_notify_test_misc_verify_tx_gen(uint16_t conn_handle, int attr_idx,
                                          uint8_t chr_flags)
@@ -1071,6 +1106,142 @@ TEST_CASE_SELF(ble_gatts_notify_test_disallowed)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+TEST_CASE_SELF(ble_gatts_notify_test_subscribed_only)
+{
+    static const uint8_t peer2_addr[6] = {3,4,5,6,7,8};
+    uint16_t conn_handle;
+
+    /* Connection 2 subscribes to characteristic 1 only. */
+    ble_gatts_notify_test_misc_init(&conn_handle, 0,
+                                    BLE_GATTS_CLT_CFG_F_NOTIFY, 0);
+
+    /* Connection 3 subscribes to characteristic 2 only. */
+    ble_hs_test_util_create_conn(3, peer2_addr,
+                                 ble_gatts_notify_test_util_gap_event, NULL);
+    ble_gatts_notify_test_misc_enable_notify(
+        3, ble_gatts_notify_test_chr_2_def_handle,
+        BLE_GATTS_CLT_CFG_F_NOTIFY);
+    ble_gatts_notify_test_util_verify_sub_event(
+        3, ble_gatts_notify_test_chr_2_def_handle + 1,
+        BLE_GAP_SUBSCRIBE_REASON_WRITE, 0, 1, 0, 0);
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    /* Updating characteristic 1 only notifies connection 2. */
+    ble_gatts_notify_test_chr_1_len = 1;
+    ble_gatts_notify_test_chr_1_val[0] = 0x11;
+    ble_gatts_chr_updated(ble_gatts_notify_test_chr_1_def_handle + 1);
+
+    ble_gatts_notify_test_misc_verify_tx_n(
+        conn_handle,
+        ble_gatts_notify_test_chr_1_def_handle + 1,
+        ble_gatts_notify_test_chr_1_val,
+        ble_gatts_notify_test_chr_1_len);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /* Updating characteristic 2 only notifies connection 3. */
+    ble_gatts_notify_test_chr_2_len = 1;
+    ble_gatts_notify_test_chr_2_val[0] = 0x22;
+    ble_gatts_chr_updated(ble_gatts_notify_test_chr_2_def_handle + 1);
+
+    ble_gatts_notify_test_misc_verify_tx_n(
+        3,
+        ble_gatts_notify_test_chr_2_def_handle + 1,
+        ble_gatts_notify_test_chr_2_val,
+        ble_gatts_notify_test_chr_2_len);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /* Once connection 2 unsubscribes, nobody gets characteristic 1. */
+    ble_gatts_notify_test_misc_enable_notify(
+        conn_handle, ble_gatts_notify_test_chr_1_def_handle, 0);
+    ble_gatts_notify_test_util_verify_sub_event(
+        conn_handle, ble_gatts_notify_test_chr_1_def_handle + 1,
+        BLE_GAP_SUBSCRIBE_REASON_WRITE, 1, 0, 0, 0);
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    ble_gatts_chr_updated(ble_gatts_notify_test_chr_1_def_handle + 1);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+    TEST_ASSERT(ble_gatts_notify_test_num_events == 0);
+
+    /* Connection 3 stays subscribed after connection 2 goes away. */
+    ble_gatts_notify_test_disconnect(conn_handle, 0, 0, 0, 0);
+
+    ble_gatts_chr_updated(ble_gatts_notify_test_chr_2_def_handle + 1);
+    ble_gatts_notify_test_misc_verify_tx_n(
+        3,
+        ble_gatts_notify_test_chr_2_def_handle + 1,
+        ble_gatts_notify_test_chr_2_val,
+        ble_gatts_notify_test_chr_2_len);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_gatts_notify_test_mult)
+{
+    struct os_mbuf *om;
+    uint16_t handles[2];
+    uint16_t conn_handle;
+    uint8_t feat;
+    int rc;
+
+    ble_gatts_notify_test_misc_init(&conn_handle, 0,
+                                    BLE_GATTS_CLT_CFG_F_NOTIFY,
+                                    BLE_GATTS_CLT_CFG_F_NOTIFY);
+
+    handles[0] = ble_gatts_notify_test_chr_1_def_handle + 1;
+    handles[1] = ble_gatts_notify_test_chr_2_def_handle + 1;
+
+    ble_gatts_notify_test_chr_1_len = 4;
+    memset(ble_gatts_notify_test_chr_1_val, 0x11, 4);
+    ble_gatts_notify_test_chr_2_len = 4;
+    memset(ble_gatts_notify_test_chr_2_val, 0x22, 4);
+
+    /* Peer hasn't declared support; regular notifications get sent. */
+    rc = ble_gatts_notify_multiple(conn_handle, 2, handles);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_notify_test_misc_verify_tx_n(conn_handle, handles[0],
+                                           ble_gatts_notify_test_chr_1_val,
+                                           ble_gatts_notify_test_chr_1_len);
+    ble_gatts_notify_test_misc_verify_tx_n(conn_handle, handles[1],
+                                           ble_gatts_notify_test_chr_2_val,
+                                           ble_gatts_notify_test_chr_2_len);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /* Peer declares support for multiple handle value notifications. */
+    feat = BLE_GATT_CHR_CLI_SUP_FEAT_MULT_NTF;
+    om = ble_hs_mbuf_from_flat(&feat, sizeof feat);
+    TEST_ASSERT_FATAL(om != NULL);
+    rc = ble_gatts_peer_cl_sup_feat_update(conn_handle, om);
+    TEST_ASSERT_FATAL(rc == 0);
+    os_mbuf_free_chain(om);
+
+    /* Both values fit in the default MTU; one PDU gets sent. */
+    rc = ble_gatts_notify_multiple(conn_handle, 2, handles);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_notify_test_misc_verify_tx_mult(conn_handle);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /* Values don't fit together in the default MTU; the PDU gets split. */
+    ble_gatts_notify_test_chr_1_len = 10;
+    memset(ble_gatts_notify_test_chr_1_val, 0x33, 10);
+    ble_gatts_notify_test_chr_2_len = 10;
+    memset(ble_gatts_notify_test_chr_2_val, 0x44, 10);
+
+    rc = ble_gatts_notify_multiple(conn_handle, 2, handles);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_notify_test_misc_verify_tx_n(conn_handle, handles[0],
+                                           ble_gatts_notify_test_chr_1_val,
+                                           ble_gatts_notify_test_chr_1_len);
+    ble_gatts_notify_test_misc_verify_tx_n(conn_handle, handles[1],
+                                           ble_gatts_notify_test_chr_2_val,
+                                           ble_gatts_notify_test_chr_2_len);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
 TEST_SUITE(ble_gatts_notify_suite)
 {
     ble_gatts_notify_test_n();
@@ -1083,6 +1254,10 @@ TEST_SUITE(ble_gatts_notify_suite)
 
     ble_gatts_notify_test_disallowed();
 
+    ble_gatts_notify_test_subscribed_only();
+
+    ble_gatts_notify_test_mult();
+
     /* XXX: Test corner cases:
      *     o Bonding after CCCD configuration.
      *     o Disconnect prior to rx of indicate ack.
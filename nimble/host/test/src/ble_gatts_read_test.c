@@ -26,9 +26,12 @@
 
 #define BLE_GATTS_READ_TEST_CHR_1_UUID    0x1111
 #define BLE_GATTS_READ_TEST_CHR_2_UUID    0x2222
+#define BLE_GATTS_READ_TEST_CHR_3_UUID    0x3333
 
 static uint8_t ble_gatts_read_test_peer_addr[6] = {2,3,4,5,6,7};
 
+static uint8_t ble_gatts_read_test_chr_3_val[100];
+
 static int
 ble_gatts_read_test_util_access_1(uint16_t conn_handle,
                                   uint16_t attr_handle,
@@ -55,6 +58,11 @@ static const struct ble_gatt_svc_def ble_gatts_read_test_svcs[] = { {
         .uuid = BLE_UUID16_DECLARE(BLE_GATTS_READ_TEST_CHR_2_UUID),
         .access_cb = ble_gatts_read_test_util_access_2,
         .flags = BLE_GATT_CHR_F_READ
+    }, {
+        .uuid = BLE_UUID16_DECLARE(BLE_GATTS_READ_TEST_CHR_3_UUID),
+        .flags = BLE_GATT_CHR_F_READ,
+        .static_val = ble_gatts_read_test_chr_3_val,
+        .static_val_len = sizeof ble_gatts_read_test_chr_3_val,
     }, {
         0
     } },
@@ -68,6 +76,7 @@ static uint8_t ble_gatts_read_test_chr_1_val[1024];
 static int ble_gatts_read_test_chr_1_len;
 static uint16_t ble_gatts_read_test_chr_2_def_handle;
 static uint16_t ble_gatts_read_test_chr_2_val_handle;
+static uint16_t ble_gatts_read_test_chr_3_val_handle;
 
 static void
 ble_gatts_read_test_misc_init(uint16_t *out_conn_handle)
@@ -110,6 +119,10 @@ ble_gatts_read_test_misc_reg_cb(struct ble_gatt_register_ctxt *ctxt,
             ble_gatts_read_test_chr_2_val_handle = ctxt->chr.val_handle;
             break;
 
+        case BLE_GATTS_READ_TEST_CHR_3_UUID:
+            ble_gatts_read_test_chr_3_val_handle = ctxt->chr.val_handle;
+            break;
+
         default:
             TEST_ASSERT_FATAL(0);
             break;
@@ -250,8 +263,512 @@ TEST_CASE_SELF(ble_gatts_read_test_case_long)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+static int
+ble_gatts_read_test_blob_once(uint16_t conn_handle, uint16_t attr_handle,
+                              uint16_t offset)
+{
+    struct ble_att_read_blob_req read_blob_req;
+    uint8_t buf[BLE_ATT_READ_BLOB_REQ_SZ];
+
+    read_blob_req.babq_handle = attr_handle;
+    read_blob_req.babq_offset = offset;
+    ble_att_read_blob_req_write(buf, sizeof buf, &read_blob_req);
+
+    return ble_hs_test_util_l2cap_rx_payload_flat(conn_handle,
+                                                  BLE_L2CAP_CID_ATT,
+                                                  buf, sizeof buf);
+}
+
+/**
+ * Reads the whole static value with a sequence of read blob requests and
+ * verifies that every response is filled up to the MTU.
+ */
+static void
+ble_gatts_read_test_static_long(uint16_t conn_handle, uint16_t mtu)
+{
+    uint16_t offset;
+    uint16_t len;
+    int rc;
+
+    for (offset = 0; offset < sizeof ble_gatts_read_test_chr_3_val;
+         offset += len) {
+
+        len = sizeof ble_gatts_read_test_chr_3_val - offset;
+        if (len > mtu - 1) {
+            len = mtu - 1;
+        }
+
+        rc = ble_gatts_read_test_blob_once(
+            conn_handle, ble_gatts_read_test_chr_3_val_handle, offset);
+        TEST_ASSERT(rc == 0);
+        ble_hs_test_util_verify_tx_read_blob_rsp(
+            ble_gatts_read_test_chr_3_val + offset, len);
+    }
+}
+
+TEST_CASE_SELF(ble_gatts_read_test_case_static)
+{
+    uint16_t conn_handle;
+    int rc;
+    int i;
+
+    ble_gatts_read_test_misc_init(&conn_handle);
+    TEST_ASSERT_FATAL(ble_gatts_read_test_chr_3_val_handle != 0);
+
+    /* The characteristic has no access callback; every read below is served
+     * straight from the static buffer.  The value spans several MTUs.
+     */
+    for (i = 0; i < (int)sizeof ble_gatts_read_test_chr_3_val; i++) {
+        ble_gatts_read_test_chr_3_val[i] = 0x80 + i;
+    }
+
+    /*** Read; truncated to the default MTU. */
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_3_val_handle,
+                             ble_gatts_read_test_chr_3_val,
+                             BLE_ATT_MTU_DFLT - 1);
+
+    /*** Long read with the default MTU. */
+    ble_gatts_read_test_static_long(conn_handle, BLE_ATT_MTU_DFLT);
+
+    /*** Read blob at the end of the value yields an empty response. */
+    rc = ble_gatts_read_test_blob_once(conn_handle,
+                                       ble_gatts_read_test_chr_3_val_handle,
+                                       sizeof ble_gatts_read_test_chr_3_val);
+    TEST_ASSERT(rc == 0);
+    ble_hs_test_util_verify_tx_read_blob_rsp(ble_gatts_read_test_chr_3_val,
+                                             0);
+
+    /*** Read blob past the end of the value fails. */
+    rc = ble_gatts_read_test_blob_once(
+        conn_handle, ble_gatts_read_test_chr_3_val_handle,
+        sizeof ble_gatts_read_test_chr_3_val + 1);
+    TEST_ASSERT(rc != 0);
+    ble_hs_test_util_verify_tx_err_rsp(BLE_ATT_OP_READ_BLOB_REQ,
+                                       ble_gatts_read_test_chr_3_val_handle,
+                                       BLE_ATT_ERR_INVALID_OFFSET);
+
+    /*** Long read with a larger MTU. */
+    ble_hs_test_util_set_att_mtu(conn_handle, 45);
+    ble_gatts_read_test_static_long(conn_handle, 45);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+#if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 0
+
+/**
+ * Makes the peer open an EATT bearer and returns its local CID.
+ */
+static uint16_t
+ble_gatts_read_test_eatt_connect(uint16_t conn_handle)
+{
+    struct ble_l2cap_sig_le_con_req req;
+    struct ble_l2cap_chan *chan;
+    struct ble_hs_conn *conn;
+    uint16_t cid;
+    int rc;
+
+    /* ATT PDUs are accepted on EATT bearers over encrypted links only */
+    ble_hs_lock();
+    conn = ble_hs_conn_find_assert(conn_handle);
+    conn->bhc_sec_state.encrypted = 1;
+    ble_hs_unlock();
+
+    req.psm = htole16(BLE_EATT_PSM);
+    req.scid = htole16(0x0040);
+    req.mtu = htole16(MYNEWT_VAL(BLE_EATT_MTU));
+    req.mps = htole16(MYNEWT_VAL(BLE_EATT_MTU));
+    req.credits = htole16(10);
+
+    rc = ble_hs_test_util_inject_rx_l2cap_sig(
+        conn_handle, BLE_L2CAP_SIG_OP_LE_CREDIT_CONNECT_REQ, 1,
+        &req, sizeof req);
+    TEST_ASSERT_FATAL(rc == 0);
+    ble_hs_test_util_prev_tx_queue_clear();
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find_assert(conn_handle);
+    chan = ble_hs_conn_chan_find_by_dcid(conn, 0x0040);
+    TEST_ASSERT_FATAL(chan != NULL);
+    cid = chan->scid;
+    ble_hs_unlock();
+
+    return cid;
+}
+
+TEST_CASE_SELF(ble_gatts_read_test_case_static_eatt)
+{
+    struct ble_att_read_req read_req;
+    struct os_mbuf *om;
+    uint8_t buf[2 + BLE_ATT_READ_REQ_SZ];
+    uint16_t conn_handle;
+    uint16_t cid;
+    int rc;
+    int i;
+
+    ble_gatts_read_test_misc_init(&conn_handle);
+
+    for (i = 0; i < (int)sizeof ble_gatts_read_test_chr_3_val; i++) {
+        ble_gatts_read_test_chr_3_val[i] = 0x40 + i;
+    }
+
+    cid = ble_gatts_read_test_eatt_connect(conn_handle);
+
+    /* Single K-frame carrying the whole request SDU */
+    put_le16(buf, BLE_ATT_READ_REQ_SZ);
+    read_req.barq_handle = ble_gatts_read_test_chr_3_val_handle;
+    ble_att_read_req_write(buf + 2, BLE_ATT_READ_REQ_SZ, &read_req);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, cid,
+                                                buf, sizeof buf);
+    TEST_ASSERT(rc == 0);
+
+    /* The value fits in the bearer MTU and is not cut to the MTU of the fixed
+     * ATT channel.
+     */
+    om = ble_hs_test_util_prev_tx_dequeue_pullup();
+    TEST_ASSERT_FATAL(om != NULL);
+    TEST_ASSERT_FATAL(om->om_len ==
+                      2 + 1 + sizeof ble_gatts_read_test_chr_3_val);
+    TEST_ASSERT(get_le16(om->om_data) ==
+                1 + sizeof ble_gatts_read_test_chr_3_val);
+    TEST_ASSERT(om->om_data[2] == BLE_ATT_OP_READ_RSP);
+    TEST_ASSERT(memcmp(om->om_data + 3, ble_gatts_read_test_chr_3_val,
+                       sizeof ble_gatts_read_test_chr_3_val) == 0);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+#endif
+
+TEST_CASE_SELF(ble_gatts_read_test_case_db_hash)
+{
+    /* AES-CMAC with a zero key over the declarations of the test table:
+     *     0001 0028 3412
+     *     0002 0328 02 0003 1111
+     *     0004 0328 02 0005 2222
+     *     0006 0328 02 0007 3333
+     * (all fields little-endian), byte-reversed into little-endian.
+     */
+    static const uint8_t expected_hash[BLE_GATT_DB_HASH_SZ] = {
+        0x82, 0x42, 0xdb, 0xcf, 0xad, 0x65, 0xfd, 0xec,
+        0xae, 0xe7, 0x95, 0x98, 0x20, 0x62, 0x04, 0x69,
+    };
+    uint8_t hash1[BLE_GATT_DB_HASH_SZ];
+    uint8_t hash2[BLE_GATT_DB_HASH_SZ];
+    uint8_t buf[BLE_ATT_READ_REQ_SZ];
+    uint8_t cmd[3 + 1 + 12];
+    uint8_t chr_2_val[] = { 0, 10, 20, 30, 40, 50 };
+    struct ble_att_read_req read_req;
+    struct ble_hs_conn *conn;
+    uint16_t conn_handle;
+    uint16_t svc_handle;
+    int rc;
+
+    ble_gatts_read_test_misc_init(&conn_handle);
+
+    /* The test table is the only one registered; enabling the hash must not
+     * add attributes in front of it.
+     */
+    rc = ble_gatts_find_svc(BLE_UUID16_DECLARE(0x1234), &svc_handle);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(svc_handle == 1);
+    TEST_ASSERT_FATAL(ble_gatts_read_test_chr_1_def_handle == 2);
+    TEST_ASSERT_FATAL(ble_gatts_read_test_chr_2_def_handle == 4);
+    TEST_ASSERT_FATAL(ble_gatts_read_test_chr_3_val_handle == 7);
+
+    /* The peer enables Robust Caching. */
+    ble_hs_lock();
+    conn = ble_hs_conn_find(conn_handle);
+    TEST_ASSERT_FATAL(conn != NULL);
+    conn->bhc_gatt_svr.peer_cl_sup_feat[0] |=
+        BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING;
+    ble_hs_unlock();
+
+    /*** The hash is stable while the table is unchanged. */
+    rc = ble_gatts_db_hash_read(BLE_HS_CONN_HANDLE_NONE, hash1);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_gatts_db_hash_read(BLE_HS_CONN_HANDLE_NONE, hash2);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(hash1, hash2, sizeof hash1) == 0);
+    TEST_ASSERT(memcmp(hash1, expected_hash, sizeof hash1) == 0);
+
+    /*** Hiding the service changes the hash. */
+    rc = ble_gatts_svc_set_visibility(svc_handle, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_gatts_db_hash_read(BLE_HS_CONN_HANDLE_NONE, hash2);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(hash1, hash2, sizeof hash1) != 0);
+
+    /*** Restoring it yields the original hash. */
+    rc = ble_gatts_svc_set_visibility(svc_handle, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_gatts_db_hash_read(BLE_HS_CONN_HANDLE_NONE, hash2);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(hash1, hash2, sizeof hash1) == 0);
+
+    /*** Commands from the change-unaware peer are dropped silently and do
+     *** not make it change-aware.
+     */
+    memset(cmd, 0, sizeof cmd);
+    cmd[0] = BLE_ATT_OP_WRITE_CMD;
+    put_le16(cmd + 1, ble_gatts_read_test_chr_2_val_handle);
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                cmd, 4);
+    TEST_ASSERT(rc == BLE_HS_EREJECT);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    cmd[0] = BLE_ATT_OP_SIGNED_WRITE_CMD;
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                cmd, sizeof cmd);
+    TEST_ASSERT(rc == BLE_HS_EREJECT);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /*** The change-unaware peer's first request is rejected. */
+    read_req.barq_handle = ble_gatts_read_test_chr_2_val_handle;
+    ble_att_read_req_write(buf, sizeof buf, &read_req);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                buf, sizeof buf);
+    TEST_ASSERT(rc == BLE_HS_EREJECT);
+    ble_hs_test_util_verify_tx_err_rsp(BLE_ATT_OP_READ_REQ, 0,
+                                       BLE_ATT_ERR_DB_OUT_OF_SYNC);
+
+    /*** The following request makes it change-aware again. */
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_2_val_handle,
+                             chr_2_val, sizeof chr_2_val);
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_2_val_handle,
+                             chr_2_val, sizeof chr_2_val);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+/**
+ * Marks the connection bonded and restores its bond, as done once the link
+ * is encrypted with a stored key.
+ */
+static void
+ble_gatts_read_test_restore_bonding(uint16_t conn_handle)
+{
+    struct ble_hs_conn *conn;
+
+    ble_hs_lock();
+    conn = ble_hs_conn_find(conn_handle);
+    TEST_ASSERT_FATAL(conn != NULL);
+    conn->bhc_sec_state.encrypted = 1;
+    conn->bhc_sec_state.bonded = 1;
+    ble_hs_unlock();
+
+    ble_gatts_bonding_restored(conn_handle);
+}
+
+static void
+ble_gatts_read_test_read_peer_sec(struct ble_store_value_sec *out_value)
+{
+    struct ble_store_key_sec key_sec;
+    int rc;
+
+    memset(&key_sec, 0, sizeof key_sec);
+    key_sec.peer_addr.type = BLE_ADDR_PUBLIC;
+    memcpy(key_sec.peer_addr.val, ble_gatts_read_test_peer_addr, 6);
+
+    rc = ble_store_read_peer_sec(&key_sec, out_value);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+static void
+ble_gatts_read_test_rx_enable_robust_caching(uint16_t conn_handle)
+{
+    uint8_t feat = BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING;
+    struct os_mbuf *om;
+    int rc;
+
+    om = ble_hs_test_util_om_from_flat(&feat, sizeof feat);
+    rc = ble_gatts_peer_cl_sup_feat_update(conn_handle, om);
+    TEST_ASSERT(rc == 0);
+    os_mbuf_free_chain(om);
+}
+
+static void
+ble_gatts_read_test_rx_out_of_sync(uint16_t conn_handle, uint16_t attr_id)
+{
+    struct ble_att_read_req read_req;
+    uint8_t buf[BLE_ATT_READ_REQ_SZ];
+    int rc;
+
+    read_req.barq_handle = attr_id;
+    ble_att_read_req_write(buf, sizeof buf, &read_req);
+
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                buf, sizeof buf);
+    TEST_ASSERT(rc == BLE_HS_EREJECT);
+    ble_hs_test_util_verify_tx_err_rsp(BLE_ATT_OP_READ_REQ, 0,
+                                       BLE_ATT_ERR_DB_OUT_OF_SYNC);
+}
+
+TEST_CASE_SELF(ble_gatts_read_test_case_db_hash_bonded)
+{
+    struct ble_store_value_sec value_sec;
+    uint8_t chr_2_val[] = { 0, 10, 20, 30, 40, 50 };
+    uint16_t conn_handle;
+    uint16_t svc_handle;
+    int rc;
+
+    ble_gatts_read_test_misc_init(&conn_handle);
+
+    rc = ble_gatts_find_svc(BLE_UUID16_DECLARE(0x1234), &svc_handle);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    memset(&value_sec, 0, sizeof value_sec);
+    value_sec.peer_addr.type = BLE_ADDR_PUBLIC;
+    memcpy(value_sec.peer_addr.val, ble_gatts_read_test_peer_addr, 6);
+    value_sec.key_size = 16;
+    value_sec.ltk_present = 1;
+    rc = ble_store_write_peer_sec(&value_sec);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_read_test_restore_bonding(conn_handle);
+
+    /*** Enabling Robust Caching is stored with the bond. */
+    ble_gatts_read_test_rx_enable_robust_caching(conn_handle);
+
+    ble_gatts_read_test_read_peer_sec(&value_sec);
+    TEST_ASSERT(value_sec.cl_sup_feat ==
+                BLE_GATT_CHR_CLI_SUP_FEAT_ROBUST_CACHING);
+    TEST_ASSERT(!value_sec.change_unaware);
+
+    /*** A change while disconnected makes the bonded peer change-unaware. */
+    ble_hs_test_util_conn_disconnect(conn_handle);
+
+    rc = ble_gatts_svc_set_visibility(svc_handle, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_gatts_svc_set_visibility(svc_handle, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_read_test_read_peer_sec(&value_sec);
+    TEST_ASSERT(value_sec.change_unaware);
+
+    /*** The state is restored with the bond; the first request is rejected
+     *** and the next one makes the peer change-aware again.
+     */
+    ble_hs_test_util_create_conn(conn_handle, ble_gatts_read_test_peer_addr,
+                                 NULL, NULL);
+    ble_gatts_read_test_restore_bonding(conn_handle);
+
+    ble_gatts_read_test_rx_out_of_sync(conn_handle,
+                                       ble_gatts_read_test_chr_2_val_handle);
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_2_val_handle,
+                             chr_2_val, sizeof chr_2_val);
+
+    ble_gatts_read_test_read_peer_sec(&value_sec);
+    TEST_ASSERT(!value_sec.change_unaware);
+
+    /*** The change-aware state is kept over the next connection. */
+    ble_hs_test_util_conn_disconnect(conn_handle);
+    ble_hs_test_util_create_conn(conn_handle, ble_gatts_read_test_peer_addr,
+                                 NULL, NULL);
+    ble_gatts_read_test_restore_bonding(conn_handle);
+
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_2_val_handle,
+                             chr_2_val, sizeof chr_2_val);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+static uint16_t ble_gatts_read_test_svc_chg_val_handle;
+static uint8_t ble_gatts_read_test_svc_chg_val[4];
+
+static const struct ble_gatt_svc_def ble_gatts_read_test_svc_chg_svcs[] = { {
+    .type = BLE_GATT_SVC_TYPE_PRIMARY,
+    .uuid = BLE_UUID16_DECLARE(0x1801),
+    .characteristics = (struct ble_gatt_chr_def[]) { {
+        .uuid = BLE_UUID16_DECLARE(BLE_GATT_CHR_SVC_CHANGED_UUID16),
+        .flags = BLE_GATT_CHR_F_INDICATE,
+        .static_val = ble_gatts_read_test_svc_chg_val,
+        .static_val_len = sizeof ble_gatts_read_test_svc_chg_val,
+        .val_handle = &ble_gatts_read_test_svc_chg_val_handle,
+    }, {
+        0
+    } },
+}, {
+    .type = BLE_GATT_SVC_TYPE_PRIMARY,
+    .uuid = BLE_UUID16_DECLARE(0x5678),
+    .characteristics = (struct ble_gatt_chr_def[]) { {
+        .uuid = BLE_UUID16_DECLARE(BLE_GATTS_READ_TEST_CHR_3_UUID),
+        .flags = BLE_GATT_CHR_F_READ,
+        .static_val = ble_gatts_read_test_chr_3_val,
+        .static_val_len = sizeof ble_gatts_read_test_chr_3_val,
+        .val_handle = &ble_gatts_read_test_chr_3_val_handle,
+    }, {
+        0
+    } },
+}, {
+    0
+} };
+
+TEST_CASE_SELF(ble_gatts_read_test_case_db_hash_svc_changed)
+{
+    struct os_mbuf *om;
+    uint16_t conn_handle;
+    uint16_t svc_handle;
+    uint8_t op;
+    int rc;
+
+    ble_hs_test_util_init();
+    ble_hs_test_util_reg_svcs(ble_gatts_read_test_svc_chg_svcs, NULL, NULL);
+    ble_hs_test_util_create_conn(2, ble_gatts_read_test_peer_addr, NULL,
+                                 NULL);
+    conn_handle = 2;
+
+    rc = ble_gatts_find_svc(BLE_UUID16_DECLARE(0x5678), &svc_handle);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_gatts_read_test_rx_enable_robust_caching(conn_handle);
+
+    rc = ble_gatts_svc_set_visibility(svc_handle, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_gatts_svc_set_visibility(svc_handle, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /*** Service Changed is indicated and confirmed. */
+    rc = ble_gatts_indicate(conn_handle,
+                            ble_gatts_read_test_svc_chg_val_handle);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    om = ble_hs_test_util_prev_tx_dequeue_pullup();
+    TEST_ASSERT_FATAL(om != NULL);
+    TEST_ASSERT(om->om_data[0] == BLE_ATT_OP_INDICATE_REQ);
+
+    op = BLE_ATT_OP_INDICATE_RSP;
+    rc = ble_hs_test_util_l2cap_rx_payload_flat(conn_handle, BLE_L2CAP_CID_ATT,
+                                                &op, sizeof op);
+    TEST_ASSERT(rc == 0);
+
+    /*** The confirmation made the peer change-aware; no request is
+     *** rejected.
+     */
+    ble_gatts_read_test_once(conn_handle,
+                             ble_gatts_read_test_chr_3_val_handle,
+                             ble_gatts_read_test_chr_3_val,
+                             BLE_ATT_MTU_DFLT - 1);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
 TEST_SUITE(ble_gatts_read_test_suite)
 {
     ble_gatts_read_test_case_basic();
     ble_gatts_read_test_case_long();
+    ble_gatts_read_test_case_static();
+#if MYNEWT_VAL(BLE_EATT_CHAN_NUM) > 0
+    ble_gatts_read_test_case_static_eatt();
+#endif
+    ble_gatts_read_test_case_db_hash();
+    ble_gatts_read_test_case_db_hash_bonded();
+    ble_gatts_read_test_case_db_hash_svc_changed();
 }
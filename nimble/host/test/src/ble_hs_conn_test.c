@@ -216,9 +216,68 @@ TEST_CASE_SELF(ble_hs_conn_test_undirect_connectable_success)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+static int
+ble_hs_conn_test_util_count_cb(struct ble_hs_conn *conn, void *arg)
+{
+    (*(int *)arg)++;
+    return 0;
+}
+
+TEST_CASE_SELF(ble_hs_conn_test_find_by_handle)
+{
+    static const uint16_t handles[] = { 1, 3, 9, 17 };
+    struct ble_hs_conn *conn;
+    int num_handles;
+    int num_conns;
+    int i;
+
+    ble_hs_test_util_init();
+
+    num_handles = sizeof handles / sizeof handles[0];
+
+    /* Handles 1, 9 and 17 share a hash bucket. */
+    for (i = 0; i < num_handles; i++) {
+        ble_hs_test_util_create_conn(handles[i],
+                                     ((uint8_t[6]){ i + 1, 2, 3, 4, 5, 6 }),
+                                     NULL, NULL);
+    }
+
+    ble_hs_lock();
+
+    for (i = 0; i < num_handles; i++) {
+        conn = ble_hs_conn_find(handles[i]);
+        TEST_ASSERT_FATAL(conn != NULL);
+        TEST_ASSERT(conn->bhc_handle == handles[i]);
+    }
+    TEST_ASSERT(ble_hs_conn_find(2) == NULL);
+    TEST_ASSERT(ble_hs_conn_find(25) == NULL);
+
+    num_conns = 0;
+    ble_hs_conn_foreach(ble_hs_conn_test_util_count_cb, &num_conns);
+    TEST_ASSERT(num_conns == num_handles);
+
+    ble_hs_unlock();
+
+    /* Remove a connection from the middle of a bucket chain. */
+    ble_hs_test_util_conn_disconnect(9);
+
+    ble_hs_lock();
+
+    TEST_ASSERT(ble_hs_conn_find(9) == NULL);
+    TEST_ASSERT(ble_hs_conn_find(1) != NULL);
+    TEST_ASSERT(ble_hs_conn_find(17) != NULL);
+
+    num_conns = 0;
+    ble_hs_conn_foreach(ble_hs_conn_test_util_count_cb, &num_conns);
+    TEST_ASSERT(num_conns == num_handles - 1);
+
+    ble_hs_unlock();
+}
+
 TEST_SUITE(ble_hs_conn_suite)
 {
     ble_hs_conn_test_direct_connect_success();
     ble_hs_conn_test_direct_connectable_success();
     ble_hs_conn_test_undirect_connectable_success();
+    ble_hs_conn_test_find_by_handle();
 }
@@ -337,10 +337,245 @@ TEST_CASE_SELF(ble_hs_hci_acl_two_conn)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+#define BLE_HS_HCI_TEST_ASYNC_MAX   4
+
+static struct {
+    uint16_t opcode;
+    int status;
+    uint8_t rsp[BLE_HCI_READ_RSSI_ACK_PARAM_LEN];
+    uint8_t rsp_len;
+} ble_hs_hci_test_async_done[BLE_HS_HCI_TEST_ASYNC_MAX];
+static int ble_hs_hci_test_async_num_done;
+
+static void
+ble_hs_hci_test_async_cb(uint16_t opcode, int status, const uint8_t *rsp,
+                         uint8_t rsp_len, void *arg)
+{
+    int idx;
+
+    TEST_ASSERT_FATAL(ble_hs_hci_test_async_num_done <
+                      BLE_HS_HCI_TEST_ASYNC_MAX);
+    TEST_ASSERT_FATAL(rsp_len <= BLE_HCI_READ_RSSI_ACK_PARAM_LEN);
+    TEST_ASSERT(arg == &ble_hs_hci_test_async_num_done);
+
+    idx = ble_hs_hci_test_async_num_done++;
+    ble_hs_hci_test_async_done[idx].opcode = opcode;
+    ble_hs_hci_test_async_done[idx].status = status;
+    ble_hs_hci_test_async_done[idx].rsp_len = rsp_len;
+    if (rsp_len > 0) {
+        memcpy(ble_hs_hci_test_async_done[idx].rsp, rsp, rsp_len);
+    }
+}
+
+TEST_CASE_SELF(ble_hs_hci_test_cmd_async)
+{
+    uint8_t params[BLE_HCI_READ_RSSI_ACK_PARAM_LEN];
+    uint8_t big[BLE_HS_HCI_CMD_ASYNC_PARAMS_MAX + 1];
+    uint16_t rssi_op;
+    uint16_t le_op;
+    uint8_t cmd[2];
+    uint8_t *param;
+    uint8_t len;
+    int rc;
+
+    rssi_op = ble_hs_hci_util_opcode_join(BLE_HCI_OGF_STATUS_PARAMS,
+                                          BLE_HCI_OCF_RD_RSSI);
+    le_op = ble_hs_hci_util_opcode_join(BLE_HCI_OGF_LE,
+                                        BLE_HCI_OCF_LE_SET_ADV_ENABLE);
+
+    put_le16(params + 0, 1);
+    params[2] = -8;
+
+    ble_hs_test_util_hci_out_clear();
+    ble_hs_test_util_hci_acks_clear();
+    ble_hs_test_util_hci_ack_append_params(rssi_op, 0, params,
+                                           sizeof params);
+    ble_hs_test_util_hci_ack_append(le_op, BLE_ERR_CMD_DISALLOWED);
+
+    /*** Commands are sent in order; callbacks are deferred. */
+    put_le16(cmd, 1);
+    rc = ble_hs_hci_cmd_tx_async(rssi_op, cmd, sizeof cmd,
+                                 ble_hs_hci_test_async_cb,
+                                 &ble_hs_hci_test_async_num_done);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    cmd[0] = 1;
+    rc = ble_hs_hci_cmd_tx_async(le_op, cmd, 1, ble_hs_hci_test_async_cb,
+                                 &ble_hs_hci_test_async_num_done);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ble_hs_hci_test_async_num_done == 0);
+
+    param = ble_hs_test_util_hci_verify_tx(BLE_HCI_OGF_STATUS_PARAMS,
+                                           BLE_HCI_OCF_RD_RSSI, &len);
+    TEST_ASSERT(len == 2 && get_le16(param) == 1);
+    param = ble_hs_test_util_hci_verify_tx(BLE_HCI_OGF_LE,
+                                           BLE_HCI_OCF_LE_SET_ADV_ENABLE,
+                                           &len);
+    TEST_ASSERT(len == 1 && param[0] == 1);
+
+    /*** Draining executes the callbacks in submission order. */
+    rc = ble_hs_hci_cmd_async_drain();
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(ble_hs_hci_test_async_num_done == 2);
+
+    TEST_ASSERT(ble_hs_hci_test_async_done[0].opcode == rssi_op);
+    TEST_ASSERT(ble_hs_hci_test_async_done[0].status == 0);
+    TEST_ASSERT(ble_hs_hci_test_async_done[0].rsp_len == sizeof params);
+    TEST_ASSERT(memcmp(ble_hs_hci_test_async_done[0].rsp, params,
+                       sizeof params) == 0);
+
+    TEST_ASSERT(ble_hs_hci_test_async_done[1].opcode == le_op);
+    TEST_ASSERT(ble_hs_hci_test_async_done[1].status ==
+                BLE_HS_HCI_ERR(BLE_ERR_CMD_DISALLOWED));
+    TEST_ASSERT(ble_hs_hci_test_async_done[1].rsp_len == 0);
+
+    /*** Failure: no ack. */
+    ble_hs_hci_test_async_num_done = 0;
+    rc = ble_hs_hci_cmd_tx_async(le_op, cmd, 1, ble_hs_hci_test_async_cb,
+                                 &ble_hs_hci_test_async_num_done);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_hs_hci_cmd_async_drain();
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT_FATAL(ble_hs_hci_test_async_num_done == 1);
+    TEST_ASSERT(ble_hs_hci_test_async_done[0].status == BLE_HS_ETIMEOUT_HCI);
+
+    /*** Failure: parameters too long to queue. */
+    memset(big, 0, sizeof big);
+    rc = ble_hs_hci_cmd_tx_async(le_op, big, sizeof big,
+                                 ble_hs_hci_test_async_cb, NULL);
+    TEST_ASSERT(rc == BLE_HS_EINVAL);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+/**
+ * Reports the controller's only outstanding ACL packet as completed and
+ * returns the handle of the connection it belonged to.
+ */
+static uint16_t
+ble_hs_hci_test_sched_complete_one(void)
+{
+    struct ble_hs_test_util_hci_num_completed_pkts_entry ncpe[2];
+    struct ble_hs_conn *conn;
+    uint16_t conn_handle;
+    int num_outstanding;
+
+    conn_handle = BLE_HS_CONN_HANDLE_NONE;
+    num_outstanding = 0;
+
+    ble_hs_lock();
+    for (conn = ble_hs_conn_first();
+         conn != NULL;
+         conn = SLIST_NEXT(conn, bhc_next)) {
+
+        if (conn->bhc_outstanding_pkts > 0) {
+            conn_handle = conn->bhc_handle;
+            num_outstanding += conn->bhc_outstanding_pkts;
+        }
+    }
+    ble_hs_unlock();
+
+    TEST_ASSERT_FATAL(num_outstanding == 1);
+
+    memset(ncpe, 0, sizeof ncpe);
+    ncpe[0].handle_id = conn_handle;
+    ncpe[0].num_pkts = 1;
+    ble_hs_test_util_hci_rx_num_completed_pkts_event(ncpe);
+
+    return conn_handle;
+}
+
+static void
+ble_hs_hci_test_sched_order(uint8_t weight1, const uint16_t *exp_order)
+{
+    struct ble_gap_conn_tx_stats stats;
+    uint8_t peer_addr1[6] = { 1, 2, 3, 4, 5, 6 };
+    uint8_t peer_addr2[6] = { 2, 3, 4, 5, 6, 7 };
+    uint8_t data[200];
+    int rc;
+    int i;
+
+    memset(data, 0xaa, sizeof data);
+
+    ble_hs_test_util_init();
+
+    /* The controller has room for a single packet. */
+    rc = ble_hs_hci_set_buf_sz(255, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    ble_hs_test_util_create_conn(1, peer_addr1, NULL, NULL);
+    ble_hs_test_util_create_conn(2, peer_addr2, NULL, NULL);
+    ble_hs_test_util_set_att_mtu(1, 256);
+    ble_hs_test_util_set_att_mtu(2, 256);
+
+    rc = ble_gap_conn_set_tx_weight(1, weight1);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Each write is a 207-byte L2CAP frame.  The first goes straight to the
+     * controller; the rest wait for buffers.
+     */
+    for (i = 0; i < 4; i++) {
+        rc = ble_hs_test_util_gatt_write_no_rsp_flat(1, 100, data,
+                                                     sizeof data);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    for (i = 0; i < 4; i++) {
+        rc = ble_hs_test_util_gatt_write_no_rsp_flat(2, 100, data,
+                                                     sizeof data);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    TEST_ASSERT(ble_hs_hci_avail_pkts == 0);
+
+    rc = ble_gap_conn_tx_stats(2, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.queued_bytes == 4 * 207);
+    TEST_ASSERT(stats.tx_bytes == 0);
+
+    for (i = 0; i < 8; i++) {
+        TEST_ASSERT(ble_hs_hci_test_sched_complete_one() == exp_order[i]);
+    }
+    TEST_ASSERT(ble_hs_hci_avail_pkts == 1);
+
+    for (i = 1; i <= 2; i++) {
+        rc = ble_gap_conn_tx_stats(i, &stats);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(stats.queued_bytes == 0);
+        TEST_ASSERT(stats.queued_bytes_max == (i == 1 ? 3 : 4) * 207);
+        TEST_ASSERT(stats.tx_bytes == 4 * 207);
+    }
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_hs_hci_acl_tx_sched)
+{
+    /* Equal weights: connections alternate once both are backlogged. */
+    static const uint16_t exp_equal[8] = { 1, 1, 2, 1, 2, 1, 2, 2 };
+
+    /* Connection 1 gets two packets per round. */
+    static const uint16_t exp_weighted[8] = { 1, 1, 1, 2, 1, 2, 2, 2 };
+
+    struct ble_gap_conn_tx_stats stats;
+    int rc;
+
+    ble_hs_hci_test_sched_order(1, exp_equal);
+    ble_hs_hci_test_sched_order(2, exp_weighted);
+
+    /*** Invalid arguments. */
+    rc = ble_gap_conn_set_tx_weight(1, 0);
+    TEST_ASSERT(rc == BLE_HS_EINVAL);
+    rc = ble_gap_conn_set_tx_weight(3, 1);
+    TEST_ASSERT(rc == BLE_HS_ENOTCONN);
+    rc = ble_gap_conn_tx_stats(3, &stats);
+    TEST_ASSERT(rc == BLE_HS_ENOTCONN);
+}
+
 TEST_SUITE(ble_hs_hci_suite)
 {
     ble_hs_hci_test_event_bad();
     ble_hs_hci_test_rssi();
+    ble_hs_hci_test_cmd_async();
     ble_hs_hci_acl_one_conn();
     ble_hs_hci_acl_two_conn();
+    ble_hs_hci_acl_tx_sched();
 }
@@ -0,0 +1,271 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "testutil/testutil.h"
+#include "host/ble_hs_mbuf.h"
+#include "ble_hs_test.h"
+#include "ble_hs_test_util.h"
+
+#define BLE_HS_MBUF_TEST_NUM_BUFS   4
+
+/* Lengths of the mbufs in the test chain; the second one is empty. */
+static const uint16_t ble_hs_mbuf_test_lens[BLE_HS_MBUF_TEST_NUM_BUFS] = {
+    3, 0, 5, 2
+};
+
+#define BLE_HS_MBUF_TEST_LEN        10
+
+/**
+ * Builds a chain holding the bytes 0, 1, ..., 9 split over mbufs of the
+ * lengths listed above.
+ */
+static struct os_mbuf *
+ble_hs_mbuf_test_util_chain(void)
+{
+    struct os_mbuf *prev;
+    struct os_mbuf *om;
+    struct os_mbuf *head;
+    uint8_t val;
+    int i;
+    int j;
+
+    head = NULL;
+    prev = NULL;
+    val = 0;
+    for (i = 0; i < BLE_HS_MBUF_TEST_NUM_BUFS; i++) {
+        if (i == 0) {
+            om = os_msys_get_pkthdr(0, 0);
+        } else {
+            om = os_msys_get(0, 0);
+        }
+        TEST_ASSERT_FATAL(om != NULL);
+
+        for (j = 0; j < ble_hs_mbuf_test_lens[i]; j++) {
+            om->om_data[j] = val++;
+        }
+        om->om_len = ble_hs_mbuf_test_lens[i];
+
+        if (prev == NULL) {
+            head = om;
+        } else {
+            SLIST_NEXT(prev, om_next) = om;
+        }
+        prev = om;
+    }
+    OS_MBUF_PKTHDR(head)->omp_len = BLE_HS_MBUF_TEST_LEN;
+
+    return head;
+}
+
+static void
+ble_hs_mbuf_test_util_verify_bytes(const uint8_t *buf, uint8_t first,
+                                   int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++) {
+        TEST_ASSERT(buf[i] == first + i);
+    }
+}
+
+TEST_CASE_SELF(ble_hs_mbuf_test_case_cursor_read)
+{
+    struct ble_hs_mbuf_cursor cur;
+    struct ble_hs_mbuf_cursor saved;
+    struct os_mbuf *om;
+    uint8_t buf[BLE_HS_MBUF_TEST_LEN + 1];
+    int rc;
+
+    ble_hs_test_util_init();
+
+    om = ble_hs_mbuf_test_util_chain();
+
+    /*** Reads across mbuf boundaries, including the empty mbuf. */
+    rc = ble_hs_mbuf_cursor_init(&cur, om, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 2);
+    TEST_ASSERT(rc == 0);
+    ble_hs_mbuf_test_util_verify_bytes(buf, 0, 2);
+
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 4);
+    TEST_ASSERT(rc == 0);
+    ble_hs_mbuf_test_util_verify_bytes(buf, 2, 4);
+
+    /*** Skip to the last mbuf. */
+    rc = ble_hs_mbuf_cursor_skip(&cur, 2);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(!ble_hs_mbuf_cursor_at_end(&cur));
+
+    /*** A short read fails and leaves the cursor unchanged. */
+    saved = cur;
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 3);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+    TEST_ASSERT(cur.om == saved.om && cur.off == saved.off);
+    rc = ble_hs_mbuf_cursor_skip(&cur, 3);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+    TEST_ASSERT(cur.om == saved.om && cur.off == saved.off);
+
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 2);
+    TEST_ASSERT(rc == 0);
+    ble_hs_mbuf_test_util_verify_bytes(buf, 8, 2);
+    TEST_ASSERT(ble_hs_mbuf_cursor_at_end(&cur));
+
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 1);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+
+    /*** Whole chain at once. */
+    rc = ble_hs_mbuf_cursor_init(&cur, om, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, BLE_HS_MBUF_TEST_LEN + 1);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, BLE_HS_MBUF_TEST_LEN);
+    TEST_ASSERT(rc == 0);
+    ble_hs_mbuf_test_util_verify_bytes(buf, 0, BLE_HS_MBUF_TEST_LEN);
+
+    /*** Start at an offset that ends an mbuf. */
+    rc = ble_hs_mbuf_cursor_init(&cur, om, 3);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = ble_hs_mbuf_cursor_read(&cur, buf, 1);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(buf[0] == 3);
+
+    /*** Offsets at and past the end. */
+    rc = ble_hs_mbuf_cursor_init(&cur, om, BLE_HS_MBUF_TEST_LEN);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(ble_hs_mbuf_cursor_at_end(&cur));
+    rc = ble_hs_mbuf_cursor_init(&cur, om, BLE_HS_MBUF_TEST_LEN + 1);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+
+    os_mbuf_free_chain(om);
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_hs_mbuf_test_case_cursor_peek)
+{
+    struct ble_hs_mbuf_cursor cur;
+    struct os_mbuf *om;
+    const uint8_t *data;
+    int rc;
+
+    ble_hs_test_util_init();
+
+    om = ble_hs_mbuf_test_util_chain();
+
+    /*** Contiguous bytes are returned in place. */
+    rc = ble_hs_mbuf_cursor_init(&cur, om, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+    data = ble_hs_mbuf_cursor_peek(&cur, 2);
+    TEST_ASSERT(data == om->om_data + 1);
+
+    /*** Peeking does not advance. */
+    data = ble_hs_mbuf_cursor_peek(&cur, 1);
+    TEST_ASSERT(data != NULL && data[0] == 1);
+
+    /*** Bytes spanning an mbuf boundary cannot be peeked. */
+    TEST_ASSERT(ble_hs_mbuf_cursor_peek(&cur, 3) == NULL);
+
+    /*** At the end of an mbuf, peek looks past the empty one. */
+    rc = ble_hs_mbuf_cursor_skip(&cur, 2);
+    TEST_ASSERT_FATAL(rc == 0);
+    data = ble_hs_mbuf_cursor_peek(&cur, 5);
+    TEST_ASSERT(data != NULL);
+    ble_hs_mbuf_test_util_verify_bytes(data, 3, 5);
+    TEST_ASSERT(ble_hs_mbuf_cursor_peek(&cur, 6) == NULL);
+
+    /*** Nothing to peek at the end. */
+    rc = ble_hs_mbuf_cursor_skip(&cur, 7);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ble_hs_mbuf_cursor_peek(&cur, 1) == NULL);
+
+    os_mbuf_free_chain(om);
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_hs_mbuf_test_case_to_iov)
+{
+    struct ble_hs_mbuf_iov iov[BLE_HS_MBUF_TEST_NUM_BUFS];
+    struct os_mbuf *om;
+    int num_iov;
+    int rc;
+
+    ble_hs_test_util_init();
+
+    om = ble_hs_mbuf_test_util_chain();
+
+    /*** Whole chain; the empty mbuf yields no piece. */
+    num_iov = BLE_HS_MBUF_TEST_NUM_BUFS;
+    rc = ble_hs_mbuf_to_iov(om, 0, BLE_HS_MBUF_TEST_LEN, iov, &num_iov);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(num_iov == 3);
+    TEST_ASSERT(iov[0].len == 3);
+    ble_hs_mbuf_test_util_verify_bytes(iov[0].base, 0, 3);
+    TEST_ASSERT(iov[1].len == 5);
+    ble_hs_mbuf_test_util_verify_bytes(iov[1].base, 3, 5);
+    TEST_ASSERT(iov[2].len == 2);
+    ble_hs_mbuf_test_util_verify_bytes(iov[2].base, 8, 2);
+
+    /*** Range starting and ending inside mbufs. */
+    num_iov = BLE_HS_MBUF_TEST_NUM_BUFS;
+    rc = ble_hs_mbuf_to_iov(om, 2, 7, iov, &num_iov);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(num_iov == 3);
+    TEST_ASSERT(iov[0].len == 1);
+    ble_hs_mbuf_test_util_verify_bytes(iov[0].base, 2, 1);
+    TEST_ASSERT(iov[1].len == 5);
+    TEST_ASSERT(iov[2].len == 1);
+    ble_hs_mbuf_test_util_verify_bytes(iov[2].base, 8, 1);
+
+    /*** Range within a single mbuf. */
+    num_iov = 1;
+    rc = ble_hs_mbuf_to_iov(om, 4, 3, iov, &num_iov);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(num_iov == 1);
+    TEST_ASSERT(iov[0].len == 3);
+    ble_hs_mbuf_test_util_verify_bytes(iov[0].base, 4, 3);
+
+    /*** Empty range. */
+    num_iov = BLE_HS_MBUF_TEST_NUM_BUFS;
+    rc = ble_hs_mbuf_to_iov(om, 5, 0, iov, &num_iov);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(num_iov == 0);
+
+    /*** Too few pieces. */
+    num_iov = 2;
+    rc = ble_hs_mbuf_to_iov(om, 0, BLE_HS_MBUF_TEST_LEN, iov, &num_iov);
+    TEST_ASSERT(rc == BLE_HS_ENOMEM);
+
+    /*** Range past the end of the chain. */
+    num_iov = BLE_HS_MBUF_TEST_NUM_BUFS;
+    rc = ble_hs_mbuf_to_iov(om, 1, BLE_HS_MBUF_TEST_LEN, iov, &num_iov);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+    rc = ble_hs_mbuf_to_iov(om, BLE_HS_MBUF_TEST_LEN + 1, 0, iov, &num_iov);
+    TEST_ASSERT(rc == BLE_HS_EBADDATA);
+
+    os_mbuf_free_chain(om);
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_SUITE(ble_hs_mbuf_test_suite)
+{
+    ble_hs_mbuf_test_case_cursor_read();
+    ble_hs_mbuf_test_case_cursor_peek();
+    ble_hs_mbuf_test_case_to_iov();
+}
@@ -43,6 +43,7 @@ main(int argc, char **argv)
 
     ble_att_clt_suite();
     ble_att_svr_suite();
+    ble_eatt_test_suite();
     ble_gap_test_suite_adv();
     ble_gap_test_suite_conn_cancel();
     ble_gap_test_suite_conn_find();
@@ -54,6 +55,7 @@ main(int argc, char **argv)
     ble_gap_test_suite_timeout();
     ble_gap_test_suite_update_conn();
     ble_gap_test_suite_wl();
+    ble_gatt_cache_test_suite();
     ble_gatt_conn_suite();
     ble_gatt_disc_c_test_suite();
     ble_gatt_disc_d_test_suite();
@@ -68,6 +70,7 @@ main(int argc, char **argv)
     ble_hs_conn_suite();
     ble_hs_hci_suite();
     ble_hs_id_test_suite_auto();
+    ble_hs_mbuf_test_suite();
     ble_hs_pvcy_test_suite_irk();
     ble_l2cap_test_suite();
     ble_os_test_suite();
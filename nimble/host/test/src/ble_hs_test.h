@@ -24,6 +24,7 @@
 
 TEST_SUITE_DECL(ble_att_clt_suite);
 TEST_SUITE_DECL(ble_att_svr_suite);
+TEST_SUITE_DECL(ble_eatt_test_suite);
 TEST_SUITE_DECL(ble_gap_test_suite_adv);
 TEST_SUITE_DECL(ble_gap_test_suite_conn_cancel);
 TEST_SUITE_DECL(ble_gap_test_suite_conn_find);
@@ -36,6 +37,7 @@ TEST_SUITE_DECL(ble_gap_test_suite_stop_adv);
 TEST_SUITE_DECL(ble_gap_test_suite_timeout);
 TEST_SUITE_DECL(ble_gap_test_suite_update_conn);
 TEST_SUITE_DECL(ble_gap_test_suite_wl);
+TEST_SUITE_DECL(ble_gatt_cache_test_suite);
 TEST_SUITE_DECL(ble_gatt_conn_suite);
 TEST_SUITE_DECL(ble_gatt_disc_c_test_suite);
 TEST_SUITE_DECL(ble_gatt_disc_d_test_suite);
@@ -50,6 +52,7 @@ TEST_SUITE_DECL(ble_hs_adv_test_suite);
 TEST_SUITE_DECL(ble_hs_conn_suite);
 TEST_SUITE_DECL(ble_hs_hci_suite);
 TEST_SUITE_DECL(ble_hs_id_test_suite_auto);
+TEST_SUITE_DECL(ble_hs_mbuf_test_suite);
 TEST_SUITE_DECL(ble_hs_pvcy_test_suite_irk);
 TEST_SUITE_DECL(ble_l2cap_test_suite);
 TEST_SUITE_DECL(ble_os_test_suite);
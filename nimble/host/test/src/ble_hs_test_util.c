@@ -244,6 +244,13 @@ ble_hs_test_util_create_rpa_conn(uint16_t handle, uint8_t own_addr_type,
     rc = ble_gap_rx_conn_complete(&evt, 0);
     TEST_ASSERT(rc == 0);
 
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+    /* Most tests expect discovery procedures to go over the air; the client
+     * cache tests turn caching back on for their connections.
+     */
+    ble_gattc_cache_set_state(handle, BLE_GATTC_CACHE_OFF);
+#endif
+
     evt2.subev_code = BLE_HCI_LE_SUBEV_RD_REM_USED_FEAT;
     evt2.status = BLE_ERR_SUCCESS;
     evt2.conn_handle = htole16(handle);
@@ -1923,6 +1930,8 @@ ble_hs_test_util_store_read(int obj_type, const union ble_store_key *key,
     case BLE_STORE_OBJ_TYPE_CCCD:
         ble_sm_test_store_key.cccd = key->cccd;
         break;
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        break;
     default:
         return BLE_HS_ENOTSUP;
     }
@@ -1937,6 +1946,8 @@ ble_hs_test_util_store_read(int obj_type, const union ble_store_key *key,
     case BLE_STORE_OBJ_TYPE_CCCD:
         ble_sm_test_store_value.cccd = value->cccd;
         break;
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        break;
     default:
         rc = BLE_HS_ENOTSUP;
         break;
@@ -1962,6 +1973,8 @@ ble_hs_test_util_store_write(int obj_type, const union ble_store_value *value)
     case BLE_STORE_OBJ_TYPE_CCCD:
         ble_sm_test_store_value.cccd = value->cccd;
         break;
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        break;
     default:
         rc = BLE_HS_ENOTSUP;
         break;
@@ -1985,6 +1998,8 @@ ble_hs_test_util_store_delete(int obj_type, const union ble_store_key *key)
     case BLE_STORE_OBJ_TYPE_CCCD:
         ble_sm_test_store_key.cccd = key->cccd;
         break;
+    case BLE_STORE_OBJ_TYPE_GATT_CACHE:
+        break;
     default:
         return BLE_HS_ENOTSUP;
     }
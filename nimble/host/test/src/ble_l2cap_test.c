@@ -741,7 +741,7 @@ ble_l2cap_test_event(struct ble_l2cap_event *event, void *arg)
         TEST_ASSERT(memcmp(sdu_rx->om_data, ev->data, ev->data_len) == 0);
         return 0;
     case BLE_L2CAP_EVENT_COC_TX_UNSTALLED:
-        /* TODO Add tests for this */
+        TEST_ASSERT(ev->app_status == event->tx_unstalled.status);
         return 0;
     default:
         return 0;
@@ -1066,7 +1066,9 @@ ble_l2cap_test_coc_send_data(struct test_data *t)
 {
     struct os_mbuf *sdu;
     struct os_mbuf *sdu_copy;
+    struct os_mbuf *om;
     struct event *ev = &t->event[t->event_iter++];
+    uint16_t offset;
     int rc;
 
     /* Send data event is created only for testing.
@@ -1104,7 +1106,20 @@ ble_l2cap_test_coc_send_data(struct test_data *t)
     assert(sdu_copy != NULL);
     put_le16(sdu_copy->om_data, ev->data_len);
 
-    ble_hs_test_util_verify_tx_l2cap(sdu);
+    /* The SDU is handed over to the stack, so verify against the copy.  It
+     * may have been split over several K-frames, each no bigger than the
+     * peer's MPS.
+     */
+    offset = 0;
+    while (offset < OS_MBUF_PKTLEN(sdu_copy)) {
+        om = ble_hs_test_util_prev_tx_dequeue();
+        TEST_ASSERT_FATAL(om != NULL);
+        TEST_ASSERT_FATAL(OS_MBUF_PKTLEN(om) <= t->chan[0]->peer_coc_mps);
+        TEST_ASSERT_FATAL(os_mbuf_cmpm(om, 0, sdu_copy, offset,
+                                       OS_MBUF_PKTLEN(om)) == 0);
+        offset += OS_MBUF_PKTLEN(om);
+    }
+    TEST_ASSERT(offset == OS_MBUF_PKTLEN(sdu_copy));
 
     rc = os_mbuf_free_chain(sdu_copy);
     TEST_ASSERT_FATAL(rc == 0);
@@ -1451,6 +1466,220 @@ TEST_CASE_SELF(ble_l2cap_test_case_coc_send_data_succeed)
     ble_hs_test_util_assert_mbufs_freed(NULL);
 }
 
+TEST_CASE_SELF(ble_l2cap_test_case_coc_send_data_multi_frame)
+{
+    struct test_data t;
+    uint8_t buf[250];
+    int i;
+
+    ble_l2cap_test_util_init();
+
+    for (i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+
+    ble_l2cap_test_set_chan_test_conf(BLE_L2CAP_TEST_PSM,
+                                      BLE_L2CAP_TEST_COC_MTU, &t);
+    t.expected_num_of_ev = 3;
+
+    t.event[0].type = BLE_L2CAP_TEST_EVENT_COC_CONNECT;
+    t.event[1].type = BLE_L2CAP_TEST_EVENT_COC_SEND_DATA;
+    t.event[1].data = buf;
+    t.event[1].data_len = sizeof(buf);
+    t.event[2].type = BLE_L2CAP_TEST_EVENT_COC_DISCONNECT;
+
+    ble_l2cap_test_coc_connect(&t);
+
+    /* Shrink the peer's MPS so that the SDU, which spans several buffers,
+     * gets split over several K-frames with frame boundaries falling inside
+     * buffers.
+     */
+    t.chan[0]->peer_coc_mps = 64;
+
+    ble_l2cap_test_coc_send_data(&t);
+    ble_l2cap_test_coc_disc(&t);
+
+    TEST_ASSERT(t.expected_num_of_ev == t.event_cnt);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_l2cap_test_case_coc_send_data_queued)
+{
+    struct test_data t = {};
+    struct os_mbuf *sdu[3];
+    struct os_mbuf *om;
+    uint32_t bytes;
+    uint16_t sdus;
+    uint8_t buf[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    int rc;
+    int i;
+
+    ble_l2cap_test_util_init();
+
+    ble_l2cap_test_set_chan_test_conf(BLE_L2CAP_TEST_PSM,
+                                      BLE_L2CAP_TEST_COC_MTU, &t);
+    t.expected_num_of_ev = 3;
+
+    t.event[0].type = BLE_L2CAP_TEST_EVENT_COC_CONNECT;
+    t.event[1].type = BLE_L2CAP_EVENT_COC_TX_UNSTALLED;
+    t.event[2].type = BLE_L2CAP_TEST_EVENT_COC_DISCONNECT;
+
+    ble_l2cap_test_coc_connect(&t);
+
+    /* Without credits the SDUs stay queued. */
+    t.chan[0]->coc_tx.credits = 0;
+
+    for (i = 0; i < 3; i++) {
+        sdu[i] = os_mbuf_get_pkthdr(&sdu_os_mbuf_pool, 0);
+        TEST_ASSERT_FATAL(sdu[i] != NULL);
+        rc = os_mbuf_append(sdu[i], buf, sizeof(buf));
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    rc = ble_l2cap_send(t.chan[0], sdu[0]);
+    TEST_ASSERT(rc == 0);
+
+    /* The queue is full now. */
+    rc = ble_l2cap_send(t.chan[0], sdu[1]);
+    TEST_ASSERT(rc == BLE_HS_ESTALLED);
+
+    rc = ble_l2cap_send(t.chan[0], sdu[2]);
+    TEST_ASSERT(rc == BLE_HS_EBUSY);
+    os_mbuf_free_chain(sdu[2]);
+
+    rc = ble_l2cap_get_tx_queued(t.chan[0], &sdus, &bytes);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(sdus == 2);
+    TEST_ASSERT(bytes == 2 * sizeof(buf));
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+
+    /* Both SDUs go out as soon as credits arrive and the application gets
+     * unstalled.
+     */
+    ble_l2cap_coc_le_credits_update(2, t.chan[0]->dcid, 2);
+    TEST_ASSERT(t.event[1].handled);
+    t.event_iter++;
+
+    for (i = 0; i < 2; i++) {
+        om = ble_hs_test_util_prev_tx_dequeue_pullup();
+        TEST_ASSERT_FATAL(om != NULL);
+        TEST_ASSERT(OS_MBUF_PKTLEN(om) == sizeof(buf) + 2);
+        TEST_ASSERT(get_le16(om->om_data) == sizeof(buf));
+        TEST_ASSERT(memcmp(om->om_data + 2, buf, sizeof(buf)) == 0);
+    }
+
+    rc = ble_l2cap_get_tx_queued(t.chan[0], &sdus, &bytes);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(sdus == 0);
+    TEST_ASSERT(bytes == 0);
+
+    ble_l2cap_test_coc_disc(&t);
+
+    TEST_ASSERT(t.expected_num_of_ev == t.event_cnt);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
+TEST_CASE_SELF(ble_l2cap_test_case_coc_send_data_queued_failed)
+{
+    struct test_data t = {};
+    struct os_mbuf *msys[MYNEWT_VAL(MSYS_1_BLOCK_COUNT)];
+    struct os_mbuf *sdu[2];
+    struct os_mbuf *om;
+    uint8_t buf[300];
+    uint16_t first;
+    uint16_t room;
+    int num_msys;
+    int rc;
+    int i;
+
+    ble_l2cap_test_util_init();
+
+    ble_l2cap_test_set_chan_test_conf(BLE_L2CAP_TEST_PSM,
+                                      BLE_L2CAP_TEST_COC_MTU, &t);
+    t.expected_num_of_ev = 3;
+
+    t.event[0].type = BLE_L2CAP_TEST_EVENT_COC_CONNECT;
+    t.event[1].type = BLE_L2CAP_EVENT_COC_TX_UNSTALLED;
+    t.event[1].app_status = BLE_HS_ENOMEM;
+    t.event[2].type = BLE_L2CAP_TEST_EVENT_COC_DISCONNECT;
+
+    ble_l2cap_test_coc_connect(&t);
+
+    for (i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+
+    /* Room left in a fresh K-frame after the SDU length */
+    om = ble_hs_mbuf_l2cap_pkt();
+    TEST_ASSERT_FATAL(om != NULL);
+    room = OS_MBUF_TRAILINGSPACE(om) - 2;
+    os_mbuf_free_chain(om);
+
+    /* The first SDU spans two buffers.  Its first K-frame takes the whole
+     * first buffer and then needs more than the K-frame has room for from
+     * the second one, so it has to allocate.
+     */
+    sdu[0] = os_mbuf_get_pkthdr(&sdu_os_mbuf_pool, 0);
+    TEST_ASSERT_FATAL(sdu[0] != NULL);
+    first = OS_MBUF_TRAILINGSPACE(sdu[0]);
+    TEST_ASSERT_FATAL(first <= room && room + 20 <= sizeof(buf));
+    rc = os_mbuf_append(sdu[0], buf, room + 20);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(OS_MBUF_PKTLEN(sdu[0]) <= t.chan[0]->coc_tx.mtu);
+    t.chan[0]->peer_coc_mps = room + 12;
+
+    sdu[1] = os_mbuf_get_pkthdr(&sdu_os_mbuf_pool, 0);
+    TEST_ASSERT_FATAL(sdu[1] != NULL);
+    rc = os_mbuf_append(sdu[1], buf, 15);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Without credits the first SDU stays queued. */
+    t.chan[0]->coc_tx.credits = 0;
+    rc = ble_l2cap_send(t.chan[0], sdu[0]);
+    TEST_ASSERT(rc == 0);
+
+    /* Leave a single msys buffer; enough for a K-frame carrying a short SDU,
+     * but not for the K-frame of the first one.
+     */
+    for (num_msys = 0; num_msys < MYNEWT_VAL(MSYS_1_BLOCK_COUNT); num_msys++) {
+        msys[num_msys] = os_msys_get(0, 0);
+        if (msys[num_msys] == NULL) {
+            break;
+        }
+    }
+    TEST_ASSERT_FATAL(num_msys > 0);
+    os_mbuf_free(msys[--num_msys]);
+
+    /* The first SDU gets dropped, but that is reported with the event
+     * rather than by the call queueing the second one, which is sent.
+     */
+    t.chan[0]->coc_tx.credits = 2;
+    rc = ble_l2cap_send(t.chan[0], sdu[1]);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(t.event[1].handled);
+    t.event_iter++;
+
+    for (i = 0; i < num_msys; i++) {
+        os_mbuf_free(msys[i]);
+    }
+
+    om = ble_hs_test_util_prev_tx_dequeue_pullup();
+    TEST_ASSERT_FATAL(om != NULL);
+    TEST_ASSERT(OS_MBUF_PKTLEN(om) == 15 + 2);
+    TEST_ASSERT(get_le16(om->om_data) == 15);
+    TEST_ASSERT(memcmp(om->om_data + 2, buf, 15) == 0);
+    TEST_ASSERT(ble_hs_test_util_prev_tx_dequeue() == NULL);
+    TEST_ASSERT(t.chan[0]->coc_tx.credits == 1);
+
+    ble_l2cap_test_coc_disc(&t);
+
+    TEST_ASSERT(t.expected_num_of_ev == t.event_cnt);
+
+    ble_hs_test_util_assert_mbufs_freed(NULL);
+}
+
 TEST_CASE_SELF(ble_l2cap_test_case_coc_send_data_failed_too_big_sdu)
 {
     struct test_data t = {};
@@ -1582,6 +1811,9 @@ TEST_SUITE(ble_l2cap_test_suite)
     ble_l2cap_test_case_sig_coc_incoming_disconnect_failed();
     ble_l2cap_test_case_invalid_cid_in_disconnect_req();
     ble_l2cap_test_case_coc_send_data_succeed();
+    ble_l2cap_test_case_coc_send_data_multi_frame();
+    ble_l2cap_test_case_coc_send_data_queued();
+    ble_l2cap_test_case_coc_send_data_queued_failed();
     ble_l2cap_test_case_coc_send_data_failed_too_big_sdu();
     ble_l2cap_test_case_coc_recv_data_succeed();
     ble_l2cap_test_case_sig_coc_conn_multi();
@@ -1406,6 +1406,11 @@ struct ble_hci_vs_set_scan_cfg_cp {
     int8_t rssi_threshold;
 } __attribute__((packed));
 
+#define BLE_HCI_OCF_VS_SCHED_TRACE                      (MYNEWT_VAL(BLE_HCI_VS_OCF_OFFSET) + (0x000C))
+struct ble_hci_vs_sched_trace_cp {
+    uint8_t enable;
+} __attribute__((packed));
+
 /* Command Specific Definitions */
 /* --- Set controller to host flow control (OGF 0x03, OCF 0x0031) --- */
 #define BLE_HCI_CTLR_TO_HOST_FC_OFF         (0)
@@ -1839,6 +1844,26 @@ struct ble_hci_vs_subev_iso_hci_feedback {
     struct feedback_pkt feedback[0];
 } __attribute__((packed));
 
+#define BLE_HCI_VS_SUBEV_ID_SCHED_TRACE         (0x04)
+/* Scheduled item was executed, reason is LL state it interrupted */
+#define BLE_HCI_VS_SCHED_TRACE_EXEC             (0x01)
+/* Scheduled item was preempted, reason is type of preempting item */
+#define BLE_HCI_VS_SCHED_TRACE_PREEMPT          (0x02)
+struct ble_hci_vs_sched_trace_rec {
+    uint8_t event;
+    uint8_t sched_type;
+    uint8_t reason;
+    uint8_t reserved;
+    uint32_t start_time;
+    uint32_t timestamp;
+    uint32_t end_time;
+} __attribute__((packed));
+struct ble_hci_ev_vs_sched_trace {
+    uint16_t lost;
+    uint8_t count;
+    struct ble_hci_vs_sched_trace_rec recs[0];
+} __attribute__((packed));
+
 #define BLE_HCI_VS_SUBEV_ID_LLCP_TRACE          (0x17)
 
 /* LE sub-event codes */
@@ -859,10 +859,22 @@
 #define MYNEWT_VAL_BLE_EATT_MTU (128)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_EATT_CHAN_PER_CONN
+#define MYNEWT_VAL_BLE_EATT_CHAN_PER_CONN (1)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE
 #define MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_GATT_CACHING
+#define MYNEWT_VAL_BLE_GATT_CACHING (0)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_GATT_DB_HASH
+#define MYNEWT_VAL_BLE_GATT_DB_HASH (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GATT_DISC_ALL_CHRS
 #define MYNEWT_VAL_BLE_GATT_DISC_ALL_CHRS (MYNEWT_VAL_BLE_ROLE_CENTRAL)
 #endif
@@ -991,6 +1003,24 @@
 #define MYNEWT_VAL_BLE_HS_GAP_UNHANDLED_HCI_EVENT (0)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_HS_HCI_CMD_ASYNC_COUNT
+#define MYNEWT_VAL_BLE_HS_HCI_CMD_ASYNC_COUNT (8)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED__drr
+#define MYNEWT_VAL_BLE_HS_TX_SCHED__drr (1)
+#endif
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED__fifo
+#define MYNEWT_VAL_BLE_HS_TX_SCHED__fifo (0)
+#endif
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED
+#define MYNEWT_VAL_BLE_HS_TX_SCHED (1)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED_QUANTUM
+#define MYNEWT_VAL_BLE_HS_TX_SCHED_QUANTUM (251)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_HS_LOG_LVL
 #define MYNEWT_VAL_BLE_HS_LOG_LVL (1)
 #endif
@@ -1039,6 +1069,14 @@
 #define MYNEWT_VAL_BLE_L2CAP_COC_SDU_BUFF_COUNT (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_LEN
+#define MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_LEN (1)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER
+#define MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_L2CAP_ENHANCED_COC
 #define MYNEWT_VAL_BLE_L2CAP_ENHANCED_COC (0)
 #endif
@@ -1131,6 +1169,10 @@
 #define MYNEWT_VAL_BLE_STORE_MAX_CCCDS (8)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_STORE_MAX_GATT_CACHE
+#define MYNEWT_VAL_BLE_STORE_MAX_GATT_CACHE (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_MESH_ACCESS_LAYER_MSG
 #define MYNEWT_VAL_BLE_MESH_ACCESS_LAYER_MSG (1)
 #endif
@@ -0,0 +1,631 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+  End-to-end host throughput benchmark.
+
+  The host runs against the virtual controller in virt_ll.c, which completes
+  every packet immediately, so the numbers reflect the cost of the host and
+  the transport alone.  The following modes are measured:
+
+    notify  GATT notifications sent by the host
+    write   GATT Write Commands received by the host
+    coc     L2CAP CoC SDUs sent by the host
+
+  PDUs use the full ATT MTU (the CoC MTU for SDUs) and are spread evenly
+  over all connections.  One CSV line is printed per mode:
+
+    mode,mtu,conns,pdus,bytes,sec,bytes_per_sec,host_ns_per_pdu,ll_ns_per_pdu
+
+  where bytes counts the L2CAP payload carried, and the per-PDU costs are the
+  CPU time used by the host and the virtual controller, respectively.
+
+  Usage: nimble-linux-throughput [-m notify|write|coc] [-t mtu] [-c conns]
+                                 [-n pdus]
+*/
+
+#include <assert.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <pthread.h>
+#include "nimble/nimble_npl.h"
+#include "nimble/nimble_port.h"
+#include "host/ble_hs.h"
+#include "host/ble_l2cap.h"
+#include "virt_ll.h"
+
+#define TASK_DEFAULT_PRIORITY       1
+#define TASK_DEFAULT_STACK          NULL
+#define TASK_DEFAULT_STACK_SIZE     400
+
+#define BENCH_PSM                   (0x0080)
+#define BENCH_MAX_CONNS             MYNEWT_VAL(BLE_MAX_CONNECTIONS)
+#define BENCH_MSYS_RESERVE          (MYNEWT_VAL(MSYS_1_BLOCK_COUNT) / 2)
+
+enum bench_mode {
+    BENCH_MODE_NOTIFY,
+    BENCH_MODE_WRITE,
+    BENCH_MODE_COC,
+    BENCH_MODE_CNT,
+};
+
+static const char *const bench_mode_names[BENCH_MODE_CNT] = {
+    [BENCH_MODE_NOTIFY] = "notify",
+    [BENCH_MODE_WRITE]  = "write",
+    [BENCH_MODE_COC]    = "coc",
+};
+
+struct bench_host_call {
+    int (*fn)(intptr_t arg);
+    intptr_t arg;
+    int rc;
+};
+
+struct bench_conn {
+    uint16_t handle;
+    struct ble_l2cap_chan *chan;
+    int stalled;
+};
+
+static struct ble_npl_task s_task_host;
+static struct ble_npl_task s_task_ll;
+static struct ble_npl_task s_task_bench;
+
+static struct ble_npl_sem s_sem_sync;
+static struct ble_npl_sem s_sem_call;
+static struct ble_npl_sem s_sem_op;
+static struct ble_npl_sem s_sem_free;
+static struct ble_npl_sem s_sem_unstalled;
+static struct ble_npl_sem s_sem_done;
+
+static int s_modes = (1 << BENCH_MODE_CNT) - 1;
+static uint16_t s_mtu = 247;
+static int s_num_conns = 1;
+static uint32_t s_num_pdus = 10000;
+
+static struct bench_conn s_conns[BENCH_MAX_CONNS];
+static int s_op_status;
+static uint16_t s_val_handle;
+static uint32_t s_writes_left;
+static uint8_t s_payload[BLE_ATT_MTU_MAX];
+
+static int
+bench_chr_access(uint16_t conn_handle, uint16_t attr_handle,
+                 struct ble_gatt_access_ctxt *ctxt, void *arg)
+{
+    if (ctxt->op != BLE_GATT_ACCESS_OP_WRITE_CHR) {
+        return BLE_ATT_ERR_UNLIKELY;
+    }
+
+    if (s_writes_left > 0 && --s_writes_left == 0) {
+        ble_npl_sem_release(&s_sem_done);
+    }
+
+    return 0;
+}
+
+static const struct ble_gatt_svc_def bench_svcs[] = {
+    {
+        .type = BLE_GATT_SVC_TYPE_PRIMARY,
+        .uuid = BLE_UUID16_DECLARE(0xfff0),
+        .characteristics = (struct ble_gatt_chr_def[]) { {
+            .uuid = BLE_UUID16_DECLARE(0xfff1),
+            .access_cb = bench_chr_access,
+            .flags = BLE_GATT_CHR_F_WRITE_NO_RSP | BLE_GATT_CHR_F_NOTIFY,
+            .val_handle = &s_val_handle,
+        }, {
+            0,
+        } },
+    },
+    {
+        0,
+    },
+};
+
+static double
+now_sec(clockid_t clk)
+{
+    struct timespec ts;
+
+    clock_gettime(clk, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static clockid_t
+ll_clock(void)
+{
+    clockid_t clk;
+    int rc;
+
+    rc = pthread_getcpuclockid(s_task_ll.handle, &clk);
+    assert(rc == 0);
+
+    return clk;
+}
+
+static void
+bench_fail(const char *what, int rc)
+{
+    fprintf(stderr, "bench: %s failed; rc=%d\n", what, rc);
+    exit(1);
+}
+
+static void
+bench_op_wait(const char *what)
+{
+    ble_npl_sem_pend(&s_sem_op, BLE_NPL_TIME_FOREVER);
+    if (s_op_status != 0) {
+        bench_fail(what, s_op_status);
+    }
+}
+
+static void
+bench_on_sync(void)
+{
+    ble_npl_sem_release(&s_sem_sync);
+}
+
+static int
+bench_gap_event(struct ble_gap_event *event, void *arg)
+{
+    switch (event->type) {
+    case BLE_GAP_EVENT_CONNECT:
+        s_op_status = event->connect.status;
+        s_conns[(intptr_t)arg].handle = event->connect.conn_handle;
+        ble_npl_sem_release(&s_sem_op);
+        break;
+
+    case BLE_GAP_EVENT_DISCONNECT:
+        fprintf(stderr, "bench: unexpected disconnect; reason=%d\n",
+                event->disconnect.reason);
+        exit(1);
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static int
+bench_mtu_cb(uint16_t conn_handle, const struct ble_gatt_error *error,
+             uint16_t mtu, void *arg)
+{
+    s_op_status = error->status;
+    ble_npl_sem_release(&s_sem_op);
+
+    return 0;
+}
+
+static int
+bench_l2cap_event(struct ble_l2cap_event *event, void *arg)
+{
+    struct bench_conn *conn;
+
+    conn = &s_conns[(intptr_t)arg];
+
+    switch (event->type) {
+    case BLE_L2CAP_EVENT_COC_CONNECTED:
+        s_op_status = event->connect.status;
+        conn->chan = event->connect.chan;
+        ble_npl_sem_release(&s_sem_op);
+        break;
+
+    case BLE_L2CAP_EVENT_COC_TX_UNSTALLED:
+        if (event->tx_unstalled.status != 0) {
+            /* An SDU got dropped; the expected byte count is unreachable. */
+            bench_fail("CoC send", event->tx_unstalled.status);
+        }
+        conn->stalled = 0;
+        ble_npl_sem_release(&s_sem_unstalled);
+        break;
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static int
+bench_gap_connect(intptr_t i)
+{
+    struct ble_gap_conn_params params;
+    ble_addr_t peer;
+
+    memset(&params, 0, sizeof(params));
+    params.scan_itvl = 0x0010;
+    params.scan_window = 0x0010;
+    params.itvl_min = BLE_GAP_INITIAL_CONN_ITVL_MIN;
+    params.itvl_max = BLE_GAP_INITIAL_CONN_ITVL_MAX;
+    params.supervision_timeout = 0x0100;
+
+    peer.type = BLE_ADDR_PUBLIC;
+    memset(peer.val, 0, sizeof(peer.val));
+    peer.val[0] = i + 1;
+
+    return ble_gap_connect(BLE_OWN_ADDR_PUBLIC, &peer, BLE_HS_FOREVER,
+                           &params, bench_gap_event, (void *)i);
+}
+
+static int
+bench_exchange_mtu(intptr_t i)
+{
+    return ble_gattc_exchange_mtu(s_conns[i].handle, bench_mtu_cb, NULL);
+}
+
+static int
+bench_coc_connect(intptr_t i)
+{
+    return ble_l2cap_connect(s_conns[i].handle, BENCH_PSM, s_mtu,
+                             os_msys_get_pkthdr(0, 0), bench_l2cap_event,
+                             (void *)i);
+}
+
+static void
+bench_host_ev(struct ble_npl_event *ev)
+{
+    struct bench_host_call *call;
+
+    call = ble_npl_event_get_arg(ev);
+    call->rc = call->fn(call->arg);
+    ble_npl_sem_release(&s_sem_call);
+}
+
+/**
+ * Starts a procedure from the host task.  The host registers a procedure
+ * only after sending its request; when called from another task, the
+ * virtual controller's immediate response could arrive before that.
+ */
+static void
+bench_host_call(const char *what, int (*fn)(intptr_t), intptr_t arg)
+{
+    struct bench_host_call call;
+    struct ble_npl_event ev;
+
+    call.fn = fn;
+    call.arg = arg;
+
+    ble_npl_event_init(&ev, bench_host_ev, &call);
+    ble_npl_eventq_put(nimble_port_get_dflt_eventq(), &ev);
+    ble_npl_sem_pend(&s_sem_call, BLE_NPL_TIME_FOREVER);
+
+    if (call.rc != 0) {
+        bench_fail(what, call.rc);
+    }
+    bench_op_wait(what);
+}
+
+static void
+bench_connect(void)
+{
+    intptr_t i;
+
+    for (i = 0; i < s_num_conns; i++) {
+        bench_host_call("connect", bench_gap_connect, i);
+        bench_host_call("MTU exchange", bench_exchange_mtu, i);
+        if (s_modes & (1 << BENCH_MODE_COC)) {
+            bench_host_call("CoC connect", bench_coc_connect, i);
+        }
+    }
+}
+
+/**
+ * Allocates an mbuf holding a PDU's worth of payload, waiting for the
+ * controller to release some if too many are in flight.  The host needs
+ * mbufs of its own for headers and fragments; running out midway through a
+ * PDU makes it drop the PDU, so a reserve is left for it.
+ */
+static struct os_mbuf *
+bench_payload_get(uint16_t len)
+{
+    struct os_mbuf *om;
+    int rc;
+
+    while (1) {
+        om = NULL;
+        if (os_msys_num_free() > BENCH_MSYS_RESERVE) {
+            om = os_msys_get_pkthdr(len, 0);
+        }
+        if (om != NULL) {
+            rc = os_mbuf_append(om, s_payload, len);
+            if (rc == 0) {
+                return om;
+            }
+            os_mbuf_free_chain(om);
+        }
+
+        ble_npl_sem_pend(&s_sem_free, BLE_NPL_TIME_FOREVER);
+    }
+}
+
+static void
+bench_notify(void)
+{
+    struct os_mbuf *om;
+    uint32_t i;
+    int rc;
+
+    for (i = 0; i < s_num_pdus; ) {
+        om = bench_payload_get(s_mtu - 3);
+        rc = ble_gatts_notify_custom(s_conns[i % s_num_conns].handle,
+                                     s_val_handle, om);
+        switch (rc) {
+        case 0:
+            i++;
+            break;
+
+        case BLE_HS_ENOMEM:
+            /* The host could not get an mbuf for the headers. */
+            ble_npl_sem_pend(&s_sem_free, BLE_NPL_TIME_FOREVER);
+            break;
+
+        default:
+            bench_fail("ble_gatts_notify_custom", rc);
+        }
+    }
+}
+
+static void
+bench_write(void)
+{
+    s_writes_left = s_num_pdus;
+    virt_ll_write_start(s_val_handle, s_mtu - 3, s_num_pdus);
+}
+
+static void
+bench_coc(void)
+{
+    struct bench_conn *conn;
+    struct os_mbuf *sdu;
+    uint32_t i;
+    int stalled;
+    int rc;
+    int c;
+
+    sdu = NULL;
+    c = 0;
+    for (i = 0; i < s_num_pdus; ) {
+        conn = &s_conns[c];
+        c = (c + 1) % s_num_conns;
+        if (conn->stalled) {
+            stalled = 0;
+            for (rc = 0; rc < s_num_conns; rc++) {
+                stalled += s_conns[rc].stalled;
+            }
+            if (stalled == s_num_conns) {
+                ble_npl_sem_pend(&s_sem_unstalled, BLE_NPL_TIME_FOREVER);
+            }
+            continue;
+        }
+
+        if (sdu == NULL) {
+            sdu = bench_payload_get(s_mtu);
+        }
+
+        conn->stalled = 1;
+        rc = ble_l2cap_send(conn->chan, sdu);
+        switch (rc) {
+        case 0:
+            conn->stalled = 0;
+            /* fall through */
+        case BLE_HS_ESTALLED:
+            sdu = NULL;
+            i++;
+            break;
+
+        case BLE_HS_EBUSY:
+            break;
+
+        default:
+            bench_fail("ble_l2cap_send", rc);
+        }
+    }
+}
+
+static void
+bench_run(enum bench_mode mode)
+{
+    double ll_cpu_start;
+    double cpu_start;
+    double start;
+    double ll_cpu;
+    double cpu;
+    double sec;
+    uint64_t bytes;
+
+    if (mode == BENCH_MODE_COC) {
+        /* Each SDU is preceded by its 2-byte length. */
+        bytes = (uint64_t)s_num_pdus * (s_mtu + 2);
+    } else {
+        bytes = (uint64_t)s_num_pdus * s_mtu;
+    }
+
+    if (mode != BENCH_MODE_WRITE) {
+        virt_ll_expect(bytes, &s_sem_done);
+    }
+
+    start = now_sec(CLOCK_MONOTONIC);
+    cpu_start = now_sec(CLOCK_PROCESS_CPUTIME_ID);
+    ll_cpu_start = now_sec(ll_clock());
+
+    switch (mode) {
+    case BENCH_MODE_NOTIFY:
+        bench_notify();
+        break;
+
+    case BENCH_MODE_WRITE:
+        bench_write();
+        break;
+
+    case BENCH_MODE_COC:
+        bench_coc();
+        break;
+
+    default:
+        assert(0);
+    }
+
+    ble_npl_sem_pend(&s_sem_done, BLE_NPL_TIME_FOREVER);
+
+    sec = now_sec(CLOCK_MONOTONIC) - start;
+    ll_cpu = now_sec(ll_clock()) - ll_cpu_start;
+    cpu = now_sec(CLOCK_PROCESS_CPUTIME_ID) - cpu_start - ll_cpu;
+
+    printf("%s,%u,%d,%u,%llu,%.3f,%.0f,%.0f,%.0f\n", bench_mode_names[mode],
+           s_mtu, s_num_conns, s_num_pdus, (unsigned long long)bytes, sec,
+           bytes / sec, cpu * 1e9 / s_num_pdus, ll_cpu * 1e9 / s_num_pdus);
+}
+
+static void *
+bench_task(void *param)
+{
+    int mode;
+    int rc;
+
+    ble_npl_sem_pend(&s_sem_sync, BLE_NPL_TIME_FOREVER);
+
+    rc = ble_att_set_preferred_mtu(s_mtu);
+    if (rc != 0) {
+        bench_fail("ble_att_set_preferred_mtu", rc);
+    }
+    virt_ll_set_peer_mtu(s_mtu);
+
+    bench_connect();
+
+    printf("mode,mtu,conns,pdus,bytes,sec,bytes_per_sec,"
+           "host_ns_per_pdu,ll_ns_per_pdu\n");
+
+    for (mode = 0; mode < BENCH_MODE_CNT; mode++) {
+        if (s_modes & (1 << mode)) {
+            bench_run(mode);
+        }
+    }
+
+    exit(0);
+}
+
+static void *
+ble_host_task(void *param)
+{
+    nimble_port_run();
+    return NULL;
+}
+
+static void *
+ble_ll_task(void *param)
+{
+    virt_ll_task(param);
+    return NULL;
+}
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-m notify|write|coc] [-t mtu] [-c conns] "
+            "[-n pdus]\n", prog);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    int ret = 0;
+    int mode;
+    int opt;
+    int i;
+
+    while ((opt = getopt(argc, argv, "m:t:c:n:")) != -1) {
+        switch (opt) {
+        case 'm':
+            for (mode = 0; mode < BENCH_MODE_CNT; mode++) {
+                if (strcmp(optarg, bench_mode_names[mode]) == 0) {
+                    break;
+                }
+            }
+            if (mode == BENCH_MODE_CNT) {
+                usage(argv[0]);
+            }
+            s_modes = 1 << mode;
+            break;
+
+        case 't':
+            s_mtu = atoi(optarg);
+            break;
+
+        case 'c':
+            s_num_conns = atoi(optarg);
+            break;
+
+        case 'n':
+            s_num_pdus = strtoul(optarg, NULL, 0);
+            break;
+
+        default:
+            usage(argv[0]);
+        }
+    }
+
+    if (s_mtu < BLE_ATT_MTU_DFLT || s_mtu > BLE_ATT_MTU_MAX ||
+        s_num_conns < 1 || s_num_conns > BENCH_MAX_CONNS ||
+        s_num_pdus == 0) {
+
+        usage(argv[0]);
+    }
+
+    for (i = 0; i < sizeof(s_payload); i++) {
+        s_payload[i] = i;
+    }
+
+    ble_npl_sem_init(&s_sem_sync, 0);
+    ble_npl_sem_init(&s_sem_call, 0);
+    ble_npl_sem_init(&s_sem_op, 0);
+    ble_npl_sem_init(&s_sem_free, 0);
+    ble_npl_sem_init(&s_sem_unstalled, 0);
+    ble_npl_sem_init(&s_sem_done, 0);
+
+    nimble_port_init();
+
+    ble_hs_cfg.sync_cb = bench_on_sync;
+    virt_ll_set_free_sem(&s_sem_free);
+
+    ret = ble_gatts_count_cfg(bench_svcs);
+    assert(ret == 0);
+    ret = ble_gatts_add_svcs(bench_svcs);
+    assert(ret == 0);
+
+    ble_npl_task_init(&s_task_ll, "virt_ll", ble_ll_task,
+                      NULL, TASK_DEFAULT_PRIORITY, BLE_NPL_TIME_FOREVER,
+                      TASK_DEFAULT_STACK, TASK_DEFAULT_STACK_SIZE);
+
+    /* Create task which handles default event queue for host stack. */
+    ble_npl_task_init(&s_task_host, "ble_host", ble_host_task,
+                      NULL, TASK_DEFAULT_PRIORITY, BLE_NPL_TIME_FOREVER,
+                      TASK_DEFAULT_STACK, TASK_DEFAULT_STACK_SIZE);
+
+    ble_npl_task_init(&s_task_bench, "bench", bench_task,
+                      NULL, TASK_DEFAULT_PRIORITY, BLE_NPL_TIME_FOREVER,
+                      TASK_DEFAULT_STACK, TASK_DEFAULT_STACK_SIZE);
+
+    pthread_exit(&ret);
+}
@@ -0,0 +1,732 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Virtual controller: an in-process stand-in for the LL side of the HCI
+ * transport, used to measure the cost of the host alone.
+ *
+ * It answers the commands the host issues at startup and when connecting,
+ * completes every ACL packet as soon as it arrives, and plays just enough of
+ * the remote device to exchange the ATT MTU, accept LE credit based
+ * connections and keep returning credits.  On request it also acts as a
+ * GATT client that floods the host with Write Commands.
+ *
+ * Everything runs on the controller's own task; the transport entry points
+ * only queue packets for it.
+ */
+
+#include "syscfg/syscfg.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os/os.h"
+#include "os/endian.h"
+#include "nimble/ble.h"
+#include "nimble/hci_common.h"
+#include "nimble/transport.h"
+#include "host/ble_att.h"
+#include "host/ble_l2cap.h"
+#include "virt_ll.h"
+
+#define VIRT_LL_MAX_CONNS       MYNEWT_VAL(BLE_MAX_CONNECTIONS)
+#define VIRT_LL_CMD_QUEUE_LEN   (4)
+#define VIRT_LL_ACL_SIZE        MYNEWT_VAL(BLE_TRANSPORT_ACL_SIZE)
+#define VIRT_LL_ACL_PKTS        MYNEWT_VAL(BLE_TRANSPORT_ACL_FROM_HS_COUNT)
+#define VIRT_LL_L2CAP_HDR_SZ    (4)
+
+/* CID the peer allocates for the CoC, and its K-frame size; one K-frame fits
+ * in a single ACL packet.  The credits bound the number of K-frames the host
+ * has outstanding, i.e., the mbufs it needs per channel.
+ */
+#define VIRT_LL_COC_CID         (0x0040)
+#define VIRT_LL_COC_MPS         (VIRT_LL_ACL_SIZE - VIRT_LL_L2CAP_HDR_SZ)
+#define VIRT_LL_COC_CREDITS     (16)
+
+#define VIRT_LL_WRITE_CMD_HDR_SZ    (3)
+
+struct virt_ll_conn {
+    uint16_t handle;
+    uint16_t completed;
+    uint16_t coc_frames;
+};
+
+static struct {
+    struct ble_npl_eventq evq;
+    struct ble_npl_event cmd_ev;
+    struct ble_npl_event write_ev;
+    struct os_mqueue acl_q;
+
+    void *cmds[VIRT_LL_CMD_QUEUE_LEN];
+    uint8_t cmd_head;
+    uint8_t cmd_cnt;
+
+    struct virt_ll_conn conns[VIRT_LL_MAX_CONNS];
+    uint16_t peer_mtu;
+
+    struct ble_npl_sem *free_sem;
+    struct ble_npl_sem *expect_sem;
+    uint64_t expect_len;
+
+    /* Write Command generator. */
+    uint32_t write_left;
+    uint16_t write_pdu_len;
+    uint16_t write_off;
+    int write_conn;
+    uint8_t write_pdu[VIRT_LL_L2CAP_HDR_SZ + BLE_ATT_MTU_MAX];
+} virt_ll;
+
+static const uint8_t virt_ll_addr[6] = { 0x01, 0x00, 0x00, 0xc0, 0xde, 0xc0 };
+
+static struct virt_ll_conn *
+virt_ll_conn_find(uint16_t handle)
+{
+    int i;
+
+    for (i = 0; i < VIRT_LL_MAX_CONNS; i++) {
+        if (virt_ll.conns[i].handle == handle) {
+            return &virt_ll.conns[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Allocates an HCI event.  Every outstanding event either acknowledges a
+ * command, of which the host has at most one in flight, or completes at least
+ * one of the host's ACL buffers, so the transport's event pool can never run
+ * dry.
+ */
+static struct ble_hci_ev *
+virt_ll_evt_get(uint8_t opcode, uint8_t len)
+{
+    struct ble_hci_ev *ev;
+
+    ev = ble_transport_alloc_evt(0);
+    assert(ev != NULL);
+
+    ev->opcode = opcode;
+    ev->length = len;
+
+    return ev;
+}
+
+static void
+virt_ll_evt_tx(struct ble_hci_ev *ev)
+{
+    os_sr_t sr;
+    int rc;
+
+    OS_ENTER_CRITICAL(sr);
+    rc = ble_transport_to_hs_evt(ev);
+    OS_EXIT_CRITICAL(sr);
+
+    assert(rc == 0);
+}
+
+static void
+virt_ll_cmd_complete(uint16_t opcode, uint8_t status, const void *rsp,
+                     uint8_t rsp_len)
+{
+    struct ble_hci_ev_command_complete *cc;
+    struct ble_hci_ev *ev;
+
+    ev = virt_ll_evt_get(BLE_HCI_EVCODE_COMMAND_COMPLETE,
+                         sizeof(*cc) + rsp_len);
+    cc = (void *)ev->data;
+    cc->num_packets = 1;
+    cc->opcode = htole16(opcode);
+    cc->status = status;
+    if (rsp_len > 0) {
+        memcpy(cc->return_params, rsp, rsp_len);
+    }
+
+    virt_ll_evt_tx(ev);
+}
+
+static void
+virt_ll_cmd_status(uint16_t opcode, uint8_t status)
+{
+    struct ble_hci_ev_command_status *cs;
+    struct ble_hci_ev *ev;
+
+    ev = virt_ll_evt_get(BLE_HCI_EVCODE_COMMAND_STATUS, sizeof(*cs));
+    cs = (void *)ev->data;
+    cs->status = status;
+    cs->num_packets = 1;
+    cs->opcode = htole16(opcode);
+
+    virt_ll_evt_tx(ev);
+}
+
+static void
+virt_ll_create_conn(const struct ble_hci_le_create_conn_cp *cmd)
+{
+    struct ble_hci_ev_le_subev_conn_complete *cc;
+    struct virt_ll_conn *conn;
+    struct ble_hci_ev *ev;
+    uint16_t opcode;
+
+    opcode = BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_CREATE_CONN);
+
+    conn = virt_ll_conn_find(0);
+    if (conn == NULL) {
+        virt_ll_cmd_status(opcode, BLE_ERR_CONN_LIMIT);
+        return;
+    }
+
+    memset(conn, 0, sizeof(*conn));
+    conn->handle = (conn - virt_ll.conns) + 1;
+
+    virt_ll_cmd_status(opcode, 0);
+
+    ev = virt_ll_evt_get(BLE_HCI_EVCODE_LE_META, sizeof(*cc));
+    cc = (void *)ev->data;
+    memset(cc, 0, sizeof(*cc));
+    cc->subev_code = BLE_HCI_LE_SUBEV_CONN_COMPLETE;
+    cc->conn_handle = htole16(conn->handle);
+    cc->role = BLE_HCI_LE_CONN_COMPLETE_ROLE_MASTER;
+    cc->peer_addr_type = cmd->peer_addr_type;
+    memcpy(cc->peer_addr, cmd->peer_addr, sizeof(cc->peer_addr));
+    cc->conn_itvl = htole16(BLE_HCI_CONN_ITVL_MIN);
+    cc->supervision_timeout = htole16(BLE_HCI_CONN_SPVN_TIMEOUT_MAX);
+
+    virt_ll_evt_tx(ev);
+}
+
+static void
+virt_ll_cmd_rx(struct ble_hci_cmd *cmd)
+{
+    union {
+        struct ble_hci_ip_rd_local_ver_rp local_ver;
+        struct ble_hci_ip_rd_loc_supp_cmd_rp supp_cmd;
+        struct ble_hci_ip_rd_loc_supp_feat_rp supp_feat;
+        struct ble_hci_ip_rd_bd_addr_rp bd_addr;
+        struct ble_hci_le_rd_buf_size_rp buf_size;
+        struct ble_hci_le_rd_loc_supp_feat_rp le_supp_feat;
+        struct ble_hci_le_rand_rp rand;
+    } rsp;
+    struct ble_hci_le_create_conn_cp create_conn;
+    uint8_t rsp_len;
+    uint16_t opcode;
+
+    opcode = le16toh(cmd->opcode);
+    if (opcode == BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_CREATE_CONN)) {
+        memcpy(&create_conn, cmd->data, sizeof(create_conn));
+    }
+
+    /* The host may reuse the command buffer once it is acknowledged. */
+    ble_transport_free(cmd);
+
+    memset(&rsp, 0, sizeof(rsp));
+    rsp_len = 0;
+
+    switch (opcode) {
+    case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_LOCAL_VER):
+        rsp.local_ver.hci_ver = BLE_HCI_VER_BCS_5_0;
+        rsp.local_ver.lmp_ver = BLE_HCI_VER_BCS_5_0;
+        rsp_len = sizeof(rsp.local_ver);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_LOC_SUPP_CMD):
+        rsp_len = sizeof(rsp.supp_cmd);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_LOC_SUPP_FEAT):
+        /* LE Supported (Controller) */
+        rsp.supp_feat.features = htole64(0x0000004000000000);
+        rsp_len = sizeof(rsp.supp_feat);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_BD_ADDR):
+        memcpy(rsp.bd_addr.addr, virt_ll_addr, sizeof(rsp.bd_addr.addr));
+        rsp_len = sizeof(rsp.bd_addr);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_BUF_SIZE):
+        rsp.buf_size.data_len = htole16(VIRT_LL_ACL_SIZE);
+        rsp.buf_size.data_packets = VIRT_LL_ACL_PKTS;
+        rsp_len = sizeof(rsp.buf_size);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_LOC_SUPP_FEAT):
+        rsp_len = sizeof(rsp.le_supp_feat);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RAND):
+        rsp.rand.random_number = ((uint64_t)rand() << 32) | rand();
+        rsp_len = sizeof(rsp.rand);
+        break;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_CREATE_CONN):
+        virt_ll_create_conn(&create_conn);
+        return;
+
+    case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_REM_FEAT):
+        /* The completion event is optional for the host; skip it. */
+        virt_ll_cmd_status(opcode, 0);
+        return;
+
+    default:
+        break;
+    }
+
+    virt_ll_cmd_complete(opcode, 0, &rsp, rsp_len);
+}
+
+static void
+virt_ll_cmd_ev(struct ble_npl_event *ev)
+{
+    void *cmd;
+    os_sr_t sr;
+
+    while (1) {
+        OS_ENTER_CRITICAL(sr);
+        if (virt_ll.cmd_cnt == 0) {
+            OS_EXIT_CRITICAL(sr);
+            return;
+        }
+        cmd = virt_ll.cmds[virt_ll.cmd_head];
+        virt_ll.cmd_head = (virt_ll.cmd_head + 1) % VIRT_LL_CMD_QUEUE_LEN;
+        virt_ll.cmd_cnt--;
+        OS_EXIT_CRITICAL(sr);
+
+        virt_ll_cmd_rx(cmd);
+    }
+}
+
+/**
+ * Sends a single-fragment L2CAP PDU from the peer to the host.
+ */
+static void
+virt_ll_l2cap_tx(uint16_t handle, uint16_t cid, const void *data,
+                 uint16_t len)
+{
+    struct hci_data_hdr hdr;
+    struct os_mbuf *om;
+    uint8_t l2cap_hdr[VIRT_LL_L2CAP_HDR_SZ];
+    os_sr_t sr;
+    int rc;
+
+    assert(len + VIRT_LL_L2CAP_HDR_SZ <= VIRT_LL_ACL_SIZE);
+
+    om = ble_transport_alloc_acl_from_ll();
+    assert(om != NULL);
+
+    hdr.hdh_handle_pb_bc = htole16(handle | (BLE_HCI_PB_FIRST_FLUSH << 12));
+    hdr.hdh_len = htole16(len + VIRT_LL_L2CAP_HDR_SZ);
+    put_le16(l2cap_hdr, len);
+    put_le16(l2cap_hdr + 2, cid);
+
+    rc = os_mbuf_append(om, &hdr, sizeof(hdr));
+    rc |= os_mbuf_append(om, l2cap_hdr, sizeof(l2cap_hdr));
+    rc |= os_mbuf_append(om, data, len);
+    assert(rc == 0);
+
+    OS_ENTER_CRITICAL(sr);
+    ble_transport_to_hs_acl(om);
+    OS_EXIT_CRITICAL(sr);
+}
+
+static void
+virt_ll_att_rx(struct virt_ll_conn *conn, struct os_mbuf *om, int off)
+{
+    uint8_t rsp[3];
+    uint8_t op;
+
+    if (os_mbuf_copydata(om, off, 1, &op) != 0 || op != BLE_ATT_OP_MTU_REQ) {
+        return;
+    }
+
+    rsp[0] = BLE_ATT_OP_MTU_RSP;
+    put_le16(rsp + 1, virt_ll.peer_mtu);
+    virt_ll_l2cap_tx(conn->handle, BLE_L2CAP_CID_ATT, rsp, sizeof(rsp));
+}
+
+static void
+virt_ll_sig_rx(struct virt_ll_conn *conn, struct os_mbuf *om, int off)
+{
+    /* op, id, len, followed by psm, scid, mtu, mps, credits */
+    uint8_t req[4 + 10];
+    /* op, id, len, followed by dcid, mtu, mps, credits, result */
+    uint8_t rsp[4 + 10];
+
+    if (os_mbuf_copydata(om, off, sizeof(req), req) != 0 ||
+        req[0] != BLE_L2CAP_SIG_OP_LE_CREDIT_CONNECT_REQ) {
+        return;
+    }
+
+    rsp[0] = BLE_L2CAP_SIG_OP_LE_CREDIT_CONNECT_RSP;
+    rsp[1] = req[1];
+    put_le16(rsp + 2, 10);
+    put_le16(rsp + 4, VIRT_LL_COC_CID);
+    put_le16(rsp + 6, virt_ll.peer_mtu);
+    put_le16(rsp + 8, VIRT_LL_COC_MPS);
+    put_le16(rsp + 10, VIRT_LL_COC_CREDITS);
+    put_le16(rsp + 12, BLE_L2CAP_COC_ERR_CONNECTION_SUCCESS);
+
+    conn->coc_frames = 0;
+    virt_ll_l2cap_tx(conn->handle, BLE_L2CAP_CID_SIG, rsp, sizeof(rsp));
+}
+
+/**
+ * Hands back the credits used up by the host's K-frames, in batches.
+ */
+static void
+virt_ll_coc_rx(struct virt_ll_conn *conn)
+{
+    uint8_t credits[4 + 4];
+
+    conn->coc_frames++;
+    if (conn->coc_frames < VIRT_LL_COC_CREDITS / 2) {
+        return;
+    }
+
+    credits[0] = BLE_L2CAP_SIG_OP_FLOW_CTRL_CREDIT;
+    credits[1] = 0;
+    put_le16(credits + 2, 4);
+    put_le16(credits + 4, VIRT_LL_COC_CID);
+    put_le16(credits + 6, conn->coc_frames);
+
+    conn->coc_frames = 0;
+    virt_ll_l2cap_tx(conn->handle, BLE_L2CAP_CID_SIG, credits,
+                     sizeof(credits));
+}
+
+static void
+virt_ll_data_rx(uint16_t len)
+{
+    if (virt_ll.expect_sem == NULL) {
+        return;
+    }
+
+    if (len >= virt_ll.expect_len) {
+        ble_npl_sem_release(virt_ll.expect_sem);
+        virt_ll.expect_sem = NULL;
+    } else {
+        virt_ll.expect_len -= len;
+    }
+}
+
+static void
+virt_ll_acl_rx(struct os_mbuf *om)
+{
+    struct virt_ll_conn *conn;
+    struct hci_data_hdr hdr;
+    uint16_t handle_pb;
+    uint16_t len;
+    uint16_t cid;
+    uint8_t l2cap_hdr[VIRT_LL_L2CAP_HDR_SZ];
+    int rc;
+
+    rc = os_mbuf_copydata(om, 0, sizeof(hdr), &hdr);
+    assert(rc == 0);
+    handle_pb = le16toh(hdr.hdh_handle_pb_bc);
+    len = le16toh(hdr.hdh_len);
+
+    conn = virt_ll_conn_find(BLE_HCI_DATA_HANDLE(handle_pb));
+    if (conn == NULL) {
+        return;
+    }
+    conn->completed++;
+
+    if (BLE_HCI_DATA_PB(handle_pb) == BLE_HCI_PB_MIDDLE) {
+        /* Control PDUs are short; continuations always carry data. */
+        virt_ll_data_rx(len);
+        return;
+    }
+
+    rc = os_mbuf_copydata(om, sizeof(hdr), sizeof(l2cap_hdr), l2cap_hdr);
+    if (rc != 0) {
+        return;
+    }
+    cid = get_le16(l2cap_hdr + 2);
+
+    switch (cid) {
+    case BLE_L2CAP_CID_ATT:
+        virt_ll_att_rx(conn, om, sizeof(hdr) + sizeof(l2cap_hdr));
+        break;
+
+    case BLE_L2CAP_CID_SIG:
+        virt_ll_sig_rx(conn, om, sizeof(hdr) + sizeof(l2cap_hdr));
+        return;
+
+    case VIRT_LL_COC_CID:
+        virt_ll_coc_rx(conn);
+        break;
+
+    default:
+        return;
+    }
+
+    if (len > VIRT_LL_L2CAP_HDR_SZ) {
+        virt_ll_data_rx(len - VIRT_LL_L2CAP_HDR_SZ);
+    }
+}
+
+/**
+ * Reports the ACL packets consumed since the last call, one Number Of
+ * Completed Packets event for all connections.
+ */
+static void
+virt_ll_nocp_tx(void)
+{
+    struct ble_hci_ev_num_comp_pkts *nocp;
+    struct ble_hci_ev *ev;
+    int count;
+    int i;
+
+    count = 0;
+    for (i = 0; i < VIRT_LL_MAX_CONNS; i++) {
+        if (virt_ll.conns[i].completed > 0) {
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    ev = virt_ll_evt_get(BLE_HCI_EVCODE_NUM_COMP_PKTS,
+                         sizeof(*nocp) + count * sizeof(nocp->completed[0]));
+    nocp = (void *)ev->data;
+    nocp->count = count;
+
+    count = 0;
+    for (i = 0; i < VIRT_LL_MAX_CONNS; i++) {
+        if (virt_ll.conns[i].completed > 0) {
+            nocp->completed[count].handle = htole16(virt_ll.conns[i].handle);
+            nocp->completed[count].packets =
+                htole16(virt_ll.conns[i].completed);
+            virt_ll.conns[i].completed = 0;
+            count++;
+        }
+    }
+
+    virt_ll_evt_tx(ev);
+}
+
+static void
+virt_ll_acl_ev(struct ble_npl_event *ev)
+{
+    struct os_mbuf *om;
+
+    while ((om = os_mqueue_get(&virt_ll.acl_q)) != NULL) {
+        virt_ll_acl_rx(om);
+        os_mbuf_free_chain(om);
+    }
+
+    virt_ll_nocp_tx();
+
+    if (virt_ll.free_sem != NULL &&
+        ble_npl_sem_get_count(virt_ll.free_sem) == 0) {
+
+        ble_npl_sem_release(virt_ll.free_sem);
+    }
+}
+
+static int
+virt_ll_write_next_conn(int cur)
+{
+    int i;
+
+    for (i = 1; i <= VIRT_LL_MAX_CONNS; i++) {
+        cur = (cur + 1) % VIRT_LL_MAX_CONNS;
+        if (virt_ll.conns[cur].handle != 0) {
+            return cur;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Feeds Write Commands to the host until the transport runs out of ACL
+ * buffers; it continues when the host frees one.
+ */
+static void
+virt_ll_write_ev(struct ble_npl_event *ev)
+{
+    struct hci_data_hdr hdr;
+    struct os_mbuf *om;
+    uint16_t frag_len;
+    uint8_t pb;
+    os_sr_t sr;
+    int rc;
+
+    while (virt_ll.write_left > 0 && virt_ll.write_conn >= 0) {
+        om = ble_transport_alloc_acl_from_ll();
+        if (om == NULL) {
+            return;
+        }
+
+        frag_len = virt_ll.write_pdu_len - virt_ll.write_off;
+        if (frag_len > VIRT_LL_ACL_SIZE) {
+            frag_len = VIRT_LL_ACL_SIZE;
+        }
+        pb = virt_ll.write_off == 0 ? BLE_HCI_PB_FIRST_FLUSH :
+                                      BLE_HCI_PB_MIDDLE;
+
+        hdr.hdh_handle_pb_bc =
+            htole16(virt_ll.conns[virt_ll.write_conn].handle | (pb << 12));
+        hdr.hdh_len = htole16(frag_len);
+
+        rc = os_mbuf_append(om, &hdr, sizeof(hdr));
+        rc |= os_mbuf_append(om, virt_ll.write_pdu + virt_ll.write_off,
+                             frag_len);
+        assert(rc == 0);
+
+        virt_ll.write_off += frag_len;
+        if (virt_ll.write_off == virt_ll.write_pdu_len) {
+            virt_ll.write_off = 0;
+            virt_ll.write_left--;
+            virt_ll.write_conn = virt_ll_write_next_conn(virt_ll.write_conn);
+        }
+
+        OS_ENTER_CRITICAL(sr);
+        ble_transport_to_hs_acl(om);
+        OS_EXIT_CRITICAL(sr);
+    }
+}
+
+static os_error_t
+virt_ll_acl_put(struct os_mempool_ext *mpe, void *data, void *arg)
+{
+    os_error_t err;
+
+    err = os_memblock_put_from_cb(&mpe->mpe_mp, data);
+
+    if (virt_ll.write_left > 0) {
+        ble_npl_eventq_put(&virt_ll.evq, &virt_ll.write_ev);
+    }
+
+    return err;
+}
+
+void
+virt_ll_set_peer_mtu(uint16_t mtu)
+{
+    virt_ll.peer_mtu = mtu;
+}
+
+void
+virt_ll_set_free_sem(struct ble_npl_sem *sem)
+{
+    virt_ll.free_sem = sem;
+}
+
+void
+virt_ll_expect(uint64_t len, struct ble_npl_sem *sem)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    virt_ll.expect_len = len;
+    virt_ll.expect_sem = sem;
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+virt_ll_write_start(uint16_t attr_handle, uint16_t len, uint32_t count)
+{
+    uint8_t *pdu;
+    int i;
+
+    assert(len + VIRT_LL_WRITE_CMD_HDR_SZ <= BLE_ATT_MTU_MAX);
+
+    pdu = virt_ll.write_pdu;
+    put_le16(pdu, VIRT_LL_WRITE_CMD_HDR_SZ + len);
+    put_le16(pdu + 2, BLE_L2CAP_CID_ATT);
+    pdu[4] = BLE_ATT_OP_WRITE_CMD;
+    put_le16(pdu + 5, attr_handle);
+    for (i = 0; i < len; i++) {
+        pdu[7 + i] = i;
+    }
+
+    virt_ll.write_pdu_len = VIRT_LL_L2CAP_HDR_SZ +
+                            VIRT_LL_WRITE_CMD_HDR_SZ + len;
+    virt_ll.write_off = 0;
+    virt_ll.write_conn = virt_ll_write_next_conn(-1);
+    virt_ll.write_left = count;
+
+    ble_npl_eventq_put(&virt_ll.evq, &virt_ll.write_ev);
+}
+
+void
+virt_ll_task(void *arg)
+{
+    struct ble_npl_event *ev;
+
+    while (1) {
+        ev = ble_npl_eventq_get(&virt_ll.evq, BLE_NPL_TIME_FOREVER);
+        ble_npl_event_run(ev);
+    }
+}
+
+/* Transport APIs for LL side */
+
+void
+ble_transport_ll_init(void)
+{
+    ble_npl_eventq_init(&virt_ll.evq);
+    ble_npl_event_init(&virt_ll.cmd_ev, virt_ll_cmd_ev, NULL);
+    ble_npl_event_init(&virt_ll.write_ev, virt_ll_write_ev, NULL);
+    os_mqueue_init(&virt_ll.acl_q, virt_ll_acl_ev, NULL);
+
+    virt_ll.peer_mtu = BLE_ATT_MTU_DFLT;
+
+    ble_transport_register_put_acl_from_ll_cb(virt_ll_acl_put);
+}
+
+int
+ble_transport_to_ll_cmd_impl(void *buf)
+{
+    os_sr_t sr;
+    int idx;
+
+    OS_ENTER_CRITICAL(sr);
+    if (virt_ll.cmd_cnt == VIRT_LL_CMD_QUEUE_LEN) {
+        OS_EXIT_CRITICAL(sr);
+        return BLE_ERR_MEM_CAPACITY;
+    }
+    idx = (virt_ll.cmd_head + virt_ll.cmd_cnt) % VIRT_LL_CMD_QUEUE_LEN;
+    virt_ll.cmds[idx] = buf;
+    virt_ll.cmd_cnt++;
+    OS_EXIT_CRITICAL(sr);
+
+    ble_npl_eventq_put(&virt_ll.evq, &virt_ll.cmd_ev);
+
+    return 0;
+}
+
+int
+ble_transport_to_ll_acl_impl(struct os_mbuf *om)
+{
+    return os_mqueue_put(&virt_ll.acl_q, &virt_ll.evq, om);
+}
+
+int
+ble_transport_to_ll_iso_impl(struct os_mbuf *om)
+{
+    os_mbuf_free_chain(om);
+
+    return 0;
+}
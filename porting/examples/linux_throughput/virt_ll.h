@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_VIRT_LL_
+#define H_VIRT_LL_
+
+#include <stdint.h>
+#include "nimble/nimble_npl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Runs the virtual controller.  Never returns; intended to be the body of a
+ * dedicated task.
+ */
+void virt_ll_task(void *arg);
+
+/**
+ * Sets the ATT MTU and the L2CAP CoC MTU the emulated peer offers.
+ */
+void virt_ll_set_peer_mtu(uint16_t mtu);
+
+/**
+ * Registers a semaphore that gets released whenever the controller has
+ * consumed ACL data from the host, i.e., when mbufs have been freed.  Senders
+ * that run out of mbufs can wait on it.
+ */
+void virt_ll_set_free_sem(struct ble_npl_sem *sem);
+
+/**
+ * Arms a one-shot notification: sem is released once the controller has
+ * received len bytes of L2CAP payload on data channels (ATT PDUs other than
+ * MTU exchange, and CoC K-frames), counted from this call.
+ */
+void virt_ll_expect(uint64_t len, struct ble_npl_sem *sem);
+
+/**
+ * Makes the emulated peer send ATT Write Commands to the host, spread over
+ * all connections in turn.
+ *
+ * @param attr_handle       The attribute to write.
+ * @param len               The length of each written value.
+ * @param count             The total number of Write Commands to send.
+ */
+void virt_ll_write_start(uint16_t attr_handle, uint16_t len, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
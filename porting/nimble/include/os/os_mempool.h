@@ -36,6 +36,16 @@
 extern "C" {
 #endif
 
+/**
+ * Hosted ports where a critical section is an expensive process-wide lock can
+ * ask for a lock-free free list by defining BLE_NPL_OS_MEMPOOL_LOCKFREE.
+ */
+#if defined(BLE_NPL_OS_MEMPOOL_LOCKFREE) && BLE_NPL_OS_MEMPOOL_LOCKFREE
+#define OS_MEMPOOL_LOCKFREE     (1)
+#else
+#define OS_MEMPOOL_LOCKFREE     (0)
+#endif
+
 /**
  * A memory block structure. This simply contains a pointer to the free list
  * chain and is only used when the block is on the free list. When the block
@@ -66,12 +76,32 @@ struct os_mempool {
     uint16_t mp_min_free;
     /** Bitmap of OS_MEMPOOL_F_[...] values. */
     uint8_t mp_flags;
+    /** Number of allocation attempts that found the pool empty */
+    uint32_t mp_num_fail;
+    /**
+     * Number of msys allocations served by this pool because the smallest
+     * pool that fit the request was empty
+     */
+    uint32_t mp_num_fallback;
+    /** Number of msys allocations that specified a size */
+    uint32_t mp_num_sized;
+    /** Block bytes left unused by sized msys allocations, in total */
+    uint32_t mp_unused_bytes;
     /** Address of memory buffer used by pool */
     uintptr_t mp_membuf_addr;
     /** Next memory pool in the list. */
     STAILQ_ENTRY(os_mempool) mp_list;
     /** Head of the list of memory blocks. */
     SLIST_HEAD(,os_memblock);
+#if OS_MEMPOOL_LOCKFREE
+    /**
+     * Free list head used instead of the SLIST head: the byte offset of the
+     * first free block plus one (0 if empty) in the low word, and a counter
+     * bumped on every update in the high word so that a stale
+     * compare-and-swap cannot succeed (ABA).
+     */
+    uint64_t mp_lf_head __attribute__((aligned(8)));
+#endif
     /** Name for memory block */
     char *name;
 };
@@ -133,6 +163,15 @@ struct os_mempool_info {
     int omi_num_free;
     /** Minimum number of free memory blocks ever */
     int omi_min_free;
+    /** Number of allocation attempts that found the pool empty */
+    int omi_num_fail;
+    /** Number of msys allocations that fell back to this pool */
+    int omi_num_fallback;
+    /**
+     * Average number of bytes per block left unused by msys allocations
+     * of a known size (internal fragmentation)
+     */
+    int omi_avg_unused;
     /** Name of the memory pool */
     char omi_name[OS_MEMPOOL_INFO_NAME_LEN];
 };
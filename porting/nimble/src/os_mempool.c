@@ -116,6 +116,103 @@ os_mempool_guard_check(const struct os_mempool *mp, void *start)
 #define os_mempool_guard_check(mp, start)
 #endif
 
+#if OS_MEMPOOL_LOCKFREE
+static inline struct os_memblock *
+os_mempool_lf_block(const struct os_mempool *mp, uint64_t head)
+{
+    uint32_t off;
+
+    off = (uint32_t)head;
+    if (off == 0) {
+        return NULL;
+    }
+
+    return (struct os_memblock *)(mp->mp_membuf_addr + off - 1);
+}
+
+static inline uint64_t
+os_mempool_lf_head(const struct os_mempool *mp,
+                   const struct os_memblock *block, uint64_t prev_head)
+{
+    uint64_t off;
+
+    off = 0;
+    if (block != NULL) {
+        off = (uintptr_t)block - mp->mp_membuf_addr + 1;
+    }
+
+    return (((prev_head >> 32) + 1) << 32) | off;
+}
+
+static struct os_memblock *
+os_mempool_lf_pop(struct os_mempool *mp)
+{
+    struct os_memblock *block;
+    struct os_memblock *next;
+    uint64_t head;
+    uint16_t num_free;
+    uint16_t min_free;
+
+    head = __atomic_load_n(&mp->mp_lf_head, __ATOMIC_ACQUIRE);
+    do {
+        block = os_mempool_lf_block(mp, head);
+        if (block == NULL) {
+            __atomic_fetch_add(&mp->mp_num_fail, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+
+        /* The block may be taken and reused by another thread before the
+         * swap below; the value read is then garbage, but the swap fails
+         * because the head counter has moved on.
+         */
+        next = __atomic_load_n(&SLIST_NEXT(block, mb_next), __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&mp->mp_lf_head, &head,
+                                          os_mempool_lf_head(mp, next, head),
+                                          true, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_ACQUIRE));
+
+    /* Count after taking the block so mp_num_free never underflows. */
+    num_free = __atomic_sub_fetch(&mp->mp_num_free, 1, __ATOMIC_RELAXED);
+    min_free = __atomic_load_n(&mp->mp_min_free, __ATOMIC_RELAXED);
+    while (num_free < min_free &&
+           !__atomic_compare_exchange_n(&mp->mp_min_free, &min_free, num_free,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+
+    return block;
+}
+
+static void
+os_mempool_lf_push(struct os_mempool *mp, struct os_memblock *block)
+{
+    uint64_t head;
+
+    /* Count before publishing the block; see os_mempool_lf_pop(). */
+    __atomic_fetch_add(&mp->mp_num_free, 1, __ATOMIC_RELAXED);
+
+    head = __atomic_load_n(&mp->mp_lf_head, __ATOMIC_RELAXED);
+    do {
+        __atomic_store_n(&SLIST_NEXT(block, mb_next),
+                         os_mempool_lf_block(mp, head), __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&mp->mp_lf_head, &head,
+                                          os_mempool_lf_head(mp, block, head),
+                                          true, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
+}
+#endif
+
+static struct os_memblock *
+os_mempool_free_first(const struct os_mempool *mp)
+{
+#if OS_MEMPOOL_LOCKFREE
+    return os_mempool_lf_block(mp, __atomic_load_n(&mp->mp_lf_head,
+                                                   __ATOMIC_ACQUIRE));
+#else
+    return SLIST_FIRST(mp);
+#endif
+}
+
 static os_error_t
 os_mempool_init_internal(struct os_mempool *mp, uint16_t blocks,
                          uint32_t block_size, void *membuf, char *name,
@@ -149,6 +246,10 @@ os_mempool_init_internal(struct os_mempool *mp, uint16_t blocks,
     mp->mp_num_free = blocks;
     mp->mp_min_free = blocks;
     mp->mp_flags = flags;
+    mp->mp_num_fail = 0;
+    mp->mp_num_fallback = 0;
+    mp->mp_num_sized = 0;
+    mp->mp_unused_bytes = 0;
     mp->mp_num_blocks = blocks;
     mp->mp_membuf_addr = (uintptr_t)membuf;
     mp->name = name;
@@ -174,6 +275,13 @@ os_mempool_init_internal(struct os_mempool *mp, uint16_t blocks,
         SLIST_NEXT(block_ptr, mb_next) = NULL;
     }
 
+#if OS_MEMPOOL_LOCKFREE
+    mp->mp_lf_head = 0;
+    if (blocks > 0) {
+        mp->mp_lf_head = os_mempool_lf_head(mp, membuf, 0);
+    }
+#endif
+
     STAILQ_INSERT_TAIL(&g_os_mempool_list, mp, mp_list);
 
     return OS_OK;
@@ -259,6 +367,10 @@ os_mempool_clear(struct os_mempool *mp)
     /* cleanup the memory pool structure */
     mp->mp_num_free = mp->mp_num_blocks;
     mp->mp_min_free = mp->mp_num_blocks;
+    mp->mp_num_fail = 0;
+    mp->mp_num_fallback = 0;
+    mp->mp_num_sized = 0;
+    mp->mp_unused_bytes = 0;
     os_mempool_poison(mp, (void *)mp->mp_membuf_addr);
     os_mempool_guard(mp, (void *)mp->mp_membuf_addr);
     SLIST_FIRST(mp) = (void *)mp->mp_membuf_addr;
@@ -280,6 +392,13 @@ os_mempool_clear(struct os_mempool *mp)
     /* Last one in the list should be NULL */
     SLIST_NEXT(block_ptr, mb_next) = NULL;
 
+#if OS_MEMPOOL_LOCKFREE
+    mp->mp_lf_head = 0;
+    if (mp->mp_num_blocks > 0) {
+        mp->mp_lf_head = os_mempool_lf_head(mp, SLIST_FIRST(mp), 0);
+    }
+#endif
+
     return OS_OK;
 }
 
@@ -289,7 +408,10 @@ os_mempool_is_sane(const struct os_mempool *mp)
     struct os_memblock *block;
 
     /* Verify that each block in the free list belongs to the mempool. */
-    SLIST_FOREACH(block, mp, mb_next) {
+    for (block = os_mempool_free_first(mp);
+         block != NULL;
+         block = SLIST_NEXT(block, mb_next)) {
+
         if (!os_memblock_from(mp, block)) {
             return false;
         }
@@ -327,7 +449,9 @@ os_memblock_from(const struct os_mempool *mp, const void *block_addr)
 void *
 os_memblock_get(struct os_mempool *mp)
 {
+#if !OS_MEMPOOL_LOCKFREE
     os_sr_t sr;
+#endif
     struct os_memblock *block;
 
     os_trace_api_u32(OS_TRACE_ID_MEMBLOCK_GET, (uintptr_t)mp);
@@ -335,6 +459,9 @@ os_memblock_get(struct os_mempool *mp)
     /* Check to make sure they passed in a memory pool (or something) */
     block = NULL;
     if (mp) {
+#if OS_MEMPOOL_LOCKFREE
+        block = os_mempool_lf_pop(mp);
+#else
         OS_ENTER_CRITICAL(sr);
         /* Check for any free */
         if (mp->mp_num_free) {
@@ -349,8 +476,11 @@ os_memblock_get(struct os_mempool *mp)
             if (mp->mp_min_free > mp->mp_num_free) {
                 mp->mp_min_free = mp->mp_num_free;
             }
+        } else {
+            mp->mp_num_fail++;
         }
         OS_EXIT_CRITICAL(sr);
+#endif
 
         if (block) {
             os_mempool_poison_check(mp, block);
@@ -366,7 +496,9 @@ os_memblock_get(struct os_mempool *mp)
 os_error_t
 os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr)
 {
+#if !OS_MEMPOOL_LOCKFREE
     os_sr_t sr;
+#endif
     struct os_memblock *block;
 
     os_trace_api_u32x2(OS_TRACE_ID_MEMBLOCK_PUT_FROM_CB, (uintptr_t)mp,
@@ -376,6 +508,9 @@ os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr)
     os_mempool_poison(mp, block_addr);
 
     block = (struct os_memblock *)block_addr;
+#if OS_MEMPOOL_LOCKFREE
+    os_mempool_lf_push(mp, block);
+#else
     OS_ENTER_CRITICAL(sr);
 
     /* Chain current free list pointer to this block; make this block head */
@@ -387,6 +522,7 @@ os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr)
     mp->mp_num_free++;
 
     OS_EXIT_CRITICAL(sr);
+#endif
 
     os_trace_api_ret_u32(OS_TRACE_ID_MEMBLOCK_PUT_FROM_CB, (uint32_t)OS_OK);
 
@@ -398,7 +534,7 @@ os_memblock_put(struct os_mempool *mp, void *block_addr)
 {
     struct os_mempool_ext *mpe;
     os_error_t ret;
-#if MYNEWT_VAL(OS_MEMPOOL_CHECK)
+#if MYNEWT_VAL(OS_MEMPOOL_CHECK) && !OS_MEMPOOL_LOCKFREE
     struct os_memblock *block;
     int sr;
 #endif
@@ -419,11 +555,23 @@ os_memblock_put(struct os_mempool *mp, void *block_addr)
     /*
      * Check for duplicate free.
      */
+#if OS_MEMPOOL_LOCKFREE
+    /* Other threads push and pop without a critical section, so the free
+     * list cannot be walked safely; a popped block may already be reused.
+     * Only catch a duplicate free that would overfill the pool.
+     */
+    assert(__atomic_load_n(&mp->mp_num_free, __ATOMIC_RELAXED) <
+           mp->mp_num_blocks);
+#else
     OS_ENTER_CRITICAL(sr);
-    SLIST_FOREACH(block, mp, mb_next) {
+    for (block = SLIST_FIRST(mp);
+         block != NULL;
+         block = SLIST_NEXT(block, mb_next)) {
+
         assert(block != (struct os_memblock *)block_addr);
     }
     OS_EXIT_CRITICAL(sr);
+#endif
 
 #endif
     /* If this is an extended mempool with a put callback, call the callback
@@ -445,6 +593,24 @@ done:
     return ret;
 }
 
+static void
+os_mempool_info_fill(const struct os_mempool *mp, struct os_mempool_info *omi)
+{
+    omi->omi_block_size = mp->mp_block_size;
+    omi->omi_num_blocks = mp->mp_num_blocks;
+    omi->omi_num_free = mp->mp_num_free;
+    omi->omi_min_free = mp->mp_min_free;
+    omi->omi_num_fail = mp->mp_num_fail;
+    omi->omi_num_fallback = mp->mp_num_fallback;
+    if (mp->mp_num_sized != 0) {
+        omi->omi_avg_unused = mp->mp_unused_bytes / mp->mp_num_sized;
+    } else {
+        omi->omi_avg_unused = 0;
+    }
+    omi->omi_name[0] = '\0';
+    strncat(omi->omi_name, mp->name, sizeof(omi->omi_name) - 1);
+}
+
 struct os_mempool *
 os_mempool_info_get_next(struct os_mempool *mp, struct os_mempool_info *omi)
 {
@@ -460,12 +626,7 @@ os_mempool_info_get_next(struct os_mempool *mp, struct os_mempool_info *omi)
         return (NULL);
     }
 
-    omi->omi_block_size = cur->mp_block_size;
-    omi->omi_num_blocks = cur->mp_num_blocks;
-    omi->omi_num_free = cur->mp_num_free;
-    omi->omi_min_free = cur->mp_min_free;
-    omi->omi_name[0] = '\0';
-    strncat(omi->omi_name, cur->name, sizeof(omi->omi_name) - 1);
+    os_mempool_info_fill(cur, omi);
 
     return (cur);
 }
@@ -484,12 +645,7 @@ os_mempool_get(const char *mempool_name, struct os_mempool_info *info)
     }
 
     if (mp != NULL && info != NULL) {
-        info->omi_block_size = mp->mp_block_size;
-        info->omi_num_blocks = mp->mp_num_blocks;
-        info->omi_num_free = mp->mp_num_free;
-        info->omi_min_free = mp->mp_min_free;
-        info->omi_name[0] = '\0';
-        strncat(info->omi_name, mp->name, sizeof(info->omi_name) - 1);
+        os_mempool_info_fill(mp, info);
     }
 
     return mp;
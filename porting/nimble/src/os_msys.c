@@ -86,6 +86,23 @@ os_msys_reset(void)
     STAILQ_INIT(&g_msys_pool_list);
 }
 
+/**
+ * Adds to a per-pool allocation statistic.
+ */
+static void
+os_msys_stat_add(uint32_t *stat, uint32_t val)
+{
+#if OS_MEMPOOL_LOCKFREE
+    __atomic_fetch_add(stat, val, __ATOMIC_RELAXED);
+#else
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    *stat += val;
+    OS_EXIT_CRITICAL(sr);
+#endif
+}
+
 static struct os_mbuf_pool *os_msys_find_pool(uint16_t dsize);
 
 static struct os_mbuf_pool *
@@ -94,14 +111,28 @@ os_msys_find_biggest_pool(void)
     return os_msys_find_pool(0xFFFF);
 }
 
+/**
+ * Finds the pool to allocate a dsize-byte block from.  Pools are kept sorted
+ * from smallest to biggest, so the first pool that fits is the best match.
+ * If that pool is exhausted, the next bigger pool with free blocks is used.
+ * If no pool that fits has free blocks, the biggest pool with free blocks is
+ * returned and the caller has to make do with a chain.
+ */
 static struct os_mbuf_pool *
 os_msys_find_pool(uint16_t dsize)
 {
     struct os_mbuf_pool *pool;
     struct os_mbuf_pool *pool_with_free_blocks = NULL;
+    struct os_mbuf_pool *best_fit = NULL;
+    struct os_mbuf_pool *last = NULL;
     uint16_t pool_free_blocks;
 
     STAILQ_FOREACH(pool, &g_msys_pool_list, omp_next) {
+        if (best_fit == NULL && dsize <= pool->omp_databuf_len) {
+            best_fit = pool;
+        }
+        last = pool;
+
         pool_free_blocks = pool->omp_pool->mp_num_free;
         if (pool_free_blocks != 0) {
             pool_with_free_blocks = pool;
@@ -111,9 +142,34 @@ os_msys_find_pool(uint16_t dsize)
         }
     }
 
+    if (pool_with_free_blocks == NULL) {
+        if (last != NULL) {
+            pool = best_fit != NULL ? best_fit : last;
+            os_msys_stat_add(&pool->omp_pool->mp_num_fail, 1);
+        }
+    } else if (best_fit != NULL && pool_with_free_blocks != best_fit) {
+        os_msys_stat_add(&pool_with_free_blocks->omp_pool->mp_num_fallback, 1);
+    }
+
     return pool_with_free_blocks;
 }
 
+/**
+ * Records how much of a block an allocation of a known size leaves unused.
+ */
+static void
+os_msys_account(struct os_mbuf *m, uint16_t dsize)
+{
+    struct os_mempool *mp;
+
+    mp = m->om_omp->omp_pool;
+
+    os_msys_stat_add(&mp->mp_num_sized, 1);
+    if (m->om_omp->omp_databuf_len > dsize) {
+        os_msys_stat_add(&mp->mp_unused_bytes,
+                         m->om_omp->omp_databuf_len - dsize);
+    }
+}
 
 struct os_mbuf *
 os_msys_get(uint16_t dsize, uint16_t leadingspace)
@@ -135,6 +191,9 @@ os_msys_get(uint16_t dsize, uint16_t leadingspace)
     }
 
     m = os_mbuf_get(pool, leadingspace);
+    if (m != NULL && dsize != 0) {
+        os_msys_account(m, dsize);
+    }
     return (m);
 err:
     return (NULL);
@@ -163,6 +222,9 @@ os_msys_get_pkthdr(uint16_t dsize, uint16_t user_hdr_len)
     }
 
     m = os_mbuf_get_pkthdr(pool, user_hdr_len);
+    if (m != NULL && dsize != 0) {
+        os_msys_account(m, dsize + total_pkthdr_len);
+    }
     return (m);
 err:
     return (NULL);
@@ -33,6 +33,13 @@ extern "C" {
 
 #define BLE_NPL_OS_ALIGNMENT (__WORDSIZE / 8)
 
+/* Critical sections are a process-wide mutex on this port, so memory pools
+ * use a lock-free free list instead.  Define to 0 to go back to locking.
+ */
+#ifndef BLE_NPL_OS_MEMPOOL_LOCKFREE
+#define BLE_NPL_OS_MEMPOOL_LOCKFREE (1)
+#endif
+
 #define BLE_NPL_TIME_FOREVER UINT32_MAX
 
 struct ble_npl_eventq *ble_npl_eventq_dflt_get(void);
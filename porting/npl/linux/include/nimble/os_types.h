@@ -38,18 +38,39 @@ struct ble_npl_event {
     uint8_t ev_queued;
     ble_npl_event_fn *ev_cb;
     void *ev_arg;
+    struct ble_npl_event *ev_next;
+    /* Queue the event was last put on. */
+    struct ble_npl_eventq *ev_evq;
 };
 
 struct ble_npl_eventq {
-    void *q;
+    /* Consumer end; protected by lock. */
+    struct ble_npl_event *head;
+    /* Producer end; updated atomically. */
+    struct ble_npl_event *tail;
+    struct ble_npl_event stub;
+    /* Events taken off the list by remove but not consumed yet, oldest
+     * first; protected by lock.
+     */
+    struct ble_npl_event *ready;
+    struct ble_npl_event *ready_tail;
+    pthread_mutex_t lock;
+    /* Futex word, bumped on every put. */
+    uint32_t seq;
+    /* Set while a consumer may be sleeping on seq. */
+    uint32_t waiters;
+    int32_t count;
 };
 
 struct ble_npl_callout {
     struct ble_npl_event c_ev;
     struct ble_npl_eventq *c_evq;
     uint32_t c_ticks;
-    timer_t c_timer;
+    /* Timer wheel slot linkage. */
+    struct ble_npl_callout *c_next;
+    struct ble_npl_callout **c_pprev;
     bool c_active;
+    bool c_inited;
 };
 
 struct ble_npl_mutex {
@@ -18,35 +18,359 @@
  */
 
 #include <assert.h>
-#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
-
-#include <time.h>
-#include <signal.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
 
 #include "nimble/nimble_npl.h"
 
+/*
+ * Callouts
+ *
+ * All callouts share one hierarchical timer wheel serviced by a single
+ * thread.  The thread sleeps on a CLOCK_MONOTONIC timerfd armed for the next
+ * wheel event and posts expired callouts straight to their event queues.
+ *
+ * The wheel has BLE_NPL_CALLOUT_LEVELS levels of BLE_NPL_CALLOUT_SLOTS slots.
+ * Level 0 has one tick (1 ms) per slot; each following level is coarser by a
+ * factor of BLE_NPL_CALLOUT_SLOTS.  A callout is placed in the first level
+ * whose span covers its remaining time and moves down a level each time the
+ * level below wraps.  Expiries beyond the top level are parked in the top
+ * level and re-inserted when reached.
+ */
+
+#define BLE_NPL_CALLOUT_SLOT_BITS   6
+#define BLE_NPL_CALLOUT_SLOTS       (1 << BLE_NPL_CALLOUT_SLOT_BITS)
+#define BLE_NPL_CALLOUT_SLOT_MASK   (BLE_NPL_CALLOUT_SLOTS - 1)
+#define BLE_NPL_CALLOUT_LEVELS      4
+
+/* Largest delta that can be placed in the top level without aliasing. */
+#define BLE_NPL_CALLOUT_MAX_DELTA \
+    ((1u << (BLE_NPL_CALLOUT_SLOT_BITS * BLE_NPL_CALLOUT_LEVELS)) - \
+     (1u << (BLE_NPL_CALLOUT_SLOT_BITS * (BLE_NPL_CALLOUT_LEVELS - 1))))
+
+struct ble_npl_callout_wheel {
+    pthread_mutex_t lock;
+    pthread_t thread;
+    int tfd;
+
+    /* Next tick to be processed. */
+    ble_npl_time_t now;
+    /* Tick the timerfd is armed for; valid if armed is set. */
+    ble_npl_time_t armed_at;
+    bool armed;
+    uint32_t num_pending;
+
+    /* Expired callouts without an event queue, run by the timer thread. */
+    struct ble_npl_callout *run;
+
+    struct ble_npl_callout *slots[BLE_NPL_CALLOUT_LEVELS]
+                                 [BLE_NPL_CALLOUT_SLOTS];
+};
+
+static struct ble_npl_callout_wheel wheel = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .tfd = -1,
+};
+
+static pthread_once_t wheel_once = PTHREAD_ONCE_INIT;
+
+static inline bool
+ble_npl_callout_time_before_eq(ble_npl_time_t a, ble_npl_time_t b)
+{
+    return (ble_npl_stime_t)(a - b) <= 0;
+}
+
 static void
-ble_npl_callout_timer_cb(union sigval sv)
+ble_npl_callout_link(struct ble_npl_callout *c)
 {
-    struct ble_npl_callout *c = (struct ble_npl_callout *)sv.sival_ptr;
+    struct ble_npl_callout **slot;
+    uint32_t delta;
+    uint32_t exp;
+    int level;
 
-    assert(c);
+    if (ble_npl_callout_time_before_eq(c->c_ticks, wheel.now)) {
+        /* Already due; fire on the next processed tick. */
+        exp = wheel.now;
+        level = 0;
+    } else {
+        delta = c->c_ticks - wheel.now;
+        if (delta > BLE_NPL_CALLOUT_MAX_DELTA) {
+            delta = BLE_NPL_CALLOUT_MAX_DELTA;
+        }
+        exp = wheel.now + delta;
 
-    c->c_active = false;
+        level = 0;
+        while (level < BLE_NPL_CALLOUT_LEVELS - 1 &&
+               delta >= (1u << (BLE_NPL_CALLOUT_SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+    }
+
+    slot = &wheel.slots[level][(exp >> (BLE_NPL_CALLOUT_SLOT_BITS * level)) &
+                               BLE_NPL_CALLOUT_SLOT_MASK];
+
+    c->c_next = *slot;
+    if (c->c_next != NULL) {
+        c->c_next->c_pprev = &c->c_next;
+    }
+    c->c_pprev = slot;
+    *slot = c;
+}
+
+static void
+ble_npl_callout_unlink(struct ble_npl_callout *c)
+{
+    *c->c_pprev = c->c_next;
+    if (c->c_next != NULL) {
+        c->c_next->c_pprev = c->c_pprev;
+    }
+    c->c_next = NULL;
+    c->c_pprev = NULL;
+}
+
+/**
+ * Re-inserts all callouts from the current slot of each level above 0 whose
+ * lower level has just wrapped.  Must be called with wheel.now at a level 0
+ * wrap point.
+ */
+static void
+ble_npl_callout_cascade(void)
+{
+    struct ble_npl_callout *list;
+    struct ble_npl_callout *c;
+    uint32_t idx;
+    int level;
+
+    for (level = 1; level < BLE_NPL_CALLOUT_LEVELS; level++) {
+        idx = (wheel.now >> (BLE_NPL_CALLOUT_SLOT_BITS * level)) &
+              BLE_NPL_CALLOUT_SLOT_MASK;
+
+        list = wheel.slots[level][idx];
+        wheel.slots[level][idx] = NULL;
+
+        while ((c = list) != NULL) {
+            list = c->c_next;
+            ble_npl_callout_link(c);
+        }
+
+        if (idx != 0) {
+            break;
+        }
+    }
+}
+
+static void
+ble_npl_callout_fire(struct ble_npl_callout *c)
+{
     if (c->c_evq) {
+        c->c_active = false;
+        wheel.num_pending--;
         ble_npl_eventq_put(c->c_evq, &c->c_ev);
-    } else {
-        c->c_ev.ev_cb(&c->c_ev);
+        return;
+    }
+
+    /*
+     * No queue to post to; the callback is run by the timer thread without
+     * the lock held.  The callout stays linked until then so that it can
+     * still be stopped.
+     */
+    c->c_next = wheel.run;
+    if (c->c_next != NULL) {
+        c->c_next->c_pprev = &c->c_next;
     }
+    c->c_pprev = &wheel.run;
+    wheel.run = c;
+}
+
+/**
+ * Processes all ticks up to and including the specified one.
+ */
+static void
+ble_npl_callout_advance(ble_npl_time_t to)
+{
+    struct ble_npl_callout **slot;
+    struct ble_npl_callout *c;
+
+    while (ble_npl_callout_time_before_eq(wheel.now, to)) {
+        if (wheel.num_pending == 0) {
+            /* Nothing to walk over. */
+            wheel.now = to + 1;
+            break;
+        }
+
+        if ((wheel.now & BLE_NPL_CALLOUT_SLOT_MASK) == 0) {
+            ble_npl_callout_cascade();
+        }
+
+        slot = &wheel.slots[0][wheel.now & BLE_NPL_CALLOUT_SLOT_MASK];
+        while ((c = *slot) != NULL) {
+            ble_npl_callout_unlink(c);
+
+            if (ble_npl_callout_time_before_eq(c->c_ticks, wheel.now)) {
+                ble_npl_callout_fire(c);
+            } else {
+                /* Parked beyond the wheel span; not due yet. */
+                ble_npl_callout_link(c);
+            }
+        }
+
+        wheel.now++;
+    }
+}
+
+/**
+ * Returns the next tick at which the wheel has work: either a level 0 expiry
+ * or a cascade of a non-empty higher level slot.
+ */
+static bool
+ble_npl_callout_next_tick(ble_npl_time_t *out_tick)
+{
+    ble_npl_time_t tick;
+    ble_npl_time_t best;
+    uint32_t idx;
+    uint32_t base;
+    bool found;
+    int level;
+    int shift;
+    int i;
+
+    if (wheel.num_pending == 0) {
+        return false;
+    }
+
+    found = false;
+    best = 0;
+
+    /* Level 0 holds exactly the expiries in [now, now + SLOTS). */
+    for (i = 0; i < BLE_NPL_CALLOUT_SLOTS; i++) {
+        if (wheel.slots[0][(wheel.now + i) & BLE_NPL_CALLOUT_SLOT_MASK]) {
+            best = wheel.now + i;
+            found = true;
+            break;
+        }
+    }
+
+    for (level = 1; level < BLE_NPL_CALLOUT_LEVELS; level++) {
+        shift = BLE_NPL_CALLOUT_SLOT_BITS * level;
+
+        /*
+         * Slots cascade when the tick reaches their start.  If the current
+         * tick is a slot start it has not been processed yet, so the current
+         * slot is still pending.
+         */
+        base = (wheel.now + (1u << shift) - 1) >> shift;
+
+        for (i = 0; i < BLE_NPL_CALLOUT_SLOTS; i++) {
+            idx = (base + i) & BLE_NPL_CALLOUT_SLOT_MASK;
+            if (wheel.slots[level][idx] != NULL) {
+                tick = (base + i) << shift;
+                if (!found || ble_npl_callout_time_before_eq(tick, best)) {
+                    best = tick;
+                    found = true;
+                }
+                break;
+            }
+        }
+    }
+
+    *out_tick = best;
+    return found;
+}
+
+/**
+ * Arms the timerfd for the next wheel event.  Must be called with the wheel
+ * locked.
+ */
+static void
+ble_npl_callout_rearm(void)
+{
+    struct itimerspec its;
+    ble_npl_stime_t delta;
+    ble_npl_time_t tick;
+
+    memset(&its, 0, sizeof(its));
+
+    wheel.armed = ble_npl_callout_next_tick(&tick);
+    if (wheel.armed) {
+        wheel.armed_at = tick;
+
+        delta = tick - ble_npl_time_get();
+        if (delta <= 0) {
+            /* A zero value would disarm the timer. */
+            its.it_value.tv_nsec = 1;
+        } else {
+            its.it_value.tv_sec = delta / 1000;
+            its.it_value.tv_nsec = (delta % 1000) * 1000000;
+        }
+    }
+
+    timerfd_settime(wheel.tfd, 0, &its, NULL);
+}
+
+static void *
+ble_npl_callout_thread(void *arg)
+{
+    struct ble_npl_callout *c;
+    uint64_t expirations;
+    ssize_t rc;
+
+    while (1) {
+        rc = read(wheel.tfd, &expirations, sizeof(expirations));
+        if (rc < 0 && errno != EINTR && errno != EAGAIN) {
+            break;
+        }
+
+        pthread_mutex_lock(&wheel.lock);
+
+        ble_npl_callout_advance(ble_npl_time_get());
+
+        while ((c = wheel.run) != NULL) {
+            ble_npl_callout_unlink(c);
+            c->c_active = false;
+            wheel.num_pending--;
+
+            pthread_mutex_unlock(&wheel.lock);
+            c->c_ev.ev_cb(&c->c_ev);
+            pthread_mutex_lock(&wheel.lock);
+        }
+
+        ble_npl_callout_rearm();
+
+        pthread_mutex_unlock(&wheel.lock);
+    }
+
+    return NULL;
+}
+
+static void
+ble_npl_callout_wheel_init(void)
+{
+    wheel.now = ble_npl_time_get();
+
+    wheel.tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    assert(wheel.tfd >= 0);
+
+    pthread_create(&wheel.thread, NULL, ble_npl_callout_thread, NULL);
 }
 
 void
 ble_npl_callout_init(struct ble_npl_callout *c, struct ble_npl_eventq *evq,
                      ble_npl_event_fn *ev_cb, void *ev_arg)
 {
-    struct sigevent event;
+    pthread_once(&wheel_once, ble_npl_callout_wheel_init);
+
+    pthread_mutex_lock(&wheel.lock);
+
+    /* Reinitializing an armed callout; take it off the wheel first. */
+    if (c->c_inited && c->c_active) {
+        ble_npl_callout_unlink(c);
+        wheel.num_pending--;
+    }
 
     /* Initialize the callout. */
     memset(c, 0, sizeof(*c));
@@ -54,48 +378,53 @@ ble_npl_callout_init(struct ble_npl_callout *c, struct ble_npl_eventq *evq,
     c->c_ev.ev_arg = ev_arg;
     c->c_evq = evq;
     c->c_active = false;
+    c->c_inited = true;
 
-    event.sigev_notify = SIGEV_THREAD;
-    event.sigev_value.sival_ptr = c; // put callout obj in signal args
-    event.sigev_notify_function = ble_npl_callout_timer_cb;
-    event.sigev_notify_attributes = NULL;
-
-    timer_create(CLOCK_REALTIME, &event, &c->c_timer);
+    pthread_mutex_unlock(&wheel.lock);
 }
 
 bool
 ble_npl_callout_is_active(struct ble_npl_callout *c)
 {
-    /* TODO: seek native posix method to determine whether timer_t is active.
-     * TODO: fix bug where one-shot timer is still active after fired.
-     */
     return c->c_active;
 }
 
 int
 ble_npl_callout_inited(struct ble_npl_callout *c)
 {
-    return (c->c_timer != NULL);
+    return c->c_inited;
 }
 
 ble_npl_error_t
 ble_npl_callout_reset(struct ble_npl_callout *c, ble_npl_time_t ticks)
 {
-    struct itimerspec its;
-
     if (ticks == 0) {
         ticks = 1;
     }
 
-    c->c_ticks = ble_npl_time_get() + ticks;
+    pthread_mutex_lock(&wheel.lock);
+
+    if (c->c_active) {
+        ble_npl_callout_unlink(c);
+        wheel.num_pending--;
+    }
+
+    if (wheel.num_pending == 0) {
+        /* Idle wheel; skip ahead instead of walking the elapsed ticks. */
+        wheel.now = ble_npl_time_get();
+    }
 
-    its.it_interval.tv_sec = 0;
-    its.it_interval.tv_nsec = 0; // one shot
-    its.it_value.tv_sec = (ticks / 1000);
-    its.it_value.tv_nsec = (ticks % 1000) * 1000000; // expiration
-    its.it_value.tv_nsec %= 1000000000;
+    c->c_ticks = ble_npl_time_get() + ticks;
     c->c_active = true;
-    timer_settime(c->c_timer, 0, &its, NULL);
+    wheel.num_pending++;
+    ble_npl_callout_link(c);
+
+    if (!wheel.armed ||
+        !ble_npl_callout_time_before_eq(wheel.armed_at, c->c_ticks)) {
+        ble_npl_callout_rearm();
+    }
+
+    pthread_mutex_unlock(&wheel.lock);
 
     return BLE_NPL_OK;
 }
@@ -103,10 +432,7 @@ ble_npl_callout_reset(struct ble_npl_callout *c, ble_npl_time_t ticks)
 int
 ble_npl_callout_queued(struct ble_npl_callout *c)
 {
-    struct itimerspec its;
-    timer_gettime(c->c_timer, &its);
-
-    return ((its.it_value.tv_sec > 0) || (its.it_value.tv_nsec > 0));
+    return c->c_active;
 }
 
 void
@@ -116,13 +442,15 @@ ble_npl_callout_stop(struct ble_npl_callout *c)
         return;
     }
 
-    struct itimerspec its;
-    its.it_interval.tv_sec = 0;
-    its.it_interval.tv_nsec = 0;
-    its.it_value.tv_sec = 0;
-    its.it_value.tv_nsec = 0;
-    timer_settime(c->c_timer, 0, &its, NULL);
-    c->c_active = false;
+    pthread_mutex_lock(&wheel.lock);
+
+    if (c->c_active) {
+        ble_npl_callout_unlink(c);
+        wheel.num_pending--;
+        c->c_active = false;
+    }
+
+    pthread_mutex_unlock(&wheel.lock);
 }
 
 ble_npl_time_t
@@ -140,17 +468,14 @@ ble_npl_callout_set_arg(struct ble_npl_callout *co, void *arg)
 uint32_t
 ble_npl_callout_remaining_ticks(struct ble_npl_callout *co, ble_npl_time_t now)
 {
-    ble_npl_time_t rt;
-    uint32_t exp;
-    struct itimerspec its;
-
-    timer_gettime(co->c_timer, &its);
+    ble_npl_stime_t rt;
 
-    exp = its.it_value.tv_sec * 1000;
+    if (!co->c_active) {
+        return 0;
+    }
 
-    if (exp > now) {
-        rt = exp - now;
-    } else {
+    rt = co->c_ticks - now;
+    if (rt < 0) {
         rt = 0;
     }
 
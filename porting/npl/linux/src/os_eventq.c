@@ -0,0 +1,381 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include "nimble/nimble_npl.h"
+
+/*
+ * Event queue
+ *
+ * Each queue is an intrusive multi-producer, single-consumer list linked
+ * through ble_npl_event.ev_next (Vyukov's MPSC queue).  Producers append with
+ * a single atomic exchange on the tail and never block; consumers are
+ * serialized by a mutex which is uncontended in the usual one-task-per-queue
+ * setup.  Idle consumers sleep on a futex word that producers bump after each
+ * put.
+ *
+ * ev_queued holds the event state.  A producer marks the event as being
+ * pushed before linking it and as queued once it is reachable, so remove
+ * never looks for an event that is not linked yet.  Remove takes the consumer
+ * lock and moves the events ahead of the removed one to the ready list, from
+ * which consumers take them first; the removed event is unlinked for good and
+ * may be reinitialized or put on any queue.
+ */
+
+#define BLE_NPL_EV_IDLE         0
+#define BLE_NPL_EV_PUSHING      1
+#define BLE_NPL_EV_QUEUED       2
+
+static struct ble_npl_eventq dflt_evq;
+static pthread_once_t dflt_evq_once = PTHREAD_ONCE_INIT;
+
+static void
+ble_npl_eventq_futex_wait(uint32_t *addr, uint32_t val,
+                          const struct timespec *tmo)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, tmo, NULL, 0);
+}
+
+static void
+ble_npl_eventq_futex_wake(uint32_t *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+static void
+ble_npl_eventq_push(struct ble_npl_eventq *evq, struct ble_npl_event *ev)
+{
+    struct ble_npl_event *prev;
+
+    __atomic_store_n(&ev->ev_next, NULL, __ATOMIC_RELAXED);
+    prev = __atomic_exchange_n(&evq->tail, ev, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->ev_next, ev, __ATOMIC_RELEASE);
+}
+
+/**
+ * Unlinks the oldest event from the queue.  Must be called with the consumer
+ * lock held.  May return NULL while a producer is half way through a push;
+ * the producer wakes the consumer once the push completes.
+ */
+static struct ble_npl_event *
+ble_npl_eventq_pop(struct ble_npl_eventq *evq)
+{
+    struct ble_npl_event *head;
+    struct ble_npl_event *next;
+
+    head = evq->head;
+    next = __atomic_load_n(&head->ev_next, __ATOMIC_ACQUIRE);
+
+    if (head == &evq->stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        evq->head = next;
+        head = next;
+        next = __atomic_load_n(&next->ev_next, __ATOMIC_ACQUIRE);
+    }
+
+    if (next != NULL) {
+        evq->head = next;
+        return head;
+    }
+
+    if (head != __atomic_load_n(&evq->tail, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+
+    /* Last element; requeue the stub so the element can be unlinked. */
+    ble_npl_eventq_push(evq, &evq->stub);
+
+    next = __atomic_load_n(&head->ev_next, __ATOMIC_ACQUIRE);
+    if (next != NULL) {
+        evq->head = next;
+        return head;
+    }
+
+    return NULL;
+}
+
+/**
+ * Waits for a producer that has linked the event to finish the put.
+ */
+static uint8_t
+ble_npl_eventq_wait_pushed(struct ble_npl_event *ev)
+{
+    uint8_t state;
+
+    while ((state = __atomic_load_n(&ev->ev_queued, __ATOMIC_ACQUIRE)) ==
+           BLE_NPL_EV_PUSHING) {
+        sched_yield();
+    }
+
+    return state;
+}
+
+/**
+ * Marks an event unlinked from the queue as no longer queued.  Must be called
+ * with the consumer lock held.
+ */
+static void
+ble_npl_eventq_unlinked(struct ble_npl_eventq *evq, struct ble_npl_event *ev)
+{
+    ble_npl_eventq_wait_pushed(ev);
+    __atomic_store_n(&ev->ev_queued, BLE_NPL_EV_IDLE, __ATOMIC_RELEASE);
+    __atomic_fetch_sub(&evq->count, 1, __ATOMIC_RELAXED);
+}
+
+static struct ble_npl_event *
+ble_npl_eventq_try_get(struct ble_npl_eventq *evq)
+{
+    struct ble_npl_event *ev;
+
+    pthread_mutex_lock(&evq->lock);
+
+    ev = evq->ready;
+    if (ev != NULL) {
+        evq->ready = ev->ev_next;
+        if (evq->ready == NULL) {
+            evq->ready_tail = NULL;
+        }
+    } else {
+        ev = ble_npl_eventq_pop(evq);
+    }
+
+    if (ev != NULL) {
+        ble_npl_eventq_unlinked(evq, ev);
+    }
+
+    pthread_mutex_unlock(&evq->lock);
+
+    return ev;
+}
+
+static void
+ble_npl_eventq_dflt_init(void)
+{
+    ble_npl_eventq_init(&dflt_evq);
+}
+
+struct ble_npl_eventq *
+ble_npl_eventq_dflt_get(void)
+{
+    pthread_once(&dflt_evq_once, ble_npl_eventq_dflt_init);
+
+    return &dflt_evq;
+}
+
+void
+ble_npl_eventq_init(struct ble_npl_eventq *evq)
+{
+    memset(evq, 0, sizeof(*evq));
+    pthread_mutex_init(&evq->lock, NULL);
+    evq->head = &evq->stub;
+    __atomic_store_n(&evq->tail, &evq->stub, __ATOMIC_RELEASE);
+}
+
+bool
+ble_npl_eventq_is_empty(struct ble_npl_eventq *evq)
+{
+    return __atomic_load_n(&evq->count, __ATOMIC_ACQUIRE) == 0;
+}
+
+int
+ble_npl_eventq_inited(const struct ble_npl_eventq *evq)
+{
+    return (evq->tail != NULL);
+}
+
+void
+ble_npl_eventq_put(struct ble_npl_eventq *evq, struct ble_npl_event *ev)
+{
+    uint8_t state;
+
+    state = BLE_NPL_EV_IDLE;
+    if (!__atomic_compare_exchange_n(&ev->ev_queued, &state,
+                                     BLE_NPL_EV_PUSHING, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        /* Already queued */
+        return;
+    }
+
+    ev->ev_evq = evq;
+    __atomic_fetch_add(&evq->count, 1, __ATOMIC_RELAXED);
+    ble_npl_eventq_push(evq, ev);
+    __atomic_store_n(&ev->ev_queued, BLE_NPL_EV_QUEUED, __ATOMIC_RELEASE);
+
+    /* Only the first put after a consumer went to sleep pays for the wake
+     * up syscall.
+     */
+    __atomic_fetch_add(&evq->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&evq->waiters, __ATOMIC_SEQ_CST) != 0 &&
+        __atomic_exchange_n(&evq->waiters, 0, __ATOMIC_SEQ_CST) != 0) {
+        ble_npl_eventq_futex_wake(&evq->seq);
+    }
+}
+
+struct ble_npl_event *
+ble_npl_eventq_get(struct ble_npl_eventq *evq, ble_npl_time_t tmo)
+{
+    struct ble_npl_event *ev;
+    struct timespec ts;
+    ble_npl_time_t deadline;
+    ble_npl_stime_t remaining;
+    uint32_t seq;
+
+    deadline = ble_npl_time_get() + tmo;
+
+    while (1) {
+        seq = __atomic_load_n(&evq->seq, __ATOMIC_SEQ_CST);
+
+        ev = ble_npl_eventq_try_get(evq);
+        if (ev != NULL || tmo == 0) {
+            return ev;
+        }
+
+        __atomic_store_n(&evq->waiters, 1, __ATOMIC_SEQ_CST);
+
+        if (tmo == BLE_NPL_TIME_FOREVER) {
+            ble_npl_eventq_futex_wait(&evq->seq, seq, NULL);
+        } else {
+            remaining = deadline - ble_npl_time_get();
+            if (remaining <= 0) {
+                return NULL;
+            }
+
+            ts.tv_sec = remaining / 1000;
+            ts.tv_nsec = (remaining % 1000) * 1000000;
+            ble_npl_eventq_futex_wait(&evq->seq, seq, &ts);
+        }
+    }
+}
+
+void
+ble_npl_eventq_run(struct ble_npl_eventq *evq)
+{
+    struct ble_npl_event *ev;
+
+    ev = ble_npl_eventq_get(evq, BLE_NPL_TIME_FOREVER);
+    ble_npl_event_run(ev);
+}
+
+/*
+ * Event
+ */
+
+void
+ble_npl_event_init(struct ble_npl_event *ev, ble_npl_event_fn *fn,
+                   void *arg)
+{
+    memset(ev, 0, sizeof(*ev));
+    ev->ev_cb = fn;
+    ev->ev_arg = arg;
+}
+
+bool
+ble_npl_event_is_queued(struct ble_npl_event *ev)
+{
+    return __atomic_load_n(&ev->ev_queued, __ATOMIC_ACQUIRE) !=
+           BLE_NPL_EV_IDLE;
+}
+
+void *
+ble_npl_event_get_arg(struct ble_npl_event *ev)
+{
+    return ev->ev_arg;
+}
+
+void
+ble_npl_event_set_arg(struct ble_npl_event *ev, void *arg)
+{
+    ev->ev_arg = arg;
+}
+
+void
+ble_npl_event_run(struct ble_npl_event *ev)
+{
+    assert(ev->ev_cb != NULL);
+
+    ev->ev_cb(ev);
+}
+
+void
+ble_npl_eventq_remove(struct ble_npl_eventq *evq, struct ble_npl_event *ev)
+{
+    struct ble_npl_event **pprev;
+    struct ble_npl_event *prev;
+    struct ble_npl_event *cur;
+
+    pthread_mutex_lock(&evq->lock);
+
+    if ((ble_npl_eventq_wait_pushed(ev) != BLE_NPL_EV_QUEUED) ||
+        (ev->ev_evq != evq)) {
+        pthread_mutex_unlock(&evq->lock);
+        return;
+    }
+
+    /* Already taken off the list by an earlier remove? */
+    prev = NULL;
+    for (pprev = &evq->ready; *pprev != NULL; pprev = &(*pprev)->ev_next) {
+        if (*pprev == ev) {
+            *pprev = ev->ev_next;
+            if (evq->ready_tail == ev) {
+                evq->ready_tail = prev;
+            }
+            ble_npl_eventq_unlinked(evq, ev);
+            pthread_mutex_unlock(&evq->lock);
+            return;
+        }
+        prev = *pprev;
+    }
+
+    /* Move everything ahead of it to the ready list.  The event is linked,
+     * but a producer that put an earlier event may still be linking that
+     * one.
+     */
+    while ((cur = ble_npl_eventq_pop(evq)) != ev) {
+        if (cur == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        cur->ev_next = NULL;
+        if (evq->ready_tail != NULL) {
+            evq->ready_tail->ev_next = cur;
+        } else {
+            evq->ready = cur;
+        }
+        evq->ready_tail = cur;
+    }
+
+    ble_npl_eventq_unlinked(evq, ev);
+
+    pthread_mutex_unlock(&evq->lock);
+}
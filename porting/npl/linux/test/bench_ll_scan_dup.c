@@ -0,0 +1,190 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Lookup benchmark for the controller's scan duplicate filter.
+
+  Three workloads are run against a full table of 8, 64 and 512 advertisers:
+    hit    - random advertisers that are all in the table,
+    cycle  - all advertisers in turn, so each one is the least recently used
+             when it is seen again (the worst case for the list),
+    miss   - advertisers never seen before, each evicting the oldest entry.
+  The time per lookup is printed, along with TSC cycles on x86 hosts.
+  bench_ll_scan_dup.exe uses the hash table (BLE_LL_SCAN_DUP_HASH), and
+  bench_ll_scan_dup_list.exe walks the LRU list.
+
+  Usage: bench_ll_scan_dup.exe [lookups]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "test_util.h"
+#include "os/os.h"
+#include "ble_ll_scan_dup_priv.h"
+
+#define BENCH_MAX_ENTRIES       (512)
+#define BENCH_NUM_KEYS          (4096)
+
+struct bench_key {
+    uint8_t type;
+    uint8_t addr[6];
+};
+
+static struct ble_ll_scan_dup_table s_tbl;
+static os_membuf_t s_tbl_mem[BLE_LL_SCAN_DUP_TABLE_MEM_SIZE(BENCH_MAX_ENTRIES)];
+#if MYNEWT_VAL(BLE_LL_SCAN_DUP_HASH)
+static struct ble_ll_scan_dup_bucket s_tbl_buckets[BENCH_MAX_ENTRIES];
+#define BENCH_BUCKETS           s_tbl_buckets
+#define BENCH_MODE              "hash"
+#else
+#define BENCH_BUCKETS           NULL
+#define BENCH_MODE              "list"
+#endif
+
+static struct bench_key s_known[BENCH_MAX_ENTRIES];
+static struct bench_key s_keys[BENCH_NUM_KEYS];
+
+extern void os_mempool_module_init(void);
+
+static void
+bench_random_key(struct bench_key *key)
+{
+    int i;
+
+    key->type = rand() & 0x01;
+    for (i = 0; i < 6; i++) {
+        key->addr[i] = rand();
+    }
+}
+
+static uint64_t
+bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+bench_fill(int num_entries)
+{
+    int created;
+    int i;
+
+    os_mempool_unregister(&s_tbl.pool);
+    ble_ll_scan_dup_table_init(&s_tbl, s_tbl_mem, num_entries,
+                               BENCH_BUCKETS, num_entries, "bench_tbl");
+
+    for (i = 0; i < num_entries; i++) {
+        bench_random_key(&s_known[i]);
+        ble_ll_scan_dup_table_get(&s_tbl, s_known[i].type, s_known[i].addr,
+                                  &created);
+    }
+}
+
+static void
+bench_make_keys(const char *workload, int num_entries)
+{
+    int i;
+
+    for (i = 0; i < BENCH_NUM_KEYS; i++) {
+        if (!strcmp(workload, "hit")) {
+            s_keys[i] = s_known[rand() % num_entries];
+        } else if (!strcmp(workload, "cycle")) {
+            s_keys[i] = s_known[i % num_entries];
+        } else {
+            bench_random_key(&s_keys[i]);
+        }
+    }
+}
+
+static void
+bench_run(const char *workload, int num_entries, int num_lookups)
+{
+    const struct bench_key *key;
+    uint64_t cycles;
+    double elapsed;
+    double start;
+    int created;
+    int i;
+
+    bench_fill(num_entries);
+    bench_make_keys(workload, num_entries);
+
+    start = now_sec();
+    cycles = bench_cycles();
+
+    for (i = 0; i < num_lookups; i++) {
+        key = &s_keys[i % BENCH_NUM_KEYS];
+        ble_ll_scan_dup_table_get(&s_tbl, key->type, key->addr, &created);
+    }
+
+    cycles = bench_cycles() - cycles;
+    elapsed = now_sec() - start;
+
+    printf("entries=%-3d %-5s %8.1f ns %8.0f cyc\n", num_entries, workload,
+           elapsed * 1e9 / num_lookups, (double)cycles / num_lookups);
+}
+
+int main(int argc, char **argv)
+{
+    static const int sizes[] = { 8, 64, 512 };
+    static const char *workloads[] = { "hit", "cycle", "miss" };
+    int num_lookups = 1000000;
+    int i;
+    int j;
+
+    if (argc > 1) {
+        num_lookups = atoi(argv[1]);
+    }
+
+    VerifyOrQuit(num_lookups > 0, "bench: invalid number of lookups");
+
+    os_mempool_module_init();
+    srand(1);
+
+    printf("scan dup filter (" BENCH_MODE ") lookups=%d (per lookup)\n",
+           num_lookups);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (j = 0; j < sizeof(workloads) / sizeof(workloads[0]); j++) {
+            bench_run(workloads[j], sizes[i], num_lookups);
+        }
+    }
+
+    return PASS;
+}
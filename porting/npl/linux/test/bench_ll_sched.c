@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Insertion benchmark for the controller's scheduler queue.
+
+  The queue is filled with items that leave no gap large enough for another
+  one, as with many connections and periodic trains scheduled back to back.
+  Each insertion is what the scheduler does with interrupts disabled, so
+  besides the mean the 99.9th percentile and the worst time of a single
+  insertion are printed, in TSC cycles on x86 hosts.  The mean time in ns
+  includes removing the item again; the worst time also includes whatever
+  preempted the benchmark on the host.  Three workloads are run:
+    tail     - an item that cannot preempt anything and may be delayed as
+               long as needed, which ends up after the last item (the worst
+               case for the list),
+    random   - an item that has to start on time at a random place, which
+               fails as it overlaps an item there,
+    preempt  - as random, but asking a preemption callback whether the item
+               it overlaps can be preempted.
+  bench_ll_sched.exe uses the tree (BLE_LL_SCHED_TREE), and
+  bench_ll_sched_list.exe the plain list.
+
+  Usage: bench_ll_sched.exe [insertions]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "test_util.h"
+#include "os/os.h"
+#include "ble_ll_sched_q_priv.h"
+
+#define BENCH_MAX_ITEMS         (4096)
+#define BENCH_MAX_INSERTS       (1000000)
+
+/* Items are 20 ticks long with 2 ticks between them */
+#define BENCH_ITEM_TICKS        (20)
+#define BENCH_ITEM_PERIOD       (22)
+
+static struct ble_ll_sched_q s_q;
+static struct ble_ll_sched_item s_items[BENCH_MAX_ITEMS];
+static struct ble_ll_sched_item s_sch;
+static uint64_t s_cycles[BENCH_MAX_INSERTS];
+
+static int
+bench_preempt_cb(struct ble_ll_sched_item *sch, struct ble_ll_sched_item *item)
+{
+    return 0;
+}
+
+static uint64_t
+bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int
+bench_cmp_cycles(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+bench_fill(int num_items)
+{
+    struct ble_ll_sched_item *first;
+    int i;
+
+    ble_ll_sched_q_init(&s_q);
+
+    for (i = 0; i < num_items; i++) {
+        s_items[i].start_time = i * BENCH_ITEM_PERIOD;
+        s_items[i].end_time = s_items[i].start_time + BENCH_ITEM_TICKS;
+        VerifyOrQuit(ble_ll_sched_q_insert(&s_q, &s_items[i], 0, NULL,
+                                           &first) == 0,
+                     "bench: fill failed");
+    }
+}
+
+static void
+bench_run(const char *workload, int num_items, int num_inserts)
+{
+    struct ble_ll_sched_item *first;
+    uint64_t cycles;
+    uint64_t c;
+    double start;
+    double elapsed;
+    int i;
+
+    bench_fill(num_items);
+    srand(1);
+
+    cycles = 0;
+    start = now_sec();
+
+    for (i = 0; i < num_inserts; i++) {
+        memset(&s_sch, 0, sizeof(s_sch));
+
+        if (!strcmp(workload, "tail")) {
+            s_sch.start_time = 1;
+        } else {
+            s_sch.start_time = (rand() % num_items) * BENCH_ITEM_PERIOD + 1;
+        }
+        s_sch.end_time = s_sch.start_time + BENCH_ITEM_TICKS;
+
+        c = bench_cycles();
+
+        if (!strcmp(workload, "tail")) {
+            ble_ll_sched_q_insert(&s_q, &s_sch, 0x7fffffff, NULL, &first);
+        } else if (!strcmp(workload, "random")) {
+            ble_ll_sched_q_insert(&s_q, &s_sch, 0, NULL, &first);
+        } else {
+            ble_ll_sched_q_insert(&s_q, &s_sch, 0, bench_preempt_cb, &first);
+        }
+
+        c = bench_cycles() - c;
+        cycles += c;
+        s_cycles[i] = c;
+
+        if (s_sch.enqueued) {
+            ble_ll_sched_q_remove(&s_q, &s_sch);
+        }
+    }
+
+    elapsed = now_sec() - start;
+
+    qsort(s_cycles, num_inserts, sizeof(s_cycles[0]), bench_cmp_cycles);
+
+    printf("items=%-4d %-7s  mean %8.1f ns %8.0f cyc  "
+           "p99.9 %8llu cyc  max %8llu cyc\n",
+           num_items, workload, elapsed * 1e9 / num_inserts,
+           (double)cycles / num_inserts,
+           (unsigned long long)s_cycles[num_inserts * 999 / 1000],
+           (unsigned long long)s_cycles[num_inserts - 1]);
+}
+
+int main(int argc, char **argv)
+{
+    static const int sizes[] = { 16, 256, 4096 };
+    static const char *workloads[] = { "tail", "random", "preempt" };
+    int num_inserts = 100000;
+    int i;
+    int j;
+
+    if (argc > 1) {
+        num_inserts = atoi(argv[1]);
+    }
+
+    VerifyOrQuit((num_inserts > 0) && (num_inserts <= BENCH_MAX_INSERTS),
+                 "bench: invalid number of insertions");
+
+    printf("scheduler queue (%s) insertions=%d\n",
+           MYNEWT_VAL(BLE_LL_SCHED_TREE) ? "tree" : "list", num_inserts);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (j = 0; j < sizeof(workloads) / sizeof(workloads[0]); j++) {
+            bench_run(workloads[j], sizes[i], num_inserts);
+        }
+    }
+
+    return PASS;
+}
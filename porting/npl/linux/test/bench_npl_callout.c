@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Stress benchmark for the ble_npl_callout implementation.
+
+  A large number of callouts is armed with random timeouts and the lateness
+  of each expiry, as seen by the task draining the event queue, is recorded
+  together with the CPU time consumed by the process.  The same workload is
+  run against a reference built the way the port used to be (one POSIX
+  timer_create() SIGEV_THREAD timer per callout).
+
+  Usage: bench_npl_callout.exe [callouts] [max timeout ms]
+*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "test_util.h"
+#include "nimble/nimble_npl.h"
+
+struct bench_timer {
+    struct ble_npl_callout co;
+    timer_t ref_timer;
+    uint64_t deadline_us;
+    uint64_t fired_us;
+};
+
+struct bench_result {
+    double mean_us;
+    double p99_us;
+    double max_us;
+    double cpu_ms;
+};
+
+static struct ble_npl_eventq s_eventq;
+
+static uint64_t
+now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static double
+cpu_ms(void)
+{
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e3 +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e3;
+}
+
+static void
+on_callout(struct ble_npl_event *ev)
+{
+    struct bench_timer *t = ble_npl_event_get_arg(ev);
+
+    t->fired_us = now_us();
+}
+
+static void
+ref_timer_cb(union sigval sv)
+{
+    struct bench_timer *t = sv.sival_ptr;
+
+    ble_npl_eventq_put(&s_eventq, &t->co.c_ev);
+}
+
+static void
+ref_timer_arm(struct bench_timer *t, uint32_t ms)
+{
+    struct itimerspec its;
+    struct sigevent sev;
+
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD;
+    sev.sigev_value.sival_ptr = t;
+    sev.sigev_notify_function = ref_timer_cb;
+    SuccessOrQuit(timer_create(CLOCK_MONOTONIC, &sev, &t->ref_timer),
+                  "bench: timer_create failed");
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = ms / 1000;
+    its.it_value.tv_nsec = (ms % 1000) * 1000000;
+    timer_settime(t->ref_timer, 0, &its, NULL);
+}
+
+static int
+cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void
+run_bench(int num_timers, uint32_t max_ms, bool use_ref,
+          struct bench_result *res)
+{
+    struct bench_timer *timers;
+    struct ble_npl_event *ev;
+    uint64_t *late;
+    uint64_t sum;
+    double cpu_start;
+    uint32_t ms;
+    int i;
+
+    timers = calloc(num_timers, sizeof(*timers));
+    late = calloc(num_timers, sizeof(*late));
+    VerifyOrQuit(timers != NULL && late != NULL, "bench: out of memory");
+
+    srand(1);
+    cpu_start = cpu_ms();
+
+    for (i = 0; i < num_timers; i++) {
+        ms = 1 + rand() % max_ms;
+
+        /* The callout event is reused by the reference timers too. */
+        ble_npl_callout_init(&timers[i].co, &s_eventq, on_callout,
+                             &timers[i]);
+        timers[i].deadline_us = now_us() + ms * 1000ULL;
+
+        if (use_ref) {
+            ref_timer_arm(&timers[i], ms);
+        } else {
+            ble_npl_callout_reset(&timers[i].co, ms);
+        }
+    }
+
+    for (i = 0; i < num_timers; i++) {
+        ev = ble_npl_eventq_get(&s_eventq, BLE_NPL_TIME_FOREVER);
+        VerifyOrQuit(ev != NULL, "bench: no event");
+        ble_npl_event_run(ev);
+    }
+
+    res->cpu_ms = cpu_ms() - cpu_start;
+
+    sum = 0;
+    for (i = 0; i < num_timers; i++) {
+        VerifyOrQuit(timers[i].fired_us != 0, "bench: callout did not fire");
+
+        /*
+         * Ticks are whole milliseconds, so an expiry may legitimately be up
+         * to one tick early relative to the microsecond deadline.
+         */
+        if (timers[i].fired_us > timers[i].deadline_us) {
+            late[i] = timers[i].fired_us - timers[i].deadline_us;
+        }
+        sum += late[i];
+
+        if (use_ref) {
+            timer_delete(timers[i].ref_timer);
+        }
+    }
+
+    qsort(late, num_timers, sizeof(*late), cmp_u64);
+
+    res->mean_us = (double)sum / num_timers;
+    res->p99_us = late[(num_timers * 99) / 100];
+    res->max_us = late[num_timers - 1];
+
+    free(late);
+    free(timers);
+}
+
+static void
+print_result(const char *name, const struct bench_result *res)
+{
+    printf("%-14s lateness mean %8.1f us  p99 %8.1f us  max %8.1f us  "
+           "cpu %8.1f ms\n", name, res->mean_us, res->p99_us, res->max_us,
+           res->cpu_ms);
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_result ref_res;
+    struct bench_result npl_res;
+    int num_timers = 10000;
+    int max_ms = 2000;
+
+    if (argc > 1) {
+        num_timers = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        max_ms = atoi(argv[2]);
+    }
+
+    VerifyOrQuit(num_timers > 0 && max_ms > 0,
+                 "bench: invalid arguments");
+
+    ble_npl_eventq_init(&s_eventq);
+
+    run_bench(num_timers, max_ms, true, &ref_res);
+    run_bench(num_timers, max_ms, false, &npl_res);
+
+    printf("callouts=%d max timeout=%d ms\n", num_timers, max_ms);
+    print_result("posix timers:", &ref_res);
+    print_result("npl callout:", &npl_res);
+
+    return PASS;
+}
@@ -0,0 +1,242 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Throughput benchmark for the ble_npl_eventq implementation.
+
+  A number of producer threads post events to a single queue drained by one
+  consumer.  The same workload is run against a reference queue built the way
+  the port used to be (heap-allocated list node per put, recursive mutex and
+  condition variable), and the events/sec of both are printed.
+
+  Usage: bench_npl_eventq.exe [producers] [events per producer]
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "test_util.h"
+#include "nimble/nimble_npl.h"
+
+#define BENCH_MAX_PRODUCERS     (16)
+
+struct ref_node {
+    struct ref_node *next;
+    struct ble_npl_event *ev;
+};
+
+struct ref_queue {
+    struct ref_node *head;
+    struct ref_node *tail;
+    pthread_mutex_t mutex;
+    pthread_cond_t condv;
+};
+
+struct bench_producer {
+    pthread_t thread;
+    struct ble_npl_event *events;
+    int num_events;
+    bool use_ref;
+};
+
+static struct ble_npl_eventq s_eventq;
+static struct ref_queue s_ref_queue;
+static volatile int s_start;
+
+static void
+ref_queue_init(struct ref_queue *q)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&q->mutex, &attr);
+    pthread_cond_init(&q->condv, NULL);
+    q->head = NULL;
+    q->tail = NULL;
+}
+
+static void
+ref_queue_put(struct ref_queue *q, struct ble_npl_event *ev)
+{
+    struct ref_node *node;
+
+    node = malloc(sizeof(*node));
+    VerifyOrQuit(node != NULL, "bench: out of memory");
+    node->next = NULL;
+    node->ev = ev;
+
+    pthread_mutex_lock(&q->mutex);
+    if (q->tail == NULL) {
+        q->head = node;
+    } else {
+        q->tail->next = node;
+    }
+    q->tail = node;
+    pthread_cond_signal(&q->condv);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+static struct ble_npl_event *
+ref_queue_get(struct ref_queue *q)
+{
+    struct ble_npl_event *ev;
+    struct ref_node *node;
+
+    pthread_mutex_lock(&q->mutex);
+    while (q->head == NULL) {
+        pthread_cond_wait(&q->condv, &q->mutex);
+    }
+    node = q->head;
+    q->head = node->next;
+    if (q->head == NULL) {
+        q->tail = NULL;
+    }
+    pthread_mutex_unlock(&q->mutex);
+
+    ev = node->ev;
+    free(node);
+
+    return ev;
+}
+
+static void
+on_event(struct ble_npl_event *ev)
+{
+}
+
+static void *
+producer_thread(void *arg)
+{
+    struct bench_producer *p = arg;
+    int i;
+
+    while (!s_start) {
+    }
+
+    for (i = 0; i < p->num_events; i++) {
+        if (p->use_ref) {
+            ref_queue_put(&s_ref_queue, &p->events[i]);
+        } else {
+            ble_npl_eventq_put(&s_eventq, &p->events[i]);
+        }
+    }
+
+    return NULL;
+}
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double
+run_bench(int num_producers, int num_events, bool use_ref)
+{
+    struct bench_producer producers[BENCH_MAX_PRODUCERS];
+    struct ble_npl_event *ev;
+    double start;
+    double elapsed;
+    int total;
+    int i;
+    int j;
+
+    s_start = 0;
+
+    for (i = 0; i < num_producers; i++) {
+        producers[i].events = calloc(num_events, sizeof(struct ble_npl_event));
+        VerifyOrQuit(producers[i].events != NULL, "bench: out of memory");
+        for (j = 0; j < num_events; j++) {
+            ble_npl_event_init(&producers[i].events[j], on_event, NULL);
+        }
+        producers[i].num_events = num_events;
+        producers[i].use_ref = use_ref;
+        pthread_create(&producers[i].thread, NULL, producer_thread,
+                       &producers[i]);
+    }
+
+    total = num_producers * num_events;
+
+    start = now_sec();
+    s_start = 1;
+
+    for (i = 0; i < total; i++) {
+        if (use_ref) {
+            ev = ref_queue_get(&s_ref_queue);
+        } else {
+            ev = ble_npl_eventq_get(&s_eventq, BLE_NPL_TIME_FOREVER);
+        }
+        VerifyOrQuit(ev != NULL, "bench: no event");
+        ble_npl_event_run(ev);
+    }
+
+    elapsed = now_sec() - start;
+
+    for (i = 0; i < num_producers; i++) {
+        pthread_join(producers[i].thread, NULL);
+        free(producers[i].events);
+    }
+
+    if (!use_ref) {
+        VerifyOrQuit(ble_npl_eventq_is_empty(&s_eventq),
+                     "bench: queue not drained");
+    }
+
+    return total / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    double ref_rate;
+    double npl_rate;
+    int num_producers = 4;
+    int num_events = 250000;
+
+    if (argc > 1) {
+        num_producers = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_events = atoi(argv[2]);
+    }
+
+    VerifyOrQuit(num_producers > 0 && num_producers <= BENCH_MAX_PRODUCERS,
+                 "bench: invalid number of producers");
+
+    ref_queue_init(&s_ref_queue);
+    ble_npl_eventq_init(&s_eventq);
+
+    ref_rate = run_bench(num_producers, num_events, true);
+    npl_rate = run_bench(num_producers, num_events, false);
+
+    printf("producers=%d events=%d\n", num_producers,
+           num_producers * num_events);
+    printf("mutex+list: %12.0f events/sec\n", ref_rate);
+    printf("npl eventq: %12.0f events/sec (x%.2f)\n", npl_rate,
+           npl_rate / ref_rate);
+
+    return PASS;
+}
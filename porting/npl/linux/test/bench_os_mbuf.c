@@ -0,0 +1,296 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Microbenchmark for the os_mbuf packet primitives.
+
+  Every operation is run on chains of 1 to 32 mbufs for several data buffer
+  sizes.  Except for append, which fills an empty packet, the chains look
+  like reassembled HCI fragments: a packet header mbuf followed by mbufs
+  that are each half full.  Chains are built and freed outside the timed
+  section, a batch at a time.
+
+  One CSV line is printed per case:
+
+    op,buf_size,chain_len,bytes,ns_per_op,bytes_per_sec
+
+  where bytes is the amount of packet data each call moves or processes.
+
+  Usage: bench_os_mbuf.exe [minimum seconds per case]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "test_util.h"
+#include "os/os.h"
+
+#define BENCH_BATCH             (32)
+#define BENCH_MAX_CHAIN         (32)
+#define BENCH_MAX_BUF           (512)
+#define BENCH_POOL_BLOCKS       (BENCH_BATCH * (BENCH_MAX_CHAIN + 2))
+#define BENCH_MAX_PAYLOAD       (BENCH_MAX_CHAIN * BENCH_MAX_BUF)
+#define BENCH_PREPEND_LEN       (4)
+
+struct bench_op {
+    const char *name;
+    /* Whether the op starts from an empty packet instead of a chain. */
+    int empty;
+    /* Runs the op on om and returns the resulting chain, to be freed. */
+    struct os_mbuf *(*run)(struct os_mbuf *om, uint16_t len);
+    /* Number of bytes one call handles, for a payload of the given size. */
+    uint16_t (*len)(uint16_t payload, uint16_t buf_size);
+};
+
+static struct os_mempool s_mempool;
+static struct os_mbuf_pool s_mbuf_pool;
+static os_membuf_t *s_mempool_mem;
+
+static uint8_t s_src[BENCH_MAX_PAYLOAD];
+static uint8_t s_dst[BENCH_MAX_PAYLOAD];
+
+extern void os_mempool_module_init(void);
+
+static struct os_mbuf *
+bench_append(struct os_mbuf *om, uint16_t len)
+{
+    SuccessOrQuit(os_mbuf_append(om, s_src, len), "bench: append failed");
+    return om;
+}
+
+static struct os_mbuf *
+bench_copydata(struct os_mbuf *om, uint16_t len)
+{
+    SuccessOrQuit(os_mbuf_copydata(om, 0, len, s_dst),
+                  "bench: copydata failed");
+    return om;
+}
+
+static struct os_mbuf *
+bench_pullup(struct os_mbuf *om, uint16_t len)
+{
+    om = os_mbuf_pullup(om, len);
+    VerifyOrQuit(om != NULL, "bench: pullup failed");
+    return om;
+}
+
+static struct os_mbuf *
+bench_adj(struct os_mbuf *om, uint16_t len)
+{
+    os_mbuf_adj(om, len);
+    return om;
+}
+
+static struct os_mbuf *
+bench_prepend(struct os_mbuf *om, uint16_t len)
+{
+    om = os_mbuf_prepend(om, len);
+    VerifyOrQuit(om != NULL, "bench: prepend failed");
+    return om;
+}
+
+static struct os_mbuf *
+bench_pack_chains(struct os_mbuf *om, uint16_t len)
+{
+    return os_mbuf_pack_chains(om, NULL);
+}
+
+static uint16_t
+bench_len_payload(uint16_t payload, uint16_t buf_size)
+{
+    return payload;
+}
+
+static uint16_t
+bench_len_first_buf(uint16_t payload, uint16_t buf_size)
+{
+    uint16_t max;
+
+    /* As much as fits in a packet header mbuf. */
+    max = buf_size - sizeof(struct os_mbuf_pkthdr);
+    return payload < max ? payload : max;
+}
+
+static uint16_t
+bench_len_half(uint16_t payload, uint16_t buf_size)
+{
+    return payload / 2;
+}
+
+static uint16_t
+bench_len_prepend(uint16_t payload, uint16_t buf_size)
+{
+    return BENCH_PREPEND_LEN;
+}
+
+static const struct bench_op bench_ops[] = {
+    { "append",      1, bench_append,      bench_len_payload },
+    { "copydata",    0, bench_copydata,    bench_len_payload },
+    { "pullup",      0, bench_pullup,      bench_len_first_buf },
+    { "adj",         0, bench_adj,         bench_len_half },
+    { "prepend",     0, bench_prepend,     bench_len_prepend },
+    { "pack_chains", 0, bench_pack_chains, bench_len_payload },
+};
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+pool_init(uint16_t buf_size)
+{
+    uint32_t block_size;
+
+    block_size = buf_size + sizeof(struct os_mbuf);
+
+    free(s_mempool_mem);
+    s_mempool_mem = malloc(OS_MEMPOOL_BYTES(BENCH_POOL_BLOCKS, block_size));
+    VerifyOrQuit(s_mempool_mem != NULL, "bench: out of memory");
+
+    SuccessOrQuit(os_mempool_init(&s_mempool, BENCH_POOL_BLOCKS, block_size,
+                                  s_mempool_mem, "bench"),
+                  "bench: os_mempool_init failed");
+    SuccessOrQuit(os_mbuf_pool_init(&s_mbuf_pool, &s_mempool, block_size,
+                                    BENCH_POOL_BLOCKS),
+                  "bench: os_mbuf_pool_init failed");
+}
+
+/**
+ * Builds a packet of chain_len mbufs, each holding fill bytes.
+ */
+static struct os_mbuf *
+chain_build(int chain_len, uint16_t fill)
+{
+    struct os_mbuf *om;
+    struct os_mbuf *m;
+    int i;
+
+    om = os_mbuf_get_pkthdr(&s_mbuf_pool, 0);
+    VerifyOrQuit(om != NULL, "bench: pool exhausted");
+    memcpy(om->om_data, s_src, fill);
+    om->om_len = fill;
+
+    for (i = 1; i < chain_len; i++) {
+        m = os_mbuf_get(&s_mbuf_pool, 0);
+        VerifyOrQuit(m != NULL, "bench: pool exhausted");
+        memcpy(m->om_data, s_src, fill);
+        m->om_len = fill;
+        os_mbuf_concat(om, m);
+    }
+
+    OS_MBUF_PKTLEN(om) = chain_len * fill;
+
+    return om;
+}
+
+static void
+run_case(const struct bench_op *op, uint16_t buf_size, int chain_len,
+         double min_sec)
+{
+    struct os_mbuf *chains[BENCH_BATCH];
+    double elapsed;
+    double start;
+    uint16_t payload;
+    uint16_t fill;
+    uint16_t len;
+    long ops;
+    int i;
+
+    fill = (buf_size - sizeof(struct os_mbuf_pkthdr)) / 2;
+    payload = chain_len * fill;
+    len = op->len(payload, buf_size);
+
+    elapsed = 0;
+    ops = 0;
+    while (elapsed < min_sec) {
+        for (i = 0; i < BENCH_BATCH; i++) {
+            if (op->empty) {
+                chains[i] = os_mbuf_get_pkthdr(&s_mbuf_pool, 0);
+                VerifyOrQuit(chains[i] != NULL, "bench: pool exhausted");
+            } else {
+                chains[i] = chain_build(chain_len, fill);
+            }
+        }
+
+        start = now_sec();
+        for (i = 0; i < BENCH_BATCH; i++) {
+            chains[i] = op->run(chains[i], len);
+        }
+        elapsed += now_sec() - start;
+        ops += BENCH_BATCH;
+
+        for (i = 0; i < BENCH_BATCH; i++) {
+            os_mbuf_free_chain(chains[i]);
+        }
+    }
+
+    VerifyOrQuit(s_mempool.mp_num_free == BENCH_POOL_BLOCKS,
+                 "bench: mbufs leaked");
+
+    printf("%s,%u,%d,%u,%.1f,%.0f\n", op->name, buf_size, chain_len, len,
+           elapsed * 1e9 / ops, (double)len * ops / elapsed);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint16_t buf_sizes[] = { 64, 128, 256, 512 };
+    static const int chain_lens[] = { 1, 2, 8, 32 };
+    double min_sec = 0.02;
+    unsigned int op;
+    unsigned int b;
+    unsigned int c;
+    int i;
+
+    if (argc > 1) {
+        min_sec = atof(argv[1]);
+    }
+
+    VerifyOrQuit(min_sec > 0, "bench: invalid duration");
+
+    for (i = 0; i < BENCH_MAX_PAYLOAD; i++) {
+        s_src[i] = i;
+    }
+
+    os_mempool_module_init();
+
+    printf("op,buf_size,chain_len,bytes,ns_per_op,bytes_per_sec\n");
+
+    for (b = 0; b < sizeof(buf_sizes) / sizeof(buf_sizes[0]); b++) {
+        pool_init(buf_sizes[b]);
+        for (op = 0; op < sizeof(bench_ops) / sizeof(bench_ops[0]); op++) {
+            for (c = 0; c < sizeof(chain_lens) / sizeof(chain_lens[0]); c++) {
+                run_case(&bench_ops[op], buf_sizes[b], chain_lens[c],
+                         min_sec);
+            }
+        }
+        os_mempool_unregister(&s_mempool);
+    }
+
+    free(s_mempool_mem);
+
+    return PASS;
+}
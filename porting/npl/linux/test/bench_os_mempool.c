@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/**
+  Multi-threaded allocation benchmark for os_mempool.
+
+  Each thread repeatedly takes a burst of blocks from one shared pool, stamps
+  them with its id, checks the stamps and puts the blocks back.  The run is
+  repeated for 1, 2, 4, ... threads and the get+put pairs per second are
+  printed.  The Makefile builds this twice: bench_os_mempool.exe uses the
+  port's default (lock-free) free list, bench_os_mempool_locked.exe is built
+  with BLE_NPL_OS_MEMPOOL_LOCKFREE=0 and uses critical sections.
+
+  Usage: bench_os_mempool.exe [max threads] [bursts per thread]
+*/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "test_util.h"
+#include "os/os.h"
+
+#define BENCH_MAX_THREADS       (16)
+#define BENCH_BURST             (4)
+#define BENCH_BLOCKS            (BENCH_MAX_THREADS * BENCH_BURST)
+#define BENCH_BLOCK_SIZE        (64)
+
+struct bench_thread {
+    pthread_t thread;
+    uintptr_t id;
+    int num_bursts;
+};
+
+static struct os_mempool s_mempool;
+static os_membuf_t s_mempool_mem[OS_MEMPOOL_SIZE(BENCH_BLOCKS,
+                                                 BENCH_BLOCK_SIZE)];
+static volatile int s_start;
+
+extern void os_mempool_module_init(void);
+
+static void *
+bench_thread(void *arg)
+{
+    struct bench_thread *t = arg;
+    uintptr_t *blocks[BENCH_BURST];
+    int i;
+    int j;
+
+    while (!s_start) {
+    }
+
+    for (i = 0; i < t->num_bursts; i++) {
+        for (j = 0; j < BENCH_BURST; j++) {
+            blocks[j] = os_memblock_get(&s_mempool);
+            VerifyOrQuit(blocks[j] != NULL, "bench: pool exhausted");
+            blocks[j][1] = t->id;
+        }
+
+        for (j = 0; j < BENCH_BURST; j++) {
+            VerifyOrQuit(blocks[j][1] == t->id,
+                         "bench: block handed out twice");
+            SuccessOrQuit(os_memblock_put(&s_mempool, blocks[j]),
+                          "bench: put refused a valid block");
+        }
+    }
+
+    return NULL;
+}
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double
+run_bench(int num_threads, int num_bursts)
+{
+    struct bench_thread threads[BENCH_MAX_THREADS];
+    double start;
+    double elapsed;
+    int i;
+
+    s_start = 0;
+
+    for (i = 0; i < num_threads; i++) {
+        threads[i].id = i + 1;
+        threads[i].num_bursts = num_bursts;
+        pthread_create(&threads[i].thread, NULL, bench_thread, &threads[i]);
+    }
+
+    start = now_sec();
+    s_start = 1;
+
+    for (i = 0; i < num_threads; i++) {
+        pthread_join(threads[i].thread, NULL);
+    }
+
+    elapsed = now_sec() - start;
+
+    VerifyOrQuit(s_mempool.mp_num_free == BENCH_BLOCKS,
+                 "bench: free count out of sync");
+    VerifyOrQuit(os_mempool_is_sane(&s_mempool), "bench: pool corrupted");
+
+    return (double)num_threads * num_bursts * BENCH_BURST / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    double rate;
+    int max_threads = 8;
+    int num_bursts = 250000;
+    int n;
+
+    if (argc > 1) {
+        max_threads = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_bursts = atoi(argv[2]);
+    }
+
+    VerifyOrQuit(max_threads > 0 && max_threads <= BENCH_MAX_THREADS,
+                 "bench: invalid number of threads");
+
+    os_mempool_module_init();
+    SuccessOrQuit(os_mempool_init(&s_mempool, BENCH_BLOCKS, BENCH_BLOCK_SIZE,
+                                  s_mempool_mem, "bench"),
+                  "bench: os_mempool_init failed");
+
+    printf("os_mempool (%s) bursts=%d burst=%d\n",
+           OS_MEMPOOL_LOCKFREE ? "lock-free" : "locked", num_bursts,
+           BENCH_BURST);
+
+    for (n = 1; n <= max_threads; n *= 2) {
+        rate = run_bench(n, num_bursts);
+        printf("threads=%-2d %12.0f get+put/sec %8.1f ns/op\n", n, rate,
+               1e9 / rate);
+    }
+
+    return PASS;
+}
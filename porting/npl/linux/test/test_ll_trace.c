@@ -0,0 +1,299 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Scheduler trace ring, built with the controller's ble_ll_trace.c.  The
+ * controller hooks it calls are stubbed here: events posted to LL are counted
+ * and run by hand once posted, and HCI events are captured instead of sent.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "test_util.h"
+#include "nimble/hci_common.h"
+#include "controller/ble_ll.h"
+#include "controller/ble_ll_ctrl.h"
+#include "controller/ble_ll_trace.h"
+
+#define TEST_TRACE_CNT      MYNEWT_VAL(BLE_LL_SCHED_TRACE_CNT)
+
+/* Same as the controller's limit for single HCI event */
+#define TEST_TRACE_EV_CNT                                           \
+    ((BLE_HCI_MAX_DATA_LEN - sizeof(struct ble_hci_ev_vs) -         \
+      sizeof(struct ble_hci_ev_vs_sched_trace)) /                   \
+     sizeof(struct ble_hci_vs_sched_trace_rec))
+
+#define TEST_TRACE_POST_CNT                                         \
+    (TEST_TRACE_EV_CNT < TEST_TRACE_CNT ? TEST_TRACE_EV_CNT : TEST_TRACE_CNT)
+
+#define TEST_TRACE_MAX_RECS (4 * TEST_TRACE_CNT)
+
+static uint32_t s_now;
+
+static struct ble_npl_event *s_posted_ev;
+static bool s_ev_pending;
+static int s_num_posted;
+
+static bool s_hci_fail;
+static int s_num_hci_ev;
+static int s_hci_lost;
+static int s_hci_max_cnt;
+static int s_num_recs;
+static struct ble_hci_vs_sched_trace_rec s_recs[TEST_TRACE_MAX_RECS];
+
+uint32_t
+os_cputime_get32(void)
+{
+    return s_now;
+}
+
+void
+ble_ll_event_add(struct ble_npl_event *ev)
+{
+    s_posted_ev = ev;
+    s_ev_pending = true;
+    s_num_posted++;
+}
+
+int
+ble_ll_hci_ev_send_vs_sched_trace(const struct ble_hci_vs_sched_trace_rec *recs,
+                                  uint8_t count, uint16_t lost)
+{
+    if (s_hci_fail) {
+        return -1;
+    }
+
+    VerifyOrQuit(count > 0, "empty trace event");
+    VerifyOrQuit(s_num_recs + count <= TEST_TRACE_MAX_RECS,
+                 "too many records");
+
+    memcpy(&s_recs[s_num_recs], recs, count * sizeof(*recs));
+    s_num_recs += count;
+    s_num_hci_ev++;
+    s_hci_lost += lost;
+    if (count > s_hci_max_cnt) {
+        s_hci_max_cnt = count;
+    }
+
+    return 0;
+}
+
+static void
+test_clear(void)
+{
+    s_ev_pending = false;
+    s_num_posted = 0;
+    s_hci_fail = false;
+    s_num_hci_ev = 0;
+    s_hci_lost = 0;
+    s_hci_max_cnt = 0;
+    s_num_recs = 0;
+}
+
+/**
+ * Adds a record tagged with the given sequence number.
+ */
+static void
+test_trace(uint32_t seq)
+{
+    s_now = 1000 + seq;
+    ble_ll_trace_sched(BLE_HCI_VS_SCHED_TRACE_EXEC, seq & 0xff, 0,
+                       seq, 2000 + seq);
+}
+
+/**
+ * Runs the event posted to LL, as LL task would.  Fails if nothing was posted
+ * since the last run.
+ */
+static int
+test_run_posted(void)
+{
+    VerifyOrQuit(s_ev_pending, "no event posted");
+    s_ev_pending = false;
+    ble_npl_event_run(s_posted_ev);
+
+    return PASS;
+}
+
+/**
+ * Checks that records with sequence numbers first, first + 1, ... were sent
+ * in order and that no HCI event exceeded its size.
+ */
+static int
+test_verify_recs(uint32_t first, int count)
+{
+    const struct ble_hci_vs_sched_trace_rec *rec;
+    int i;
+
+    VerifyOrQuit(s_num_recs == count, "wrong number of records sent");
+    VerifyOrQuit(s_hci_max_cnt <= TEST_TRACE_EV_CNT, "HCI event too long");
+
+    for (i = 0; i < count; i++) {
+        rec = &s_recs[i];
+        VerifyOrQuit(le32toh(rec->start_time) == first + i,
+                     "records out of order");
+        VerifyOrQuit(rec->event == BLE_HCI_VS_SCHED_TRACE_EXEC &&
+                     rec->sched_type == ((first + i) & 0xff) &&
+                     rec->reason == 0 && rec->reserved == 0,
+                     "wrong record header");
+        VerifyOrQuit(le32toh(rec->timestamp) == 1000 + first + i,
+                     "wrong timestamp");
+        VerifyOrQuit(le32toh(rec->end_time) == 2000 + first + i,
+                     "wrong end time");
+    }
+
+    return PASS;
+}
+
+int
+test_init(void)
+{
+    ble_ll_trace_sched_init();
+    test_clear();
+
+    /* Nothing is recorded until enabled */
+    test_trace(0);
+    ble_ll_trace_sched_enable(0);
+    VerifyOrQuit(s_num_posted == 0 && s_num_recs == 0,
+                 "recorded while disabled");
+
+    return PASS;
+}
+
+/**
+ * Host is notified once an HCI event can be filled, or once the ring is full
+ * if it is smaller than that.  Records that do not fit are counted as lost.
+ */
+int
+test_post(void)
+{
+    uint32_t seq;
+
+    ble_ll_trace_sched_reset();
+    test_clear();
+    ble_ll_trace_sched_enable(1);
+
+    for (seq = 0; seq < TEST_TRACE_POST_CNT - 1; seq++) {
+        test_trace(seq);
+    }
+    VerifyOrQuit(s_num_posted == 0, "posted too early");
+
+    test_trace(seq++);
+    VerifyOrQuit(s_num_posted == 1, "not posted");
+
+    /* Fill the ring and drop two more */
+    for (; seq < TEST_TRACE_CNT + 2; seq++) {
+        test_trace(seq);
+    }
+
+    /* Only complete HCI events are sent until the trace is disabled */
+    SuccessOrQuit(test_run_posted(), "event not run");
+    VerifyOrQuit(s_num_recs ==
+                 TEST_TRACE_CNT - TEST_TRACE_CNT % TEST_TRACE_POST_CNT,
+                 "wrong number of records sent from event");
+    VerifyOrQuit(s_hci_lost == 2, "lost records not reported");
+
+    ble_ll_trace_sched_enable(0);
+    SuccessOrQuit(test_verify_recs(0, TEST_TRACE_CNT), "wrong records");
+    VerifyOrQuit(s_hci_lost == 2, "lost records reported twice");
+
+    return PASS;
+}
+
+/**
+ * A run of records that wraps around the end of the ring is split into two
+ * HCI events and keeps its order.
+ */
+int
+test_wrap(void)
+{
+    uint32_t seq;
+
+    ble_ll_trace_sched_reset();
+    test_clear();
+    ble_ll_trace_sched_enable(1);
+
+    /* Move the start of the ring */
+    test_trace(100);
+    ble_ll_trace_sched_enable(0);
+    VerifyOrQuit(s_num_recs == 1, "flush failed");
+
+    test_clear();
+    ble_ll_trace_sched_enable(1);
+    for (seq = 0; seq < TEST_TRACE_CNT; seq++) {
+        test_trace(seq);
+    }
+    SuccessOrQuit(test_run_posted(), "event not run");
+    ble_ll_trace_sched_enable(0);
+
+    SuccessOrQuit(test_verify_recs(0, TEST_TRACE_CNT), "wrong records");
+    VerifyOrQuit(s_num_hci_ev >= 2, "wrapped run sent as one event");
+    VerifyOrQuit(s_hci_lost == 0, "records reported lost");
+
+    return PASS;
+}
+
+/**
+ * Records are kept if the HCI event cannot be allocated and sent on the next
+ * attempt, which the next record triggers even if it does not fit in the
+ * ring.
+ */
+int
+test_hci_fail(void)
+{
+    uint32_t seq;
+
+    ble_ll_trace_sched_reset();
+    test_clear();
+    ble_ll_trace_sched_enable(1);
+
+    s_hci_fail = true;
+    for (seq = 0; seq < TEST_TRACE_POST_CNT; seq++) {
+        test_trace(seq);
+    }
+    SuccessOrQuit(test_run_posted(), "event not run");
+    VerifyOrQuit(s_num_recs == 0, "records sent");
+
+    s_hci_fail = false;
+    test_trace(seq++);
+    SuccessOrQuit(test_run_posted(), "not posted again");
+    SuccessOrQuit(test_verify_recs(0, TEST_TRACE_POST_CNT), "wrong records");
+    VerifyOrQuit(s_hci_lost == (TEST_TRACE_POST_CNT == TEST_TRACE_CNT),
+                 "wrong number of lost records");
+
+    /* Reset drops pending records */
+    test_clear();
+    test_trace(seq);
+    ble_ll_trace_sched_reset();
+    ble_ll_trace_sched_enable(0);
+    VerifyOrQuit(s_num_recs == 0, "records sent after reset");
+
+    return PASS;
+}
+
+int
+main(void)
+{
+    SuccessOrQuit(test_init(),      "Failed: trace init");
+    SuccessOrQuit(test_post(),      "Failed: trace post");
+    SuccessOrQuit(test_wrap(),      "Failed: trace ring wrap");
+    SuccessOrQuit(test_hci_fail(),  "Failed: trace HCI failure");
+    printf("All tests passed\n");
+    return PASS;
+}
@@ -36,6 +36,8 @@
 static bool                   s_tests_running = true;
 static struct ble_npl_task    s_task;
 static struct ble_npl_callout s_callout;
+static struct ble_npl_callout s_callout_stopped;
+static struct ble_npl_callout s_callout_reinit;
 static int                    s_callout_args = TEST_ARGS_VALUE;
 
 static struct ble_npl_eventq  s_eventq;
@@ -49,6 +51,9 @@ void on_callout(struct ble_npl_event *ev)
     VerifyOrQuit(*(int*)ev->ev_arg == TEST_ARGS_VALUE,
 		 "callout: args corrupted");
 
+    VerifyOrQuit(ev == &s_callout.c_ev,
+		 "callout: stopped callout fired");
+
     s_tests_running = false;
 }
 
@@ -67,18 +72,52 @@ int test_init(void)
 
 int test_queued(void)
 {
-  //VerifyOrQuit(ble_npl_callout_queued(&s_callout),
-  //	 "callout: not queued when expected");
+    VerifyOrQuit(!ble_npl_callout_is_active(&s_callout),
+                 "callout: queued before reset");
     return PASS;
 }
 
 int test_reset(void)
 {
-    return ble_npl_callout_reset(&s_callout, TEST_INTERVAL);
+    int rc;
+
+    rc = ble_npl_callout_reset(&s_callout, TEST_INTERVAL);
+
+    VerifyOrQuit(ble_npl_callout_is_active(&s_callout),
+                 "callout: not queued when expected");
+    VerifyOrQuit(ble_npl_callout_remaining_ticks(&s_callout,
+                                                 ble_npl_time_get()) <=
+                 TEST_INTERVAL,
+                 "callout: wrong remaining ticks");
+    return rc;
 }
 
 int test_stop(void)
 {
+    ble_npl_callout_init(&s_callout_stopped, &s_eventq, on_callout,
+                         &s_callout_args);
+
+    /* Expires before s_callout; must never be delivered once stopped. */
+    ble_npl_callout_reset(&s_callout_stopped, TEST_INTERVAL / 2);
+    ble_npl_callout_stop(&s_callout_stopped);
+
+    VerifyOrQuit(!ble_npl_callout_is_active(&s_callout_stopped),
+                 "callout: active after stop");
+    return PASS;
+}
+
+int test_reinit(void)
+{
+    ble_npl_callout_init(&s_callout_reinit, &s_eventq, on_callout,
+                         &s_callout_args);
+
+    /* Reinitializing an armed callout disarms it; it must never fire. */
+    ble_npl_callout_reset(&s_callout_reinit, TEST_INTERVAL / 4);
+    ble_npl_callout_init(&s_callout_reinit, &s_eventq, on_callout,
+                         &s_callout_args);
+
+    VerifyOrQuit(!ble_npl_callout_is_active(&s_callout_reinit),
+                 "callout: active after reinit");
     return PASS;
 }
 
@@ -92,6 +131,8 @@ void *test_task_run(void *args)
     SuccessOrQuit(test_init(),   "callout_init failed");
     SuccessOrQuit(test_queued(), "callout_queued failed");
     SuccessOrQuit(test_reset(),  "callout_reset failed");
+    SuccessOrQuit(test_stop(),   "callout_stop failed");
+    SuccessOrQuit(test_reinit(), "callout_init of armed callout failed");
 
     while (s_tests_running)
     {
@@ -85,6 +85,120 @@ int test_put(void)
     return PASS;
 }
 
+int test_is_empty(void)
+{
+    VerifyOrQuit(ble_npl_eventq_is_empty(&s_eventq),
+                 "eventq: new queue not empty");
+
+    s_event.ev_cb = on_event;
+    s_event.ev_arg = &s_event_args;
+    ble_npl_eventq_put(&s_eventq, &s_event);
+    VerifyOrQuit(!ble_npl_eventq_is_empty(&s_eventq),
+                 "eventq: queue empty after put");
+
+    ble_npl_eventq_remove(&s_eventq, &s_event);
+    VerifyOrQuit(ble_npl_eventq_is_empty(&s_eventq),
+                 "eventq: queue not empty after remove");
+    VerifyOrQuit(!ble_npl_event_is_queued(&s_event),
+                 "eventq: removed event still queued");
+
+    return PASS;
+}
+
+int test_get_timeout(void)
+{
+    struct ble_npl_event *ev;
+    ble_npl_time_t start;
+
+    start = ble_npl_time_get();
+    ev = ble_npl_eventq_get(&s_eventq, ble_npl_time_ms_to_ticks32(50));
+
+    VerifyOrQuit(ev == NULL, "eventq: removed event returned");
+    VerifyOrQuit(ble_npl_time_get() - start >= ble_npl_time_ms_to_ticks32(50),
+                 "eventq: get returned before timeout");
+
+    return PASS;
+}
+
+static void on_other_event(struct ble_npl_event *ev)
+{
+}
+
+/* A removed event is unlinked, so it can be reinitialized and put again
+ * without disturbing the events around it.
+ */
+int test_remove_reinit(void)
+{
+    struct ble_npl_event ev[3];
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        ble_npl_event_init(&ev[i], on_other_event, NULL);
+        ble_npl_eventq_put(&s_eventq, &ev[i]);
+    }
+
+    ble_npl_eventq_remove(&s_eventq, &ev[1]);
+    ble_npl_event_init(&ev[1], on_other_event, NULL);
+    ble_npl_eventq_put(&s_eventq, &ev[1]);
+
+    ble_npl_eventq_remove(&s_eventq, &ev[1]);
+    /* Taken off the list along with the removal above */
+    ble_npl_eventq_remove(&s_eventq, &ev[2]);
+    ble_npl_eventq_put(&s_eventq, &ev[1]);
+
+    VerifyOrQuit(ble_npl_eventq_get(&s_eventq, 0) == &ev[0],
+                 "eventq: wrong first event");
+    VerifyOrQuit(ble_npl_eventq_get(&s_eventq, 0) == &ev[1],
+                 "eventq: wrong second event");
+    VerifyOrQuit(ble_npl_eventq_get(&s_eventq, 0) == NULL,
+                 "eventq: removed event returned");
+    VerifyOrQuit(ble_npl_eventq_is_empty(&s_eventq),
+                 "eventq: queue not empty");
+
+    return PASS;
+}
+
+/* A removed event put on another queue is delivered from that queue only. */
+int test_remove_other_queue(void)
+{
+    struct ble_npl_eventq other;
+    struct ble_npl_event ev[2];
+    int i;
+
+    ble_npl_eventq_init(&other);
+
+    for (i = 0; i < 2; i++) {
+        ble_npl_event_init(&ev[i], on_other_event, NULL);
+        ble_npl_eventq_put(&s_eventq, &ev[i]);
+    }
+
+    ble_npl_eventq_remove(&s_eventq, &ev[0]);
+    ble_npl_eventq_put(&other, &ev[0]);
+
+    /* Not on this queue anymore */
+    ble_npl_eventq_remove(&s_eventq, &ev[0]);
+    VerifyOrQuit(ble_npl_event_is_queued(&ev[0]),
+                 "eventq: removed from wrong queue");
+
+    VerifyOrQuit(ble_npl_eventq_get(&s_eventq, 0) == &ev[1],
+                 "eventq: wrong event");
+    VerifyOrQuit(ble_npl_eventq_get(&s_eventq, 0) == NULL,
+                 "eventq: moved event returned");
+    VerifyOrQuit(ble_npl_eventq_is_empty(&s_eventq),
+                 "eventq: queue not empty");
+
+    VerifyOrQuit(!ble_npl_eventq_is_empty(&other),
+                 "eventq: other queue empty");
+    VerifyOrQuit(ble_npl_eventq_get(&other, 0) == &ev[0],
+                 "eventq: moved event not returned");
+    VerifyOrQuit(ble_npl_eventq_get(&other, 0) == NULL,
+                 "eventq: other queue has extra event");
+    VerifyOrQuit(ble_npl_eventq_is_empty(&other),
+                 "eventq: other queue not empty");
+
+    return PASS;
+}
+
 int test_get_no_wait(void)
 {
     //struct ble_npl_event *ev = ble_npl_eventq_get_no_wait(&s_eventq);
@@ -108,6 +222,11 @@ void *task_test_runner(void *args)
     int count = 1000000000;
 
     SuccessOrQuit(test_init(), "eventq_init failed");
+    SuccessOrQuit(test_is_empty(), "eventq_is_empty failed");
+    SuccessOrQuit(test_get_timeout(), "eventq_get timeout failed");
+    SuccessOrQuit(test_remove_reinit(), "eventq_remove reinit failed");
+    SuccessOrQuit(test_remove_other_queue(),
+                  "eventq_remove other queue failed");
     SuccessOrQuit(test_put(),  "eventq_put failed");
     SuccessOrQuit(test_get(),  "eventq_get failed");
     SuccessOrQuit(test_put(),  "eventq_put failed");
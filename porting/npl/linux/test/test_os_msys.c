@@ -0,0 +1,263 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdbool.h>
+#include "test_util.h"
+#include "os/os.h"
+#include "mem/mem.h"
+#include "ble_hs_mbuf_priv.h"
+
+#define TEST_MSYS_SMALL_BLOCKS      2
+#define TEST_MSYS_SMALL_BLOCK_SIZE  64
+#define TEST_MSYS_BIG_BLOCKS        2
+#define TEST_MSYS_BIG_BLOCK_SIZE    256
+
+static os_membuf_t s_small_mem[OS_MEMPOOL_SIZE(TEST_MSYS_SMALL_BLOCKS,
+                                               TEST_MSYS_SMALL_BLOCK_SIZE)];
+static struct os_mempool s_small_mempool;
+static struct os_mbuf_pool s_small_pool;
+
+static os_membuf_t s_big_mem[OS_MEMPOOL_SIZE(TEST_MSYS_BIG_BLOCKS,
+                                             TEST_MSYS_BIG_BLOCK_SIZE)];
+static struct os_mempool s_big_mempool;
+static struct os_mbuf_pool s_big_pool;
+
+extern void os_mempool_module_init(void);
+
+static struct os_mempool_info
+test_info(const char *name)
+{
+    struct os_mempool_info omi;
+
+    VerifyOrQuit(os_mempool_get(name, &omi) != NULL, "pool not registered");
+    return omi;
+}
+
+/**
+ * Frees every block and zeroes the counters of both msys pools.
+ */
+static void
+test_reset(void)
+{
+    SuccessOrQuit(os_mempool_clear(&s_small_mempool), "clear failed");
+    SuccessOrQuit(os_mempool_clear(&s_big_mempool), "clear failed");
+}
+
+int
+test_init(void)
+{
+    os_mempool_module_init();
+    os_msys_reset();
+
+    /* Register the big pool first; msys has to keep them sorted. */
+    SuccessOrQuit(mem_init_mbuf_pool(s_big_mem, &s_big_mempool, &s_big_pool,
+                                     TEST_MSYS_BIG_BLOCKS,
+                                     TEST_MSYS_BIG_BLOCK_SIZE, "big"),
+                  "big pool init failed");
+    SuccessOrQuit(os_msys_register(&s_big_pool), "big pool register failed");
+
+    SuccessOrQuit(mem_init_mbuf_pool(s_small_mem, &s_small_mempool,
+                                     &s_small_pool, TEST_MSYS_SMALL_BLOCKS,
+                                     TEST_MSYS_SMALL_BLOCK_SIZE, "small"),
+                  "small pool init failed");
+    SuccessOrQuit(os_msys_register(&s_small_pool),
+                  "small pool register failed");
+
+    return PASS;
+}
+
+/**
+ * Sized requests are served by the smallest pool that fits; unsized ones by
+ * the biggest pool.
+ */
+int
+test_select(void)
+{
+    struct os_mempool_info omi;
+    struct os_mbuf *om;
+    uint16_t small_len;
+
+    test_reset();
+    small_len = s_small_pool.omp_databuf_len;
+
+    om = os_msys_get(8, 0);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_small_pool,
+                 "small request not served by small pool");
+    os_mbuf_free_chain(om);
+
+    om = os_msys_get(small_len, 0);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_small_pool,
+                 "exact fit not served by small pool");
+    os_mbuf_free_chain(om);
+
+    om = os_msys_get(small_len + 1, 0);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_big_pool,
+                 "large request not served by big pool");
+    os_mbuf_free_chain(om);
+
+    om = os_msys_get(0, 0);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_big_pool,
+                 "unsized request not served by big pool");
+    os_mbuf_free_chain(om);
+
+    /* 8 of small_len and 0 of small_len bytes left unused, on average half
+     * of it; the big pool left 0 unused by the single sized allocation.
+     */
+    omi = test_info("small");
+    VerifyOrQuit(omi.omi_avg_unused == (small_len - 8) / 2,
+                 "wrong small pool avg unused");
+    VerifyOrQuit(omi.omi_num_fallback == 0 && omi.omi_num_fail == 0,
+                 "unexpected small pool fallback or fail");
+    omi = test_info("big");
+    VerifyOrQuit(omi.omi_avg_unused ==
+                 s_big_pool.omp_databuf_len - (small_len + 1),
+                 "wrong big pool avg unused");
+    VerifyOrQuit(omi.omi_num_fallback == 0 && omi.omi_num_fail == 0,
+                 "unexpected big pool fallback or fail");
+
+    return PASS;
+}
+
+/**
+ * An exhausted pool makes msys fall back to the next bigger one, and a
+ * request no pool can serve is counted as a failure of the pool that fits.
+ */
+int
+test_fallback(void)
+{
+    struct os_mempool_info omi;
+    struct os_mbuf *small[TEST_MSYS_SMALL_BLOCKS];
+    struct os_mbuf *big[TEST_MSYS_BIG_BLOCKS];
+    struct os_mbuf *om;
+    int i;
+
+    test_reset();
+
+    for (i = 0; i < TEST_MSYS_SMALL_BLOCKS; i++) {
+        small[i] = os_msys_get(8, 0);
+        VerifyOrQuit(small[i] != NULL && small[i]->om_omp == &s_small_pool,
+                     "small request not served by small pool");
+    }
+
+    /* Small pool exhausted; served by the big one. */
+    big[0] = os_msys_get(8, 0);
+    VerifyOrQuit(big[0] != NULL && big[0]->om_omp == &s_big_pool,
+                 "no fallback to big pool");
+    omi = test_info("big");
+    VerifyOrQuit(omi.omi_num_fallback == 1, "fallback not counted");
+
+    /* Big requests take the big pool anyway; not a fallback. */
+    big[1] = os_msys_get(s_small_pool.omp_databuf_len + 1, 0);
+    VerifyOrQuit(big[1] != NULL && big[1]->om_omp == &s_big_pool,
+                 "large request not served by big pool");
+    omi = test_info("big");
+    VerifyOrQuit(omi.omi_num_fallback == 1, "fallback miscounted");
+
+    /* Everything exhausted. */
+    om = os_msys_get(8, 0);
+    VerifyOrQuit(om == NULL, "allocation from exhausted msys");
+    om = os_msys_get(s_small_pool.omp_databuf_len + 1, 0);
+    VerifyOrQuit(om == NULL, "allocation from exhausted msys");
+
+    omi = test_info("small");
+    VerifyOrQuit(omi.omi_num_fail == 1, "small pool fail not counted");
+    VerifyOrQuit(omi.omi_num_fallback == 0, "small pool fallback counted");
+    omi = test_info("big");
+    VerifyOrQuit(omi.omi_num_fail == 1, "big pool fail not counted");
+
+    for (i = 0; i < TEST_MSYS_SMALL_BLOCKS; i++) {
+        os_mbuf_free_chain(small[i]);
+    }
+    for (i = 0; i < TEST_MSYS_BIG_BLOCKS; i++) {
+        os_mbuf_free_chain(big[i]);
+    }
+
+    VerifyOrQuit(os_msys_num_free() ==
+                 TEST_MSYS_SMALL_BLOCKS + TEST_MSYS_BIG_BLOCKS,
+                 "blocks leaked");
+
+    return PASS;
+}
+
+/**
+ * Host packets of a known size come from the smallest pool that holds them
+ * contiguously; if only a smaller block is left, the host takes the biggest
+ * block available rather than failing.
+ */
+int
+test_hs_sized(void)
+{
+    struct os_mbuf *big[TEST_MSYS_BIG_BLOCKS];
+    struct os_mbuf *om;
+    uint16_t len;
+    int i;
+
+    test_reset();
+
+    om = ble_hs_mbuf_l2cap_pkt_sized(8);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_small_pool,
+                 "small packet not served by small pool");
+    VerifyOrQuit(OS_MBUF_TRAILINGSPACE(om) >= 8, "small packet too short");
+    os_mbuf_free_chain(om);
+
+    /* Too big for a small block once the headers are accounted for. */
+    len = s_small_pool.omp_databuf_len;
+    om = ble_hs_mbuf_l2cap_pkt_sized(len);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_big_pool,
+                 "large packet not served by big pool");
+    VerifyOrQuit(OS_MBUF_TRAILINGSPACE(om) >= len, "large packet too short");
+    os_mbuf_free_chain(om);
+
+    /* With the big pool exhausted, the host gets the biggest free block and
+     * does not hold on to the first one it tried.
+     */
+    for (i = 0; i < TEST_MSYS_BIG_BLOCKS; i++) {
+        big[i] = os_msys_get(0, 0);
+        VerifyOrQuit(big[i] != NULL && big[i]->om_omp == &s_big_pool,
+                     "unsized request not served by big pool");
+    }
+
+    om = ble_hs_mbuf_l2cap_pkt_sized(len);
+    VerifyOrQuit(om != NULL && om->om_omp == &s_small_pool,
+                 "no fallback to the biggest free block");
+    VerifyOrQuit(s_small_mempool.mp_num_free == TEST_MSYS_SMALL_BLOCKS - 1,
+                 "block leaked on fallback");
+    os_mbuf_free_chain(om);
+
+    for (i = 0; i < TEST_MSYS_BIG_BLOCKS; i++) {
+        os_mbuf_free_chain(big[i]);
+    }
+
+    VerifyOrQuit(os_msys_num_free() ==
+                 TEST_MSYS_SMALL_BLOCKS + TEST_MSYS_BIG_BLOCKS,
+                 "blocks leaked");
+
+    return PASS;
+}
+
+int
+main(void)
+{
+    SuccessOrQuit(test_init(),      "Failed: msys init");
+    SuccessOrQuit(test_select(),    "Failed: msys pool selection");
+    SuccessOrQuit(test_fallback(),  "Failed: msys pool fallback");
+    SuccessOrQuit(test_hs_sized(),  "Failed: host sized packets");
+    printf("All tests passed\n");
+    return PASS;
+}
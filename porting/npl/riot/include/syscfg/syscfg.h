@@ -1521,6 +1521,10 @@
 #define MYNEWT_VAL_BLE_LL_NUM_SCAN_DUP_ADVS (8)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_SCAN_DUP_HASH
+#define MYNEWT_VAL_BLE_LL_SCAN_DUP_HASH (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_NUM_SCAN_RSP_ADVS
 #define MYNEWT_VAL_BLE_LL_NUM_SCAN_RSP_ADVS (8)
 #endif
@@ -1537,10 +1541,22 @@
 #define MYNEWT_VAL_BLE_LL_PUBLIC_DEV_ADDR (0x000000000000)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_RESOLV_BATCH_SIZE
+#define MYNEWT_VAL_BLE_LL_RESOLV_BATCH_SIZE (1)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_LL_RESOLV_CACHE_SIZE
+#define MYNEWT_VAL_BLE_LL_RESOLV_CACHE_SIZE (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_RESOLV_LIST_SIZE
 #define MYNEWT_VAL_BLE_LL_RESOLV_LIST_SIZE (4)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_RESOLV_NEG_CACHE_SIZE
+#define MYNEWT_VAL_BLE_LL_RESOLV_NEG_CACHE_SIZE (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_RFMGMT_ENABLE_TIME
 #define MYNEWT_VAL_BLE_LL_RFMGMT_ENABLE_TIME (1500)
 #endif
@@ -1593,6 +1609,18 @@
 #define MYNEWT_VAL_BLE_LL_SCHED_SCAN_SYNC_PDU_LEN (32)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_SCHED_TRACE
+#define MYNEWT_VAL_BLE_LL_SCHED_TRACE (0)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_LL_SCHED_TRACE_CNT
+#define MYNEWT_VAL_BLE_LL_SCHED_TRACE_CNT (64)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_LL_SCHED_TREE
+#define MYNEWT_VAL_BLE_LL_SCHED_TREE (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_STACK_SIZE
 #define MYNEWT_VAL_BLE_LL_STACK_SIZE (120)
 #endif
@@ -1749,10 +1777,22 @@
 #define MYNEWT_VAL_BLE_EATT_MTU (128)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_EATT_CHAN_PER_CONN
+#define MYNEWT_VAL_BLE_EATT_CHAN_PER_CONN (1)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE
 #define MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_GATT_CACHING
+#define MYNEWT_VAL_BLE_GATT_CACHING (0)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_GATT_DB_HASH
+#define MYNEWT_VAL_BLE_GATT_DB_HASH (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GATT_DISC_ALL_CHRS
 #define MYNEWT_VAL_BLE_GATT_DISC_ALL_CHRS (MYNEWT_VAL_BLE_ROLE_CENTRAL)
 #endif
@@ -1881,6 +1921,24 @@
 #define MYNEWT_VAL_BLE_HS_GAP_UNHANDLED_HCI_EVENT (0)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_HS_HCI_CMD_ASYNC_COUNT
+#define MYNEWT_VAL_BLE_HS_HCI_CMD_ASYNC_COUNT (8)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED__drr
+#define MYNEWT_VAL_BLE_HS_TX_SCHED__drr (1)
+#endif
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED__fifo
+#define MYNEWT_VAL_BLE_HS_TX_SCHED__fifo (0)
+#endif
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED
+#define MYNEWT_VAL_BLE_HS_TX_SCHED (1)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_HS_TX_SCHED_QUANTUM
+#define MYNEWT_VAL_BLE_HS_TX_SCHED_QUANTUM (251)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_HS_LOG_LVL
 #define MYNEWT_VAL_BLE_HS_LOG_LVL (1)
 #endif
@@ -1929,6 +1987,14 @@
 #define MYNEWT_VAL_BLE_L2CAP_COC_SDU_BUFF_COUNT (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_LEN
+#define MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_LEN (1)
+#endif
+
+#ifndef MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER
+#define MYNEWT_VAL_BLE_L2CAP_COC_TX_QUEUE_HIGH_WATER (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_L2CAP_ENHANCED_COC
 #define MYNEWT_VAL_BLE_L2CAP_ENHANCED_COC (0)
 #endif
@@ -2021,6 +2087,10 @@
 #define MYNEWT_VAL_BLE_STORE_MAX_CCCDS (8)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_STORE_MAX_GATT_CACHE
+#define MYNEWT_VAL_BLE_STORE_MAX_GATT_CACHE (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_SVC_GAP_APPEARANCE
 #define MYNEWT_VAL_BLE_SVC_GAP_APPEARANCE (0)
 #endif
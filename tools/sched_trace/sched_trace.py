@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+"""
+Converts NimBLE controller scheduler trace (BLE_LL_SCHED_TRACE) captured in
+btsnoop file into Chrome trace JSON that can be opened in Perfetto UI or
+chrome://tracing.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+BLE_HCI_EVCODE_VS = 0xff
+BLE_HCI_VS_SUBEV_ID_SCHED_TRACE = 0x04
+
+BLE_HCI_VS_SCHED_TRACE_EXEC = 0x01
+BLE_HCI_VS_SCHED_TRACE_PREEMPT = 0x02
+
+BTSNOOP_MAGIC = b"btsnoop\0"
+BTSNOOP_HCI_UNENCAP = 1001
+BTSNOOP_HCI_UART = 1002
+BTSNOOP_MONITOR = 2001
+
+H4_EVENT = 0x04
+MONITOR_EVENT_PKT = 0x0003
+
+REC_FMT = "<BBBBIII"
+REC_LEN = struct.calcsize(REC_FMT)
+
+SCHED_TYPES = {
+    1: "adv",
+    2: "scan",
+    3: "conn",
+    5: "dtm",
+    6: "periodic",
+    7: "sync",
+    8: "scan_aux",
+    9: "big",
+    255: "external",
+}
+
+LL_STATES = {
+    0: "standby",
+    1: "adv",
+    2: "scanning",
+    4: "connection",
+    5: "dtm",
+    6: "sync",
+    7: "scan_aux",
+    8: "external",
+    9: "big",
+}
+
+PID = 1
+OCCUPANCY_TID = 0
+
+
+def sched_type_name(sched_type):
+    return SCHED_TYPES.get(sched_type, "type_%u" % sched_type)
+
+
+def btsnoop_events(f):
+    """Yields HCI event packets (event code onwards) from btsnoop file"""
+
+    hdr = f.read(16)
+    if len(hdr) != 16 or hdr[:8] != BTSNOOP_MAGIC:
+        raise ValueError("not a btsnoop file")
+
+    _, datalink = struct.unpack(">II", hdr[8:])
+    if datalink not in (BTSNOOP_HCI_UNENCAP, BTSNOOP_HCI_UART,
+                        BTSNOOP_MONITOR):
+        raise ValueError("unsupported btsnoop datalink %u" % datalink)
+
+    while True:
+        rec = f.read(24)
+        if len(rec) < 24:
+            return
+
+        _, incl_len, flags, _, _ = struct.unpack(">IIIIQ", rec)
+        data = f.read(incl_len)
+        if len(data) < incl_len:
+            return
+
+        if datalink == BTSNOOP_HCI_UNENCAP:
+            # bit 1 set for commands and events, bit 0 set for received
+            if (flags & 0x03) == 0x03:
+                yield data
+        elif datalink == BTSNOOP_HCI_UART:
+            if data and data[0] == H4_EVENT:
+                yield data[1:]
+        elif (flags & 0xffff) == MONITOR_EVENT_PKT:
+            yield data
+
+
+def sched_trace_events(pkts):
+    """Yields (lost, records) from scheduler trace HCI events"""
+
+    for pkt in pkts:
+        if len(pkt) < 6 or pkt[0] != BLE_HCI_EVCODE_VS:
+            continue
+        if pkt[2] != BLE_HCI_VS_SUBEV_ID_SCHED_TRACE:
+            continue
+
+        lost, count = struct.unpack_from("<HB", pkt, 3)
+        recs = []
+        for i in range(count):
+            off = 6 + i * REC_LEN
+            if off + REC_LEN > len(pkt):
+                break
+            recs.append(struct.unpack_from(REC_FMT, pkt, off))
+
+        yield lost, recs
+
+
+class Timeline:
+    """Unwraps 32-bit tick counter and converts ticks to microseconds"""
+
+    def __init__(self, tick_hz):
+        self.tick_hz = tick_hz
+        self.last = None
+        self.ticks = 0
+
+    def update(self, timestamp):
+        # Timeline starts at controller time of first record
+        if self.last is None:
+            self.ticks = timestamp
+        else:
+            self.ticks += self.diff(timestamp, self.last)
+        self.last = timestamp
+        return self.ticks
+
+    @staticmethod
+    def diff(a, b):
+        d = (a - b) & 0xffffffff
+        if d & 0x80000000:
+            d -= 0x100000000
+        return d
+
+    def us(self, ticks):
+        return ticks * 1000000.0 / self.tick_hz
+
+
+def convert(pkts, tick_hz):
+    tl = Timeline(tick_hz)
+    events = []
+    tids = set()
+
+    for lost, recs in sched_trace_events(pkts):
+        if lost:
+            events.append({
+                "name": "records lost",
+                "ph": "i",
+                "s": "g",
+                "pid": PID,
+                "ts": tl.us(tl.ticks),
+                "args": {"lost": lost},
+            })
+
+        for event, sched_type, reason, _, start, timestamp, end in recs:
+            now = tl.update(timestamp)
+            start_ticks = now + Timeline.diff(start, timestamp)
+            end_ticks = now + Timeline.diff(end, timestamp)
+            name = sched_type_name(sched_type)
+            tids.add(sched_type)
+
+            if event == BLE_HCI_VS_SCHED_TRACE_EXEC:
+                late_us = tl.us(now - start_ticks)
+                # Planned slot, items on scheduler queue never overlap
+                events.append({
+                    "name": name,
+                    "ph": "X",
+                    "pid": PID,
+                    "tid": OCCUPANCY_TID,
+                    "ts": tl.us(start_ticks),
+                    "dur": max(tl.us(end_ticks - start_ticks), 0),
+                })
+                events.append({
+                    "name": name,
+                    "ph": "X",
+                    "pid": PID,
+                    "tid": sched_type,
+                    "ts": tl.us(now),
+                    "dur": max(tl.us(end_ticks - now), 0),
+                    "args": {
+                        "planned_start_us": tl.us(start_ticks),
+                        "late_us": late_us,
+                        "interrupted": LL_STATES.get(reason, reason),
+                    },
+                })
+                events.append({
+                    "name": "start latency [us]",
+                    "ph": "C",
+                    "pid": PID,
+                    "ts": tl.us(now),
+                    "args": {name: late_us},
+                })
+            elif event == BLE_HCI_VS_SCHED_TRACE_PREEMPT:
+                events.append({
+                    "name": "preempted by %s" % sched_type_name(reason),
+                    "ph": "i",
+                    "s": "t",
+                    "pid": PID,
+                    "tid": sched_type,
+                    "ts": tl.us(now),
+                    "args": {
+                        "planned_start_us": tl.us(start_ticks),
+                        "planned_end_us": tl.us(end_ticks),
+                    },
+                })
+
+    meta = [{
+        "name": "process_name",
+        "ph": "M",
+        "pid": PID,
+        "args": {"name": "BLE LL scheduler"},
+    }, {
+        "name": "thread_name",
+        "ph": "M",
+        "pid": PID,
+        "tid": OCCUPANCY_TID,
+        "args": {"name": "occupancy"},
+    }]
+    for tid in sorted(tids):
+        meta.append({
+            "name": "thread_name",
+            "ph": "M",
+            "pid": PID,
+            "tid": tid,
+            "args": {"name": sched_type_name(tid)},
+        })
+
+    return {"traceEvents": meta + events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert NimBLE scheduler trace from btsnoop file into "
+                    "Chrome trace JSON (Perfetto, chrome://tracing)")
+    parser.add_argument("input", help="btsnoop file, e.g. from btmon -w")
+    parser.add_argument("output", nargs="?",
+                        help="output JSON file (default: stdout)")
+    parser.add_argument("--tick-hz", type=int, default=32768,
+                        help="controller timer frequency, i.e. "
+                             "OS_CPUTIME_FREQ (default: 32768)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        trace = convert(btsnoop_events(f), args.tick_hz)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
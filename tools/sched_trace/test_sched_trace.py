@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+"""
+Tests for sched_trace.py on synthetic btsnoop files.
+
+Run with: python3 -m unittest test_sched_trace
+"""
+
+import io
+import struct
+import unittest
+
+import sched_trace as st
+
+TICK_HZ = 1000000
+
+SCHED_TYPE_ADV = 1
+SCHED_TYPE_CONN = 3
+
+
+def rec(event, sched_type, reason, start, timestamp, end):
+    return struct.pack(st.REC_FMT, event, sched_type, reason, 0,
+                       start, timestamp, end)
+
+
+def trace_event(recs, lost=0):
+    """HCI event (event code onwards) carrying given records"""
+
+    params = struct.pack("<BHB", st.BLE_HCI_VS_SUBEV_ID_SCHED_TRACE, lost,
+                         len(recs)) + b"".join(recs)
+    return struct.pack("BB", st.BLE_HCI_EVCODE_VS, len(params)) + params
+
+
+def other_event():
+    """Command Complete event, not part of trace"""
+
+    return bytes([0x0e, 0x04, 0x01, 0x0c, 0xfc, 0x00])
+
+
+def btsnoop(datalink, pkts):
+    """btsnoop file with given (flags, data) packets"""
+
+    f = io.BytesIO()
+    f.write(st.BTSNOOP_MAGIC + struct.pack(">II", 1, datalink))
+    for flags, data in pkts:
+        f.write(struct.pack(">IIIIQ", len(data), len(data), flags, 0, 0))
+        f.write(data)
+    f.seek(0)
+    return f
+
+
+def events_of(trace, ph, tid=None):
+    return [e for e in trace["traceEvents"]
+            if e["ph"] == ph and (tid is None or e.get("tid") == tid)]
+
+
+class BtsnoopTest(unittest.TestCase):
+    def expect_events(self, datalink, pkts, expected):
+        got = list(st.btsnoop_events(btsnoop(datalink, pkts)))
+        self.assertEqual(got, expected)
+
+    def test_unencap(self):
+        ev = trace_event([])
+        cmd = bytes([0x0c, 0xfc, 0x01, 0x01])
+        self.expect_events(st.BTSNOOP_HCI_UNENCAP,
+                           [(0x02, cmd), (0x03, ev), (0x01, b"\x00")],
+                           [ev])
+
+    def test_uart(self):
+        ev = trace_event([])
+        self.expect_events(st.BTSNOOP_HCI_UART,
+                           [(0x00, b"\x01\x0c\xfc\x00"),
+                            (0x01, bytes([st.H4_EVENT]) + ev)],
+                           [ev])
+
+    def test_monitor(self):
+        ev = trace_event([])
+        self.expect_events(st.BTSNOOP_MONITOR,
+                           [(0x0002, b"\x0c\xfc\x00"),
+                            (st.MONITOR_EVENT_PKT, ev)],
+                           [ev])
+
+    def test_truncated(self):
+        ev = trace_event([])
+        f = btsnoop(st.BTSNOOP_MONITOR, [(st.MONITOR_EVENT_PKT, ev)] * 2)
+        data = f.getvalue()[:-1]
+        got = list(st.btsnoop_events(io.BytesIO(data)))
+        self.assertEqual(got, [ev])
+
+    def test_bad_magic(self):
+        with self.assertRaises(ValueError):
+            list(st.btsnoop_events(io.BytesIO(b"btsnoop\1" + bytes(8))))
+
+    def test_bad_datalink(self):
+        with self.assertRaises(ValueError):
+            list(st.btsnoop_events(btsnoop(1000, [])))
+
+
+class ConvertTest(unittest.TestCase):
+    def convert(self, pkts):
+        f = btsnoop(st.BTSNOOP_HCI_UART,
+                    [(0x01, bytes([st.H4_EVENT]) + p) for p in pkts])
+        return st.convert(st.btsnoop_events(f), TICK_HZ)
+
+    def test_filter(self):
+        trace = self.convert([other_event()])
+        self.assertEqual(events_of(trace, "X"), [])
+        self.assertEqual(events_of(trace, "i"), [])
+
+    def test_exec(self):
+        trace = self.convert([
+            other_event(),
+            trace_event([
+                rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_ADV, 4,
+                    1000, 1010, 1500),
+            ]),
+        ])
+
+        occupancy = events_of(trace, "X", st.OCCUPANCY_TID)
+        self.assertEqual(len(occupancy), 1)
+        self.assertEqual(occupancy[0]["name"], "adv")
+        self.assertEqual(occupancy[0]["ts"], 1000)
+        self.assertEqual(occupancy[0]["dur"], 500)
+
+        item = events_of(trace, "X", SCHED_TYPE_ADV)
+        self.assertEqual(len(item), 1)
+        self.assertEqual(item[0]["ts"], 1010)
+        self.assertEqual(item[0]["dur"], 490)
+        self.assertEqual(item[0]["args"]["late_us"], 10)
+        self.assertEqual(item[0]["args"]["interrupted"], "connection")
+
+        latency = events_of(trace, "C")
+        self.assertEqual(latency[0]["args"], {"adv": 10})
+
+        names = {e["tid"]: e["args"]["name"] for e in events_of(trace, "M")
+                 if e["name"] == "thread_name"}
+        self.assertEqual(names, {st.OCCUPANCY_TID: "occupancy",
+                                 SCHED_TYPE_ADV: "adv"})
+
+    def test_preempt(self):
+        trace = self.convert([
+            trace_event([
+                rec(st.BLE_HCI_VS_SCHED_TRACE_PREEMPT, SCHED_TYPE_ADV,
+                    SCHED_TYPE_CONN, 2000, 1900, 2300),
+            ]),
+        ])
+
+        preempt = events_of(trace, "i", SCHED_TYPE_ADV)
+        self.assertEqual(len(preempt), 1)
+        self.assertEqual(preempt[0]["name"], "preempted by conn")
+        self.assertEqual(preempt[0]["ts"], 1900)
+        self.assertEqual(preempt[0]["args"]["planned_start_us"], 2000)
+        self.assertEqual(preempt[0]["args"]["planned_end_us"], 2300)
+        self.assertEqual(events_of(trace, "X"), [])
+
+    def test_lost(self):
+        trace = self.convert([
+            trace_event([
+                rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_ADV, 0,
+                    100, 100, 200),
+            ]),
+            trace_event([
+                rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_ADV, 0,
+                    900, 900, 1000),
+            ], lost=3),
+        ])
+
+        lost = [e for e in events_of(trace, "i")
+                if e["name"] == "records lost"]
+        self.assertEqual(len(lost), 1)
+        self.assertEqual(lost[0]["args"]["lost"], 3)
+        # Marked at last record received before the gap
+        self.assertEqual(lost[0]["ts"], 100)
+
+    def test_wrap(self):
+        trace = self.convert([
+            trace_event([
+                rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_ADV, 0,
+                    0xffffff00, 0xffffff00, 0xffffff80),
+                rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_CONN, 0,
+                    0xfffffff0, 0x00000010, 0x00000100),
+            ]),
+        ])
+
+        item = events_of(trace, "X", SCHED_TYPE_CONN)
+        self.assertEqual(item[0]["ts"], 0xffffff00 + 0x110)
+        self.assertEqual(item[0]["args"]["late_us"], 0x20)
+        self.assertEqual(item[0]["dur"], 0xf0)
+
+    def test_short_event(self):
+        # Records count larger than what event carries
+        ev = bytearray(trace_event([
+            rec(st.BLE_HCI_VS_SCHED_TRACE_EXEC, SCHED_TYPE_ADV, 0,
+                100, 100, 200),
+        ]))
+        ev[5] = 2
+        trace = self.convert([bytes(ev)])
+        self.assertEqual(len(events_of(trace, "X", SCHED_TYPE_ADV)), 1)
+
+
+if __name__ == "__main__":
+    unittest.main()